@@ -34,6 +34,7 @@
 #include "llbc/comm/BasePoller.h"
 #include "llbc/comm/IService.h"
 #include "llbc/comm/ServiceMgr.h"
+#include "llbc/comm/EventBus.h"
 
 #include "llbc/comm/protocol/ProtocolLayer.h"
 #include "llbc/comm/protocol/ProtoReportLevel.h"
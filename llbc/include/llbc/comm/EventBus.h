@@ -0,0 +1,169 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef __LLBC_COMM_EVENT_BUS_H__
+#define __LLBC_COMM_EVENT_BUS_H__
+
+#include "llbc/common/Common.h"
+#include "llbc/core/Core.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * Previous declare some classes.
+ */
+class LLBC_IService;
+class LLBC_ServiceMgr;
+
+__LLBC_NS_END
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The cross-service event bus class encapsulation.
+ *
+ * Every service own an event bus(see LLBC_IService::GetEventBus()), the posted/published events
+ * are coalesced per destination service, and at the end of each owner service frame, every
+ * destination service's events are delivered through one service queue push, then fired in order
+ * by destination service's event manager(same as LLBC_IService::FireEvent()).
+ *
+ * Note:
+ *  - Event bus is not thread-safe, only use it in owner service thread(facades/timers/...).
+ *  - Event bus take over the events, include post/publish failed events(except the events which set
+ *    dont delete after fire option, same as LLBC_EventManager::FireEvent()).
+ *  - Dedup key is optional, in one frame, posted(or published) events have same event Id and same
+ *    non-zero dedup key will be merged, the latest event replace the pending one(keep the
+ *    pending one's position), eg: "entity X changed" event can use entity Id as dedup key.
+ */
+class LLBC_EXPORT LLBC_EventBus
+{
+public:
+    /**
+     * Constructor & Destructor.
+     * @param[in] svc    - the owner service.
+     * @param[in] svcMgr - the service manager.
+     */
+    LLBC_EventBus(LLBC_IService *svc, LLBC_ServiceMgr &svcMgr);
+    ~LLBC_EventBus();
+
+public:
+    /**
+     * Subscribe topic, owner service will receive the events published to the topic.
+     * @param[in] topic - the topic, must be greater than 0.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SubscribeTopic(int topic);
+
+    /**
+     * Unsubscribe topic.
+     * @param[in] topic - the topic.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int UnsubscribeTopic(int topic);
+
+public:
+    /**
+     * Post event to specified service, event will be delivered at the end of owner service frame.
+     * @param[in] svcId    - the destination service Id.
+     * @param[in] ev       - the event.
+     * @param[in] dedupKey - the dedup key, 0 means not dedup.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int Post(int svcId, LLBC_Event *ev, uint64 dedupKey = 0);
+
+    /**
+     * Publish event to specified topic, all topic subscribed services will receive this event
+     * (the last subscribed service receive the event, others receive the cloned events).
+     * Note: The event derived from LLBC_Event must override Clone() to clone the derived event,
+     *       otherwise publish will fail with LLBC_ERROR_NOT_ALLOW.
+     * @param[in] topic    - the topic.
+     * @param[in] ev       - the event.
+     * @param[in] dedupKey - the dedup key, 0 means not dedup.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int Publish(int topic, LLBC_Event *ev, uint64 dedupKey = 0);
+
+    /**
+     * Get the pending(posted and published but not delivered) events count.
+     * @return size_t - the pending events count.
+     */
+    size_t GetPendingCount() const;
+
+    /**
+     * Deliver all pending events, every destination service's events delivered by one queue push.
+     * Owner service will auto call this method at the end of each frame.
+     */
+    void Flush();
+
+private:
+    /**
+     * \brief The pending events batch encapsulation.
+     */
+    struct _Batch
+    {
+        std::vector<LLBC_Event *> evs;
+
+        typedef std::map<std::pair<int, uint64>, size_t> _DedupIndexes;
+        _DedupIndexes dedupIdxs;
+    };
+
+    typedef std::map<int, _Batch> _Batches;
+
+    /**
+     * Add event to batch, if has same dedup key pending event, replace it.
+     */
+    void AddToBatch(_Batch &batch, LLBC_Event *ev, uint64 dedupKey);
+
+    /**
+     * Delete all batch events and reset batch, batch buffer will be reused.
+     */
+    void ClearBatch(_Batch &batch);
+
+    /**
+     * Check event can be cloned or not(Clone() return the same type event).
+     */
+    bool IsCloneable(const LLBC_Event *ev);
+
+    /**
+     * Delete the event, if event set dont delete after fire option, do nothing.
+     */
+    static void DeleteEvent(LLBC_Event *ev);
+
+    LLBC_DISABLE_ASSIGNMENT(LLBC_EventBus);
+
+private:
+    LLBC_IService *_svc;
+    LLBC_ServiceMgr &_svcMgr;
+
+    size_t _pendingCount;
+    _Batches _svcBatches;
+    _Batches _topicBatches;
+
+    std::vector<int> _subscribers;
+
+    typedef std::map<const std::type_info *, bool> _Cloneables;
+    _Cloneables _cloneables;
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_COMM_EVENT_BUS_H__
@@ -36,6 +36,7 @@ class LLBC_ICoder;
 class LLBC_Packet;
 class LLBC_IFacade;
 class LLBC_Session;
+class LLBC_EventBus;
 class LLBC_PollerMgr;
 class LLBC_ICoderFactory;
 class LLBC_IFacadeFactory;
@@ -532,6 +533,21 @@ public:
      */
     virtual void FireEvent(LLBC_Event *ev) = 0;
 
+    /**
+     * Fire events batch(asynchronous operation), all events delivered through one service queue push,
+     * and fired in order.
+     * @param[in] evs - the will fire events, service take over the events, and vector will be cleared.
+     */
+    virtual void FireEvents(std::vector<LLBC_Event *> &evs) = 0;
+
+    /**
+     * Get the service event bus, use to post/publish events to other services, the events will be
+     * batched per destination service and delivered at the end of each service frame.
+     * Note: Only can use it in service thread.
+     * @return LLBC_EventBus & - the event bus.
+     */
+    virtual LLBC_EventBus &GetEventBus() = 0;
+
 public:
     /**
      * Post lazy task to service.
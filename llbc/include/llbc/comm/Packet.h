@@ -40,6 +40,8 @@ __LLBC_NS_BEGIN
  */
 class LLBC_EXPORT LLBC_Packet
 {
+    LLBC_ALLOCATOR_CLASS_OPS(LLBC_MemoryTag::Comm)
+
 public:
     LLBC_Packet();
     virtual ~LLBC_Packet();
@@ -349,6 +351,34 @@ public:
      */
     int Read(void *buf, size_t len);
 
+    /**
+     * Read buffer view from packet, zero-copy version of Read(void *, size_t), the view point to payload.
+     * Note: View only valid before payload released or reallocated(packet destroy/Clear, write grow,
+     *       Set/Detach/Reset/GiveUp payload, ...), see LLBC_ArrayView.
+     * @param[out] view - the buffer view.
+     * @param[in]  len  - require read size, in bytes.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int ReadBufferView(LLBC_BlobView &view, size_t len);
+
+    /**
+     * Read array view from packet, zero-copy version of Read(std::vector<_Ty>), wire format is same.
+     * Note: Only available for pod type elements(see LLBC_StreamPodTraits) that need not byte order convert,
+     *       view lifetime same as ReadBufferView().
+     * @param[out] view - the array view.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    template <typename _Ty>
+    int ReadView(LLBC_ArrayView<_Ty> &view);
+
+    /**
+     * Read null-terminated string view from packet, zero-copy version of Read(std::string &)/Read(LLBC_String &),
+     * the view not include '\0', view lifetime same as ReadBufferView().
+     * @param[out] view - the string view.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int ReadCStrView(LLBC_StringView &view);
+
     /**
      * STL container adapt read functions.
      * @param[out] val - container.
@@ -548,6 +578,31 @@ private:
     template <typename _RawTy>
     int WriteRawType(_RawTy val);
 
+    /**
+     * Read pod type array from packet, as one bulk copy, see LLBC_StreamPodTraits.
+     * @param[out] val   - the vector, the read elements will append to vector.
+     * @param[in]  count - the elements count.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    template <typename _PodTy>
+    int ReadPodArray(std::vector<_PodTy> &val, uint32 count);
+
+    /**
+     * Write pod type array to packet, as one bulk copy, see LLBC_StreamPodTraits.
+     * @param[in] val - the vector.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    template <typename _PodTy>
+    int WritePodArray(const std::vector<_PodTy> &val);
+
+    /**
+     * Convert pod type array byte order between host and network in batch(in place).
+     * @param[in/out] arr   - the array.
+     * @param[in]     count - the elements count.
+     */
+    template <typename _PodTy>
+    static void ConvertPodArrayByteOrder(_PodTy *arr, size_t count);
+
 private:
     /**
      * Check and create payload(if payload not exist).
@@ -556,6 +611,13 @@ private:
      */
     LLBC_MessageBlock *&CheckAndCreatePayload(size_t initSize);
 
+    /**
+     * Write segmented stream data to packet, all segments will copy to payload once(no flatten).
+     * @param[in] stream - the segmented stream.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int WriteSegmentedStream(const LLBC_Stream &stream);
+
 private:
     /**
      * Cleanup the pre-handle result data.
@@ -605,6 +667,8 @@ private:
 
     LLBC_IObjectPoolInst *_selfPoolInst;
     LLBC_IObjectPoolInst *_msgBlockPoolInst;
+
+    LLBC_ViewGuard _payloadViewGuard;
 };
 
 __LLBC_NS_END
@@ -210,6 +210,7 @@ LLBC_FORCE_INLINE size_t LLBC_Packet::GetPayloadLength() const
 
 LLBC_FORCE_INLINE LLBC_MessageBlock *LLBC_Packet::GetMutablePayload()
 {
+    _payloadViewGuard.Invalidate();
     if (!_payload && _msgBlockPoolInst)
         _payload = reinterpret_cast<LLBC_MessageBlock *>(_msgBlockPoolInst->Get());
 
@@ -218,6 +219,8 @@ LLBC_FORCE_INLINE LLBC_MessageBlock *LLBC_Packet::GetMutablePayload()
 
 LLBC_FORCE_INLINE LLBC_MessageBlock * LLBC_Packet::DetachPayload()
 {
+    _payloadViewGuard.Invalidate();
+
     LLBC_MessageBlock *payload = _payload;
     _payload = NULL;
 
@@ -236,6 +239,7 @@ LLBC_FORCE_INLINE void LLBC_Packet::SetPayload(LLBC_MessageBlock *payload)
 
 LLBC_FORCE_INLINE void LLBC_Packet::ResetPayload()
 {
+    _payloadViewGuard.Invalidate();
     if (_payload)
     {
         _payload->SetReadPos(0);
@@ -349,6 +353,9 @@ LLBC_FORCE_INLINE int LLBC_Packet::Read(std::vector<_Ty> &val)
         return LLBC_FAILED;
     }
 
+    if (LLBC_StreamPodTraits<_Ty>::IsPod)
+        return this->ReadPodArray(val, len);
+
     for (uint32 i = 0; i < len; ++i)
     {
         _Ty elem;
@@ -461,6 +468,84 @@ LLBC_FORCE_INLINE int LLBC_Packet::Read(std::map<_Kty, _Ty> &val)
     return LLBC_OK;
 }
 
+LLBC_FORCE_INLINE int LLBC_Packet::ReadBufferView(LLBC_BlobView &view, size_t len)
+{
+    if (!_payload || _payload->GetReadableSize() < len)
+    {
+        LLBC_SetLastError(LLBC_ERROR_LIMIT);
+        return LLBC_FAILED;
+    }
+
+    view.Bind(reinterpret_cast<const uint8 *>(_payload->GetDataStartWithReadPos()), len, _payloadViewGuard);
+    _payload->ShiftReadPos(static_cast<long>(len));
+
+    return LLBC_OK;
+}
+
+template <typename _Ty>
+inline int LLBC_Packet::ReadView(LLBC_ArrayView<_Ty> &view)
+{
+    if (!LLBC_StreamPodTraits<_Ty>::IsPod)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+        return LLBC_FAILED;
+    }
+
+#if LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+    // Can't point to elements that need convert byte order.
+    if (LLBC_StreamPodTraits<_Ty>::NeedSwap && LLBC_MachineEndian != LLBC_Endian::NetEndian)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+        return LLBC_FAILED;
+    }
+#endif // LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+
+    if (!_payload || _payload->GetReadableSize() < sizeof(uint32))
+    {
+        LLBC_SetLastError(LLBC_ERROR_LIMIT);
+        return LLBC_FAILED;
+    }
+
+    uint32 count;
+    const size_t oldReadPos = _payload->GetReadPos();
+    this->Read(count);
+    if (_payload->GetReadableSize() / sizeof(_Ty) < count)
+    {
+        _payload->SetReadPos(oldReadPos);
+
+        LLBC_SetLastError(LLBC_ERROR_LIMIT);
+        return LLBC_FAILED;
+    }
+
+    view.Bind(reinterpret_cast<const _Ty *>(_payload->GetDataStartWithReadPos()), count, _payloadViewGuard);
+    _payload->ShiftReadPos(static_cast<long>(sizeof(_Ty) * count));
+
+    return LLBC_OK;
+}
+
+LLBC_FORCE_INLINE int LLBC_Packet::ReadCStrView(LLBC_StringView &view)
+{
+    const size_t readableSize = _payload ? _payload->GetReadableSize() : 0;
+    if (readableSize == 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_LIMIT);
+        return LLBC_FAILED;
+    }
+
+    const char *str = reinterpret_cast<const char *>(_payload->GetDataStartWithReadPos());
+    const char *strEnd = reinterpret_cast<const char *>(memchr(str, '\0', readableSize));
+    if (!strEnd)
+    {
+        LLBC_SetLastError(LLBC_ERROR_FORMAT);
+        return LLBC_FAILED;
+    }
+
+    view.Bind(str, strEnd - str, _payloadViewGuard);
+    _payload->ShiftReadPos(static_cast<long>(strEnd - str + 1));
+
+    return LLBC_OK;
+}
+
 template <typename _Ty>
 LLBC_FORCE_INLINE int LLBC_Packet::Read(_Ty &val)
 {
@@ -564,13 +649,18 @@ LLBC_FORCE_INLINE int LLBC_Packet::Write(const void *buf, size_t len)
 
 LLBC_FORCE_INLINE int LLBC_Packet::Write(const LLBC_Stream &stream)
 {
-    return CheckAndCreatePayload(stream.GetPos())->Write(stream.GetBuf(), stream.GetPos());
+    if (!stream.IsSegmented())
+        return CheckAndCreatePayload(stream.GetPos())->Write(stream.GetBuf(), stream.GetPos());
+
+    return WriteSegmentedStream(stream);
 }
 
 template <typename _Ty>
 LLBC_FORCE_INLINE int LLBC_Packet::Write(const std::vector<_Ty> &val)
 {
     this->Write(static_cast<uint32>(val.size()));
+    if (LLBC_StreamPodTraits<_Ty>::IsPod)
+        return this->WritePodArray(val);
 
     const size_t size = val.size();
     for (size_t i = 0; i < size; ++i)
@@ -710,8 +800,80 @@ LLBC_FORCE_INLINE int LLBC_Packet::WriteRawType(_RawTy val)
     return CheckAndCreatePayload(sizeof(val))->Write(&val, sizeof(val));
 }
 
+__LLBC_NS_END
+
+__LLBC_INTERNAL_NS_BEGIN
+
+/**
+ * The packet pod array byte order swap unit size, LLBC_Host2Net<sint64/uint64>() reverse
+ * 32 bits parts separately, bulk conversion must keep this wire format.
+ */
+template <typename _PodTy>
+struct __LLBC_PacketPodSwapUnit { enum { value = sizeof(_PodTy) }; };
+template <>
+struct __LLBC_PacketPodSwapUnit<LLBC_NS sint64> { enum { value = 4 }; };
+template <>
+struct __LLBC_PacketPodSwapUnit<LLBC_NS uint64> { enum { value = 4 }; };
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+template <typename _PodTy>
+inline int LLBC_Packet::ReadPodArray(std::vector<_PodTy> &val, uint32 count)
+{
+    if (count == 0)
+        return LLBC_OK;
+
+    if (!_payload || _payload->GetReadableSize() / sizeof(_PodTy) < count)
+    {
+        LLBC_SetLastError(LLBC_ERROR_LIMIT);
+        return LLBC_FAILED;
+    }
+
+    const size_t oldSize = val.size();
+    val.resize(oldSize + count);
+    _payload->Read(&val[oldSize], sizeof(_PodTy) * count);
+
+    ConvertPodArrayByteOrder(&val[oldSize], count);
+
+    return LLBC_OK;
+}
+
+template <typename _PodTy>
+inline int LLBC_Packet::WritePodArray(const std::vector<_PodTy> &val)
+{
+    if (val.empty())
+        return LLBC_OK;
+
+    const size_t size = sizeof(_PodTy) * val.size();
+    LLBC_MessageBlock *payload = CheckAndCreatePayload(size);
+    if (payload->Write(&val[0], size) != LLBC_OK)
+        return LLBC_FAILED;
+
+    ConvertPodArrayByteOrder(reinterpret_cast<_PodTy *>(
+        reinterpret_cast<uint8 *>(payload->GetDataStartWithWritePos()) - size), val.size());
+
+    return LLBC_OK;
+}
+
+template <typename _PodTy>
+inline void LLBC_Packet::ConvertPodArrayByteOrder(_PodTy *arr, size_t count)
+{
+#if LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+    if (!LLBC_StreamPodTraits<_PodTy>::NeedSwap || LLBC_MachineEndian == LLBC_Endian::NetEndian)
+        return;
+
+    const size_t swapUnit = LLBC_INL_NS __LLBC_PacketPodSwapUnit<_PodTy>::value;
+    LLBC_ReverseBytesArray(arr, swapUnit, count * (sizeof(_PodTy) / swapUnit));
+#endif // LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+}
+
 LLBC_FORCE_INLINE LLBC_MessageBlock *&LLBC_Packet::CheckAndCreatePayload(size_t initSize)
 {
+    // Payload maybe reallocated by write operation.
+    _payloadViewGuard.Invalidate();
+
     if (!_payload)
     {
         if (_msgBlockPoolInst)
@@ -27,6 +27,7 @@
 
 #include "llbc/comm/FacadeEvents.h"
 #include "llbc/comm/IService.h"
+#include "llbc/comm/EventBus.h"
 #include "llbc/comm/ServiceEvent.h"
 #include "llbc/comm/PollerMgr.h"
 #include "llbc/comm/protocol/ProtocolLayer.h"
@@ -375,6 +376,18 @@ public:
      */
     virtual void FireEvent(LLBC_Event *ev);
 
+    /**
+     * Fire events batch(asynchronous operation).
+     * @param[in] evs - the will fire events, service take over the events, and vector will be cleared.
+     */
+    virtual void FireEvents(std::vector<LLBC_Event *> &evs);
+
+    /**
+     * Get the service event bus.
+     * @return LLBC_EventBus & - the event bus.
+     */
+    virtual LLBC_EventBus &GetEventBus();
+
 public:
     /**
      * Post lazy task to service.
@@ -499,6 +512,7 @@ private:
     void HandleEv_SubscribeEv(LLBC_ServiceEvent &ev);
     void HandleEv_UnsubscribeEv(LLBC_ServiceEvent &ev);
     void HandleEv_FireEv(LLBC_ServiceEvent &ev);
+    void HandleEv_FireEvBatch(LLBC_ServiceEvent &ev);
     void HandleEv_AppCfgReloaded(LLBC_ServiceEvent &ev);
 
     /**
@@ -678,6 +692,7 @@ private:
 
 private:
     LLBC_ServiceMgr &_svcMgr;
+    LLBC_EventBus _evBus;
 
 private:
     std::vector<LLBC_Packet *> _multicastOtherPackets;
@@ -57,6 +57,7 @@ public:
         SubscribeEv,
         UnsubscribeEv,
         FireEv,
+        FireEvBatch,
 
         AppCfgReloaded,
 
@@ -186,6 +187,17 @@ struct LLBC_HIDDEN LLBC_SvcEv_FireEv : public LLBC_ServiceEvent
     virtual ~LLBC_SvcEv_FireEv();
 };
 
+/**
+ * \brief The fire-event batch event structure encapsulation.
+ */
+struct LLBC_HIDDEN LLBC_SvcEv_FireEvBatch : public LLBC_ServiceEvent
+{
+    std::vector<LLBC_Event *> evs;
+
+    LLBC_SvcEv_FireEvBatch();
+    virtual ~LLBC_SvcEv_FireEvBatch();
+};
+
 /**
  * \brief The application config reloaded event structure encapsulation.
  */
@@ -265,6 +277,11 @@ public:
      */
     static LLBC_MessageBlock *BuildFireEvEv(LLBC_Event *ev);
 
+    /**
+     * Build fire-event batch event, the events will be taken over and the events vector will be cleared.
+     */
+    static LLBC_MessageBlock *BuildFireEvBatchEv(std::vector<LLBC_Event *> &evs);
+
     /**
      * Build application config reloaded event.
      */
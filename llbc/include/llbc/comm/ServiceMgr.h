@@ -111,12 +111,40 @@ public:
      */
     const Name2Services &GetAllIndexedByNameServices() const;
 
+public:
+    /**
+     * Subscribe event bus topic, the events published to this topic(by any service's event bus)
+     * will be delivered to subscribed service.
+     * Note: Service can subscribe topic before started, the events delivered to not started
+     *       services will be discarded, when service stopped, all its subscriptions will be removed.
+     * @param[in] topic - the topic, must be greater than 0.
+     * @param[in] svcId - the subscriber service Id.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SubscribeTopic(int topic, int svcId);
+
+    /**
+     * Unsubscribe event bus topic.
+     * @param[in] topic - the topic.
+     * @param[in] svcId - the subscriber service Id.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int UnsubscribeTopic(int topic, int svcId);
+
+    /**
+     * Get the topic subscribed services Ids.
+     * @param[in] topic   - the topic.
+     * @param[out] svcIds - the subscribed services Ids, will be cleared before fill.
+     */
+    void GetTopicSubscribers(int topic, std::vector<int> &svcIds);
+
 private:
     /**
      * Friend class: LLBC_Service.
      *  Access methods:
      *      OnServiceStart()
      *      OnServiceStop()
+     *      OnServiceCleanup()
      */
     friend class LLBC_Service;
 
@@ -132,6 +160,13 @@ private:
      */
     void OnServiceStop(LLBC_IService *svc);
 
+    /**
+     * Remove service's event bus topic subscriptions, self-drive and external-drive service
+     * will call this method when service stopped.
+     * @param[in] svc - the service.
+     */
+    void OnServiceCleanup(LLBC_IService *svc);
+
 private:
     LLBC_IService *GetServiceNonLock(int id);
     LLBC_IService *GetServiceNonLock(const LLBC_String &name);
@@ -149,6 +184,9 @@ private:
 
     Id2Services _id2Services;
     _Services2 _name2Services;
+
+    typedef std::map<int, std::vector<int> > _Topic2Services;
+    _Topic2Services _topic2Services;
 };
 
 /**
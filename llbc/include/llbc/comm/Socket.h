@@ -303,6 +303,14 @@ public:
      */
     int AsyncSend(LLBC_MessageBlock *block);
 
+    /**
+     * Asynchronous send stream data, stream buffer/segments will append to the socket's send queue
+     * without copy(segmented stream no need to flatten), after call, stream will be empty.
+     * @param[in] stream - the stream.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int AsyncSend(LLBC_Stream &stream);
+
     /**
      * Check the socket exist no send data or not.
      * @return bool - return true it means exist data not send.
@@ -0,0 +1,105 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef __LLBC_COM_ALLOCATOR_H__
+#define __LLBC_COM_ALLOCATOR_H__
+
+#include "llbc/common/PFConfig.h"
+
+#include "llbc/common/Macro.h"
+#include "llbc/common/Config.h"
+#include "llbc/common/OSHeader.h"
+#include "llbc/common/BasicDataType.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The memory tag class encapsulation, use to attribute library allocator allocated bytes to subsystems.
+ */
+class LLBC_EXPORT LLBC_MemoryTag
+{
+public:
+    enum
+    {
+        Begin,
+
+        Default = Begin,    // Untagged allocations(LLBC_Malloc/LLBC_Calloc/LLBC_Realloc).
+        MsgBlock,           // LLBC_MessageBlock objects and buffers.
+        Log,                // Log data, log messages.
+        Timer,              // Timer data.
+        Event,              // Event objects.
+        Comm,               // Communication module objects(packets, poller events, ...).
+        User,               // User defined allocations.
+
+        End
+    };
+
+    /**
+     * Get memory tag describe.
+     * @param[in] tag - the memory tag.
+     * @return const char * - the tag describe, if tag invalid, return "Unknown".
+     */
+    static const char *GetTagDesc(int tag);
+
+    /**
+     * Check giving memory tag is legal or not.
+     * @param[in] tag - the memory tag.
+     * @return bool - return true if legal, otherwise return false.
+     */
+    static bool IsLegal(int tag);
+};
+
+/**
+ * \brief The memory tag statistic structure encapsulation.
+ */
+struct LLBC_EXPORT LLBC_MemoryTagStat
+{
+    sint64 inUseBytes;       // In use bytes(block usable size).
+    sint64 inUseBlocks;      // In use blocks count.
+    sint64 totalAllocTimes;  // Total allocate times(included realloc).
+};
+
+/**
+ * Library allocator allocate/reallocate/free functions, do not direct call these functions,
+ * use LLBC_Malloc/LLBC_TagMalloc/... macros instead.
+ */
+LLBC_EXTERN LLBC_EXPORT void *__LLBC_Malloc(int tag, size_t size);
+LLBC_EXTERN LLBC_EXPORT void *__LLBC_Calloc(int tag, size_t size);
+LLBC_EXTERN LLBC_EXPORT void *__LLBC_Realloc(int tag, void *memblock, size_t size);
+LLBC_EXTERN LLBC_EXPORT void __LLBC_Free(void *memblock);
+
+/**
+ * Get memory tag statistic, only available when LLBC_CFG_COM_ALLOCATOR_ENABLE_TAG_STAT enabled.
+ * @param[in]  tag  - the memory tag.
+ * @param[out] stat - the tag statistic.
+ * @return int - return 0 if success, otherwise return -1.
+ */
+LLBC_EXTERN LLBC_EXPORT int LLBC_GetMemoryTagStat(int tag, LLBC_MemoryTagStat &stat);
+
+/**
+ * Flush current thread allocator cache, give back all cached blocks to central free lists.
+ * Library will auto flush thread cache when thread exit, normally you don't need call this function.
+ */
+LLBC_EXTERN LLBC_EXPORT void LLBC_FlushAllocatorThreadCache();
+
+__LLBC_NS_END
+
+#endif // !__LLBC_COM_ALLOCATOR_H__
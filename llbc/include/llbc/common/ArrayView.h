@@ -0,0 +1,202 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef __LLBC_COM_ARRAY_VIEW_H__
+#define __LLBC_COM_ARRAY_VIEW_H__
+
+#include "llbc/common/PFConfig.h"
+
+#include "llbc/common/Config.h"
+#include "llbc/common/Macro.h"
+#include "llbc/common/BasicDataType.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * Pre-declare some classes.
+ */
+class LLBC_Stream;
+class LLBC_Packet;
+
+/**
+ * \brief The view guard class encapsulation, use to detect view use-after-release.
+ *        Buffer owner(LLBC_Stream/LLBC_Packet) hold a guard, views read from owner share the guard token,
+ *        when owner release/reallocate buffer, call Invalidate() to mark all shared views invalid.
+ * Note: Guard only used when LLBC_CFG_COM_VIEW_GUARD_ENABLED enabled, not thread safe.
+ */
+class LLBC_ViewGuard
+{
+public:
+    /**
+     * The guard token, shared by guard and views.
+     */
+    struct Token
+    {
+        int refs;
+        bool valid;
+    };
+
+public:
+    LLBC_ViewGuard();
+    /**
+     * Copy constructor, new guard never share token with copied guard.
+     */
+    LLBC_ViewGuard(const LLBC_ViewGuard &another);
+
+    ~LLBC_ViewGuard();
+
+public:
+    /**
+     * Acquire current valid token, the token reference count will increase.
+     * @return Token * - the token, release by Release().
+     */
+    Token *Acquire();
+
+    /**
+     * Release token.
+     * @param[in] token - the token, could be null.
+     */
+    static void Release(Token *token);
+
+    /**
+     * Invalidate all views that acquired token from this guard.
+     */
+    void Invalidate();
+
+public:
+    /**
+     * Assignment operator, do nothing, guard never share token with another guard.
+     */
+    LLBC_ViewGuard &operator =(const LLBC_ViewGuard &another);
+
+private:
+    Token *_token;
+};
+
+/**
+ * \brief Readonly array view(pointer + length) class encapsulation, the data not owned by view.
+ *        The view read from LLBC_Stream/LLBC_Packet(ReadView/ReadBufferView/ReadCStrView) is valid
+ *        until the underlying buffer released or reallocated.
+ * Note: If LLBC_CFG_COM_VIEW_GUARD_ENABLED(default enabled in debug mode), access released view will assert.
+ */
+template <typename T>
+class LLBC_ArrayView
+{
+public:
+    typedef T value_type;
+    typedef const T *const_iterator;
+
+public:
+    LLBC_ArrayView();
+    /**
+     * Construct view using external data, the view not guarded.
+     * @param[in] data - the data pointer.
+     * @param[in] size - the elements count.
+     */
+    LLBC_ArrayView(const T *data, size_t size);
+
+    LLBC_ArrayView(const LLBC_ArrayView<T> &another);
+
+    ~LLBC_ArrayView();
+
+public:
+    /**
+     * Get view data pointer.
+     * Note: The view read from stream/packet, data pointer maybe not aligned with T.
+     * @return const T * - the data pointer.
+     */
+    const T *data() const;
+
+    /**
+     * Get view elements count.
+     * @return size_t - the elements count.
+     */
+    size_t size() const;
+
+    /**
+     * Check view is empty or not.
+     * @return bool - the empty flag.
+     */
+    bool empty() const;
+
+    /**
+     * Iterator support.
+     */
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    /**
+     * Get element.
+     * @param[in] index - the element index.
+     * @return const T & - the element.
+     */
+    const T &operator [](size_t index) const;
+
+public:
+    /**
+     * Check view underlying buffer still valid or not, if guard disabled, always return true.
+     * @return bool - the valid flag.
+     */
+    bool IsValid() const;
+
+    /**
+     * Reset view to empty view.
+     */
+    void Reset();
+
+public:
+    LLBC_ArrayView<T> &operator =(const LLBC_ArrayView<T> &another);
+
+private:
+    friend class LLBC_Stream;
+    friend class LLBC_Packet;
+
+    /**
+     * Bind view to owner's buffer.
+     */
+    void Bind(const T *data, size_t size, LLBC_ViewGuard &guard);
+
+    /**
+     * Check view valid before access data, only check when guard enabled.
+     */
+    void CheckValid() const;
+
+private:
+    const T *_data;
+    size_t _size;
+
+#if LLBC_CFG_COM_VIEW_GUARD_ENABLED
+    LLBC_ViewGuard::Token *_token;
+#endif // LLBC_CFG_COM_VIEW_GUARD_ENABLED
+};
+
+/**
+ * The string/blob view type define.
+ */
+typedef LLBC_ArrayView<char> LLBC_StringView;
+typedef LLBC_ArrayView<uint8> LLBC_BlobView;
+
+__LLBC_NS_END
+
+#include "llbc/common/ArrayViewImpl.h"
+
+#endif // !__LLBC_COM_ARRAY_VIEW_H__
@@ -0,0 +1,227 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifdef __LLBC_COM_ARRAY_VIEW_H__
+
+__LLBC_NS_BEGIN
+
+inline LLBC_ViewGuard::LLBC_ViewGuard()
+: _token(NULL)
+{
+}
+
+inline LLBC_ViewGuard::LLBC_ViewGuard(const LLBC_ViewGuard &another)
+: _token(NULL)
+{
+}
+
+inline LLBC_ViewGuard::~LLBC_ViewGuard()
+{
+    Invalidate();
+}
+
+inline LLBC_ViewGuard::Token *LLBC_ViewGuard::Acquire()
+{
+    if (!_token)
+    {
+        _token = LLBC_New(Token);
+        _token->refs = 1;
+        _token->valid = true;
+    }
+
+    ++_token->refs;
+
+    return _token;
+}
+
+inline void LLBC_ViewGuard::Release(Token *token)
+{
+    if (token && --token->refs == 0)
+        LLBC_Delete(token);
+}
+
+inline void LLBC_ViewGuard::Invalidate()
+{
+    if (!_token)
+        return;
+
+    _token->valid = false;
+    Release(_token);
+
+    _token = NULL;
+}
+
+inline LLBC_ViewGuard &LLBC_ViewGuard::operator =(const LLBC_ViewGuard &another)
+{
+    return *this;
+}
+
+template <typename T>
+inline LLBC_ArrayView<T>::LLBC_ArrayView()
+: _data(NULL)
+, _size(0)
+#if LLBC_CFG_COM_VIEW_GUARD_ENABLED
+, _token(NULL)
+#endif // LLBC_CFG_COM_VIEW_GUARD_ENABLED
+{
+}
+
+template <typename T>
+inline LLBC_ArrayView<T>::LLBC_ArrayView(const T *data, size_t size)
+: _data(data)
+, _size(data ? size : 0)
+#if LLBC_CFG_COM_VIEW_GUARD_ENABLED
+, _token(NULL)
+#endif // LLBC_CFG_COM_VIEW_GUARD_ENABLED
+{
+}
+
+template <typename T>
+inline LLBC_ArrayView<T>::LLBC_ArrayView(const LLBC_ArrayView<T> &another)
+: _data(another._data)
+, _size(another._size)
+#if LLBC_CFG_COM_VIEW_GUARD_ENABLED
+, _token(another._token)
+#endif // LLBC_CFG_COM_VIEW_GUARD_ENABLED
+{
+#if LLBC_CFG_COM_VIEW_GUARD_ENABLED
+    if (_token)
+        ++_token->refs;
+#endif // LLBC_CFG_COM_VIEW_GUARD_ENABLED
+}
+
+template <typename T>
+inline LLBC_ArrayView<T>::~LLBC_ArrayView()
+{
+#if LLBC_CFG_COM_VIEW_GUARD_ENABLED
+    LLBC_ViewGuard::Release(_token);
+#endif // LLBC_CFG_COM_VIEW_GUARD_ENABLED
+}
+
+template <typename T>
+inline const T *LLBC_ArrayView<T>::data() const
+{
+    CheckValid();
+    return _data;
+}
+
+template <typename T>
+inline size_t LLBC_ArrayView<T>::size() const
+{
+    return _size;
+}
+
+template <typename T>
+inline bool LLBC_ArrayView<T>::empty() const
+{
+    return _size == 0;
+}
+
+template <typename T>
+inline typename LLBC_ArrayView<T>::const_iterator LLBC_ArrayView<T>::begin() const
+{
+    CheckValid();
+    return _data;
+}
+
+template <typename T>
+inline typename LLBC_ArrayView<T>::const_iterator LLBC_ArrayView<T>::end() const
+{
+    CheckValid();
+    return _data + _size;
+}
+
+template <typename T>
+inline const T &LLBC_ArrayView<T>::operator [](size_t index) const
+{
+    CheckValid();
+    ASSERT(index < _size && "LLBC_ArrayView::operator[] index out of range");
+
+    return _data[index];
+}
+
+template <typename T>
+inline bool LLBC_ArrayView<T>::IsValid() const
+{
+#if LLBC_CFG_COM_VIEW_GUARD_ENABLED
+    return !_token || _token->valid;
+#else // !LLBC_CFG_COM_VIEW_GUARD_ENABLED
+    return true;
+#endif // LLBC_CFG_COM_VIEW_GUARD_ENABLED
+}
+
+template <typename T>
+inline void LLBC_ArrayView<T>::Reset()
+{
+    _data = NULL;
+    _size = 0;
+
+#if LLBC_CFG_COM_VIEW_GUARD_ENABLED
+    LLBC_ViewGuard::Release(_token);
+    _token = NULL;
+#endif // LLBC_CFG_COM_VIEW_GUARD_ENABLED
+}
+
+template <typename T>
+inline LLBC_ArrayView<T> &LLBC_ArrayView<T>::operator =(const LLBC_ArrayView<T> &another)
+{
+    if (this == &another)
+        return *this;
+
+#if LLBC_CFG_COM_VIEW_GUARD_ENABLED
+    if (another._token)
+        ++another._token->refs;
+    LLBC_ViewGuard::Release(_token);
+
+    _token = another._token;
+#endif // LLBC_CFG_COM_VIEW_GUARD_ENABLED
+
+    _data = another._data;
+    _size = another._size;
+
+    return *this;
+}
+
+template <typename T>
+inline void LLBC_ArrayView<T>::Bind(const T *data, size_t size, LLBC_ViewGuard &guard)
+{
+    Reset();
+
+    _data = data;
+    _size = size;
+
+#if LLBC_CFG_COM_VIEW_GUARD_ENABLED
+    _token = guard.Acquire();
+#endif // LLBC_CFG_COM_VIEW_GUARD_ENABLED
+}
+
+template <typename T>
+inline void LLBC_ArrayView<T>::CheckValid() const
+{
+#if LLBC_CFG_COM_VIEW_GUARD_ENABLED
+    ASSERT(IsValid() && "LLBC_ArrayView underlying buffer released, could not access view data");
+#endif // LLBC_CFG_COM_VIEW_GUARD_ENABLED
+}
+
+__LLBC_NS_END
+
+#endif // __LLBC_COM_ARRAY_VIEW_H__
@@ -31,9 +31,11 @@
 // #include "llbc/common/ThirdHeader.h"
 #include "llbc/common/Macro.h"
 #include "llbc/common/BasicDataType.h"
+#include "llbc/common/Allocator.h"
 #include "llbc/common/Define.h"
 #include "llbc/common/Template.h"
 #include "llbc/common/Endian.h"
+#include "llbc/common/ArrayView.h"
 #include "llbc/common/Stream.h"
 #include "llbc/common/StringDataType.h"
 #include "llbc/common/EventDataType.h"
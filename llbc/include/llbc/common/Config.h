@@ -24,6 +24,34 @@
 
 #include "llbc/common/PFConfig.h"
 
+/**
+ * \brief common/allocator about config options define.
+ */
+// Library allocator backend, used by LLBC_Malloc/LLBC_Calloc/LLBC_Realloc/LLBC_Free
+// and LLBC_ALLOCATOR_CLASS_OPS() declared classes(LLBC_MessageBlock, LLBC_Packet, ...).
+//   0: System allocator(malloc/realloc/free), default.
+//   1: Library in-tree thread-caching size-class allocator.
+// Note: Once the library allocator enabled(backend 1, or enabled tag statistic), memory allocated by
+//       LLBC_Malloc/LLBC_Calloc/LLBC_Realloc must be freed by LLBC_Free, do not mix it with ::free().
+#define LLBC_CFG_COM_ALLOCATOR_BACKEND                      0
+// Enable/Disable allocator per-subsystem(tag) bytes statistic, see LLBC_MemoryTag.
+#define LLBC_CFG_COM_ALLOCATOR_ENABLE_TAG_STAT              0
+// Size-class allocator max small block size(included block header), in bytes,
+// larger blocks will allocate from system allocator directly.
+#define LLBC_CFG_COM_ALLOCATOR_MAX_SMALL_SIZE               (32 * 1024)
+// Size-class allocator central span size, in bytes.
+#define LLBC_CFG_COM_ALLOCATOR_SPAN_SIZE                    (64 * 1024)
+// Size-class allocator per-thread cache max cached bytes per size class.
+#define LLBC_CFG_COM_ALLOCATOR_THREAD_CACHE_CLASS_LIMIT     (256 * 1024)
+
+/**
+ * \brief common/stream about config options define.
+ */
+// Segmented stream(see LLBC_Stream::SetSegmented()) default segment size, in bytes.
+#define LLBC_CFG_COM_STREAM_DFT_SEGMENT_SIZE                (64 * 1024)
+// Stream/Packet read views(see LLBC_ArrayView) use-after-release guard enabled or not, default only enabled in debug mode.
+#define LLBC_CFG_COM_VIEW_GUARD_ENABLED                     (0 || LLBC_DEBUG)
+
 /**
  * \brief OS about config options define.
  */
@@ -65,6 +93,19 @@
 // Determine library impl _ui64toa() API or not, Non-WIN32 Platform specific.
 #define LLBC_CFG_CORE_UTILS_IMPL__UI64TOA                   0
 
+/**
+ * \brief core/variant about config options define.
+ */
+// Variant short string inline storage size(include tailing '\0'), shorter strings store in variant holder directly,
+// longer strings/dictionaries are heap allocated and shared(copy-on-write) between variants.
+#define LLBC_CFG_CORE_VARIANT_INLINE_STR_SIZE               24
+
+/**
+ * \brief core/event about config options define.
+ */
+// The typed event max event Id, typed listeners stored in flat table indexed by event Id.
+#define LLBC_CFG_CORE_EVENT_TYPED_EVENT_MAX_ID              65535
+
 /**
  * \brief core/sampler about config options define.
  */
@@ -123,6 +164,19 @@
 #define LLBC_CFG_LOG_MAX_BACKUP_INDEX                       1000
 // Default log file buffer size, in bytes.
 #define LLBC_CFG_LOG_DEFAULT_LOG_FILE_BUFFER_SIZE           1024000
+// Default log file chunk size(in bytes, only available in asynchronous mode), if is 0, chunk mode disabled,
+// otherwise file appender write log file by chunks, and execute log files backup in background task.
+#define LLBC_CFG_LOG_DEFAULT_LOG_FILE_CHUNK_SIZE            0
+// Log file chunk alignment, chunk size will be round up to this alignment.
+#define LLBC_CFG_LOG_FILE_CHUNK_ALIGNMENT                   4096
+// Max log file chunk size.
+#define LLBC_CFG_LOG_MAX_LOG_FILE_CHUNK_SIZE                (64 * 1024 * 1024)
+// Default gzip backup log files option(only available in chunk/mmap mode, non-win32 platform, using gzip utility).
+#define LLBC_CFG_LOG_DEFAULT_GZIP_BACKUP_FILE               0
+// Default log file mmap window size, in bytes, if is 0, disable mmap mode(only available in non-win32 platforms).
+#define LLBC_CFG_LOG_DEFAULT_FILE_MMAP_WINDOW_SIZE          0
+// Max log file mmap window size, in bytes.
+#define LLBC_CFG_LOG_MAX_FILE_MMAP_WINDOW_SIZE              (256 * 1024 * 1024)
 // Default log appenders flush interval, in milli-seconds.
 #define LLBC_CFG_LOG_DEFAULT_LOG_FLUSH_INTERVAL             200
 // Default max log appenders flush interval, in milli-seconds.
@@ -134,14 +188,76 @@
 #define LLBC_CFG_LOG_ROOT_LOGGER_TAKE_OVER_UNCONFIGED       1
 // Default logfile create option
 #define LLBC_CFG_LOG_LAZY_CREATE_LOG_FILE                   0
+// Default shared log thread count(only read from root logger config), if is 0,
+// every asynchronous logger will create its own log thread, otherwise all
+// asynchronous loggers share this number of log threads.
+#define LLBC_CFG_LOG_DEFAULT_SHARED_LOG_THREAD_COUNT        0
+// Max shared log thread count.
+#define LLBC_CFG_LOG_MAX_SHARED_LOG_THREAD_COUNT            8
+// Default log ring buffer size(in log records, every producer thread owns one ring per log thread),
+// if is 0, asynchronous logger will transfer log data to log thread by message queue.
+#define LLBC_CFG_LOG_DEFAULT_RING_BUFFER_SIZE               0
+// Default log ring overflow policy, available policies: block, drop, sync(see LLBC_LogRingOverflowPolicy).
+#define LLBC_CFG_LOG_DEFAULT_RING_OVERFLOW_POLICY           "block"
+// Max log rings count per log thread, if producer threads exceed this limit,
+// the exceeded threads will transfer log data by message queue.
+#define LLBC_CFG_LOG_MAX_RING_COUNT                         256
+// Log rings drain interval when all rings empty, in milli-seconds.
+#define LLBC_CFG_LOG_RING_DRAIN_INTERVAL                    5
+// Max log records count drained in one batch.
+#define LLBC_CFG_LOG_RING_DRAIN_BATCH_SIZE                  4096
+// Default log to network option.
+#define LLBC_CFG_LOG_DEFAULT_LOG_TO_NETWORK                 0
+// Default network log pattern.
+#define LLBC_CFG_LOG_DEFAULT_NETWORK_LOG_PATTERN            "%T %f:%l@[%N][%L] - %m%n"
+// Default network log collector ip.
+#define LLBC_CFG_LOG_DEFAULT_NETWORK_IP                     "127.0.0.1"
+// Default network log protocol, available protocols: udp, tcp(see LLBC_LogNetworkProtocol).
+#define LLBC_CFG_LOG_DEFAULT_NETWORK_PROTOCOL               "udp"
+// Default network log buffer size(in bytes), when buffer full(collector unreachable or too slow),
+// new log records will be dropped and counted.
+#define LLBC_CFG_LOG_DEFAULT_NETWORK_BUFFER_SIZE            1048576
+// Default network log batch size(in bytes), log records are batched into one datagram/write.
+#define LLBC_CFG_LOG_DEFAULT_NETWORK_BATCH_SIZE             8192
+// Max network log datagram size(udp protocol batch size will be limited to this value).
+#define LLBC_CFG_LOG_MAX_NETWORK_DATAGRAM_SIZE              65507
+// Default network log reconnect interval(in milli-seconds), reconnect interval will be doubled
+// after every failed connect, until reach max reconnect interval.
+#define LLBC_CFG_LOG_DEFAULT_NETWORK_RECONNECT_INTERVAL     500
+// Default network log max reconnect interval(in milli-seconds).
+#define LLBC_CFG_LOG_DEFAULT_NETWORK_MAX_RECONNECT_INTERVAL 30000
+// Network log connect timeout(in milli-seconds, only available in tcp protocol).
+#define LLBC_CFG_LOG_NETWORK_CONNECT_TIMEOUT                5000
+// Default logger rate limit(max log messages per second), if is 0, no limit.
+#define LLBC_CFG_LOG_DEFAULT_RATE_LIMIT                     0
+// Default per-tag rate limit(max log messages per second for every tag), if is 0, no limit.
+#define LLBC_CFG_LOG_DEFAULT_TAG_RATE_LIMIT                 0
+// Default log sample rate(the probability of log message be accepted, [0.0, 1.0]), if is 1.0, no sampling.
+#define LLBC_CFG_LOG_DEFAULT_SAMPLE_RATE                    1.0
+// Default suppressed log messages report interval(in milli-seconds).
+#define LLBC_CFG_LOG_DEFAULT_SUPPRESSED_REPORT_INTERVAL     10000
+// Max rate limited tags count per logger, exceeded tags only limited by logger rate limit.
+#define LLBC_CFG_LOG_MAX_RATE_LIMIT_TAGS                    1024
+// Json log message initialize buffer size(per-thread reused, auto grow).
+#define LLBC_CFG_LOG_JSON_BUFFER_SIZE                       512
+// Json log message max reused buffer size, if buffer grow exceeded this size, will release it after message output.
+#define LLBC_CFG_LOG_JSON_MAX_REUSED_BUFFER_SIZE            65536
+// Default defer json log format flag(only available in asynchronous mode), if is 1, json log message will serialize in log thread.
+#define LLBC_CFG_LOG_DEFAULT_DEFER_JSON_FORMAT              0
 
 /**
  * \brief core/timer about configs.
  */
 // Strict timer schedule mode.
 #define LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE                 0
-// Long timeout time, when a timer timeout time >= <this value>, when call Cancel(), will force remove from binary heap.
+// Long timeout time, deprecated, timer scheduler always remove timer from binary heap when call Cancel() now.
 #define LLBC_CFG_CORE_TIMER_LONG_TIMEOUT_TIME               864000000 // 10 days
+// Default timer scheduler type(see LLBC_TimerSchedulerType), 0: binary heap, 1: hierarchical timing wheel.
+#define LLBC_CFG_CORE_TIMER_DEFAULT_SCHEDULER_TYPE          0
+// Timer scheduler instrument top N slowest timer classes.
+#define LLBC_CFG_CORE_TIMER_INSTRUMENT_TOP_N                10
+// Default timer scheduler type(see LLBC_TimerSchedulerType), 0: binary heap, 1: hierarchical timing wheel.
+#define LLBC_CFG_CORE_TIMER_DEFAULT_SCHEDULER_TYPE          0
 
 /**
 * \brief core/objectpool about configs.
@@ -97,6 +97,22 @@ void LLBC_ReverseBytes(T &val);
 template <typename T>
 T LLBC_ReverseBytes2(const T &val);
 
+/**
+ * Reverse array elements byte order in batch(in place).
+ * Note: 1. Buffer no need to be aligned.
+ *       2. 16/32/64 bits elements use SIMD kernel(AVX2/SSSE3, selected at runtime by cpu features) if available.
+ * @param[in/out] buf      - the array buffer.
+ * @param[in]     elemSize - the array element size, in bytes.
+ * @param[in]     count    - the array elements count.
+ */
+LLBC_EXTERN LLBC_EXPORT void LLBC_ReverseBytesArray(void *buf, size_t elemSize, size_t count);
+
+/**
+ * Get LLBC_ReverseBytesArray() runtime selected implementation name.
+ * @return const char * - the implementation name, avx2/ssse3/scalar.
+ */
+LLBC_EXTERN LLBC_EXPORT const char *LLBC_GetReverseBytesArrayImpl();
+
 /**
  * Convert network byte order data to host byte order.
  * @param[in/out] val - the will convert's value, network byte order, and the convert
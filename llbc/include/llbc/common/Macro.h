@@ -23,6 +23,7 @@
 #define __LLBC_COM_MACRO_H__
 
 #include "llbc/common/PFConfig.h"
+#include "llbc/common/Config.h"
 
 // The llbc namespace define.
 #define LLBC_NAMESPACE ::llbc::
@@ -238,11 +239,31 @@ private:                                            \
 #endif // LLBC_TARGET_PLATFORM_WIN32
 
 /* Memory operations macros. */
+// Determine use library allocator or not(see LLBC_CFG_COM_ALLOCATOR_XXX configs).
+#if LLBC_CFG_COM_ALLOCATOR_BACKEND != 0 || LLBC_CFG_COM_ALLOCATOR_ENABLE_TAG_STAT
+ #define LLBC_USING_LIB_ALLOCATOR 1
+#else
+ #define LLBC_USING_LIB_ALLOCATOR 0
+#endif
+
 // allocate/reallocate/free.
+#if LLBC_USING_LIB_ALLOCATOR
+#define LLBC_Malloc(type, size)             LLBC_TagMalloc(LLBC_NS LLBC_MemoryTag::Default, type, size)
+#define LLBC_Calloc(type, size)             LLBC_TagCalloc(LLBC_NS LLBC_MemoryTag::Default, type, size)
+#define LLBC_Realloc(type, memblock, size)  LLBC_TagRealloc(LLBC_NS LLBC_MemoryTag::Default, type, memblock, size)
+#define LLBC_Free(memblock)                 (LLBC_NS __LLBC_Free(memblock))
+#define LLBC_TagMalloc(tag, type, size)     (reinterpret_cast<type *>(LLBC_NS __LLBC_Malloc((tag), (size))))
+#define LLBC_TagCalloc(tag, type, size)     (reinterpret_cast<type *>(LLBC_NS __LLBC_Calloc((tag), (size))))
+#define LLBC_TagRealloc(tag, type, memblock, size) (reinterpret_cast<type *>(LLBC_NS __LLBC_Realloc((tag), (memblock), (size))))
+#else // !LLBC_USING_LIB_ALLOCATOR
 #define LLBC_Malloc(type, size)             (reinterpret_cast<type *>(::malloc(size)))
 #define LLBC_Calloc(type, size)             (reinterpret_cast<type *>(::calloc(size, 1)))
 #define LLBC_Realloc(type, memblock, size)  (reinterpret_cast<type *>(::realloc((memblock), (size))))
 #define LLBC_Free(memblock)                 (::free(memblock))
+#define LLBC_TagMalloc(tag, type, size)     LLBC_Malloc(type, size)
+#define LLBC_TagCalloc(tag, type, size)     LLBC_Calloc(type, size)
+#define LLBC_TagRealloc(tag, type, memblock, size) LLBC_Realloc(type, memblock, size)
+#endif // LLBC_USING_LIB_ALLOCATOR
 #define LLBC_XFree(memblock)        \
     do {                            \
         if (LIKELY(memblock)) {     \
@@ -282,6 +303,20 @@ private:                                            \
         }                           \
     } while(0)                      \
 
+// class specific new/delete operators, route LLBC_New/LLBC_Delete of the class to library allocator.
+// Usage: put LLBC_ALLOCATOR_CLASS_OPS(LLBC_MemoryTag::XXX) at the head of class declaration.
+#if LLBC_USING_LIB_ALLOCATOR
+#define LLBC_ALLOCATOR_CLASS_OPS(tag)                                                      \
+    public:                                                                                \
+        static void *operator new(size_t size) { return LLBC_NS __LLBC_Malloc((tag), size); } \
+        static void *operator new(size_t, void *where) { return where; }                  \
+        static void operator delete(void *ptr) { LLBC_NS __LLBC_Free(ptr); }              \
+        static void operator delete(void *, void *) {  }                                  \
+
+#else // !LLBC_USING_LIB_ALLOCATOR
+#define LLBC_ALLOCATOR_CLASS_OPS(tag)
+#endif // LLBC_USING_LIB_ALLOCATOR
+
 #define LLBC_Recycle(objptr)                LLBC_NS LLBC_PoolObjectReflection::Recycle(objptr)
 #define LLBC_XRecycle(objptr)               LLBC_NS LLBC_PoolObjectReflection::RecycleX(objptr)
 
@@ -408,4 +443,9 @@ private:                                            \
 // Define rtti buffer size.
  #define __LLBC_RTTI_BUF_SIZE    512
 
+/**
+ * Library allocator functions declare, LLBC_Malloc/LLBC_Free/... macros depend on it.
+ */
+#include "llbc/common/Allocator.h"
+
 #endif // !__LLBC_COM_MACRO_H__
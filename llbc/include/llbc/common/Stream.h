@@ -26,6 +26,15 @@
 
 #include "llbc/common/Macro.h"
 #include "llbc/common/BasicDataType.h"
+#include "llbc/common/Endian.h"
+#include "llbc/common/ArrayView.h"
+
+// STL containers hint insert() position iterator type, C++11 changed it to const_iterator.
+#if __cplusplus >= 201103L
+ #define __LLBC_STREAM_STL_HINT_ITER const_iterator
+#else
+ #define __LLBC_STREAM_STL_HINT_ITER iterator
+#endif
 
 /** Some stream helper macros define **/
 /*  DeSerialize/Read about macros define  */
@@ -111,8 +120,124 @@
     } while(0);                                                 \
     return (retVal)                                             \
 
+/*  Field-list serialize macros define  */
+// Begin field-list define, field-list macros will generate Serialize/DeSerialize,
+// SerializeEx/DeSerializeEx methods for class/struct, fields read/write in list order,
+// fields visited through const object when write, through non-const object when read.
+// Note: Field-list macros change member access to public.
+// eg:
+//     struct Foo
+//     {
+//         sint32 id;
+//         std::string name;
+//         std::vector<sint64> values;
+//
+//         LLBC_STREAM_FIELDS_BEGIN()
+//             LLBC_STREAM_FIELD(id)
+//             LLBC_STREAM_FIELD(name)
+//             LLBC_STREAM_FIELD(values)
+//         LLBC_STREAM_FIELDS_END()
+//     };
+#define LLBC_STREAM_FIELDS_BEGIN()                              \
+public:                                                         \
+    void Serialize(LLBC_NAMESPACE LLBC_Stream &stream) const    \
+    {                                                           \
+        LLBC_NAMESPACE LLBC_StreamFieldWriter writer(stream, false); \
+        __LLBC_StreamVisitFields(*this, writer);                \
+    }                                                           \
+    bool DeSerialize(LLBC_NAMESPACE LLBC_Stream &stream)        \
+    {                                                           \
+        LLBC_NAMESPACE LLBC_StreamFieldReader reader(stream, false); \
+        return __LLBC_StreamVisitFields(*this, reader);         \
+    }                                                           \
+    void SerializeEx(LLBC_NAMESPACE LLBC_Stream &stream) const  \
+    {                                                           \
+        LLBC_NAMESPACE LLBC_StreamFieldWriter writer(stream, true); \
+        __LLBC_StreamVisitFields(*this, writer);                \
+    }                                                           \
+    bool DeSerializeEx(LLBC_NAMESPACE LLBC_Stream &stream)      \
+    {                                                           \
+        LLBC_NAMESPACE LLBC_StreamFieldReader reader(stream, true); \
+        return __LLBC_StreamVisitFields(*this, reader);         \
+    }                                                           \
+    template <typename _Self, typename _Visitor>                \
+    static bool __LLBC_StreamVisitFields(_Self &self, _Visitor &visitor) \
+    {                                                           \
+
+// Field define.
+#define LLBC_STREAM_FIELD(field)                                \
+        if (!visitor.Visit(self.field))                         \
+            return false;                                       \
+
+// End field-list define.
+#define LLBC_STREAM_FIELDS_END()                                \
+        return true;                                            \
+    }                                                           \
+
+/*  Pod type declare macros define  */
+// Declare user-defined type as pod type, the type must be trivially copyable and serialize as raw
+// memory(not define Serialize/DeSerialize methods), contiguous containers(std::vector) of pod type
+// will be read/written as one bulk memory copy, instead of element by element.
+// Note: Use this macro in global namespace.
+#define LLBC_STREAM_DECLARE_POD(type)                           \
+    __LLBC_NS_BEGIN                                             \
+    __LLBC_STREAM_POD_TRAITS(type, false, false);               \
+    __LLBC_NS_END                                               \
+
+#define __LLBC_STREAM_POD_TRAITS(type, needSwap, compactEncoded) \
+    template <>                                                 \
+    struct LLBC_StreamPodTraits<type>                           \
+    {                                                           \
+        enum                                                    \
+        {                                                       \
+            IsPod = true,                                       \
+            NeedSwap = needSwap,                                \
+            CompactEncoded = compactEncoded                     \
+        };                                                      \
+    }                                                           \
+
 __LLBC_NS_BEGIN
 
+/**
+ * \brief Stream pod type traits, pod type contiguous containers can be read/written as one bulk memory copy.
+ *        IsPod          - is pod type or not.
+ *        NeedSwap       - need reverse bytes order when stream endian different from machine endian or not.
+ *        CompactEncoded - compact mode stream encode type as varint or not(can't bulk copy in compact mode).
+ */
+template <typename T>
+struct LLBC_StreamPodTraits
+{
+    enum
+    {
+        IsPod = false,
+        NeedSwap = false,
+        CompactEncoded = false
+    };
+};
+
+// Note: bool not declare as pod type, because std::vector<bool> is not contiguous container.
+__LLBC_STREAM_POD_TRAITS(sint8, false, false);
+__LLBC_STREAM_POD_TRAITS(uint8, false, false);
+__LLBC_STREAM_POD_TRAITS(sint16, true, true);
+__LLBC_STREAM_POD_TRAITS(uint16, true, true);
+__LLBC_STREAM_POD_TRAITS(sint32, true, true);
+__LLBC_STREAM_POD_TRAITS(uint32, true, true);
+__LLBC_STREAM_POD_TRAITS(long, true, true);
+__LLBC_STREAM_POD_TRAITS(ulong, true, true);
+__LLBC_STREAM_POD_TRAITS(sint64, true, true);
+__LLBC_STREAM_POD_TRAITS(uint64, true, true);
+__LLBC_STREAM_POD_TRAITS(float, true, false);
+__LLBC_STREAM_POD_TRAITS(double, true, false);
+
+/**
+ * \brief Stream segment(buffer pointer + data length), the memory layout compatible with posix struct iovec.
+ */
+struct LLBC_StreamSegment
+{
+    void *buf;
+    size_t len;
+};
+
 /**
  * \brief Stream class encapsulation, support serialize/deserialize operations.
  */
@@ -214,6 +339,66 @@ public:
      */
     void SetEndian(int endian);
 
+    /**
+     * Check stream is compact mode or not.
+     * @return bool - the compact mode flag.
+     */
+    bool IsCompact() const;
+
+    /**
+     * Set stream compact mode, in compact mode, all 16/32/64 bits integers(include container/string length)
+     * Read/Write, ReadEx/WriteEx as LEB128 varint, signed integers zigzag encoded before write.
+     * Note: Default is non-compact mode(fixed width), compact mode stream data must be read in compact mode.
+     * @param[in] compact - the compact mode flag.
+     */
+    void SetCompact(bool compact);
+
+    /**
+     * Check stream is segmented mode or not.
+     * @return bool - the segmented mode flag.
+     */
+    bool IsSegmented() const;
+
+    /**
+     * Enter segmented write mode, in segmented mode, when stream buffer full, stream will append new
+     * segment(segmentSize bytes at least) to write, instead of realloc and copy the whole buffer.
+     * Note: 1. Position & size are total position & size of all segments.
+     *       2. Any operation that need contiguous buffer(Read/Peek, Replace/Insert, Detach, SetPos to sealed segment)
+     *          will flatten the stream automatically and leave segmented mode, GetBuf()/GetBufStartWithPos() is not
+     *          available in segmented mode, call Flatten() first.
+     *       3. Attach attribute's stream can't enter segmented mode.
+     * @param[in] segmentSize - the segment size, in bytes, 0 means use LLBC_CFG_COM_STREAM_DFT_SEGMENT_SIZE.
+     */
+    void SetSegmented(size_t segmentSize = 0);
+
+    /**
+     * Get stream data segments count, non-segmented stream has 1 segment at most.
+     * @return size_t - the data segments count.
+     */
+    size_t GetSegmentCount() const;
+
+    /**
+     * Get stream data segments(only contain written data, [0, pos)), can be used as iovec array directly.
+     * @param[out] segments - the segments array.
+     * @param[in]  count    - the segments array size.
+     * @return size_t - the filled segments count.
+     */
+    size_t GetSegments(LLBC_StreamSegment *segments, size_t count) const;
+
+    /**
+     * Detach all data segments from stream, the segment buffers ownership transfer to caller(use LLBC_Free to free),
+     * after detached, stream will be empty(still in segmented mode if stream is segmented).
+     * @param[out] segments - the segments array, must not less than GetSegmentCount().
+     * @param[in]  count    - the segments array size.
+     * @return size_t - the detached segments count, return 0 if segments array too small or stream is attach attribute.
+     */
+    size_t DetachSegments(LLBC_StreamSegment *segments, size_t count);
+
+    /**
+     * Flatten all segments to one contiguous buffer, and leave segmented mode.
+     */
+    void Flatten();
+
     /**
      * Swap two stream objects.
      * @param[in/out] another - another stream.
@@ -299,6 +484,43 @@ public:
      */
     bool ReadBuffer(void *buf, size_t size);
 
+    /**
+     * Read buffer view from stream, zero-copy version of ReadBuffer(), the view point to stream buffer.
+     * Note: View only valid before stream buffer released or reallocated(destroy, write grow, Attach/Assign/Detach/
+     *       Swap/Clear/Flatten/...), see LLBC_ArrayView.
+     * @param[out] view - the buffer view.
+     * @param[in]  size - require read size, in bytes.
+     * @return bool - return true if successed, otherwise return false.
+     */
+    bool ReadBufferView(LLBC_BlobView &view, size_t size);
+
+    /**
+     * Read array view from stream, zero-copy version of Read(std::vector<T>), wire format is same.
+     * Note: Only available for pod type elements(see LLBC_StreamPodTraits) that need not byte order convert and not
+     *       varint encoded(compact mode integers), otherwise return false, view lifetime same as ReadBufferView().
+     * @param[out] view - the array view.
+     * @return bool - return true if successed, otherwise return false.
+     */
+    template <typename T>
+    bool ReadView(LLBC_ArrayView<T> &view);
+
+    /**
+     * Read array view from stream, zero-copy version of ReadEx(std::vector<T>)/ReadEx(std::string)/
+     * ReadEx(LLBC_String), wire format is same, see ReadView().
+     * @param[out] view - the array view.
+     * @return bool - return true if successed, otherwise return false.
+     */
+    template <typename T>
+    bool ReadViewEx(LLBC_ArrayView<T> &view);
+
+    /**
+     * Read null-terminated string view from stream, zero-copy version of Read(std::string)/Read(LLBC_String),
+     * the view not include '\0', view lifetime same as ReadBufferView().
+     * @param[out] view - the string view.
+     * @return bool - return true if successed, otherwise return false.
+     */
+    bool ReadCStrView(LLBC_StringView &view);
+
     /**
      * Write template function, will automatch functio to write, if
      * this class exist Serialize method, will call Serialize method
@@ -333,12 +555,12 @@ public:
         // Check initialized first.
         obj.CheckInitialized();
 
-        // Resize Stream.
+        // Write length and reserve buffer.
         size_t needSize = static_cast<size_t>(obj.ByteSize());
-        if ((_size - _pos) < needSize + sizeof(uint32))
-            Resize(_size + (needSize + sizeof(uint32)));
-
         Write(static_cast<uint32>(needSize));
+        if (!Reserve(needSize))
+            return;
+
         obj.SerializeToArray(reinterpret_cast<char *>(_buf) + _pos, static_cast<int>(needSize));
         _pos += needSize;
     }
@@ -347,7 +569,7 @@ public:
     /**
      * Adapted pair container, like: map.
      */
-    template <typename T, typename T::iterator (T::*)(typename T::iterator, const std::pair<const typename T::key_type, typename T::referent_type> &)>
+    template <typename T, typename T::iterator (T::*)(typename T::__LLBC_STREAM_STL_HINT_ITER, const std::pair<const typename T::key_type, typename T::mapped_type> &)>
     struct adapted_stl_pair_write_fun;
 #endif // LLBC_TARGET_PLATFORM_NON_WIN32
 #if LLBC_TARGET_PLATFORM_NON_WIN32
@@ -355,7 +577,7 @@ public:
      * Adapted non-pair container, like: vector, list, deque(not include queue, stack).
      * adapt insert() function.
      */
-    template <typename T, typename T::iterator (T::*)(typename T::iterator, const typename T::value_type &)>
+    template <typename T, typename T::iterator (T::*)(typename T::__LLBC_STREAM_STL_HINT_ITER, const typename T::value_type &)>
     struct adapted_stl_non_pair_write_fun;
 #else // LLBC_TARGET_PLATFORM_WIN32
     /**
@@ -387,7 +609,7 @@ public:
         for (; iter != obj.end(); ++iter)
         {
             typedef typename T::key_type KeyType;
-            typedef typename T::referent_type ValType;
+            typedef typename T::mapped_type ValType;
             
             const KeyType &key = iter->first;
             this->Write<KeyType>(key);
@@ -403,12 +625,21 @@ public:
      */
     template <typename T>
 #if LLBC_TARGET_PLATFORM_NON_WIN32
-    void adapt_write_data(const T &obj, adapted_stl_non_pair_write_fun<T, &T::insert> *)
+    void adapt_write_non_pair_data(const T &obj, adapted_stl_non_pair_write_fun<T, &T::insert> *)
 #else
-    void adapt_write_data(const T &obj, adapted_stl_non_pair_write_fun<T, &T::begin, &T::end> *)
+    void adapt_write_non_pair_data(const T &obj, adapted_stl_non_pair_write_fun<T, &T::begin, &T::end> *)
 #endif
     {
         this->Write<uint32>(static_cast<uint32>(obj.size()));
+        this->write_elems(obj);
+    }
+
+    /**
+     * STL container elements write method impl.
+     */
+    template <typename T>
+    void write_elems(const T &obj)
+    {
         typename T::const_iterator iter = obj.begin();
         for (; iter != obj.end(); ++iter)
         {
@@ -420,10 +651,32 @@ public:
     }
 
     /**
-     * Raw type write method impl.
+     * STL contiguous container elements write method impl, pod type elements write as one bulk copy.
+     */
+    template <typename E, typename A>
+    void write_elems(const std::vector<E, A> &obj)
+    {
+        if (!this->write_pod_elems(obj))
+        {
+            for (size_t i = 0; i < obj.size(); ++i)
+                this->Write<E>(obj[i]);
+        }
+    }
+
+    /**
+     * Non-pair container or raw type write method impl.
      */
     template <typename T>
     void adapt_write_data(const T &obj, ...)
+    {
+        return this->adapt_write_non_pair_data<T>(obj, 0);
+    }
+
+    /**
+     * Raw type write method impl.
+     */
+    template <typename T>
+    void adapt_write_non_pair_data(const T &obj, ...)
     {
         this->WriteBuffer(&obj, sizeof(obj));
     }
@@ -457,12 +710,12 @@ public:
         // Check initialized first.
         obj.CheckInitialized();
 
-        // Resize Stream.
+        // Write length and reserve buffer.
         size_t needSize = static_cast<size_t>(obj.ByteSize());
-        if ((_size - _pos) < needSize + sizeof(uint32))
-            Resize(_size + (needSize + sizeof(uint32)));
-
         Write(static_cast<uint32>(needSize));
+        if (!Reserve(needSize))
+            return;
+
         obj.SerializeToArray(reinterpret_cast<char *>(_buf) + _pos, static_cast<int>(needSize));
         _pos += needSize;
     }
@@ -488,7 +741,7 @@ public:
         for (; iter != obj.end(); ++iter)
         {
             typedef typename T::key_type KeyType;
-            typedef typename T::referent_type ValType;
+            typedef typename T::mapped_type ValType;
 
             const KeyType &key = iter->first;
             this->WriteEx<KeyType>(key);
@@ -504,12 +757,21 @@ public:
      */
     template <typename T>
 #if LLBC_TARGET_PLATFORM_NON_WIN32
-    void adapt_write_data_ex(const T &obj, adapted_stl_non_pair_write_fun<T, &T::insert> *)
+    void adapt_write_non_pair_data_ex(const T &obj, adapted_stl_non_pair_write_fun<T, &T::insert> *)
 #else
-    void adapt_write_data_ex(const T &obj, adapted_stl_non_pair_write_fun<T, &T::begin, &T::end> *)
+    void adapt_write_non_pair_data_ex(const T &obj, adapted_stl_non_pair_write_fun<T, &T::begin, &T::end> *)
 #endif
     {
         this->WriteEx<uint32>(static_cast<uint32>(obj.size()));
+        this->write_elems_ex(obj);
+    }
+
+    /**
+     * STL container elements write method impl(WriteEx).
+     */
+    template <typename T>
+    void write_elems_ex(const T &obj)
+    {
         typename T::const_iterator iter = obj.begin();
         for (; iter != obj.end(); ++iter)
         {
@@ -520,11 +782,58 @@ public:
         }
     }
 
+    /**
+     * STL contiguous container elements write method impl(WriteEx), pod type elements write as one bulk copy.
+     */
+    template <typename E, typename A>
+    void write_elems_ex(const std::vector<E, A> &obj)
+    {
+        if (!this->write_pod_elems(obj))
+        {
+            for (size_t i = 0; i < obj.size(); ++i)
+                this->WriteEx<E>(obj[i]);
+        }
+    }
+
+    /**
+     * Pod type elements bulk write method impl.
+     * @return bool - return true if written, return false if elements type is not pod type(or can't bulk copy).
+     */
+    template <typename E, typename A>
+    bool write_pod_elems(const std::vector<E, A> &obj)
+    {
+        typedef LLBC_StreamPodTraits<E> PodTraits;
+        if (!PodTraits::IsPod || (PodTraits::CompactEncoded && _compact))
+            return false;
+
+        const size_t size = sizeof(E) * obj.size();
+        if (size == 0 || !Reserve(size))
+            return true;
+
+        uint8 *buf = reinterpret_cast<uint8 *>(_buf) + _pos;
+        memcpy(buf, &obj[0], size);
+        if (PodTraits::NeedSwap && _endian != LLBC_MachineEndian)
+            LLBC_ReverseBytesArray(buf, sizeof(E), obj.size());
+
+        _pos += size;
+
+        return true;
+    }
+
+    /**
+     * Non-pair container or raw type writeex method impl.
+     */
+    template <typename T>
+    void adapt_write_data_ex(const T &obj, ...)
+    {
+        return this->adapt_write_non_pair_data_ex<T>(obj, 0);
+    }
+
     /**
      * Raw type writeex method impl.
      */
     template <typename T>
-    void adapt_write_data_ex(const T&obj, ...)
+    void adapt_write_non_pair_data_ex(const T &obj, ...)
     {
         this->WriteBuffer(&obj, sizeof(obj));
     }
@@ -562,6 +871,8 @@ public:
         uint32 pbDataSize;
         if (UNLIKELY(Read(pbDataSize) == false))
             return false;
+        else if (UNLIKELY(_pos + pbDataSize > _size))
+            return false;
 
         bool ret = obj.ParseFromArray(reinterpret_cast<char *>(_buf) + _pos, static_cast<int>(pbDataSize));
         if (!ret)
@@ -575,7 +886,7 @@ public:
     /**
      * Adapted pair container, like: map.
      */
-    template <typename T, typename T::iterator (T::*)(typename T::iterator, const std::pair<const typename T::key_type, typename T::referent_type> &)>
+    template <typename T, typename T::iterator (T::*)(typename T::__LLBC_STREAM_STL_HINT_ITER, const std::pair<const typename T::key_type, typename T::mapped_type> &)>
     struct adapted_stl_pair_read_fun;
 #endif // LLBC_TARGET_PLATFORM_NON_WIN32
 #if LLBC_TARGET_PLATFORM_NON_WIN32
@@ -583,7 +894,7 @@ public:
      * Adapted non-pair container, like: vector, list, deque(not include queue, stack).
      * adapt insert() function.
      */
-    template <typename T, typename T::iterator (T::*)(typename T::iterator, const typename T::value_type &)>
+    template <typename T, typename T::iterator (T::*)(typename T::__LLBC_STREAM_STL_HINT_ITER, const typename T::value_type &)>
     struct adapted_stl_non_pair_read_fun;
 #else // LLBC_TARGET_PLATFORM_WIN32.
     /**
@@ -617,7 +928,7 @@ public:
             return false;
 
         typedef typename T::key_type KeyType;
-        typedef typename T::referent_type ValType;
+        typedef typename T::mapped_type ValType;
         for (uint32 i = 0; i < count; ++i)
         {
             KeyType key;
@@ -640,9 +951,9 @@ public:
      */
     template <typename T>
 #if LLBC_TARGET_PLATFORM_NON_WIN32
-    bool adapt_read_data(T &obj, adapted_stl_non_pair_read_fun<T, &T::insert> *)
+    bool adapt_read_non_pair_data(T &obj, adapted_stl_non_pair_read_fun<T, &T::insert> *)
 #else
-    bool adapt_read_data(T &obj, adapted_stl_non_pair_read_fun<T, &T::begin, &T::end> *)
+    bool adapt_read_non_pair_data(T &obj, adapted_stl_non_pair_read_fun<T, &T::begin, &T::end> *)
 #endif
     {
         obj.clear();
@@ -651,6 +962,15 @@ public:
         if (!this->Read<uint32>(count))
             return false;
 
+        return this->read_elems(obj, count);
+    }
+
+    /**
+     * STL container elements read method impl.
+     */
+    template <typename T>
+    bool read_elems(T &obj, uint32 count)
+    {
         for (uint32 i = 0; i < count; ++i)
         {
             typedef typename T::value_type ElemType;
@@ -666,15 +986,70 @@ public:
     }
 
     /**
-     * Raw type read method impl.
+     * STL contiguous container elements read method impl, pod type elements read as one bulk copy.
+     */
+    template <typename E, typename A>
+    bool read_elems(std::vector<E, A> &obj, uint32 count)
+    {
+        typedef LLBC_StreamPodTraits<E> PodTraits;
+        if (PodTraits::IsPod && !(PodTraits::CompactEncoded && _compact))
+            return this->read_pod_elems(obj, count);
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            E elem;
+            if (!this->Read<E>(elem))
+                return false;
+
+            obj.push_back(elem);
+        }
+
+        return true;
+    }
+
+    /**
+     * Pod type elements bulk read method impl.
+     */
+    template <typename E, typename A>
+    bool read_pod_elems(std::vector<E, A> &obj, uint32 count)
+    {
+        if (count == 0)
+            return true;
+
+        if (UNLIKELY(_segments != NULL))
+            Flatten();
+
+        // Check readable size before resize container.
+        if (count > (_size - _pos) / sizeof(E))
+            return false;
+
+        const size_t size = sizeof(E) * count;
+        obj.resize(count);
+        memcpy(&obj[0], reinterpret_cast<const uint8 *>(_buf) + _pos, size);
+        if (LLBC_StreamPodTraits<E>::NeedSwap && _endian != LLBC_MachineEndian)
+            LLBC_ReverseBytesArray(&obj[0], sizeof(E), count);
+
+        _pos += size;
+
+        return true;
+    }
+
+    /**
+     * Non-pair container or raw type read method impl.
      */
     template <typename T>
     bool adapt_read_data(T &obj, ...)
     {
-        if (_size >= _pos + sizeof(T))
-            return this->ReadBuffer(&obj, sizeof(T));
+        return this->adapt_read_non_pair_data<T>(obj, 0);
+    }
 
-        return false;
+    /**
+     * Raw type read method impl.
+     */
+    template <typename T>
+    bool adapt_read_non_pair_data(T &obj, ...)
+    {
+        return this->ReadBuffer(&obj, sizeof(T));
     }
 
     /**
@@ -704,6 +1079,8 @@ public:
         uint32 pbDataSize;
         if (UNLIKELY(Read(pbDataSize) == false))
             return false;
+        else if (UNLIKELY(_pos + pbDataSize > _size))
+            return false;
 
         bool ret = obj.ParseFromArray(reinterpret_cast<char *>(_buf) + _pos, static_cast<int>(pbDataSize));
         if (!ret)
@@ -736,7 +1113,7 @@ public:
             return false;
 
         typedef typename T::key_type KeyType;
-        typedef typename T::referent_type ValType;
+        typedef typename T::mapped_type ValType;
         for (uint32 i = 0; i < count; ++i)
         {
             KeyType key;
@@ -759,9 +1136,9 @@ public:
      */
     template <typename T>
 #if LLBC_TARGET_PLATFORM_NON_WIN32
-    bool adapt_read_data_ex(T &obj, adapted_stl_non_pair_read_fun<T, &T::insert> *)
+    bool adapt_read_non_pair_data_ex(T &obj, adapted_stl_non_pair_read_fun<T, &T::insert> *)
 #else
-    bool adapt_read_data_ex(T &obj, adapted_stl_non_pair_read_fun<T, &T::begin, &T::end> *)
+    bool adapt_read_non_pair_data_ex(T &obj, adapted_stl_non_pair_read_fun<T, &T::begin, &T::end> *)
 #endif
     {
         obj.clear();
@@ -770,6 +1147,15 @@ public:
         if (!this->ReadEx<uint32>(count))
             return false;
 
+        return this->read_elems_ex(obj, count);
+    }
+
+    /**
+     * STL container elements read method impl(ReadEx).
+     */
+    template <typename T>
+    bool read_elems_ex(T &obj, uint32 count)
+    {
         for (uint32 i = 0; i < count; ++i)
         {
             typedef typename T::value_type ElemType;
@@ -785,15 +1171,43 @@ public:
     }
 
     /**
-     * Raw type readex method impl.
+     * STL contiguous container elements read method impl(ReadEx), pod type elements read as one bulk copy.
+     */
+    template <typename E, typename A>
+    bool read_elems_ex(std::vector<E, A> &obj, uint32 count)
+    {
+        typedef LLBC_StreamPodTraits<E> PodTraits;
+        if (PodTraits::IsPod && !(PodTraits::CompactEncoded && _compact))
+            return this->read_pod_elems(obj, count);
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            E elem;
+            if (!this->ReadEx<E>(elem))
+                return false;
+
+            obj.push_back(elem);
+        }
+
+        return true;
+    }
+
+    /**
+     * Non-pair container or raw type readex method impl.
      */
     template <typename T>
     bool adapt_read_data_ex(T &obj, ...)
     {
-        if (_size >= _pos + sizeof(T))
-            return this->ReadBuffer(&obj, sizeof(T));
+        return this->adapt_read_non_pair_data_ex<T>(obj, 0);
+    }
 
-        return false;
+    /**
+     * Raw type readex method impl.
+     */
+    template <typename T>
+    bool adapt_read_non_pair_data_ex(T &obj, ...)
+    {
+        return this->ReadBuffer(&obj, sizeof(T));
     }
 
     /**
@@ -804,7 +1218,7 @@ public:
     template <typename T>
     bool Peek(T &obj)
     {
-        size_t oldPos = _pos;
+        size_t oldPos = GetPos();
         bool ret = Read<T>(obj);
         this->SetPos(oldPos);
 
@@ -819,7 +1233,7 @@ public:
     template <typename T>
     bool PeekEx(T &obj)
     {
-        size_t oldPos = _pos;
+        size_t oldPos = GetPos();
         bool ret = ReadEx<T>(obj);
         this->SetPos(oldPos);
 
@@ -910,6 +1324,21 @@ public:
     void WriteDouble(double value);
     void WritePtr(const void *value);
 
+public:
+    /**
+     * Varint(LEB128) read/write support, available in any mode.
+     * Note: Signed integers zigzag encoded, small absolute values use less bytes.
+     */
+    bool ReadVarUInt32(uint32 &value);
+    bool ReadVarSInt32(sint32 &value);
+    bool ReadVarUInt64(uint64 &value);
+    bool ReadVarSInt64(sint64 &value);
+
+    void WriteVarUInt32(uint32 value);
+    void WriteVarSInt32(sint32 value);
+    void WriteVarUInt64(uint64 value);
+    void WriteVarSInt64(sint64 value);
+
 public:
     LLBC_Stream &operator =(const LLBC_Stream &rhs);
 
@@ -920,16 +1349,113 @@ private:
     template <typename T>
     void WriteRawType(const T &value);
 
+    template <typename T>
+    bool ReadCompactSInt(T &value);
+    template <typename T>
+    bool ReadCompactUInt(T &value);
+
+    template <typename T>
+    void WriteCompactSInt(const T &value);
+    template <typename T>
+    void WriteCompactUInt(const T &value);
+
+    bool ReadVarint(uint64 &value);
+    void WriteVarint(uint64 value);
+
+    /**
+     * Reserve writable space at current position, in segmented mode, will append new segment if need.
+     * @param[in] len - the need writable size, in bytes.
+     * @return bool - return true if success, otherwise return false(attach attribute's buf limit).
+     */
+    bool Reserve(size_t len);
+
+    template <typename T>
+    bool ReadArrayView(LLBC_ArrayView<T> &view, bool ex);
+
+    void AppendSegment(size_t len);
+    void DestroySegments();
+
     bool OverlappedCheck(const void *another, size_t len);
 
+private:
+    /**
+     * Segmented mode sealed segments, _buf/_pos/_size describe the tail(writing) segment.
+     */
+    struct _Segments
+    {
+        size_t segmentSize;
+        size_t sealedSize;
+
+        size_t count;
+        size_t capacity;
+        LLBC_StreamSegment *segments;
+    };
+
 private:
     void *_buf;
     size_t _pos;
     size_t _size;
 
     int _endian;
+    bool _compact;
 
     bool _attach;
+    _Segments *_segments;
+
+    LLBC_ViewGuard _viewGuard;
+};
+
+/**
+ * \brief Field-list fields writer, see LLBC_STREAM_FIELDS_BEGIN() macro.
+ */
+class LLBC_StreamFieldWriter
+{
+public:
+    LLBC_StreamFieldWriter(LLBC_Stream &stream, bool ex)
+    : _stream(stream)
+    , _ex(ex)
+    {
+    }
+
+public:
+    template <typename T>
+    bool Visit(const T &field)
+    {
+        if (_ex)
+            _stream.WriteEx<T>(field);
+        else
+            _stream.Write<T>(field);
+
+        return true;
+    }
+
+private:
+    LLBC_Stream &_stream;
+    bool _ex;
+};
+
+/**
+ * \brief Field-list fields reader, see LLBC_STREAM_FIELDS_BEGIN() macro.
+ */
+class LLBC_StreamFieldReader
+{
+public:
+    LLBC_StreamFieldReader(LLBC_Stream &stream, bool ex)
+    : _stream(stream)
+    , _ex(ex)
+    {
+    }
+
+public:
+    template <typename T>
+    bool Visit(T &field)
+    {
+        return _ex ? _stream.ReadEx<T>(field) : _stream.Read<T>(field);
+    }
+
+private:
+    LLBC_Stream &_stream;
+    bool _ex;
 };
 
 __LLBC_NS_END
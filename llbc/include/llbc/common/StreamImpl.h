@@ -32,8 +32,10 @@ inline LLBC_Stream::LLBC_Stream()
 , _size(0)
 
 , _endian(LLBC_DefaultEndian)
+, _compact(false)
 
 , _attach(false)
+, _segments(NULL)
 {
 }
 
@@ -43,8 +45,10 @@ inline LLBC_Stream::LLBC_Stream(const LLBC_Stream &rhs)
 , _size(0)
 
 , _endian(LLBC_DefaultEndian)
+, _compact(false)
 
 , _attach(false)
+, _segments(NULL)
 {
     this->Assign(rhs);
 }
@@ -55,8 +59,10 @@ inline LLBC_Stream::LLBC_Stream(const LLBC_Stream &rhs, bool attach)
 , _size(0)
 
 , _endian(LLBC_DefaultEndian)
+, _compact(false)
 
 , _attach(false)
+, _segments(NULL)
 {
     if (attach)
         this->Attach(rhs);
@@ -68,7 +74,7 @@ inline LLBC_Stream::LLBC_Stream(size_t size)
 {
     if (size > 0)
     {
-        _buf = calloc(size, 1);
+        _buf = LLBC_Calloc(void, size);
         ASSERT(_buf && "LLBC_Stream object alloc memory from heap failed");
     }
     else
@@ -80,8 +86,10 @@ inline LLBC_Stream::LLBC_Stream(size_t size)
     _size = size;
 
     _endian = LLBC_DefaultEndian;
+    _compact = false;
 
     _attach = false;
+    _segments = NULL;
 }
 
 inline LLBC_Stream::LLBC_Stream(void *buf, size_t len, bool attach)
@@ -90,8 +98,10 @@ inline LLBC_Stream::LLBC_Stream(void *buf, size_t len, bool attach)
 , _size(0)
 
 , _endian(LLBC_DefaultEndian)
+, _compact(false)
 
 , _attach(false)
+, _segments(NULL)
 {
     if (attach)
     {
@@ -105,12 +115,20 @@ inline LLBC_Stream::LLBC_Stream(void *buf, size_t len, bool attach)
 
 inline LLBC_Stream::~LLBC_Stream()
 {
+    if (_segments)
+        DestroySegments();
+
     if (!_attach)
         LLBC_XFree(_buf);
 }
 
 inline void LLBC_Stream::Attach(const LLBC_Stream &rhs)
 {
+    ASSERT(!rhs._segments && "LLBC_Stream::Attach() could not attach segmented stream, call Flatten() first");
+    _viewGuard.Invalidate();
+    if (_segments)
+        DestroySegments();
+
     if (!_attach)
         LLBC_XFree(_buf);
 
@@ -119,6 +137,7 @@ inline void LLBC_Stream::Attach(const LLBC_Stream &rhs)
     _size = rhs._size;
 
     _endian = rhs._endian;
+    _compact = rhs._compact;
 
     _attach = true;
 }
@@ -128,6 +147,10 @@ inline void LLBC_Stream::Attach(void *buf, size_t len)
     if ((buf && len == 0) || (!buf && len > 0))
         return;
 
+    _viewGuard.Invalidate();
+    if (_segments)
+        DestroySegments();
+
     if (!_attach)
         LLBC_XFree(_buf);
 
@@ -140,35 +163,55 @@ inline void LLBC_Stream::Attach(void *buf, size_t len)
 
 inline void LLBC_Stream::Assign(const LLBC_Stream &rhs)
 {
+    _viewGuard.Invalidate();
+    if (_segments)
+        DestroySegments();
+
     if (!_attach)
         LLBC_XFree(_buf);
 
-    if (rhs._buf)
+    // Segmented stream will be flatten copy.
+    const size_t sealedSize = rhs._segments ? rhs._segments->sealedSize : 0;
+    if (rhs._buf || sealedSize > 0)
     {
-        _buf = malloc(rhs._size);
-        memcpy(_buf, rhs._buf, rhs._size);
+        _buf = LLBC_Malloc(void, sealedSize + rhs._size);
+        uint8 *copyTo = reinterpret_cast<uint8 *>(_buf);
+        for (size_t i = 0; sealedSize > 0 && i < rhs._segments->count; ++i)
+        {
+            const LLBC_StreamSegment &segment = rhs._segments->segments[i];
+            memcpy(copyTo, segment.buf, segment.len);
+            copyTo += segment.len;
+        }
+
+        if (rhs._buf)
+            memcpy(copyTo, rhs._buf, rhs._size);
     }
     else
     {
         _buf = NULL;
     }
 
-    _pos = rhs._pos;
-    _size = rhs._size;
+    _pos = sealedSize + rhs._pos;
+    _size = sealedSize + rhs._size;
 
     _endian = rhs._endian;
+    _compact = rhs._compact;
 
     _attach = false;
 }
 
 inline void LLBC_Stream::Assign(void *buf, size_t len)
 {
+    _viewGuard.Invalidate();
+    if (_segments)
+        DestroySegments();
+
     if (!_attach)
         LLBC_XFree(_buf);
 
     if (buf && len > 0)
     {
-        _buf = malloc(len);
+        _buf = LLBC_Malloc(void, len);
         memcpy(_buf, buf, len);
 
         _size = len;
@@ -186,6 +229,10 @@ inline void LLBC_Stream::Assign(void *buf, size_t len)
 
 inline void *LLBC_Stream::Detach()
 {
+    _viewGuard.Invalidate();
+    if (_segments)
+        Flatten();
+
     void *tmp = _buf;
 
     _buf = NULL;
@@ -218,24 +265,158 @@ inline void LLBC_Stream::SetEndian(int endian)
         _endian = endian;
 }
 
+inline bool LLBC_Stream::IsCompact() const
+{
+    return _compact;
+}
+
+inline void LLBC_Stream::SetCompact(bool compact)
+{
+    _compact = compact;
+}
+
+inline bool LLBC_Stream::IsSegmented() const
+{
+    return _segments != NULL;
+}
+
+inline void LLBC_Stream::SetSegmented(size_t segmentSize)
+{
+    if (_attach)
+    {
+        ASSERT(false && "LLBC_Stream::SetSegmented() attach attribute's stream could not enter segmented mode");
+        return;
+    }
+
+    if (!_segments)
+    {
+        _segments = LLBC_Malloc(_Segments, sizeof(_Segments));
+        _segments->sealedSize = 0;
+        _segments->count = 0;
+        _segments->capacity = 0;
+        _segments->segments = NULL;
+    }
+
+    _segments->segmentSize = segmentSize > 0 ? segmentSize : LLBC_CFG_COM_STREAM_DFT_SEGMENT_SIZE;
+}
+
+inline size_t LLBC_Stream::GetSegmentCount() const
+{
+    return (_segments ? _segments->count : 0) + (_pos > 0 ? 1 : 0);
+}
+
+inline size_t LLBC_Stream::GetSegments(LLBC_StreamSegment *segments, size_t count) const
+{
+    size_t filled = 0;
+    if (_segments)
+    {
+        filled = MIN(count, _segments->count);
+        if (filled > 0)
+            memcpy(segments, _segments->segments, sizeof(LLBC_StreamSegment) * filled);
+    }
+
+    if (_pos > 0 && filled < count)
+    {
+        segments[filled].buf = _buf;
+        segments[filled].len = _pos;
+
+        ++filled;
+    }
+
+    return filled;
+}
+
+inline size_t LLBC_Stream::DetachSegments(LLBC_StreamSegment *segments, size_t count)
+{
+    const size_t segmentCount = GetSegmentCount();
+    if (_attach || count < segmentCount)
+        return 0;
+
+    _viewGuard.Invalidate();
+    GetSegments(segments, count);
+    if (_segments)
+    {
+        _segments->sealedSize = 0;
+        _segments->count = 0;
+    }
+
+    // The empty tail segment still hold by stream.
+    if (_pos > 0)
+    {
+        _buf = NULL;
+        _pos = _size = 0;
+    }
+
+    return segmentCount;
+}
+
+inline void LLBC_Stream::Flatten()
+{
+    if (!_segments)
+        return;
+
+    if (_segments->count > 0)
+    {
+        _viewGuard.Invalidate();
+
+        // Copy all sealed segments and tail segment(include tail's unused space) to new buffer.
+        const size_t sealedSize = _segments->sealedSize;
+        uint8 *buf = LLBC_Malloc(uint8, sealedSize + _size);
+
+        uint8 *copyTo = buf;
+        for (size_t i = 0; i < _segments->count; ++i)
+        {
+            const LLBC_StreamSegment &segment = _segments->segments[i];
+            memcpy(copyTo, segment.buf, segment.len);
+            copyTo += segment.len;
+        }
+
+        if (_buf)
+        {
+            memcpy(copyTo, _buf, _size);
+            LLBC_Free(_buf);
+        }
+
+        _buf = buf;
+        _pos += sealedSize;
+        _size += sealedSize;
+    }
+
+    DestroySegments();
+}
+
 inline void LLBC_Stream::Swap(LLBC_Stream &another)
 {
+    _viewGuard.Invalidate();
+    another._viewGuard.Invalidate();
+
     LLBC_Swap(_buf, another._buf);
     LLBC_Swap(_pos, another._pos);
     LLBC_Swap(_size, another._size);
 
     LLBC_Swap(_endian,  another._endian);
+    LLBC_Swap(_compact, another._compact);
 
     LLBC_Swap(_attach, another._attach);
+    LLBC_Swap(_segments, another._segments);
 }
 
 inline size_t LLBC_Stream::GetPos() const
 {
-    return _pos;
+    return _segments ? _segments->sealedSize + _pos : _pos;
 }
 
 inline void LLBC_Stream::SetPos(size_t pos)
 {
+    if (_segments)
+    {
+        // Only tail segment position can be set directly.
+        if (pos >= _segments->sealedSize)
+            pos -= _segments->sealedSize;
+        else
+            Flatten();
+    }
+
     ASSERT(pos <= _size);
     _pos = pos;
 }
@@ -243,9 +424,9 @@ inline void LLBC_Stream::SetPos(size_t pos)
 inline bool LLBC_Stream::Skip(long size)
 {
     const size_t skipped = static_cast<
-        size_t>(MAX(0, static_cast<long>(_pos) + size));
+        size_t>(MAX(0, static_cast<long>(GetPos()) + size));
 
-    if (skipped > _size)
+    if (skipped > GetSize())
         return false;
 
     this->SetPos(skipped);
@@ -255,18 +436,8 @@ inline bool LLBC_Stream::Skip(long size)
 
 inline void LLBC_Stream::Fill(size_t size)
 {
-    if (_pos + size > _size)
-    {
-        if (!_attach)
-        {
-            Resize(_size + MAX(size, _size));
-        }
-        else
-        {
-            ASSERT(false && "stream obj attach's buf limit");
-            return;
-        }
-    }
+    if (!Reserve(size))
+        return;
 
     memset((char *)_buf + _pos, 0, size);
     _pos += size;
@@ -274,16 +445,18 @@ inline void LLBC_Stream::Fill(size_t size)
 
 inline size_t LLBC_Stream::GetSize() const
 {
-    return _size;
+    return _segments ? _segments->sealedSize + _size : _size;
 }
 
 inline void *LLBC_Stream::GetBuf() const
 {
+    ASSERT((!_segments || _segments->count == 0) && "LLBC_Stream::GetBuf() segmented stream not contiguous, call Flatten() first");
     return _buf;
 }
 
 inline void *LLBC_Stream::GetBufStartWithPos() const
 {
+    ASSERT((!_segments || _segments->count == 0) && "LLBC_Stream::GetBufStartWithPos() segmented stream not contiguous, call Flatten() first");
     return reinterpret_cast<
         char *>(const_cast<void *>(_buf)) + _pos;
 }
@@ -297,6 +470,9 @@ inline void LLBC_Stream::Replace(size_t n0, size_t n1, const void *buf, size_t l
 {
     ASSERT(buf && len && "LLBC_Stream::Insert() buf or len invalid!");
 
+    if (_segments)
+        Flatten();
+
     // Swap n0, n1, if n0 > n1.
     if (UNLIKELY(n0 > n1))
     {
@@ -360,19 +536,9 @@ inline void LLBC_Stream::Replace(size_t n0, size_t n1, const void *buf, size_t l
 inline void LLBC_Stream::WriteBuffer(const void *buf, size_t len)
 {
     if (UNLIKELY(!buf || len <= 0))
-    {
         return;
-    }
-    else if (_pos + len > _size)
-    {
-        if (!_attach)
-            Resize(_size + MAX(len, _size));
-        else
-        {
-            ASSERT(false && "stream obj attach's buf limit");
-            return;
-        }
-    }
+    else if (!Reserve(len))
+        return;
 
     // Check memory overlapped
     ASSERT(this->OverlappedCheck(buf, len) && "LLBC_Stream::WriteBuffer() buffer overlapped!");
@@ -385,7 +551,11 @@ inline bool LLBC_Stream::ReadBuffer(void *buf, size_t len)
 {
     if (len == 0)
         return true;
-    else if (_pos + len > _size)
+
+    if (UNLIKELY(_segments != NULL))
+        Flatten();
+
+    if (_pos + len > _size)
         return false;
 
     ASSERT(buf && "LLBC_Stream::ReadBuffer(): expect not-null buf pointer to read");
@@ -399,11 +569,98 @@ inline bool LLBC_Stream::ReadBuffer(void *buf, size_t len)
     return true;
 }
 
+inline bool LLBC_Stream::ReadBufferView(LLBC_BlobView &view, size_t size)
+{
+    if (UNLIKELY(_segments != NULL))
+        Flatten();
+
+    if (_pos + size > _size)
+        return false;
+
+    view.Bind(reinterpret_cast<const uint8 *>(_buf) + _pos, size, _viewGuard);
+    _pos += size;
+
+    return true;
+}
+
+template <typename T>
+inline bool LLBC_Stream::ReadView(LLBC_ArrayView<T> &view)
+{
+    return ReadArrayView(view, false);
+}
+
+template <typename T>
+inline bool LLBC_Stream::ReadViewEx(LLBC_ArrayView<T> &view)
+{
+    return ReadArrayView(view, true);
+}
+
+inline bool LLBC_Stream::ReadCStrView(LLBC_StringView &view)
+{
+    if (UNLIKELY(_segments != NULL))
+        Flatten();
+
+    if (_pos >= _size)
+        return false;
+
+    const char *str = reinterpret_cast<const char *>(_buf) + _pos;
+    const char *strEnd = reinterpret_cast<const char *>(memchr(str, '\0', _size - _pos));
+    if (!strEnd)
+        return false;
+
+    view.Bind(str, strEnd - str, _viewGuard);
+    _pos += strEnd - str + 1;
+
+    return true;
+}
+
+template <typename T>
+inline bool LLBC_Stream::ReadArrayView(LLBC_ArrayView<T> &view, bool ex)
+{
+    // Can't point to elements that need convert byte order or varint decode.
+    typedef LLBC_StreamPodTraits<T> PodTraits;
+    if (!PodTraits::IsPod ||
+        (PodTraits::NeedSwap && _endian != LLBC_MachineEndian) ||
+        (PodTraits::CompactEncoded && _compact))
+        return false;
+
+    if (UNLIKELY(_segments != NULL))
+        Flatten();
+
+    const size_t oldPos = _pos;
+
+    uint32 count;
+    if (!(ex ? this->ReadEx<uint32>(count) : this->Read<uint32>(count)))
+        return false;
+
+    if (count > (_size - _pos) / sizeof(T))
+    {
+        _pos = oldPos;
+        return false;
+    }
+
+    view.Bind(reinterpret_cast<const T *>(reinterpret_cast<const uint8 *>(_buf) + _pos), count, _viewGuard);
+    _pos += sizeof(T) * count;
+
+    return true;
+}
+
 inline void LLBC_Stream::Resize(size_t newSize)
 {
+    // In segmented mode, only resize the tail segment.
+    if (_segments)
+    {
+        if (newSize <= _segments->sealedSize)
+            return;
+
+        newSize -= _segments->sealedSize;
+    }
+
     if (newSize > _size)
     {
-        _buf = realloc(_buf, newSize);
+        _viewGuard.Invalidate();
+
+        _buf = LLBC_Realloc(void, _buf, newSize);
         ASSERT(_buf && "alloc memory from heap fail!");
 
         _size = newSize;
@@ -412,6 +669,8 @@ inline void LLBC_Stream::Resize(size_t newSize)
 
 inline void LLBC_Stream::Clear()
 {
+    _viewGuard.Invalidate();
+
     if (_attach)
     {
         _buf = NULL;
@@ -421,6 +680,16 @@ inline void LLBC_Stream::Clear()
     }
     else
     {
+        // Free sealed segments, reuse tail segment.
+        if (_segments)
+        {
+            for (size_t i = 0; i < _segments->count; ++i)
+                LLBC_Free(_segments->segments[i].buf);
+
+            _segments->sealedSize = 0;
+            _segments->count = 0;
+        }
+
         _pos = 0;
     }
 }
@@ -442,42 +711,42 @@ inline bool LLBC_Stream::ReadUInt8(uint8 &value)
 
 inline bool LLBC_Stream::ReadSInt16(sint16 &value)
 {
-    return this->ReadRawType(value);
+    return _compact ? this->ReadCompactSInt(value) : this->ReadRawType(value);
 }
 
 inline bool LLBC_Stream::ReadUInt16(uint16 &value)
 {
-    return this->ReadRawType(value);
+    return _compact ? this->ReadCompactUInt(value) : this->ReadRawType(value);
 }
 
 inline bool LLBC_Stream::ReadSInt32(sint32 &value)
 {
-    return this->ReadRawType(value);
+    return _compact ? this->ReadCompactSInt(value) : this->ReadRawType(value);
 }
 
 inline bool LLBC_Stream::ReadUInt32(uint32 &value)
 {
-    return this->ReadRawType(value);
+    return _compact ? this->ReadCompactUInt(value) : this->ReadRawType(value);
 }
 
 inline bool LLBC_Stream::ReadSInt64(sint64 &value)
 {
-    return this->ReadRawType(value);
+    return _compact ? this->ReadCompactSInt(value) : this->ReadRawType(value);
 }
 
 inline bool LLBC_Stream::ReadUInt64(uint64 &value)
 {
-    return this->ReadRawType(value);
+    return _compact ? this->ReadCompactUInt(value) : this->ReadRawType(value);
 }
 
 inline bool LLBC_Stream::ReadLong(long &value)
 {
-    return this->ReadRawType(value);
+    return _compact ? this->ReadCompactSInt(value) : this->ReadRawType(value);
 }
 
 inline bool LLBC_Stream::ReadULong(ulong &value)
 {
-    return this->ReadRawType(value);
+    return _compact ? this->ReadCompactUInt(value) : this->ReadRawType(value);
 }
 
 inline bool LLBC_Stream::ReadFloat(float &value)
@@ -515,49 +784,49 @@ inline uint8 LLBC_Stream::ReadUInt8_2(uint8 failRet)
 
 inline sint16 LLBC_Stream::ReadSInt16_2(sint16 failRet)
 {
-    this->ReadRawType(failRet);
+    this->ReadSInt16(failRet);
     return failRet;
 }
 
 inline uint16 LLBC_Stream::ReadUInt16_2(uint16 failRet)
 {
-    this->ReadRawType(failRet);
+    this->ReadUInt16(failRet);
     return failRet;
 }
 
 inline sint32 LLBC_Stream::ReadSInt32_2(sint32 failRet)
 {
-    this->ReadRawType(failRet);
+    this->ReadSInt32(failRet);
     return failRet;
 }
 
 inline uint32 LLBC_Stream::ReadUInt32_2(uint32 failRet)
 {
-    this->ReadRawType(failRet);
+    this->ReadUInt32(failRet);
     return failRet;
 }
 
 inline sint64 LLBC_Stream::ReadSInt64_2(sint64 failRet)
 {
-    this->ReadRawType(failRet);
+    this->ReadSInt64(failRet);
     return failRet;
 }
 
 inline uint64 LLBC_Stream::ReadUInt64_2(uint64 failRet)
 {
-    this->ReadRawType(failRet);
+    this->ReadUInt64(failRet);
     return failRet;
 }
 
 inline long LLBC_Stream::ReadLong_2(long failRet)
 {
-    this->ReadRawType(failRet);
+    this->ReadLong(failRet);
     return failRet;
 }
 
 inline ulong LLBC_Stream::ReadULong_2(ulong failRet)
 {
-    this->ReadRawType(failRet);
+    this->ReadULong(failRet);
     return failRet;
 }
 
@@ -596,42 +865,66 @@ inline void LLBC_Stream::WriteUInt8(uint8 value)
 
 inline void LLBC_Stream::WriteSint16(sint16 value)
 {
-    this->WriteRawType(value);
+    if (_compact)
+        this->WriteCompactSInt(value);
+    else
+        this->WriteRawType(value);
 }
 
 inline void LLBC_Stream::WriteUInt16(uint16 value)
 {
-    this->WriteRawType(value);
+    if (_compact)
+        this->WriteCompactUInt(value);
+    else
+        this->WriteRawType(value);
 }
 
 inline void LLBC_Stream::WriteSInt32(sint32 value)
 {
-    this->WriteRawType(value);
+    if (_compact)
+        this->WriteCompactSInt(value);
+    else
+        this->WriteRawType(value);
 }
 
 inline void LLBC_Stream::WriteUInt32(uint32 value)
 {
-    this->WriteRawType(value);
+    if (_compact)
+        this->WriteCompactUInt(value);
+    else
+        this->WriteRawType(value);
 }
 
 inline void LLBC_Stream::WriteSInt64(sint64 value)
 {
-    this->WriteRawType(value);
+    if (_compact)
+        this->WriteCompactSInt(value);
+    else
+        this->WriteRawType(value);
 }
 
 inline void LLBC_Stream::WriteUInt64(uint64 value)
 {
-    this->WriteRawType(value);
+    if (_compact)
+        this->WriteCompactUInt(value);
+    else
+        this->WriteRawType(value);
 }
 
 inline void LLBC_Stream::WriteLong(long value)
 {
-    this->WriteRawType(value);
+    if (_compact)
+        this->WriteCompactSInt(value);
+    else
+        this->WriteRawType(value);
 }
 
 inline void LLBC_Stream::WriteULong(ulong value)
 {
-    this->WriteRawType(value);
+    if (_compact)
+        this->WriteCompactUInt(value);
+    else
+        this->WriteRawType(value);
 }
 
 inline void LLBC_Stream::WriteFloat(float value)
@@ -649,6 +942,46 @@ inline void LLBC_Stream::WritePtr(const void *value)
     this->WriteRawType(value);
 }
 
+inline bool LLBC_Stream::ReadVarUInt32(uint32 &value)
+{
+    return this->ReadCompactUInt(value);
+}
+
+inline bool LLBC_Stream::ReadVarSInt32(sint32 &value)
+{
+    return this->ReadCompactSInt(value);
+}
+
+inline bool LLBC_Stream::ReadVarUInt64(uint64 &value)
+{
+    return this->ReadCompactUInt(value);
+}
+
+inline bool LLBC_Stream::ReadVarSInt64(sint64 &value)
+{
+    return this->ReadCompactSInt(value);
+}
+
+inline void LLBC_Stream::WriteVarUInt32(uint32 value)
+{
+    this->WriteCompactUInt(value);
+}
+
+inline void LLBC_Stream::WriteVarSInt32(sint32 value)
+{
+    this->WriteCompactSInt(value);
+}
+
+inline void LLBC_Stream::WriteVarUInt64(uint64 value)
+{
+    this->WriteCompactUInt(value);
+}
+
+inline void LLBC_Stream::WriteVarSInt64(sint64 value)
+{
+    this->WriteCompactSInt(value);
+}
+
 inline LLBC_Stream &LLBC_Stream::operator =(const LLBC_Stream &rhs)
 {
     this->Assign(rhs);
@@ -679,6 +1012,179 @@ inline void LLBC_Stream::WriteRawType(const T &value)
     }
 }
 
+template <typename T>
+inline bool LLBC_Stream::ReadCompactSInt(T &value)
+{
+    // Flatten before capture position, flatten in ReadVarint() will rebase it.
+    if (UNLIKELY(_segments != NULL))
+        Flatten();
+
+    const size_t oldPos = _pos;
+
+    uint64 encoded;
+    if (!this->ReadVarint(encoded))
+        return false;
+
+    // ZigZag decode, and check value range(don't silently truncate).
+    const sint64 decoded = static_cast<sint64>(encoded >> 1) ^ -static_cast<sint64>(encoded & 0x01);
+    if (static_cast<sint64>(static_cast<T>(decoded)) != decoded)
+    {
+        _pos = oldPos;
+        return false;
+    }
+
+    value = static_cast<T>(decoded);
+
+    return true;
+}
+
+template <typename T>
+inline bool LLBC_Stream::ReadCompactUInt(T &value)
+{
+    // Flatten before capture position, flatten in ReadVarint() will rebase it.
+    if (UNLIKELY(_segments != NULL))
+        Flatten();
+
+    const size_t oldPos = _pos;
+
+    uint64 encoded;
+    if (!this->ReadVarint(encoded))
+        return false;
+
+    if (static_cast<uint64>(static_cast<T>(encoded)) != encoded)
+    {
+        _pos = oldPos;
+        return false;
+    }
+
+    value = static_cast<T>(encoded);
+
+    return true;
+}
+
+template <typename T>
+inline void LLBC_Stream::WriteCompactSInt(const T &value)
+{
+    // ZigZag encode: 0 -> 0, -1 -> 1, 1 -> 2, -2 -> 3, ...
+    const sint64 sval = static_cast<sint64>(value);
+    this->WriteVarint((static_cast<uint64>(sval) << 1) ^ static_cast<uint64>(sval >> 63));
+}
+
+template <typename T>
+inline void LLBC_Stream::WriteCompactUInt(const T &value)
+{
+    this->WriteVarint(static_cast<uint64>(value));
+}
+
+inline bool LLBC_Stream::ReadVarint(uint64 &value)
+{
+    if (UNLIKELY(_segments != NULL))
+        Flatten();
+
+    const uint8 *buf = reinterpret_cast<const uint8 *>(_buf) + _pos;
+    const size_t readableSize = MIN(_size - _pos, static_cast<size_t>(10));
+
+    uint64 result = 0;
+    for (size_t i = 0; i < readableSize; ++i)
+    {
+        const uint8 byte = buf[i];
+        result |= static_cast<uint64>(byte & 0x7f) << (7 * i);
+        if ((byte & 0x80) == 0)
+        {
+            value = result;
+            _pos += i + 1;
+
+            return true;
+        }
+    }
+
+    // Truncated or malformed(more than 10 bytes) varint.
+    return false;
+}
+
+inline void LLBC_Stream::WriteVarint(uint64 value)
+{
+    uint8 buf[10];
+    size_t len = 0;
+    while (value >= 0x80)
+    {
+        buf[len++] = static_cast<uint8>(value | 0x80);
+        value >>= 7;
+    }
+
+    buf[len++] = static_cast<uint8>(value);
+
+    this->WriteBuffer(buf, len);
+}
+
+inline bool LLBC_Stream::Reserve(size_t len)
+{
+    if (LIKELY(_pos + len <= _size))
+        return true;
+
+    if (_attach)
+    {
+        ASSERT(false && "stream obj attach's buf limit");
+        return false;
+    }
+
+    if (_segments)
+        AppendSegment(len);
+    else
+        Resize(_size + MAX(len, _size));
+
+    return true;
+}
+
+inline void LLBC_Stream::AppendSegment(size_t len)
+{
+    const size_t newSegmentSize = MAX(len, _segments->segmentSize);
+
+    // Empty tail segment, reallocate it directly.
+    if (_pos == 0)
+    {
+        LLBC_XFree(_buf);
+        _buf = LLBC_Malloc(void, newSegmentSize);
+        ASSERT(_buf && "alloc memory from heap fail!");
+
+        _size = newSegmentSize;
+
+        return;
+    }
+
+    // Seal the tail segment.
+    if (_segments->count == _segments->capacity)
+    {
+        _segments->capacity = MAX(_segments->capacity * 2, static_cast<size_t>(8));
+        _segments->segments = LLBC_Realloc(LLBC_StreamSegment,
+                                           _segments->segments,
+                                           sizeof(LLBC_StreamSegment) * _segments->capacity);
+        ASSERT(_segments->segments && "alloc memory from heap fail!");
+    }
+
+    LLBC_StreamSegment &sealed = _segments->segments[_segments->count++];
+    sealed.buf = _buf;
+    sealed.len = _pos;
+    _segments->sealedSize += _pos;
+
+    // Allocate new tail segment.
+    _buf = LLBC_Malloc(void, newSegmentSize);
+    ASSERT(_buf && "alloc memory from heap fail!");
+
+    _pos = 0;
+    _size = newSegmentSize;
+}
+
+inline void LLBC_Stream::DestroySegments()
+{
+    for (size_t i = 0; i < _segments->count; ++i)
+        LLBC_Free(_segments->segments[i].buf);
+
+    LLBC_XFree(_segments->segments);
+    LLBC_Free(_segments);
+    _segments = NULL;
+}
+
 inline bool LLBC_Stream::OverlappedCheck(const void *another, size_t len)
 {
     if (!_buf)
@@ -24,100 +24,125 @@
 __LLBC_NS_BEGIN
 
 /* Adapted sint16/uint16/sint32/uint32/long/unsigned long/sint64/uint64/float/double types Read/Write template method */
+/* Note: In compact mode, integer types read/write as varint, float/double types always fixed width */
 template <>
 inline bool LLBC_Stream::Read(sint16 &obj)
 {
-    return this->ReadRawType(obj);
+    return _compact ? this->ReadCompactSInt(obj) : this->ReadRawType(obj);
 }
 
 template <>
 inline void LLBC_Stream::Write(const sint16 &obj)
 {
-    this->WriteRawType(obj);
+    if (_compact)
+        this->WriteCompactSInt(obj);
+    else
+        this->WriteRawType(obj);
 }
 
 template <>
 inline bool LLBC_Stream::Read(uint16 &obj)
 {
-    return this->ReadRawType(obj);
+    return _compact ? this->ReadCompactUInt(obj) : this->ReadRawType(obj);
 }
 
 template <>
 inline void LLBC_Stream::Write(const uint16 &obj)
 {
-    this->WriteRawType(obj);
+    if (_compact)
+        this->WriteCompactUInt(obj);
+    else
+        this->WriteRawType(obj);
 }
 
 template <>
 inline bool LLBC_Stream::Read(sint32 &obj)
 {
-    return this->ReadRawType(obj);
+    return _compact ? this->ReadCompactSInt(obj) : this->ReadRawType(obj);
 }
 
 template <>
 inline void LLBC_Stream::Write(const sint32 &obj)
 {
-    this->WriteRawType(obj);
+    if (_compact)
+        this->WriteCompactSInt(obj);
+    else
+        this->WriteRawType(obj);
 }
 
 template <>
 inline bool LLBC_Stream::Read(uint32 &obj)
 {
-    return this->ReadRawType(obj);
+    return _compact ? this->ReadCompactUInt(obj) : this->ReadRawType(obj);
 }
 
 template <>
 inline void LLBC_Stream::Write(const uint32 &obj)
 {
-    this->WriteRawType(obj);
+    if (_compact)
+        this->WriteCompactUInt(obj);
+    else
+        this->WriteRawType(obj);
 }
 
 template <>
 inline bool LLBC_Stream::Read(long &obj)
 {
-    return this->ReadRawType(obj);
+    return _compact ? this->ReadCompactSInt(obj) : this->ReadRawType(obj);
 }
 
 template <>
 inline void LLBC_Stream::Write(const long &obj)
 {
-    this->WriteRawType(obj);
+    if (_compact)
+        this->WriteCompactSInt(obj);
+    else
+        this->WriteRawType(obj);
 }
 
 template <>
 inline bool LLBC_Stream::Read(unsigned long &obj)
 {
-    return this->ReadRawType(obj);
+    return _compact ? this->ReadCompactUInt(obj) : this->ReadRawType(obj);
 }
 
 template <>
 inline void LLBC_Stream::Write(const unsigned long &obj)
 {
-    this->WriteRawType(obj);
+    if (_compact)
+        this->WriteCompactUInt(obj);
+    else
+        this->WriteRawType(obj);
 }
 
 template <>
 inline bool LLBC_Stream::Read(sint64 &obj)
 {
-    return this->ReadRawType(obj);
+    return _compact ? this->ReadCompactSInt(obj) : this->ReadRawType(obj);
 }
 
 template <>
 inline void LLBC_Stream::Write(const sint64 &obj)
 {
-    this->WriteRawType(obj);
+    if (_compact)
+        this->WriteCompactSInt(obj);
+    else
+        this->WriteRawType(obj);
 }
 
 template <>
 inline bool LLBC_Stream::Read(uint64 &obj)
 {
-    return this->ReadRawType(obj);
+    return _compact ? this->ReadCompactUInt(obj) : this->ReadRawType(obj);
 }
 
 template <>
 inline void LLBC_Stream::Write(const uint64 &obj)
 {
-    this->WriteRawType(obj);
+    if (_compact)
+        this->WriteCompactUInt(obj);
+    else
+        this->WriteRawType(obj);
 }
 
 template <>
@@ -148,97 +173,121 @@ inline void LLBC_Stream::Write(const double &obj)
 template <>
 inline bool LLBC_Stream::ReadEx(sint16 &obj)
 {
-    return this->ReadRawType(obj);
+    return _compact ? this->ReadCompactSInt(obj) : this->ReadRawType(obj);
 }
 
 template <>
 inline void LLBC_Stream::WriteEx(const sint16 &obj)
 {
-    this->WriteRawType(obj);
+    if (_compact)
+        this->WriteCompactSInt(obj);
+    else
+        this->WriteRawType(obj);
 }
 
 template <>
 inline bool LLBC_Stream::ReadEx(uint16 &obj)
 {
-    return this->ReadRawType(obj);
+    return _compact ? this->ReadCompactUInt(obj) : this->ReadRawType(obj);
 }
 
 template <>
 inline void LLBC_Stream::WriteEx(const uint16 &obj)
 {
-    this->WriteRawType(obj);
+    if (_compact)
+        this->WriteCompactUInt(obj);
+    else
+        this->WriteRawType(obj);
 }
 
 template <>
 inline bool LLBC_Stream::ReadEx(sint32 &obj)
 {
-    return this->ReadRawType(obj);
+    return _compact ? this->ReadCompactSInt(obj) : this->ReadRawType(obj);
 }
 
 template <>
 inline void LLBC_Stream::WriteEx(const sint32 &obj)
 {
-    this->WriteRawType(obj);
+    if (_compact)
+        this->WriteCompactSInt(obj);
+    else
+        this->WriteRawType(obj);
 }
 
 template <>
 inline bool LLBC_Stream::ReadEx(uint32 &obj)
 {
-    return this->ReadRawType(obj);
+    return _compact ? this->ReadCompactUInt(obj) : this->ReadRawType(obj);
 }
 
 template <>
 inline void LLBC_Stream::WriteEx(const uint32 &obj)
 {
-    this->WriteRawType(obj);
+    if (_compact)
+        this->WriteCompactUInt(obj);
+    else
+        this->WriteRawType(obj);
 }
 
 template <>
 inline bool LLBC_Stream::ReadEx(long &obj)
 {
-    return this->ReadRawType(obj);
+    return _compact ? this->ReadCompactSInt(obj) : this->ReadRawType(obj);
 }
 
 template <>
 inline void LLBC_Stream::WriteEx(const long &obj)
 {
-    this->WriteRawType(obj);
+    if (_compact)
+        this->WriteCompactSInt(obj);
+    else
+        this->WriteRawType(obj);
 }
 
 template <>
 inline bool LLBC_Stream::ReadEx(unsigned long &obj)
 {
-    return this->ReadRawType(obj);
+    return _compact ? this->ReadCompactUInt(obj) : this->ReadRawType(obj);
 }
 
 template <>
 inline void LLBC_Stream::WriteEx(const unsigned long &obj)
 {
-    this->WriteRawType(obj);
+    if (_compact)
+        this->WriteCompactUInt(obj);
+    else
+        this->WriteRawType(obj);
 }
 
 template <>
 inline bool LLBC_Stream::ReadEx(sint64 &obj)
 {
-    return this->ReadRawType(obj);
+    return _compact ? this->ReadCompactSInt(obj) : this->ReadRawType(obj);
 }
 
 template <>
 inline void LLBC_Stream::WriteEx(const sint64 &obj)
 {
-    this->WriteRawType(obj);
+    if (_compact)
+        this->WriteCompactSInt(obj);
+    else
+        this->WriteRawType(obj);
 }
 
 template <>
 inline bool LLBC_Stream::ReadEx(uint64 &obj)
 {
-    return this->ReadRawType(obj);
+    return _compact ? this->ReadCompactUInt(obj) : this->ReadRawType(obj);
 }
 
 template <>
 inline void LLBC_Stream::WriteEx(const uint64 &obj)
 {
-    this->WriteRawType(obj);
+    if (_compact)
+        this->WriteCompactUInt(obj);
+    else
+        this->WriteRawType(obj);
 }
 
 template <>
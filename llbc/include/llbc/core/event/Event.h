@@ -32,6 +32,8 @@ __LLBC_NS_BEGIN
  */
 class LLBC_EXPORT LLBC_Event
 {
+    LLBC_ALLOCATOR_CLASS_OPS(LLBC_MemoryTag::Event)
+
 public:
     LLBC_Event(int id = 0, bool dontDelAfterFire = false);
     virtual ~LLBC_Event();
@@ -55,6 +57,14 @@ public:
      */
     void SetDontDelAfterFire(bool dontDelAfterFire);
 
+    /**
+     * Clone the event(include all params), the cloned event always delete after fire.
+     * Note: If you derived from LLBC_Event, override this method to clone the derived event,
+     *       otherwise the derived event can't be published to event bus topic.
+     * @return LLBC_Event * - the cloned event.
+     */
+    virtual LLBC_Event *Clone() const;
+
 public:
     /**
      * Get integer key indexed event param.
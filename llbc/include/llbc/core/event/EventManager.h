@@ -81,7 +81,7 @@ public:
                                           const LLBC_ListenerStub &bindedStub = LLBC_INVALID_LISTENER_STUB);
 
     /**
-     * Remove event listener.
+     * Remove event listener, both LLBC_Event listeners and typed listeners will be removed.
      * @param[in] id - event Id.
      * @return int - success if return LLBC_OK, otherwise return LLBC_FAILED.
      *               specially, if return LLBC_FAILED,  and fetch the last error is pending,
@@ -90,7 +90,7 @@ public:
     virtual int RemoveListener(int id);
 
     /**
-     * Remove event listener using listener stub.
+     * Remove event listener(or typed event listener) using listener stub.
      * @param[in] stub - event listener stub.
      * @return int - success if return LLBC_OK, otherwise return LLBC_FAILED,
      *               specially, if return LLBC_FAILED, and fetch the last error is pending,
@@ -107,6 +107,47 @@ public:
      */
     virtual int RemoveListenerX(LLBC_ListenerStub &stub);
 
+public:
+    /**
+     * Add typed event listener, typed event is plain struct(or class), fire by FireTypedEvent().
+     * Note: event Id bound to the event type of first added typed listener, add typed listener(or fire
+     *       typed event) with other event type will fail with LLBC_ERROR_INVALID.
+     * @param[in] id         - event Id, must be in (0, LLBC_CFG_CORE_EVENT_TYPED_EVENT_MAX_ID].
+     * @param[in] listener   - event listener.
+     * @param[in] bindedStub - the binded stub, if not specified, will auto gen stub.
+     * @return LLBC_ListenerStub - return LLBC_INVALID_LISTENER_STUB if failed, otherwise return validate stub.
+     */
+    template <typename EventType>
+    LLBC_ListenerStub AddTypedListener(int id,
+                                       void (*listener)(const EventType &),
+                                       const LLBC_ListenerStub &bindedStub = LLBC_INVALID_LISTENER_STUB);
+
+    /**
+     * Add typed event listener.
+     * @param[in] id         - event Id, must be in (0, LLBC_CFG_CORE_EVENT_TYPED_EVENT_MAX_ID].
+     * @param[in] obj        - object.
+     * @param[in] listener   - listener.
+     * @param[in] bindedStub - the binded stub, if not specified, will auto gen stub.
+     * @return LLBC_ListenerStub - return LLBC_INVALID_LISTENER_STUB if failed, otherwise return validate stub.
+     */
+    template <typename ObjectType, typename EventType>
+    LLBC_ListenerStub AddTypedListener(int id,
+                                       ObjectType *obj,
+                                       void (ObjectType::*listener)(const EventType &),
+                                       const LLBC_ListenerStub &bindedStub = LLBC_INVALID_LISTENER_STUB);
+
+    /**
+     * Add typed event listener, the listener delegate will be deleted by event manager.
+     * @param[in] id         - event Id, must be in (0, LLBC_CFG_CORE_EVENT_TYPED_EVENT_MAX_ID].
+     * @param[in] listener   - event listener.
+     * @param[in] bindedStub - the binded stub, if not specified, will auto gen stub.
+     * @return LLBC_ListenerStub - return LLBC_INVALID_LISTENER_STUB if failed, otherwise return validate stub.
+     */
+    template <typename EventType>
+    LLBC_ListenerStub AddTypedListener(int id,
+                                       LLBC_IDelegate1<void, const EventType &> *listener,
+                                       const LLBC_ListenerStub &bindedStub = LLBC_INVALID_LISTENER_STUB);
+
 public:
     /**
      * Fire the event.
@@ -120,6 +161,15 @@ public:
      */
     void FireEvent(int id);
 
+    /**
+     * Fire the typed event, event object not copied and not deleted, stack allocated or pooled
+     * event objects can be fired directly, no memory allocation in firing.
+     * @param[in] id - event Id.
+     * @param[in] ev - the typed event object.
+     */
+    template <typename EventType>
+    void FireTypedEvent(int id, const EventType &ev);
+
     /**
      * Check event manager is firing or not.
      * @return bool - firing flag.
@@ -136,10 +186,61 @@ protected:
 
         int evId;
         LLBC_IDelegate1<void, LLBC_Event *> *listener;
+        LLBC_IDelegate1<void, const void *> *typedListener;
 
         _Listener();
     };
 
+    /**
+     * \brief The typed event type tag, use the address of per event type static variable.
+     */
+    template <typename EventType>
+    struct _TypedEventTag
+    {
+        static const void *Get() { static char tag; return &tag; }
+    };
+
+    /**
+     * \brief The typed listener adapters, cast erased event object pointer back to event type.
+     */
+    template <typename EventType>
+    class _TypedFuncListener : public LLBC_IDelegate1<void, const void *>
+    {
+    public:
+        explicit _TypedFuncListener(void (*func)(const EventType &)) : _func(func) {  }
+
+        virtual void Invoke(const void *ev) { (*_func)(*static_cast<const EventType *>(ev)); }
+
+    private:
+        void (*_func)(const EventType &);
+    };
+
+    template <typename ObjectType, typename EventType>
+    class _TypedMethListener : public LLBC_IDelegate1<void, const void *>
+    {
+    public:
+        _TypedMethListener(ObjectType *obj, void (ObjectType::*meth)(const EventType &)) : _obj(obj), _meth(meth) {  }
+
+        virtual void Invoke(const void *ev) { (_obj->*_meth)(*static_cast<const EventType *>(ev)); }
+
+    private:
+        ObjectType *_obj;
+        void (ObjectType::*_meth)(const EventType &);
+    };
+
+    template <typename EventType>
+    class _TypedDelegListener : public LLBC_IDelegate1<void, const void *>
+    {
+    public:
+        explicit _TypedDelegListener(LLBC_IDelegate1<void, const EventType &> *deleg) : _deleg(deleg) {  }
+        virtual ~_TypedDelegListener() { LLBC_Delete(_deleg); }
+
+        virtual void Invoke(const void *ev) { _deleg->Invoke(*static_cast<const EventType *>(ev)); }
+
+    private:
+        LLBC_IDelegate1<void, const EventType &> *_deleg;
+    };
+
     /**
      * \brief Wrap the event operation information.
      */
@@ -150,6 +251,15 @@ protected:
     };
 
 protected:
+    /**
+     * Add event listener or typed event listener(only one listener can be specified).
+     */
+    LLBC_ListenerStub AddListenerImpl(int id,
+                                      LLBC_IDelegate1<void, LLBC_Event *> *listener,
+                                      LLBC_IDelegate1<void, const void *> *typedListener,
+                                      const void *typedEventTag,
+                                      const LLBC_ListenerStub &bindedStub);
+
     /**
      * Search given listen stub in the event manager.
      */
@@ -181,6 +291,12 @@ protected:
     typedef std::map<int, _Listeners> _ListenersMap;
     _ListenersMap _listeners;
 
+    // Typed listeners, flat table indexed by event Id.
+    typedef std::vector<_Listeners> _TypedListenersTable;
+    _TypedListenersTable _typedListeners;
+    // Typed event tags, indexed by event Id, bound when first typed listener added.
+    std::vector<const void *> _typedEventTags;
+
     typedef std::map<LLBC_ListenerStub, _Listener> _StubIndexedListeners;
     _StubIndexedListeners _stubListeners;
 };
@@ -57,6 +57,61 @@ LLBC_ListenerStub LLBC_EventManager::AddListener(int id,
     return this->AddListener(id, LLBC_New2(__EventMethodDeleg, obj, listener), bindedStub);
 }
 
+template <typename EventType>
+LLBC_ListenerStub LLBC_EventManager::AddTypedListener(int id,
+                                                      void (*listener)(const EventType &),
+                                                      const LLBC_ListenerStub &bindedStub)
+{
+    if (listener == NULL)
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_INVALID_LISTENER_STUB;
+    }
+
+    typedef _TypedFuncListener<EventType> __TypedFuncListener;
+
+    return AddListenerImpl(id, NULL, LLBC_New1(__TypedFuncListener, listener),
+                           _TypedEventTag<EventType>::Get(),
+                           bindedStub);
+}
+
+template <typename ObjectType, typename EventType>
+LLBC_ListenerStub LLBC_EventManager::AddTypedListener(int id,
+                                                      ObjectType *obj,
+                                                      void (ObjectType::*listener)(const EventType &),
+                                                      const LLBC_ListenerStub &bindedStub)
+{
+    if (!obj || !listener)
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_INVALID_LISTENER_STUB;
+    }
+
+    typedef _TypedMethListener<ObjectType, EventType> __TypedMethListener;
+
+    return AddListenerImpl(id, NULL, LLBC_New2(__TypedMethListener, obj, listener),
+                           _TypedEventTag<EventType>::Get(),
+                           bindedStub);
+}
+
+template <typename EventType>
+LLBC_ListenerStub LLBC_EventManager::AddTypedListener(int id,
+                                                      LLBC_IDelegate1<void, const EventType &> *listener,
+                                                      const LLBC_ListenerStub &bindedStub)
+{
+    if (listener == NULL)
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_INVALID_LISTENER_STUB;
+    }
+
+    typedef _TypedDelegListener<EventType> __TypedDelegListener;
+
+    return AddListenerImpl(id, NULL, LLBC_New1(__TypedDelegListener, listener),
+                           _TypedEventTag<EventType>::Get(),
+                           bindedStub);
+}
+
 inline int LLBC_EventManager::RemoveListenerX(LLBC_ListenerStub &stub)
 {
     if (RemoveListener(stub) != LLBC_OK)
@@ -75,6 +130,34 @@ inline void LLBC_EventManager::FireEvent(int id)
     FireEvent(new LLBC_Event(id));
 }
 
+template <typename EventType>
+void LLBC_EventManager::FireTypedEvent(int id, const EventType &ev)
+{
+    // Flat table lookup, no listeners no firing.
+    if (id <= 0 || static_cast<size_t>(id) >= _typedListeners.size())
+        return;
+
+    _Listeners &listeners = _typedListeners[id];
+    if (listeners.empty())
+        return;
+
+    // Event type must be the type bound to event Id.
+    if (UNLIKELY(_typedEventTags[id] != _TypedEventTag<EventType>::Get()))
+    {
+        LLBC_SetLastError(LLBC_ERROR_INVALID);
+        return;
+    }
+
+    // Listeners add/remove operations are delayed when firing, table and listeners keep unchanged.
+    BeforeFireEvent();
+
+    const size_t listenerCount = listeners.size();
+    for (size_t i = 0; i < listenerCount; ++i)
+        listeners[i].typedListener->Invoke(&ev);
+
+    AfterFireEvent();
+}
+
 inline bool LLBC_EventManager::IsFiring() const
 {
     return _firing > 0;
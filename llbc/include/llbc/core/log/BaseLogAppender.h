@@ -65,6 +65,14 @@ protected:
      */
     virtual LLBC_LogTokenChain *GetTokenChain() const;
 
+    /**
+     * Format log data by current appender's token chain.
+     * If log data has format cache, appenders which have same pattern only format it once.
+     * @param[in] data - the log data.
+     * @return const LLBC_String & - the formatted data, available until next log data output.
+     */
+    const LLBC_String &FormatLogData(const LLBC_LogData &data);
+
 protected:
     /**
      * Get next appender.
@@ -84,11 +92,19 @@ protected:
      */
     virtual void Flush();
 
+    /**
+     * Check appender has pending output or not, default has no pending output.
+     * @return bool - return true if has pending output, otherwise return false.
+     */
+    virtual bool HasPendingOutput() const;
+
 private:
     int _level;
 
     LLBC_LogTokenChain *_chain;
     LLBC_ILogAppender *_next;
+
+    LLBC_String _formattedData;
 };
 
 __LLBC_NS_END
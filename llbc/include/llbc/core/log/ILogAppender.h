@@ -53,6 +53,7 @@ public:
         Console = Begin,        // console type appender.
         File,                   // file type appender.
         Network,                // network type appender.
+        MmapFile,               // memory-mapped file type appender.
 
         End
     };
@@ -75,9 +76,17 @@ struct LLBC_LogAppenderInitInfo
     int maxBackupIndex;             // max backup index, used in File type appender.
     int fileBufferSize;             // file buffer size, used in File type appender.
     bool lazyCreateLogFile;         // logfile create option, used in File type appender
+    int fileChunkSize;              // file chunk size, in bytes, 0 means disable chunk mode, used in File type appender.
+    bool gzipBackupFile;            // gzip backup file flag(only available in chunk mode), used in File/MmapFile type appender.
+    int fileMmapWindowSize;         // file mmap window size, in bytes, used in MmapFile type appender.
 
     LLBC_String ip;                 // Ip address, used in Network type appender.
     uint16 port;                    // port, used in Network type appender.
+    int networkProtocol;            // network protocol, see LLBC_LogNetworkProtocol, used in Network type appender.
+    int networkBufferSize;          // network buffer size, in bytes, used in Network type appender.
+    int networkBatchSize;           // network batch size, in bytes, used in Network type appender.
+    int reconnectInterval;          // reconnect interval, in milli-seconds, used in Network type appender.
+    int maxReconnectInterval;       // max reconnect interval, in milli-seconds, used in Network type appender.
 };
 
 /**
@@ -149,6 +158,13 @@ protected:
      * Flush method.
      */
     virtual void Flush() = 0;
+
+    /**
+     * Check appender has pending output or not(buffered but not output yet after flush).
+     * If has pending output, log runnable will flush appender again in next flush interval.
+     * @return bool - return true if has pending output, otherwise return false.
+     */
+    virtual bool HasPendingOutput() const = 0;
 };
 
 __LLBC_NS_END
@@ -65,6 +65,16 @@ public:
     static int init(const LLBC_String &cfgFile);
     static void destroy();
 
+public:
+    /**
+     * Get logger handle, the handle can be cached and passed to d5/i5/w5/e5/f5(and json variants),
+     * these methods check logger's log level first, don't need any logger lookup.
+     * Note: The handle is valid until logger component destroyed.
+     * @param[in] logger - the logger name, if NULL, return root logger.
+     * @return LLBC_Logger * - the logger handle, if logger component not initialized or logger not found, return NULL.
+     */
+    static LLBC_Logger *GetLogger(const char *logger);
+
 public:
     /**
      * Output debug level message.
@@ -77,6 +87,7 @@ public:
     static void d4(const char *logger, const char *tag, const char *fmt, ...);
     template <typename Tag>
     static void d4(const char *logger, const char *fmt, ...);
+    static void d5(LLBC_Logger *logger, const char *tag, const char *fmt, ...);
 
     /**
      * Output debug level json message.
@@ -89,6 +100,7 @@ public:
     static LLBC_LogJsonMsg &jd4(const char *logger, const char *tag);
     template <typename Tag>
     static LLBC_LogJsonMsg &jd4(const char *logger);
+    static LLBC_LogJsonMsg &jd5(LLBC_Logger *logger, const char *tag);
 
     /**
      * Output info level message.
@@ -101,6 +113,7 @@ public:
     static void i4(const char *logger, const char *tag, const char *fmt, ...);
     template <typename Tag>
     static void i4(const char *logger, const char *fmt, ...);
+    static void i5(LLBC_Logger *logger, const char *tag, const char *fmt, ...);
 
     /**
      * Output info level json message.
@@ -113,6 +126,7 @@ public:
     static LLBC_LogJsonMsg &ji4(const char *logger, const char *tag);
     template <typename Tag>
     static LLBC_LogJsonMsg &ji4(const char *logger);
+    static LLBC_LogJsonMsg &ji5(LLBC_Logger *logger, const char *tag);
 
     /**
      * Output warning level message.
@@ -125,6 +139,7 @@ public:
     static void w4(const char *logger, const char *tag, const char *fmt, ...);
     template <typename Tag>
     static void w4(const char *logger, const char *fmt, ...);
+    static void w5(LLBC_Logger *logger, const char *tag, const char *fmt, ...);
 
     /**
      * Output warning level json message.
@@ -137,6 +152,7 @@ public:
     static LLBC_LogJsonMsg &jw4(const char *logger, const char *tag);
     template <typename Tag>
     static LLBC_LogJsonMsg &jw4(const char *logger);
+    static LLBC_LogJsonMsg &jw5(LLBC_Logger *logger, const char *tag);
 
     /**
      * Output error level message.
@@ -149,6 +165,7 @@ public:
     static void e4(const char *logger, const char *tag, const char *fmt, ...);
     template <typename Tag>
     static void e4(const char *logger, const char *fmt, ...);
+    static void e5(LLBC_Logger *logger, const char *tag, const char *fmt, ...);
 
     /**
      * Output error level json message.
@@ -161,6 +178,7 @@ public:
     static LLBC_LogJsonMsg &je4(const char *logger, const char *tag);
     template <typename Tag>
     static LLBC_LogJsonMsg &je4(const char *logger);
+    static LLBC_LogJsonMsg &je5(LLBC_Logger *logger, const char *tag);
 
     /**
      * Output fatal level message.
@@ -173,6 +191,7 @@ public:
     static void f4(const char *logger, const char *tag, const char *fmt, ...);
     template <typename Tag>
     static void f4(const char *logger, const char *fmt, ...);
+    static void f5(LLBC_Logger *logger, const char *tag, const char *fmt, ...);
     
     /**
      * Output fatal level json message.
@@ -185,11 +204,14 @@ public:
     static LLBC_LogJsonMsg &jf4(const char *logger, const char *tag);
     template <typename Tag>
     static LLBC_LogJsonMsg &jf4(const char *logger);
+    static LLBC_LogJsonMsg &jf5(LLBC_Logger *logger, const char *tag);
 private:
     /**
      * Initialize Log help class.
+     * @param[in] loggerManager - the logger manager.
+     * @param[in] minLogLevel   - the minimum log level of all loggers.
      */
-    static void Initialize(LLBC_LoggerManager *loggerManager);
+    static void Initialize(LLBC_LoggerManager *loggerManager, int minLogLevel);
 
     /**
      * Finalize Log helper class.
@@ -204,6 +226,19 @@ private:
      */
     friend class LLBC_LoggerManager;
 
+    /**
+     * Lower the minimum log level, if given level less than it.
+     * @param[in] level - the new log level of any logger.
+     */
+    static void LowerMinLogLevel(int level);
+
+    /**
+     * Friend class: LLBC_Logger.
+     *     Access methods:
+     *         LowerMinLogLevel() - When logger log level changed, this method will be called!
+     */
+    friend class LLBC_Logger;
+
 private:
     /**
     * When logger component not initialize, will use this function to output message.
@@ -213,6 +248,9 @@ private:
 private:
     static LLBC_Logger *_rootLogger;
     static LLBC_LoggerManager *_loggerManager;
+
+    // All loggers' minimum log level, lower than it, log message will be discarded before lookup logger.
+    static volatile sint32 _minLogLevel;
 };
 
 __LLBC_NS_END
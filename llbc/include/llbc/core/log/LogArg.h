@@ -0,0 +1,140 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef __LLBC_CORE_LOG_LOG_ARG_H__
+#define __LLBC_CORE_LOG_LOG_ARG_H__
+
+#include "llbc/common/Common.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * Pre-declare some classes.
+ */
+struct LLBC_LogData;
+
+__LLBC_NS_END
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The binary log argument class encapsulation.
+ *
+ * Binary log(deferred formatting log) only capture format string pointer and raw argument values
+ * in caller thread, the format operation will be done in log thread.
+ * Only the types which LLBC_LogArg supported can be used as binary log argument, other types will
+ * cause compile error. Argument will be formatted by the argument real type, so mismatched conversion
+ * specification(eg: %d with double argument) will not cause undefined behavior.
+ */
+class LLBC_EXPORT LLBC_LogArg
+{
+public:
+    /**
+     * Argument type enumeration.
+     */
+    enum
+    {
+        Begin,
+
+        SInt = Begin,
+        UInt,
+        Double,
+        Ptr,
+        Str,
+        Serialized, // Pre-serialized arguments, only use in caller thread, never appear in log data.
+
+        End
+    };
+
+public:
+    /**
+     * Constructors, support all integral types, floating point types, pointer and string types.
+     */
+    LLBC_LogArg(bool val);
+    LLBC_LogArg(sint8 val);
+    LLBC_LogArg(uint8 val);
+    LLBC_LogArg(sint16 val);
+    LLBC_LogArg(uint16 val);
+    LLBC_LogArg(sint32 val);
+    LLBC_LogArg(uint32 val);
+    LLBC_LogArg(long val);
+    LLBC_LogArg(ulong val);
+    LLBC_LogArg(sint64 val);
+    LLBC_LogArg(uint64 val);
+    LLBC_LogArg(float val);
+    LLBC_LogArg(double val);
+    LLBC_LogArg(const void *val);
+    LLBC_LogArg(const char *val);
+    LLBC_LogArg(const std::string &val);
+    LLBC_LogArg(const LLBC_String &val);
+
+    /**
+     * Construct pre-serialized arguments, the serialized content will be copied to log data as is.
+     * @param[in] args    - the serialized arguments(same format as Serialize() output, or the
+     *                      format which specific formatter can recognize, eg: deferred json log).
+     * @param[in] argsLen - the serialized arguments length.
+     * @return LLBC_LogArg - the pre-serialized arguments.
+     */
+    static LLBC_LogArg FromSerialized(const char *args, size_t argsLen);
+
+private:
+    /**
+     * Internal constructor, use to construct pre-serialized arguments.
+     */
+    LLBC_LogArg(int type, const char *str, size_t strLen);
+
+public:
+    /**
+     * Serialize arguments to log data(copy string arguments content).
+     * @param[in] fmt      - the format string, must be static string(eg: string literal).
+     * @param[in] args     - the arguments.
+     * @param[in] argCount - the arguments count.
+     * @param[in] data     - the log data.
+     */
+    static void Serialize(const char *fmt, const LLBC_LogArg *args, int argCount, LLBC_LogData &data);
+
+    /**
+     * Format log data serialized arguments to log message, if log data is not binary log data or
+     * already formatted, do nothing.
+     * If log data is deferred json log data, will dispatch to LLBC_LogJsonMsg::Format().
+     * @param[in] data - the log data.
+     */
+    static void Format(LLBC_LogData &data);
+
+private:
+    int _type;
+    union
+    {
+        sint64 sintVal;
+        uint64 uintVal;
+        double doubleVal;
+        const void *ptrVal;
+    } _val;
+
+    const char *_str;
+    size_t _strLen;
+};
+
+__LLBC_NS_END
+
+#include "llbc/core/log/LogArgImpl.h"
+
+#endif // !__LLBC_CORE_LOG_LOG_ARG_H__
@@ -0,0 +1,91 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifdef __LLBC_CORE_LOG_LOG_ARG_H__
+
+__LLBC_NS_BEGIN
+
+#define __LLBC_LOG_ARG_CTOR(argType, type, member, castType) \
+    inline LLBC_LogArg::LLBC_LogArg(argType val)               \
+    : _type(type)                                              \
+    , _str(NULL)                                               \
+    , _strLen(0)                                               \
+    {                                                          \
+        _val.member = static_cast<castType>(val);              \
+    }                                                          \
+
+__LLBC_LOG_ARG_CTOR(bool, SInt, sintVal, sint64)
+__LLBC_LOG_ARG_CTOR(sint8, SInt, sintVal, sint64)
+__LLBC_LOG_ARG_CTOR(uint8, UInt, uintVal, uint64)
+__LLBC_LOG_ARG_CTOR(sint16, SInt, sintVal, sint64)
+__LLBC_LOG_ARG_CTOR(uint16, UInt, uintVal, uint64)
+__LLBC_LOG_ARG_CTOR(sint32, SInt, sintVal, sint64)
+__LLBC_LOG_ARG_CTOR(uint32, UInt, uintVal, uint64)
+__LLBC_LOG_ARG_CTOR(long, SInt, sintVal, sint64)
+__LLBC_LOG_ARG_CTOR(ulong, UInt, uintVal, uint64)
+__LLBC_LOG_ARG_CTOR(sint64, SInt, sintVal, sint64)
+__LLBC_LOG_ARG_CTOR(uint64, UInt, uintVal, uint64)
+__LLBC_LOG_ARG_CTOR(float, Double, doubleVal, double)
+__LLBC_LOG_ARG_CTOR(double, Double, doubleVal, double)
+__LLBC_LOG_ARG_CTOR(const void *, Ptr, ptrVal, const void *)
+
+#undef __LLBC_LOG_ARG_CTOR
+
+inline LLBC_LogArg::LLBC_LogArg(const char *val)
+: _type(Str)
+, _str(val ? val : "(null)")
+, _strLen(val ? strlen(val) : 6)
+{
+    _val.ptrVal = NULL;
+}
+
+inline LLBC_LogArg::LLBC_LogArg(const std::string &val)
+: _type(Str)
+, _str(val.data())
+, _strLen(val.size())
+{
+    _val.ptrVal = NULL;
+}
+
+inline LLBC_LogArg::LLBC_LogArg(const LLBC_String &val)
+: _type(Str)
+, _str(val.data())
+, _strLen(val.size())
+{
+    _val.ptrVal = NULL;
+}
+
+inline LLBC_LogArg::LLBC_LogArg(int type, const char *str, size_t strLen)
+: _type(type)
+, _str(str)
+, _strLen(strLen)
+{
+    _val.ptrVal = NULL;
+}
+
+inline LLBC_LogArg LLBC_LogArg::FromSerialized(const char *args, size_t argsLen)
+{
+    return LLBC_LogArg(Serialized, args, argsLen);
+}
+
+__LLBC_NS_END
+
+#endif // __LLBC_CORE_LOG_LOG_ARG_H__
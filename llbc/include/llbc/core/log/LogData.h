@@ -30,6 +30,7 @@ __LLBC_NS_BEGIN
  * Pre-declare some classes.
  */
 class LLBC_IObjectPoolInst;
+class LLBC_LogFormatCache;
 
 __LLBC_NS_END
 
@@ -40,6 +41,8 @@ __LLBC_NS_BEGIN
  */
 struct LLBC_EXPORT LLBC_LogData
 {
+    LLBC_ALLOCATOR_CLASS_OPS(LLBC_MemoryTag::Log)
+
     char *msg;                            // Log message(allocate from heap).
     uint32 msgLen;                        // message length.
 
@@ -59,6 +62,13 @@ struct LLBC_EXPORT LLBC_LogData
 
     LLBC_ThreadId threadId;               // Log native thread Id.
 
+    const char *binFmt;                   // Deferred formatting format string(binary log, must be static string).
+    char *binArgs;                        // Deferred formatting serialized arguments(allocate from heap, reused).
+    uint32 binArgsSize;                   // Deferred formatting serialized arguments buffer size.
+    uint32 binArgsLen;                    // Deferred formatting serialized arguments length.
+
+    LLBC_LogFormatCache *fmtCache;        // Output thread's format cache(only available while outputing to appenders).
+
 public:
     /**
      * Constructor & Destructor.
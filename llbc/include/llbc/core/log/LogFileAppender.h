@@ -32,6 +32,7 @@ __LLBC_NS_BEGIN
  * Pre-declare some classes.
  */
 class LLBC_File;
+class LLBC_LogFileBackupTask;
 
 __LLBC_NS_END
 
@@ -39,6 +40,13 @@ __LLBC_NS_BEGIN
 
 /**
  * \brief File log appender class encapsulation.
+ *
+ * If file chunk size configured(only available in asynchronous mode), appender works in chunk mode:
+ *  - log data are accumulated in appender's own chunk buffer, every full chunk will be written by one write
+ *    call, and the chunk end always aligned to chunk size in file.
+ *  - the partial chunk will be written in flush(bounded by logger's flush interval), log level don't trigger flush.
+ *  - when log file rolled, appender only rename the rolled file, the backup files index shifting and gzip
+ *    compress(if enabled) will be executed in background backup task.
  */
 class LLBC_LogFileAppender : public LLBC_BaseLogAppender
 {
@@ -75,6 +83,22 @@ public:
      */
     virtual int Output(const LLBC_LogData &data);
 
+public:
+    /**
+     * Build log file name.
+     * @param[in] basePath     - the base path, if not empty, will join with base name.
+     * @param[in] baseName     - the log file base name.
+     * @param[in] fileSuffix   - the log file suffix.
+     * @param[in] dailyRolling - daily rolling mode flag, if true, will append date to file name.
+     * @param[in] now          - now time.
+     * @return LLBC_String - the log file name.
+     */
+    static LLBC_String BuildLogFileName(const LLBC_String &basePath,
+                                        const LLBC_String &baseName,
+                                        const LLBC_String &fileSuffix,
+                                        bool dailyRolling,
+                                        sint64 now);
+
 protected:
     /**
      * Flush method.
@@ -82,6 +106,25 @@ protected:
     virtual void Flush();
 
 private:
+    /**
+     * Write data to chunk buffer, when chunk full, will write chunk to file.
+     * @param[in] data - the data.
+     * @param[in] len  - the data length.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int WriteToChunk(const char *data, size_t len);
+
+    /**
+     * Write chunk buffer data to file.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int WriteChunk();
+
+    /**
+     * Update chunk write size, make chunk end aligned to chunk size in file.
+     */
+    void UpdateChunkWriteSize();
+
     /**
      * Check and update log file.
      * @param[in] now 
@@ -118,6 +161,12 @@ private:
      */
     void BackupFiles() const;
 
+    /**
+     * Rename the log file to temporary rolled file, and push it to backup task.
+     * @param[in] now - now time.
+     */
+    void RollFile(sint64 now);
+
     /**
      * Update log file buffer info(included buffer mode and buffer size).
      */
@@ -139,6 +188,9 @@ private:
     long _maxFileSize;
     int _maxBackupIndex;
 
+    size_t _fileChunkSize;
+    LLBC_LogFileBackupTask *_backupTask;
+
 private:
     LLBC_String _fileName;
 
@@ -147,6 +199,11 @@ private:
 
     sint64 _nonFlushLogCount;
     sint64 _logfileLastCheckTime;
+
+    char *_chunkBuf;
+    size_t _chunkLen;
+    size_t _chunkWriteSize;
+    uint32 _rolledFileSeq;
 };
 
 __LLBC_NS_END
@@ -0,0 +1,112 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef __LLBC_CORE_LOG_LOG_FILE_BACKUP_TASK_H__
+#define __LLBC_CORE_LOG_LOG_FILE_BACKUP_TASK_H__
+
+#include "llbc/common/Common.h"
+
+#include "llbc/core/thread/Task.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The log file backup task class encapsulation.
+ *        File appender rename the rolled log file to a temporary name and push it to backup task,
+ *        backup task shift backup files index, move the rolled file to backup file(index 1) and
+ *        compress it(if enabled) in background, so the log thread never blocked by file system operations.
+ */
+class LLBC_HIDDEN LLBC_LogFileBackupTask : public LLBC_BaseTask
+{
+public:
+    /**
+     * Construct backup task.
+     * @param[in] maxBackupIndex - max backup index.
+     * @param[in] gzipBackupFile - gzip backup file or not.
+     */
+    LLBC_LogFileBackupTask(int maxBackupIndex, bool gzipBackupFile);
+    virtual ~LLBC_LogFileBackupTask();
+
+public:
+    /**
+     * Task service routine.
+     */
+    virtual void Svc();
+
+    /**
+     * Cleanup method, backup all not yet backup files.
+     */
+    virtual void Cleanup();
+
+public:
+    /**
+     * Push rolled log file to backup.
+     * @param[in] rolledFile - the rolled log file(temporary name).
+     * @param[in] fileName   - the log file name(before rolled).
+     * @param[in] fileSuffix - the log file suffix.
+     */
+    void PushRolledFile(const LLBC_String &rolledFile,
+                        const LLBC_String &fileName,
+                        const LLBC_String &fileSuffix);
+
+    /**
+     * Stop backup task, it just send stop signal to task, must call Wait() to real stop task.
+     */
+    void Stop();
+
+private:
+    /**
+     * Backup rolled file.
+     * @param[in] block - the message block which contain rolled file info.
+     */
+    void BackupRolledFile(LLBC_MessageBlock *block);
+
+    /**
+     * Build backup file name.
+     */
+    LLBC_String BuildBackupFileName(const LLBC_String &fileNameNonSuffix,
+                                    int index,
+                                    const LLBC_String &fileSuffix) const;
+
+    /**
+     * Find exist backup file(compressed or uncompressed), if not found, return empty string.
+     */
+    LLBC_String FindBackupFile(const LLBC_String &fileNameNonSuffix,
+                               int index,
+                               const LLBC_String &fileSuffix) const;
+
+    /**
+     * Gzip the backup file, the backup file will be replaced by <backup file>.gz.
+     * @param[in] backupFile - the backup file.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int GzipFile(const LLBC_String &backupFile) const;
+
+private:
+    volatile bool _stoped;
+
+    const int _maxBackupIndex;
+    const bool _gzipBackupFile;
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_CORE_LOG_LOG_FILE_BACKUP_TASK_H__
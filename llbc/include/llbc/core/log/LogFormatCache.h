@@ -0,0 +1,97 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef __LLBC_CORE_LOG_LOG_FORMAT_CACHE_H__
+#define __LLBC_CORE_LOG_LOG_FORMAT_CACHE_H__
+
+#include "llbc/common/Common.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * Pre-declare some classes.
+ */
+struct LLBC_LogData;
+class LLBC_LogTokenChain;
+
+__LLBC_NS_END
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The log format cache class encapsulation.
+ *        Every output thread owns a format cache per log runnable, appenders which have
+ *        same pattern only format the log data once, and the formatted buffers will be reused.
+ */
+class LLBC_HIDDEN LLBC_LogFormatCache
+{
+public:
+    LLBC_LogFormatCache();
+    ~LLBC_LogFormatCache();
+
+public:
+    /**
+     * Reset the cache, must call before output new log data.
+     */
+    void Reset();
+
+    /**
+     * Format log data by given token chain, if the same pattern log data already formatted, return it directly.
+     * @param[in] chain - the token chain.
+     * @param[in] data  - the log data.
+     * @return const LLBC_String & - the formatted data, available until next Reset() call.
+     */
+    const LLBC_String &Format(const LLBC_LogTokenChain *chain, const LLBC_LogData &data);
+
+    /**
+     * Get time prefix("yy-mm-dd HH:MM:SS."), the prefix only rebuild when second changed.
+     * @param[in] logTime - the log time, in milli-seconds.
+     * @return const char * - the time prefix, length is TimePrefixLen.
+     */
+    const char *GetTimePrefix(sint64 logTime);
+
+public:
+    /**
+     * The time prefix length.
+     */
+    static const size_t TimePrefixLen = 18;
+
+private:
+    /**
+     * \brief The formatted entry structure encapsulation.
+     */
+    struct _Entry
+    {
+        const LLBC_LogTokenChain *chain; // The token chain which last format this entry.
+        LLBC_String pattern;             // The token chain pattern.
+        bool formatted;                  // Formatted flag.
+        LLBC_String formattedData;       // The formatted data(buffer reused).
+    };
+
+    std::vector<_Entry *> _entries;
+
+    time_t _timePrefixSecond;
+    char _timePrefix[TimePrefixLen + 1];
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_CORE_LOG_LOG_FORMAT_CACHE_H__
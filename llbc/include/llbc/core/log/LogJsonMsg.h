@@ -31,14 +31,26 @@ __LLBC_NS_BEGIN
  * Pre-declare some classes.
  */
 class LLBC_Logger;
+class LLBC_Variant;
+struct LLBC_LogData;
+
+__LLBC_NS_END
+
+__LLBC_NS_BEGIN
 
 /**
  * \brief The json log msg class encapsulation.
+ *
+ * Json log message is streaming serialized(no DOM), key/value pairs write to the per-thread
+ * reused buffer directly, the json log message object itself is got from current thread's
+ * unsafety object pool, so log a json message don't need any temporary memory allocation.
+ * If logger enabled deferJsonFormat option(asynchronous mode only), key/value pairs will be
+ * serialized as binary arguments, and the json string will be built in log thread.
  */
 class LLBC_EXPORT LLBC_LogJsonMsg
 {
 public:
-    explicit LLBC_LogJsonMsg(bool loggerInited, LLBC_Logger *logger, const char* tag, int lv);
+    LLBC_LogJsonMsg();
     ~LLBC_LogJsonMsg();
 
 public:
@@ -54,23 +66,102 @@ public:
     */
     void Finish(const char *fmt, ...);
 
+public:
+    /**
+     * Object pool support method, reset json message, but keep buffers for reuse.
+     */
+    void Clear();
+
+public:
+    /**
+     * The deferred json log data format string(as marker, compare by address).
+     */
+    static const char * const deferredFmt;
+
+    /**
+     * Format deferred json log data to json string, if log data is not deferred json log data
+     * or already formatted, do nothing.
+     * @param[in] data - the log data.
+     */
+    static void Format(LLBC_LogData &data);
+
 private:
     /**
-    * When logger component not initialize, will use this function to output message.
-    */
+     * Friend class: LLBC_LogHelper.
+     *     Access methods:
+     *         Init() - initialize json message after get from object pool.
+     *     Access data members:
+     *         _disabledMsg - returned when log level filtered, avoid getting message from object pool.
+     */
+    friend class LLBC_LogHelper;
+
+    /**
+     * Initialize json message.
+     * @param[in] loggerInited - logger component initialized or not.
+     * @param[in] logger       - the logger, can be NULL.
+     * @param[in] tag          - the log tag, can be NULL.
+     * @param[in] lv           - the log level.
+     */
+    void Init(bool loggerInited, LLBC_Logger *logger, const char *tag, int lv);
+
+    /**
+     * Write key/value to json writer or deferred arguments.
+     */
+    void WriteKey(const char *key);
+    void WriteStr(const char *str, size_t len);
+    void WriteValue(bool value);
+    void WriteValue(sint32 value);
+    void WriteValue(uint32 value);
+    void WriteValue(long value);
+    void WriteValue(ulong value);
+    void WriteValue(sint64 value);
+    void WriteValue(uint64 value);
+    void WriteValue(double value);
+    void WriteValue(const char *value);
+    void WriteValue(const std::string &value);
+    void WriteValue(const LLBC_String &value);
+    void WriteValue(const LLBC_Variant &value);
+
+    /**
+     * Append deferred argument.
+     */
+    void AppendDeferred(int type, const void *val);
+
+    /**
+     * When logger component not initialize, will use this function to output message.
+     */
     static void UnInitOutput(FILE *to, const char *msg);
 
 private:
+    /**
+     * Deferred argument types.
+     */
+    enum
+    {
+        DeferredBool,
+        DeferredSInt,
+        DeferredUInt,
+        DeferredDouble,
+        DeferredStr
+    };
+
+    bool _enabled;
+    bool _deferred;
     bool _loggerInited;
     LLBC_Logger *_logger;
     const char *_tag;
     int _lv;
 
-    LLBC_Json::Document &_doc;
+    LLBC_Json::StringBuffer _buf;
+    LLBC_Json::Writer<LLBC_Json::StringBuffer> _writer;
+    LLBC_String _deferredArgs;
+
+    // The shared disabled json message, never enabled, never released to object pool.
+    static LLBC_LogJsonMsg _disabledMsg;
 };
 
 __LLBC_NS_END
 
 #include "llbc/core/log/LogJsonMsgImpl.h"
 
-#endif // !__LLBC_CORE_LOG_LOG_JSONMSG_H__
\ No newline at end of file
+#endif // !__LLBC_CORE_LOG_LOG_JSONMSG_H__
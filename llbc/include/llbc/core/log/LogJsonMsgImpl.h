@@ -27,39 +27,130 @@ __LLBC_NS_BEGIN
 
 inline LLBC_LogJsonMsg &LLBC_LogJsonMsg::Add(const char *key, const char* value)
 {
-    _doc.AddMember(LLBC_Json::StringRef(key), LLBC_JsonValue(value, strlen(value)).Move(), _doc.GetAllocator());
+    if (_enabled)
+    {
+        WriteKey(key);
+        WriteValue(value);
+    }
+
     return *this;
 }
 
-template <>
-inline LLBC_LogJsonMsg &LLBC_LogJsonMsg::Add(const char *key, const sint64 &value)
+template <typename T>
+inline LLBC_LogJsonMsg &LLBC_LogJsonMsg::Add(const char *key, const T &value)
 {
-    _doc.AddMember(LLBC_Json::StringRef(key), LLBC_JsonValue(static_cast<int64_t>(value)).Move(), _doc.GetAllocator());
+    if (_enabled)
+    {
+        WriteKey(key);
+        WriteValue(value);
+    }
+
     return *this;
 }
 
-template <>
-inline LLBC_LogJsonMsg &LLBC_LogJsonMsg::Add(const char *key, const uint64 &value)
+inline void LLBC_LogJsonMsg::WriteKey(const char *key)
 {
-    _doc.AddMember(LLBC_Json::StringRef(key), LLBC_JsonValue(static_cast<uint64_t>(value)).Move(), _doc.GetAllocator());
-    return *this;
+    WriteStr(key, strlen(key));
 }
 
-template <>
-inline LLBC_LogJsonMsg &LLBC_LogJsonMsg::Add(const char *key, const LLBC_Variant &value)
+inline void LLBC_LogJsonMsg::WriteStr(const char *str, size_t len)
 {
-    LLBC_String str = value.ValueToString();
-    _doc.AddMember(LLBC_Json::StringRef(key), LLBC_JsonValue(str.c_str(), str.length(), _doc.GetAllocator()).Move(), _doc.GetAllocator());
-    return *this;
+    if (_deferred)
+    {
+        const uint32 strLen = static_cast<uint32>(len);
+        _deferredArgs.append(1, static_cast<char>(DeferredStr));
+        _deferredArgs.append(reinterpret_cast<const char *>(&strLen), sizeof(uint32));
+        _deferredArgs.append(str, len);
+    }
+    else
+    {
+        _writer.String(str, len);
+    }
 }
 
-template <typename T>
-inline LLBC_LogJsonMsg &LLBC_LogJsonMsg::Add(const char *key, const T &value)
+inline void LLBC_LogJsonMsg::WriteValue(bool value)
 {
-    _doc.AddMember(LLBC_Json::StringRef(key), LLBC_JsonValue(value).Move(), _doc.GetAllocator());
-    return *this;
+    if (_deferred)
+    {
+        const sint64 val = value ? 1 : 0;
+        AppendDeferred(DeferredBool, &val);
+    }
+    else
+    {
+        _writer.Bool(value);
+    }
+}
+
+inline void LLBC_LogJsonMsg::WriteValue(sint32 value)
+{
+    WriteValue(static_cast<sint64>(value));
+}
+
+inline void LLBC_LogJsonMsg::WriteValue(uint32 value)
+{
+    WriteValue(static_cast<uint64>(value));
+}
+
+inline void LLBC_LogJsonMsg::WriteValue(long value)
+{
+    WriteValue(static_cast<sint64>(value));
+}
+
+inline void LLBC_LogJsonMsg::WriteValue(ulong value)
+{
+    WriteValue(static_cast<uint64>(value));
+}
+
+inline void LLBC_LogJsonMsg::WriteValue(sint64 value)
+{
+    if (_deferred)
+        AppendDeferred(DeferredSInt, &value);
+    else
+        _writer.Int64(value);
+}
+
+inline void LLBC_LogJsonMsg::WriteValue(uint64 value)
+{
+    if (_deferred)
+        AppendDeferred(DeferredUInt, &value);
+    else
+        _writer.Uint64(value);
+}
+
+inline void LLBC_LogJsonMsg::WriteValue(double value)
+{
+    if (_deferred)
+        AppendDeferred(DeferredDouble, &value);
+    else if (LIKELY(value - value == 0.0))
+        _writer.Double(value);
+    else // NaN or Inf, json not support.
+        _writer.Null();
+}
+
+inline void LLBC_LogJsonMsg::WriteValue(const char *value)
+{
+    if (value)
+        WriteStr(value, strlen(value));
+    else
+        WriteStr("(null)", 6);
+}
+
+inline void LLBC_LogJsonMsg::WriteValue(const std::string &value)
+{
+    WriteStr(value.data(), value.size());
+}
+
+inline void LLBC_LogJsonMsg::WriteValue(const LLBC_String &value)
+{
+    WriteStr(value.data(), value.size());
+}
+
+inline void LLBC_LogJsonMsg::WriteValue(const LLBC_Variant &value)
+{
+    const LLBC_String str = value.ValueToString();
+    WriteStr(str.data(), str.size());
 }
 
 __LLBC_NS_END
 
-#endif // __LLBC_CORE_LOG_LOG_JSONMSG_H__
\ No newline at end of file
+#endif // __LLBC_CORE_LOG_LOG_JSONMSG_H__
@@ -0,0 +1,178 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef __LLBC_CORE_LOG_LOG_MMAP_FILE_APPENDER_H__
+#define __LLBC_CORE_LOG_LOG_MMAP_FILE_APPENDER_H__
+
+#include "llbc/common/Common.h"
+
+#include "llbc/core/log/BaseLogAppender.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * Pre-declare some classes.
+ */
+class LLBC_LogFileBackupTask;
+
+__LLBC_NS_END
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief Memory-mapped file log appender class encapsulation(only available in linux platform, and
+ *        log directory's file system must support posix_fallocate(), otherwise Initialize() return
+ *        LLBC_ERROR_NOT_IMPL, logger will use file appender instead).
+ *
+ * Appender maps a fixed size window of log file, and log data are copied to mapped window directly:
+ *  - log file is pre-sized(allocated) window by window, when window full, slide window forward and remap.
+ *  - log data are in page cache as soon as copied, so the outputed log data survive process crash,
+ *    and log thread never block in write() call.
+ *  - mapped window will be msync(asynchronous) in flush(bounded by logger's flush interval).
+ *  - when log file closed, file will be truncated to actually written size, if process crashed, the
+ *    pre-sized zero tail will be trimmed when log file reopened.
+ *  - log file rolling is same as file appender(daily rolling/max file size), the backup files index shifting
+ *    and gzip compress(if enabled) will be executed in background backup task.
+ */
+class LLBC_LogMmapFileAppender : public LLBC_BaseLogAppender
+{
+    typedef LLBC_BaseLogAppender _Base;
+
+public:
+    LLBC_LogMmapFileAppender();
+    virtual ~LLBC_LogMmapFileAppender();
+
+public:
+    /**
+     * Get log appender type, see LLBC_LogAppenderType.
+     * @return int - log appender type.
+     */
+    virtual int GetType() const;
+
+public:
+    /**
+     * Initialize the log appender.
+     * @param[in] initInfo - log appender initialize info structure.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int Initialize(const LLBC_LogAppenderInitInfo &initInfo);
+
+    /**
+     * Finalize the appender.
+     */
+    virtual void Finalize();
+
+    /**
+     * Output log data.
+     * @param[in] data - log data.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int Output(const LLBC_LogData &data);
+
+protected:
+    /**
+     * Flush method, msync mapped window.
+     */
+    virtual void Flush();
+
+private:
+    /**
+     * Write data to mapped window, if window full, slide window.
+     * @param[in] data - the data.
+     * @param[in] len  - the data length.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int Write(const char *data, size_t len);
+
+    /**
+     * Map the window which contain given file offset, log file will be pre-sized to window end.
+     * @param[in] offset - the file offset.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int MapWindow(sint64 offset);
+
+    /**
+     * Unmap current mapped window.
+     */
+    void UnmapWindow();
+
+    /**
+     * Check and update log file.
+     * @param[in] now - now time.
+     */
+    void CheckAndUpdateLogFile(sint64 now);
+
+    /**
+     * Open the log file.
+     * @param[in] fileName - the log file name.
+     * @param[in] clear    - clear flag.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int OpenFile(const LLBC_String &fileName, bool clear);
+
+    /**
+     * Close the log file, file will be truncated to actually written size.
+     */
+    void CloseFile();
+
+    /**
+     * Get actually written size of opened log file(trim pre-sized zero tail).
+     * @param[in] fileSize - the log file size.
+     * @return sint64 - the actually written size.
+     */
+    sint64 GetWrittenSize(sint64 fileSize) const;
+
+    /**
+     * Rename the log file to temporary rolled file, and push it to backup task.
+     * @param[in] now - now time.
+     */
+    void RollFile(sint64 now);
+
+private:
+    LLBC_String _basePath;
+    LLBC_String _baseName;
+    LLBC_String _fileSuffix;
+
+    bool _isDailyRolling;
+    long _maxFileSize;
+    int _maxBackupIndex;
+
+    size_t _windowSize;
+    LLBC_LogFileBackupTask *_backupTask;
+
+private:
+    LLBC_String _fileName;
+
+    int _fd;
+    sint64 _fileSize;
+
+    char *_window;
+    sint64 _windowBeg;
+    sint64 _windowEnd;
+    bool _windowDirty;
+
+    sint64 _logfileLastCheckTime;
+    uint32 _rolledFileSeq;
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_CORE_LOG_LOG_MMAP_FILE_APPENDER_H__
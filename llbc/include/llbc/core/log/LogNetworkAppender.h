@@ -28,8 +28,54 @@
 
 __LLBC_NS_BEGIN
 
+/**
+ * \brief The network log protocol class encapsulation.
+ */
+class LLBC_EXPORT LLBC_LogNetworkProtocol
+{
+public:
+    enum
+    {
+        Begin,
+
+        Udp = Begin, // UDP protocol, log records are batched into datagrams.
+        Tcp,         // TCP protocol, log records are batched into stream writes.
+
+        End
+    };
+
+public:
+    /**
+     * Get network protocol string describe.
+     * @param[in] protocol - the network protocol.
+     * @return const LLBC_String & - the protocol describe.
+     */
+    static const LLBC_String &GetProtocolDesc(int protocol);
+
+    /**
+     * Get network protocol by describe(case insensitive).
+     * @param[in] str - the protocol describe.
+     * @return int - the network protocol, if not found, return End.
+     */
+    static int Str2Protocol(const char *str);
+
+    /**
+     * Check given network protocol is legal or not.
+     * @param[in] protocol - the network protocol.
+     * @return bool - return true if legal, otherwise return false.
+     */
+    static bool IsLegal(int protocol);
+};
+
 /**
  * \brief Network log appender class encapsulation.
+ *
+ * Network appender send log records to log collector(ip:port) by UDP or TCP protocol.
+ * Every log record is framed as [uint32 length(network order)][formatted log record],
+ * frames are buffered in a bounded buffer, and sent in batches(many frames per datagram/write),
+ * a frame never be splitted into two datagrams.
+ * If collector unreachable or too slow, when buffer full, new log records will be dropped and counted.
+ * If connection broken, appender will reconnect with exponential backoff.
  */
 class LLBC_LogNetworkAppender : public LLBC_BaseLogAppender
 {
@@ -39,7 +85,6 @@ public:
     LLBC_LogNetworkAppender();
     virtual ~LLBC_LogNetworkAppender();
 
-public:
 public:
     /**
      * Get log appender type, see LLBC_LogAppenderType.
@@ -67,9 +112,102 @@ public:
      */
     virtual int Output(const LLBC_LogData &data);
 
+public:
+    /**
+     * Get sent log records count.
+     * @return sint64 - the sent log records count.
+     */
+    sint64 GetSentLogCount() const;
+
+    /**
+     * Get dropped log records count(buffer full or record too large).
+     * @return sint64 - the dropped log records count.
+     */
+    sint64 GetDroppedLogCount() const;
+
+protected:
+    /**
+     * Flush method, send all buffered log records as many as possible.
+     */
+    virtual void Flush();
+
+    /**
+     * Check has unsent log records or not.
+     * @return bool - return true if has unsent log records, otherwise return false.
+     */
+    virtual bool HasPendingOutput() const;
+
+private:
+    /**
+     * Send buffered log records in batches, until all sent or socket would block or connection broken.
+     */
+    void SendBuffered();
+
+    /**
+     * Check connection, if disconnected and reach reconnect time, will try to connect.
+     * @return bool - return true if connected, otherwise return false.
+     */
+    bool CheckConnection();
+
+    /**
+     * Close socket and schedule next reconnect(with exponential backoff).
+     */
+    void CloseAndScheduleReconnect();
+
+    /**
+     * Build next batch, batch always contain whole frames.
+     * @param[out] frameCount - the frames count in batch.
+     * @return size_t - the batch size, in bytes.
+     */
+    size_t BuildBatch(size_t &frameCount) const;
+
+    /**
+     * Drop the unsent frames of partial sent batch.
+     */
+    void DropPartialBatch();
+
+    /**
+     * Drop log records.
+     * @param[in] count - the dropped log records count.
+     */
+    void DropLogs(sint64 count);
+
+private:
+    /**
+     * The connection state enumeration.
+     */
+    enum
+    {
+        Disconnected,
+        Connecting,
+        Connected
+    };
+
 private:
     LLBC_String _ip;
     uint16 _port;
+    int _protocol;
+
+    LLBC_SocketHandle _sock;
+    int _connState;
+    sint64 _connBeginTime;
+
+    int _initReconnectInterval;
+    int _maxReconnectInterval;
+    int _reconnectInterval;
+    sint64 _nextConnectTime;
+
+    char *_buf;
+    size_t _bufCap;
+    size_t _head;
+    size_t _tail;
+    size_t _sendPos;
+    size_t _batchSize;
+    size_t _batchEnd;
+    size_t _batchFrameCount;
+
+    volatile sint64 _sentLogCount;
+    volatile sint64 _droppedLogCount;
 };
 
 __LLBC_NS_END
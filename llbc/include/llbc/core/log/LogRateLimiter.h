@@ -0,0 +1,169 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef __LLBC_CORE_LOG_LOG_RATE_LIMITER_H__
+#define __LLBC_CORE_LOG_LOG_RATE_LIMITER_H__
+
+#include "llbc/common/Common.h"
+
+#include "llbc/core/thread/SpinLock.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * Pre-declare some classes.
+ */
+class LLBC_LoggerConfigInfo;
+
+__LLBC_NS_END
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The log rate limiter class encapsulation.
+ *        Rate limiter check log message before any formatting and log data allocation, in order:
+ *        per-tag rate limit -> logger rate limit -> probabilistic sampling.
+ *        Rate limits are lock free token buckets(only read clock when bucket tokens exhausted),
+ *        sampling use thread local random state, and suppressed counts are atomic counters.
+ *        Suppressed log messages count will be reported periodically by logger's log thread flush tick.
+ */
+class LLBC_HIDDEN LLBC_LogRateLimiter
+{
+public:
+    LLBC_LogRateLimiter();
+    ~LLBC_LogRateLimiter();
+
+public:
+    /**
+     * Initialize rate limiter, must call before any log message check.
+     * @param[in] config - the logger config.
+     */
+    void Initialize(const LLBC_LoggerConfigInfo &config);
+
+    /**
+     * Check log message allowed or not, thread safe(lock free, except first time seen tag).
+     * @param[in] tag - the log tag, can be NULL.
+     * @return bool - return true if allowed, otherwise return false.
+     */
+    bool Allow(const char *tag);
+
+    /**
+     * Build suppressed log messages report if report interval reached, and clear suppressed counts, thread safe.
+     * @param[out] report - the report message.
+     * @return bool - return true if has suppressed log messages to report, otherwise return false.
+     */
+    bool BuildReport(LLBC_String &report);
+
+    /**
+     * Get total suppressed log messages count.
+     * @return sint64 - the total suppressed count.
+     */
+    sint64 GetSuppressedCount() const;
+
+private:
+    /**
+     * The lock free token bucket structure encapsulation, tokens unit is 1/1000 token.
+     */
+    struct _TokenBucket
+    {
+        sint64 rate;
+        sint64 capacity;
+        volatile sint64 tokens;
+        volatile sint64 lastRefillTime;
+
+        _TokenBucket();
+
+        /**
+         * Set bucket limit.
+         * @param[in] rate  - the rate limit(per second), 0 means not limit.
+         * @param[in] burst - the burst limit, 0 means use rate.
+         */
+        void SetLimit(sint64 rate, sint64 burst);
+
+        /**
+         * Acquire one token, if bucket tokens exhausted, refill bucket and try again.
+         * @return bool - return true if acquired, otherwise return false.
+         */
+        bool Acquire();
+
+        /**
+         * Try take one token from bucket, don't refill.
+         * @return bool - return true if token taken, otherwise return false.
+         */
+        bool TryTake();
+
+        /**
+         * Refill bucket by elapsed time since last refill.
+         * @return bool - return true if bucket refilled(by this or other thread), otherwise return false.
+         */
+        bool Refill();
+    };
+
+    /**
+     * The tag rate limiter structure encapsulation.
+     */
+    struct _TagLimiter
+    {
+        int hash;
+        LLBC_String tag;
+        _TokenBucket bucket;
+        volatile sint64 suppressedCount;
+    };
+
+    /**
+     * Get the tag limiter, if not exist, create it.
+     * @param[in] tag - the log tag.
+     * @return _TagLimiter * - the tag limiter, if tags count limited, return NULL.
+     */
+    _TagLimiter *GetTagLimiter(const char *tag);
+
+    /**
+     * Get suppressed count and clear it.
+     * @param[in] count - the suppressed count.
+     * @return sint64 - the suppressed count before clear.
+     */
+    static sint64 FetchAndClear(volatile sint64 *count);
+
+private:
+    LLBC_SpinLock _lock;
+
+    _TokenBucket _bucket;
+    bool _sampling;
+    uint32 _sampleThreshold;
+
+    int _tagRateLimit;
+    std::map<LLBC_String, int> _tagRateLimits;
+    _TagLimiter * volatile *_tagSlots;
+    size_t _tagSlotMask;
+    size_t _tagCount;
+
+    sint64 _reportInterval;
+    volatile sint64 _lastReportTime;
+    sint64 _lastReportTotalCount;
+
+    volatile sint64 _rateLimitedCount;
+    volatile sint64 _sampledOutCount;
+    volatile sint64 _totalSuppressedCount;
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_CORE_LOG_LOG_RATE_LIMITER_H__
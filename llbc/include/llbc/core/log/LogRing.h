@@ -0,0 +1,197 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef __LLBC_CORE_LOG_LOG_RING_H__
+#define __LLBC_CORE_LOG_LOG_RING_H__
+
+#include "llbc/common/Common.h"
+
+#include "llbc/core/log/LogData.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * Pre-declare some classes.
+ */
+class LLBC_LogRunnable;
+
+__LLBC_NS_END
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The log ring overflow policy class encapsulation.
+ *        When producer thread's log ring is full, logger will use this policy to process log data.
+ */
+class LLBC_EXPORT LLBC_LogRingOverflowPolicy
+{
+public:
+    enum
+    {
+        Begin,
+
+        Block = Begin, // Block producer thread until log ring has free slot.
+        Drop,          // Drop log data, and increase logger's dropped log count.
+        Sync,          // Output log data in producer thread synchronously(drain producer thread's ring first).
+
+        End
+    };
+
+public:
+    /**
+     * Get overflow policy string describe.
+     * @param[in] policy - the overflow policy.
+     * @return const LLBC_String & - the policy describe.
+     */
+    static const LLBC_String &GetPolicyDesc(int policy);
+
+    /**
+     * Get overflow policy by describe(case insensitive).
+     * @param[in] str - the policy describe.
+     * @return int - the overflow policy, if not found, return End.
+     */
+    static int Str2Policy(const char *str);
+
+    /**
+     * Check given overflow policy is legal or not.
+     * @param[in] policy - the overflow policy.
+     * @return bool - return true if legal, otherwise return false.
+     */
+    static bool IsLegal(int policy);
+};
+
+/**
+ * \brief The single producer single consumer log ring class encapsulation.
+ *        Every producer thread owns a log ring per log runnable, log runnable drain all rings in batch.
+ *        All slots are preallocated, slot's log data buffers will be reused.
+ *        When producer thread exit, ring will be released, and reused by other producer thread after drained.
+ */
+class LLBC_HIDDEN LLBC_LogRing
+{
+public:
+    /**
+     * The ring slot structure encapsulation.
+     */
+    struct Slot
+    {
+        LLBC_LogRunnable *owner; // The log data owner runnable(the runnable own the appenders).
+        LLBC_LogData data;       // The log data.
+
+        Slot();
+    };
+
+public:
+    /**
+     * Constructor & Destructor.
+     * @param[in] capacity - the ring capacity, will round up to power of 2.
+     */
+    explicit LLBC_LogRing(size_t capacity);
+    ~LLBC_LogRing();
+
+public:
+    /**
+     * Get ring capacity.
+     * @return size_t - the ring capacity.
+     */
+    size_t GetCapacity() const;
+
+    /**
+     * Get ring used slots count.
+     * @return size_t - the used slots count.
+     */
+    size_t GetSize() const;
+
+public:
+    /**
+     * Producer method, begin write slot.
+     * @return Slot * - the writable slot, if ring is full, return NULL.
+     */
+    Slot *BeginWrite();
+
+    /**
+     * Producer method, publish the slot returned by BeginWrite().
+     */
+    void EndWrite();
+
+public:
+    /**
+     * Consumer method, get the front slot.
+     * @return Slot * - the front slot, if ring is empty, return NULL.
+     */
+    Slot *Front();
+
+    /**
+     * Consumer method, clear the front slot and release it to producer.
+     */
+    void PopFront();
+
+public:
+    /**
+     * Producer method, release ring when producer thread exit.
+     */
+    void Release();
+
+    /**
+     * Consumer method, reclaim the ring if it released by producer thread and drained.
+     * @return bool - return true if reclaimed(ring can be reused by other producer thread), otherwise return false.
+     */
+    bool Reclaim();
+
+    /**
+     * Reuse reclaimed ring for new producer thread.
+     * @return bool - return true if reused, otherwise return false.
+     */
+    bool Reuse();
+
+    LLBC_DISABLE_ASSIGNMENT(LLBC_LogRing);
+
+private:
+    /**
+     * The ring state enumeration.
+     */
+    enum
+    {
+        InUse,     // Ring owned by producer thread.
+        Released,  // Producer thread exited, ring may still has log data to drain.
+        Reclaimed  // Ring drained after producer thread exited, can be reused by other producer thread.
+    };
+
+private:
+    size_t _capacity;
+    sint64 _mask;
+    Slot *_slots;
+
+    // Consumer side members.
+    volatile sint64 _head;
+    sint64 _cachedTail;
+
+    char _pad[64];
+
+    // Producer side members.
+    volatile sint64 _tail;
+    sint64 _cachedHead;
+
+    volatile sint32 _state;
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_CORE_LOG_LOG_RING_H__
@@ -24,7 +24,10 @@
 
 #include "llbc/common/Common.h"
 
+#include "llbc/core/thread/Tls.h"
 #include "llbc/core/thread/Task.h"
+#include "llbc/core/thread/SpinLock.h"
+#include "llbc/core/thread/SimpleLock.h"
 
 __LLBC_NS_BEGIN
 
@@ -32,6 +35,9 @@ __LLBC_NS_BEGIN
  * Pre-declare some classes.
  */
 struct LLBC_LogData;
+class LLBC_Logger;
+class LLBC_LogRing;
+class LLBC_LogFormatCache;
 class LLBC_ILogAppender;
 
 __LLBC_NS_END
@@ -40,6 +46,10 @@ __LLBC_NS_BEGIN
 
 /**
  * \brief Log Runnable class encapsulation.
+ *
+ * A log runnable owns a logger's appenders, and can be activated as the logger's own log thread.
+ * If shared log thread enabled, a log runnable can also be activated as a shared log thread, which
+ * serve other loggers' log runnables(output log data to served runnable's appenders and batch flush them).
  */
 class LLBC_LogRunnable : public LLBC_BaseTask
 {
@@ -64,6 +74,19 @@ public:
      */
     void SetFlushInterval(sint64 flushInterval);
 
+    /**
+     * Set runnable log ring buffer size, only can call before runnable activated.
+     * @param[in] ringBufferSize - the log ring buffer size, 0 means disable log ring.
+     */
+    void SetRingBufferSize(size_t ringBufferSize);
+
+    /**
+     * Set suppressed log messages reporter, only can call before runnable activated.
+     * Reporter's suppressed report will output in log thread's flush tick.
+     * @param[in] reporter - the reporter logger(the rate limited logger which own this runnable).
+     */
+    void SetSuppressedReporter(LLBC_Logger *reporter);
+
 public:
     /**
      * Add log appender.
@@ -71,12 +94,44 @@ public:
      */
     void AddAppender(LLBC_ILogAppender *appender);
 
+    /**
+     * Add served log runnable, only can call before runnable activated.
+     * Served runnable's flush interval will be merged into this runnable(use the min flush interval).
+     * @param[in] runnable - the served runnable, this runnable don't take over the served runnable's ownership.
+     */
+    void AddServedRunnable(LLBC_LogRunnable *runnable);
+
     /**
      * Output log data.
      * @param[in] data - log data.
      */
     int Output(LLBC_LogData *data);
 
+    /**
+     * Push log data to runnable's message queue, queued log data will output by owner runnable's appenders.
+     * @param[in] owner - the log data owner runnable(the runnable own the appenders).
+     * @param[in] data  - log data.
+     * @param[in] block - the message block used to transfer log data.
+     */
+    void PushLogData(LLBC_LogRunnable *owner, LLBC_LogData *data, LLBC_MessageBlock *block);
+
+    /**
+     * Get calling thread's log ring, if calling thread log ring not create, will reuse reclaimed ring or create it.
+     * Calling thread's log ring will be released when thread exit, and reclaimed by log thread after drained.
+     * @return LLBC_LogRing * - the log ring, if log ring disabled or ring count limited, return NULL.
+     */
+    LLBC_LogRing *GetThreadRing();
+
+    /**
+     * Synchronous output log data in producer thread, used when producer thread's log ring overflow.
+     * Before output log data, all log data in producer thread's ring will output first, to keep log order.
+     * @param[in] ring  - the producer thread's log ring.
+     * @param[in] owner - the log data owner runnable.
+     * @param[in] data  - log data.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SyncOutput(LLBC_LogRing *ring, LLBC_LogRunnable *owner, LLBC_LogData *data);
+
     /**
      * Stop log runnable, it just send stop signal to task, must call Wait() to real stop runnable.
      */
@@ -89,12 +144,58 @@ private:
      */
     void FlushAppenders(bool force = false);
 
+    /**
+     * Report self and served runnables' suppressed log messages, call in flush tick.
+     */
+    void ReportSuppressed();
+
+    /**
+     * Output queued log data.
+     * @param[in] block - the message block which contain log data.
+     */
+    void OutputQueuedLogData(LLBC_MessageBlock *block);
+
+    /**
+     * Drain all log rings, the log data from different rings will be merged by log time.
+     * If all rings drained, reclaim the rings which released by exited producer threads.
+     * @return size_t - drained log data count.
+     */
+    size_t DrainRings();
+
+    /**
+     * Output and pop all log data in given ring.
+     * @param[in] ring - the log ring.
+     */
+    void DrainRing(LLBC_LogRing *ring);
+
+    /**
+     * Get calling thread's format cache, if calling thread format cache not create, will create it.
+     * @return LLBC_LogFormatCache * - the format cache.
+     */
+    LLBC_LogFormatCache *GetThreadFormatCache();
+
 private:
     volatile bool _stoped;
     LLBC_ILogAppender *_head;
+    bool _dirty;
+    LLBC_Logger *_suppressedReporter;
+
+    std::vector<LLBC_LogRunnable *> _servedRunnables;
 
     sint64 _lastFlushTime;
     sint64 _flushInterval;
+
+    size_t _ringBufferSize;
+    LLBC_TlsHandle _threadRingKey;
+    LLBC_SpinLock _ringLock;
+    LLBC_LogRing *_rings[LLBC_CFG_LOG_MAX_RING_COUNT];
+    volatile sint32 _ringCount;
+
+    LLBC_SimpleLock _outputLock;
+
+    LLBC_Tls<LLBC_LogFormatCache> _threadFmtCache;
+    LLBC_SpinLock _fmtCacheLock;
+    std::vector<LLBC_LogFormatCache *> _fmtCaches;
 };
 
 __LLBC_NS_END
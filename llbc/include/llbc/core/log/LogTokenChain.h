@@ -60,6 +60,12 @@ public:
      */
     void Format(const LLBC_LogData &data, LLBC_String &formattedData) const;
 
+    /**
+     * Get the token chain pattern.
+     * @return const LLBC_String & - the pattern string.
+     */
+    const LLBC_String &GetPattern() const;
+
     /**
      * Clean the log token chain.
      */
@@ -73,6 +79,7 @@ private:
     void AppendToken(LLBC_ILogToken *token);
 
 private:
+    LLBC_String _pattern;
     LLBC_ILogToken *_head;
 };
 
@@ -29,6 +29,7 @@
 #include "llbc/core/utils/Util_DelegateImpl.h"
 #include "llbc/core/objectpool/ExportedObjectPoolTypes.h"
 
+#include "llbc/core/log/LogArg.h"
 #include "llbc/core/log/LogLevel.h"
 #include "llbc/core/thread/RecursiveLock.h"
 
@@ -38,8 +39,13 @@ __LLBC_NS_BEGIN
  * Pre-declare some classes.
  */
 struct LLBC_LogData;
+class LLBC_LogRing;
 class LLBC_LogRunnable;
 class LLBC_LoggerConfigInfo;
+class LLBC_LogNetworkAppender;
+class LLBC_LogRateLimiter;
+class LLBC_LogHelper;
+class LLBC_LogJsonMsg;
 
 __LLBC_NS_END
 
@@ -59,9 +65,14 @@ public:
      * Initialize the loggeer.
      * @param[in] name   - logger name.
      * @param[in] config - logger config info.
+     * @param[in] sharedLogRunnable - the shared log runnable, if not NULL and logger is asynchronous mode,
+     *                                logger will output log data in this shared log thread, otherwise
+     *                                asynchronous logger will create its own log thread.
      * @return int - return 0 if success, otherwise return -1.
      */
-    int Initialize(const LLBC_String &name, const LLBC_LoggerConfigInfo *config);
+    int Initialize(const LLBC_String &name,
+                   const LLBC_LoggerConfigInfo *config,
+                   LLBC_LogRunnable *sharedLogRunnable = NULL);
 
     /**
      * Check logger initialized or not.
@@ -82,13 +93,13 @@ public:
     const LLBC_String &GetLoggerName() const;
 
     /**
-     * Get log level.
+     * Get log level, lock free, can be called in any thread.
      * @return int - the log level.
      */
     int GetLogLevel() const;
 
     /**
-     * Set log level.
+     * Set log level, the new level is visible to all producer threads at once.
      * @param[in] level - new log level.
      */
     void SetLogLevel(int level);
@@ -99,6 +110,30 @@ public:
      */
     bool IsTakeOver() const;
 
+    /**
+     * Get dropped log count(only log ring overflow policy is drop, log data will be dropped).
+     * @return sint64 - the dropped log count.
+     */
+    sint64 GetDroppedLogCount() const;
+
+    /**
+     * Get network appender sent log count.
+     * @return sint64 - the sent log count, if not log to network, return 0.
+     */
+    sint64 GetNetworkSentLogCount() const;
+
+    /**
+     * Get network appender dropped log count(network buffer full or log record too large).
+     * @return sint64 - the dropped log count, if not log to network, return 0.
+     */
+    sint64 GetNetworkDroppedLogCount() const;
+
+    /**
+     * Get suppressed log count(suppressed by rate limit or sampling).
+     * @return sint64 - the suppressed log count.
+     */
+    sint64 GetSuppressedLogCount() const;
+
 public:
     /**
      * Install logger hook.
@@ -170,11 +205,115 @@ public:
      */
     int OutputNonFormat(int level, const char *tag, const char *file, int line, const char *message, size_t messageLen = -1);
 
+public:
+    /**
+     * Binary log(deferred formatting log) output, caller thread only capture format string and arguments,
+     * the format operation will be done in log thread(if logger is asynchronous mode).
+     * @param[in] level - log level.
+     * @param[in] tag   - log tag, can set to NULL.
+     * @param[in] file  - log file name.
+     * @param[in] line  - log file line.
+     * @param[in] fmt   - format control string, must be static string(eg: string literal).
+     * @param[in] argN  - the arguments, only LLBC_LogArg supported types can be used(check at compile time).
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int BOutput(int level, const char *tag, const char *file, int line, const char *fmt);
+    template <typename Arg1>
+    int BOutput(int level, const char *tag, const char *file, int line, const char *fmt, const Arg1 &arg1);
+    template <typename Arg1, typename Arg2>
+    int BOutput(int level, const char *tag, const char *file, int line, const char *fmt, const Arg1 &arg1, const Arg2 &arg2);
+    template <typename Arg1, typename Arg2, typename Arg3>
+    int BOutput(int level, const char *tag, const char *file, int line, const char *fmt, const Arg1 &arg1, const Arg2 &arg2, const Arg3 &arg3);
+    template <typename Arg1, typename Arg2, typename Arg3, typename Arg4>
+    int BOutput(int level, const char *tag, const char *file, int line, const char *fmt, const Arg1 &arg1, const Arg2 &arg2, const Arg3 &arg3, const Arg4 &arg4);
+    template <typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5>
+    int BOutput(int level, const char *tag, const char *file, int line, const char *fmt, const Arg1 &arg1, const Arg2 &arg2, const Arg3 &arg3, const Arg4 &arg4, const Arg5 &arg5);
+    template <typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5, typename Arg6>
+    int BOutput(int level, const char *tag, const char *file, int line, const char *fmt, const Arg1 &arg1, const Arg2 &arg2, const Arg3 &arg3, const Arg4 &arg4, const Arg5 &arg5, const Arg6 &arg6);
+    template <typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5, typename Arg6, typename Arg7>
+    int BOutput(int level, const char *tag, const char *file, int line, const char *fmt, const Arg1 &arg1, const Arg2 &arg2, const Arg3 &arg3, const Arg4 &arg4, const Arg5 &arg5, const Arg6 &arg6, const Arg7 &arg7);
+    template <typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5, typename Arg6, typename Arg7, typename Arg8>
+    int BOutput(int level, const char *tag, const char *file, int line, const char *fmt, const Arg1 &arg1, const Arg2 &arg2, const Arg3 &arg3, const Arg4 &arg4, const Arg5 &arg5, const Arg6 &arg6, const Arg7 &arg7, const Arg8 &arg8);
+
+    /**
+     * Binary log output, all BOutput() methods will call this method to output.
+     * @param[in] level    - log level.
+     * @param[in] tag      - log tag, can set to NULL.
+     * @param[in] file     - log file name.
+     * @param[in] line     - log file line.
+     * @param[in] fmt      - format control string, must be static string(eg: string literal).
+     * @param[in] args     - the arguments.
+     * @param[in] argCount - the arguments count.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int BinOutput(int level, const char *tag, const char *file, int line, const char *fmt, const LLBC_LogArg *args, int argCount);
+
 private:
+    /**
+     * Friend class: LLBC_LogHelper.
+     *     Access methods:
+     *         IsSuppressed() - check rate limit before format log message.
+     *         DirectOutput() - output formatted log message(take over message ownership).
+     */
+    friend class LLBC_LogHelper;
+
+    /**
+     * Friend class: LLBC_LogJsonMsg.
+     *     Access methods:
+     *         IsSuppressed() - check rate limit before serialize json log message.
+     *         DirectOutput() - output serialized json log message.
+     *     Access data members:
+     *         _config - check defer json format option.
+     */
+    friend class LLBC_LogJsonMsg;
+
+    /**
+     * Friend class: LLBC_LogRunnable.
+     *     Access methods:
+     *         ReportSuppressed() - output suppressed log messages report in log thread's flush tick.
+     */
+    friend class LLBC_LogRunnable;
+
+    /**
+     * Check log message suppressed by rate limiter or not, must call before any formatting.
+     * @param[in] tag - log tag.
+     * @return bool - return true if suppressed, otherwise return false.
+     */
+    bool IsSuppressed(const char *tag);
+
+    /**
+     * Output suppressed log messages report if report interval reached(bypass rate limiter).
+     */
+    void ReportSuppressed();
+
     /**
      * Direct output message using given level.
      */
-    int DirectOutput(int level, const char *tag, const char *file, int line, char *message, int len);
+    int DirectOutput(int level,
+                     const char *tag,
+                     const char *file,
+                     int line,
+                     char *message,
+                     int len,
+                     const char *binFmt = NULL,
+                     const LLBC_LogArg *binArgs = NULL,
+                     int binArgCount = 0);
+
+    /**
+     * Output message to producer thread's log ring, if ring overflow, process by ring overflow policy.
+     */
+    int RingOutput(LLBC_LogRunnable *consumer,
+                   LLBC_LogRing *ring,
+                   int level,
+                   const char *tag,
+                   const char *file,
+                   int line,
+                   char *message,
+                   int len,
+                   const char *binFmt,
+                   const LLBC_LogArg *binArgs,
+                   int binArgCount);
+
     /**
      * Build log data.
      * @param[in] level   - log level.
@@ -192,15 +331,30 @@ private:
                                char *message,
                                int len);
 
+    /**
+     * Fill log data, parameters same as BuildLogData().
+     */
+    void FillLogData(LLBC_LogData *data,
+                     int level,
+                     const char *tag,
+                     const char *file,
+                     int line,
+                     char *message,
+                     int len);
+
 private:
     LLBC_RecursiveLock _lock;
 
     LLBC_String _name;
 
-    int _logLevel;
+    volatile sint32 _logLevel;
     const LLBC_LoggerConfigInfo *_config;
 
     LLBC_LogRunnable *_logRunnable;
+    LLBC_LogRunnable *_sharedLogRunnable;
+    volatile sint64 _droppedLogCount;
+    LLBC_LogNetworkAppender *_networkAppender;
+    LLBC_LogRateLimiter *_rateLimiter;
     LLBC_SafetyObjectPool _objPool;
     LLBC_ObjectPoolInst<LLBC_MessageBlock> &_msgBlockPoolInst;
     LLBC_ObjectPoolInst<LLBC_LogData> &_logDataPoolInst;
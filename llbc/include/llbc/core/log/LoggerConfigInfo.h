@@ -163,6 +163,24 @@ public:
      */
     int GetFileBufferSize() const;
 
+    /**
+     * Get file chunk size, 0 means chunk mode disabled.
+     * @return int - the file chunk size.
+     */
+    int GetFileChunkSize() const;
+
+    /**
+     * Get gzip backup file option(only available in chunk/mmap mode).
+     * @return bool - gzip backup file option.
+     */
+    bool IsGzipBackupFile() const;
+
+    /**
+     * Get file mmap window size, 0 means mmap mode disabled.
+     * @return int - the file mmap window size.
+     */
+    int GetFileMmapWindowSize() const;
+
 public:
     /**
      * Get take over option.
@@ -177,6 +195,137 @@ public:
      */
     bool IsLazyCreateLogFile() const;
 
+public:
+    /**
+     * Get shared log thread count, only available in root logger config.
+     * @return int - the shared log thread count, 0 means every asynchronous logger use its own log thread.
+     */
+    int GetSharedLogThreadCount() const;
+
+public:
+    /**
+     * Get log ring buffer size, only available in asynchronous mode.
+     * @return int - the log ring buffer size, 0 means transfer log data by message queue.
+     */
+    int GetRingBufferSize() const;
+
+    /**
+     * Get log ring overflow policy.
+     * @return int - the log ring overflow policy, see LLBC_LogRingOverflowPolicy.
+     */
+    int GetRingOverflowPolicy() const;
+
+public:
+    /**
+     * Get defer json log format option, only available in asynchronous mode.
+     * @return bool - if true, json log message will serialize in log thread.
+     */
+    bool IsDeferJsonFormat() const;
+
+public:
+    /**
+     * Get log to network switch.
+     * @return bool - log to network switch.
+     */
+    bool IsLogToNetwork() const;
+
+    /**
+     * Get network log level.
+     * @return int - network log level.
+     */
+    int GetNetworkLogLevel() const;
+
+    /**
+     * Get network log pattern.
+     * @return const LLBC_String & - network log pattern.
+     */
+    const LLBC_String &GetNetworkPattern() const;
+
+    /**
+     * Get network log collector ip.
+     * @return const LLBC_String & - the collector ip.
+     */
+    const LLBC_String &GetNetworkIp() const;
+
+    /**
+     * Get network log collector port.
+     * @return uint16 - the collector port.
+     */
+    uint16 GetNetworkPort() const;
+
+    /**
+     * Get network log protocol.
+     * @return int - the network log protocol, see LLBC_LogNetworkProtocol.
+     */
+    int GetNetworkProtocol() const;
+
+    /**
+     * Get network log buffer size.
+     * @return int - the network log buffer size, in bytes.
+     */
+    int GetNetworkBufferSize() const;
+
+    /**
+     * Get network log batch size.
+     * @return int - the network log batch size, in bytes.
+     */
+    int GetNetworkBatchSize() const;
+
+    /**
+     * Get network log reconnect interval.
+     * @return int - the reconnect interval, in milli-seconds.
+     */
+    int GetNetworkReconnectInterval() const;
+
+    /**
+     * Get network log max reconnect interval.
+     * @return int - the max reconnect interval, in milli-seconds.
+     */
+    int GetNetworkMaxReconnectInterval() const;
+
+public:
+    /**
+     * Get logger rate limit.
+     * @return int - the max log messages per second, 0 means no limit.
+     */
+    int GetRateLimit() const;
+
+    /**
+     * Get logger rate limit burst.
+     * @return int - the max burst log messages, 0 means same as rate limit.
+     */
+    int GetRateLimitBurst() const;
+
+    /**
+     * Get default per-tag rate limit.
+     * @return int - the max log messages per second for every tag, 0 means no limit.
+     */
+    int GetTagRateLimit() const;
+
+    /**
+     * Get specific tags rate limits, these rate limits override the default per-tag rate limit.
+     * @return const std::map<LLBC_String, int> & - the tag -> rate limit map.
+     */
+    const std::map<LLBC_String, int> &GetTagRateLimits() const;
+
+    /**
+     * Get log sample rate.
+     * @return double - the probability of log message be accepted.
+     */
+    double GetSampleRate() const;
+
+    /**
+     * Get suppressed log messages report interval.
+     * @return int - the report interval, in milli-seconds.
+     */
+    int GetSuppressedReportInterval() const;
+
+    /**
+     * Check logger rate limit or sampling enabled or not.
+     * @return bool - return true if enabled, otherwise return false.
+     */
+    bool IsRateLimitEnabled() const;
+
 private:
     /**
      * Normalize the log file name.
@@ -210,8 +359,35 @@ private:
     int _maxBackupIndex;
     int _fileBufferSize;
     bool _lazyCreateLogFile;
+    int _fileChunkSize;
+    bool _gzipBackupFile;
+    int _fileMmapWindowSize;
 
     bool _takeOver;
+    int _sharedLogThreadCount;
+
+    int _ringBufferSize;
+    int _ringOverflowPolicy;
+
+    bool _deferJsonFormat;
+
+    bool _logToNetwork;
+    int _networkLogLevel;
+    LLBC_String _networkPattern;
+    LLBC_String _networkIp;
+    uint16 _networkPort;
+    int _networkProtocol;
+    int _networkBufferSize;
+    int _networkBatchSize;
+    int _networkReconnectInterval;
+    int _networkMaxReconnectInterval;
+
+    int _rateLimit;
+    int _rateLimitBurst;
+    int _tagRateLimit;
+    std::map<LLBC_String, int> _tagRateLimits;
+    double _sampleRate;
+    int _suppressedReportInterval;
 };
 
 __LLBC_NS_END
@@ -113,6 +113,21 @@ inline int LLBC_LoggerConfigInfo::GetFileBufferSize() const
     return _fileBufferSize;
 }
 
+inline int LLBC_LoggerConfigInfo::GetFileChunkSize() const
+{
+    return _fileChunkSize;
+}
+
+inline bool LLBC_LoggerConfigInfo::IsGzipBackupFile() const
+{
+    return _gzipBackupFile;
+}
+
+inline int LLBC_LoggerConfigInfo::GetFileMmapWindowSize() const
+{
+    return _fileMmapWindowSize;
+}
+
 inline bool LLBC_LoggerConfigInfo::IsTakeOver() const
 {
     return _takeOver;
@@ -123,6 +138,111 @@ inline bool LLBC_LoggerConfigInfo::IsLazyCreateLogFile() const
     return _lazyCreateLogFile;
 }
 
+inline int LLBC_LoggerConfigInfo::GetSharedLogThreadCount() const
+{
+    return _sharedLogThreadCount;
+}
+
+inline bool LLBC_LoggerConfigInfo::IsDeferJsonFormat() const
+{
+    return _deferJsonFormat;
+}
+
+inline int LLBC_LoggerConfigInfo::GetRingBufferSize() const
+{
+    return _ringBufferSize;
+}
+
+inline int LLBC_LoggerConfigInfo::GetRingOverflowPolicy() const
+{
+    return _ringOverflowPolicy;
+}
+
+inline bool LLBC_LoggerConfigInfo::IsLogToNetwork() const
+{
+    return _logToNetwork;
+}
+
+inline int LLBC_LoggerConfigInfo::GetNetworkLogLevel() const
+{
+    return _networkLogLevel;
+}
+
+inline const LLBC_String &LLBC_LoggerConfigInfo::GetNetworkPattern() const
+{
+    return _networkPattern;
+}
+
+inline const LLBC_String &LLBC_LoggerConfigInfo::GetNetworkIp() const
+{
+    return _networkIp;
+}
+
+inline uint16 LLBC_LoggerConfigInfo::GetNetworkPort() const
+{
+    return _networkPort;
+}
+
+inline int LLBC_LoggerConfigInfo::GetNetworkProtocol() const
+{
+    return _networkProtocol;
+}
+
+inline int LLBC_LoggerConfigInfo::GetNetworkBufferSize() const
+{
+    return _networkBufferSize;
+}
+
+inline int LLBC_LoggerConfigInfo::GetNetworkBatchSize() const
+{
+    return _networkBatchSize;
+}
+
+inline int LLBC_LoggerConfigInfo::GetNetworkReconnectInterval() const
+{
+    return _networkReconnectInterval;
+}
+
+inline int LLBC_LoggerConfigInfo::GetNetworkMaxReconnectInterval() const
+{
+    return _networkMaxReconnectInterval;
+}
+
+inline int LLBC_LoggerConfigInfo::GetRateLimit() const
+{
+    return _rateLimit;
+}
+
+inline int LLBC_LoggerConfigInfo::GetRateLimitBurst() const
+{
+    return _rateLimitBurst;
+}
+
+inline int LLBC_LoggerConfigInfo::GetTagRateLimit() const
+{
+    return _tagRateLimit;
+}
+
+inline const std::map<LLBC_String, int> &LLBC_LoggerConfigInfo::GetTagRateLimits() const
+{
+    return _tagRateLimits;
+}
+
+inline double LLBC_LoggerConfigInfo::GetSampleRate() const
+{
+    return _sampleRate;
+}
+
+inline int LLBC_LoggerConfigInfo::GetSuppressedReportInterval() const
+{
+    return _suppressedReportInterval;
+}
+
+inline bool LLBC_LoggerConfigInfo::IsRateLimitEnabled() const
+{
+    return _rateLimit > 0 || _tagRateLimit > 0 || !_tagRateLimits.empty() || _sampleRate < 1.0;
+}
+
 __LLBC_NS_END
 
 #endif // __LLBC_CORE_LOG_LOGGER_CONFIG_INFO_H__
@@ -30,6 +30,7 @@ __LLBC_NS_BEGIN
  * Pre-declare some classes.
  */
 class LLBC_Logger;
+class LLBC_LogRunnable;
 class LLBC_LoggerConfigInfo;
 
 __LLBC_NS_END
@@ -56,9 +57,10 @@ public:
      * Config given logger.
      * @param[in] name   - logger name.
      * @param[in] logger - will config logger.
+     * @param[in] sharedLogRunnable - the shared log runnable, only used when logger is asynchronous mode.
      * @return int - return 0 if success, otherwise return -1.
      */
-    int Config(const LLBC_String &name, LLBC_Logger *logger) const;
+    int Config(const LLBC_String &name, LLBC_Logger *logger, LLBC_LogRunnable *sharedLogRunnable = NULL) const;
 
 public:
     /**
@@ -23,6 +23,12 @@
 
 __LLBC_NS_BEGIN
 
+inline int LLBC_Logger::GetLogLevel() const
+{
+    // Aligned 32 bit load is atomic, don't use LLBC_AtomicGet(it is a locked read-modify-write).
+    return _logLevel;
+}
+
 inline int LLBC_Logger::InstallHook(int level, void (*hookFunc)(const LLBC_LogData *logData))
 {
     LLBC_IDelegate1<void, const LLBC_LogData *> *hookDeleg = 
@@ -48,6 +54,94 @@ inline int LLBC_Logger::InstallHook(int level, ObjType *obj, void ( ObjType::*ho
     return installRet;
 }
 
+inline int LLBC_Logger::BOutput(int level, const char *tag, const char *file, int line, const char *fmt)
+{
+    if (level < _logLevel)
+        return LLBC_OK;
+
+    return BinOutput(level, tag, file, line, fmt, NULL, 0);
+}
+
+template <typename Arg1>
+inline int LLBC_Logger::BOutput(int level, const char *tag, const char *file, int line, const char *fmt, const Arg1 &arg1)
+{
+    if (level < _logLevel)
+        return LLBC_OK;
+
+    const LLBC_LogArg args[] = {LLBC_LogArg(arg1)};
+    return BinOutput(level, tag, file, line, fmt, args, 1);
+}
+
+template <typename Arg1, typename Arg2>
+inline int LLBC_Logger::BOutput(int level, const char *tag, const char *file, int line, const char *fmt, const Arg1 &arg1, const Arg2 &arg2)
+{
+    if (level < _logLevel)
+        return LLBC_OK;
+
+    const LLBC_LogArg args[] = {LLBC_LogArg(arg1), LLBC_LogArg(arg2)};
+    return BinOutput(level, tag, file, line, fmt, args, 2);
+}
+
+template <typename Arg1, typename Arg2, typename Arg3>
+inline int LLBC_Logger::BOutput(int level, const char *tag, const char *file, int line, const char *fmt, const Arg1 &arg1, const Arg2 &arg2, const Arg3 &arg3)
+{
+    if (level < _logLevel)
+        return LLBC_OK;
+
+    const LLBC_LogArg args[] = {LLBC_LogArg(arg1), LLBC_LogArg(arg2), LLBC_LogArg(arg3)};
+    return BinOutput(level, tag, file, line, fmt, args, 3);
+}
+
+template <typename Arg1, typename Arg2, typename Arg3, typename Arg4>
+inline int LLBC_Logger::BOutput(int level, const char *tag, const char *file, int line, const char *fmt, const Arg1 &arg1, const Arg2 &arg2, const Arg3 &arg3, const Arg4 &arg4)
+{
+    if (level < _logLevel)
+        return LLBC_OK;
+
+    const LLBC_LogArg args[] = {LLBC_LogArg(arg1), LLBC_LogArg(arg2), LLBC_LogArg(arg3), LLBC_LogArg(arg4)};
+    return BinOutput(level, tag, file, line, fmt, args, 4);
+}
+
+template <typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5>
+inline int LLBC_Logger::BOutput(int level, const char *tag, const char *file, int line, const char *fmt, const Arg1 &arg1, const Arg2 &arg2, const Arg3 &arg3, const Arg4 &arg4, const Arg5 &arg5)
+{
+    if (level < _logLevel)
+        return LLBC_OK;
+
+    const LLBC_LogArg args[] = {LLBC_LogArg(arg1), LLBC_LogArg(arg2), LLBC_LogArg(arg3), LLBC_LogArg(arg4), LLBC_LogArg(arg5)};
+    return BinOutput(level, tag, file, line, fmt, args, 5);
+}
+
+template <typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5, typename Arg6>
+inline int LLBC_Logger::BOutput(int level, const char *tag, const char *file, int line, const char *fmt, const Arg1 &arg1, const Arg2 &arg2, const Arg3 &arg3, const Arg4 &arg4, const Arg5 &arg5, const Arg6 &arg6)
+{
+    if (level < _logLevel)
+        return LLBC_OK;
+
+    const LLBC_LogArg args[] = {LLBC_LogArg(arg1), LLBC_LogArg(arg2), LLBC_LogArg(arg3), LLBC_LogArg(arg4), LLBC_LogArg(arg5), LLBC_LogArg(arg6)};
+    return BinOutput(level, tag, file, line, fmt, args, 6);
+}
+
+template <typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5, typename Arg6, typename Arg7>
+inline int LLBC_Logger::BOutput(int level, const char *tag, const char *file, int line, const char *fmt, const Arg1 &arg1, const Arg2 &arg2, const Arg3 &arg3, const Arg4 &arg4, const Arg5 &arg5, const Arg6 &arg6, const Arg7 &arg7)
+{
+    if (level < _logLevel)
+        return LLBC_OK;
+
+    const LLBC_LogArg args[] = {LLBC_LogArg(arg1), LLBC_LogArg(arg2), LLBC_LogArg(arg3), LLBC_LogArg(arg4), LLBC_LogArg(arg5), LLBC_LogArg(arg6), LLBC_LogArg(arg7)};
+    return BinOutput(level, tag, file, line, fmt, args, 7);
+}
+
+template <typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5, typename Arg6, typename Arg7, typename Arg8>
+inline int LLBC_Logger::BOutput(int level, const char *tag, const char *file, int line, const char *fmt, const Arg1 &arg1, const Arg2 &arg2, const Arg3 &arg3, const Arg4 &arg4, const Arg5 &arg5, const Arg6 &arg6, const Arg7 &arg7, const Arg8 &arg8)
+{
+    if (level < _logLevel)
+        return LLBC_OK;
+
+    const LLBC_LogArg args[] = {LLBC_LogArg(arg1), LLBC_LogArg(arg2), LLBC_LogArg(arg3), LLBC_LogArg(arg4), LLBC_LogArg(arg5), LLBC_LogArg(arg6), LLBC_LogArg(arg7), LLBC_LogArg(arg8)};
+    return BinOutput(level, tag, file, line, fmt, args, 8);
+}
+
 __LLBC_NS_END
 
 #endif // __LLBC_CORE_LOG_LOGGER_H__
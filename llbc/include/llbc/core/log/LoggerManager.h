@@ -37,6 +37,7 @@ __LLBC_NS_BEGIN
  * Pre-declare some classes.
  */
 class LLBC_Logger;
+class LLBC_LogRunnable;
 class LLBC_LoggerConfigurator;
 
 __LLBC_NS_END
@@ -84,14 +85,65 @@ public:
      */
     LLBC_Logger *GetLogger(const LLBC_String &name) const;
 
+    /**
+     * Get logger by name, lock free version, use logger lookup table built when logger manager initialized.
+     * Note: Don't call this method when logger manager initializing or finalizing.
+     * @param[in] name - logger name.
+     * @return LLBC_Logger * - logger.
+     */
+    LLBC_Logger *GetLogger(const char *name) const;
+
+private:
+    /**
+     * Build logger lookup table, all loggers must be configured before call this method.
+     * @return int - the minimum log level of all loggers.
+     */
+    int BuildLookupTable();
+
+    /**
+     * Destroy logger lookup table.
+     */
+    void DestroyLookupTable();
+
+    /**
+     * Create shared log runnables, shared log thread count read from root logger config.
+     */
+    void CreateSharedLogRunnables();
+
+    /**
+     * Allocate shared log runnable for given logger, if logger is not asynchronous mode
+     * or shared log thread disabled, return NULL.
+     * @param[in] name - logger name.
+     * @return LLBC_LogRunnable * - the shared log runnable.
+     */
+    LLBC_LogRunnable *AllocSharedLogRunnable(const LLBC_String &name);
+
+    /**
+     * Stop and delete all shared log runnables, all queued log data will be output before runnable deleted.
+     */
+    void DestroySharedLogRunnables();
+
 private:
     LLBC_RecursiveLock _lock;
 
     LLBC_Logger *_root;
     std::map<LLBC_String, LLBC_Logger *> _loggers;
 
+    struct _LookupSlot
+    {
+        int hash;
+        const char *name;
+        LLBC_Logger *logger;
+    };
+    _LookupSlot * volatile _lookupTable;
+    size_t _lookupTableMask;
+    bool _rootTakeOver;
+
     LLBC_LoggerConfigurator *_configurator;
 
+    size_t _nextSharedLogRunnable;
+    std::vector<LLBC_LogRunnable *> _sharedLogRunnables;
+
     static LLBC_String _rootLoggerName;
 };
 
@@ -339,6 +391,91 @@ template class LLBC_EXPORT LLBC_Singleton<LLBC_LoggerManager>;
 
 #endif // LLBC_CFG_LOG_USING_WITH_STREAM
 
+/**
+ * Binary log(deferred formatting log) operations macro define.
+ * Only capture format string and arguments in caller thread, format operation will be done in log thread,
+ * format string must be static string, arguments type will be checked at compile time(see LLBC_LogArg).
+ */
+#define LLBC_DEBUG_BLOG(fmt, ...)                                                           \
+    LLBC_NS LLBC_LoggerManagerSingleton->GetRootLogger()->                                  \
+        BOutput(LLBC_NS LLBC_LogLevel::Debug, NULL, __FILE__, __LINE__, fmt, ##__VA_ARGS__) \
+
+#define LLBC_INFO_BLOG(fmt, ...)                                                           \
+    LLBC_NS LLBC_LoggerManagerSingleton->GetRootLogger()->                                 \
+        BOutput(LLBC_NS LLBC_LogLevel::Info, NULL, __FILE__, __LINE__, fmt, ##__VA_ARGS__) \
+
+#define LLBC_WARN_BLOG(fmt, ...)                                                           \
+    LLBC_NS LLBC_LoggerManagerSingleton->GetRootLogger()->                                 \
+        BOutput(LLBC_NS LLBC_LogLevel::Warn, NULL, __FILE__, __LINE__, fmt, ##__VA_ARGS__) \
+
+#define LLBC_ERROR_BLOG(fmt, ...)                                                           \
+    LLBC_NS LLBC_LoggerManagerSingleton->GetRootLogger()->                                  \
+        BOutput(LLBC_NS LLBC_LogLevel::Error, NULL, __FILE__, __LINE__, fmt, ##__VA_ARGS__) \
+
+#define LLBC_FATAL_BLOG(fmt, ...)                                                           \
+    LLBC_NS LLBC_LoggerManagerSingleton->GetRootLogger()->                                  \
+        BOutput(LLBC_NS LLBC_LogLevel::Fatal, NULL, __FILE__, __LINE__, fmt, ##__VA_ARGS__) \
+
+#define LLBC_DEBUG_BLOG2(tag, fmt, ...)                                                    \
+    LLBC_NS LLBC_LoggerManagerSingleton->GetRootLogger()->                                 \
+        BOutput(LLBC_NS LLBC_LogLevel::Debug, tag, __FILE__, __LINE__, fmt, ##__VA_ARGS__) \
+
+#define LLBC_INFO_BLOG2(tag, fmt, ...)                                                    \
+    LLBC_NS LLBC_LoggerManagerSingleton->GetRootLogger()->                                \
+        BOutput(LLBC_NS LLBC_LogLevel::Info, tag, __FILE__, __LINE__, fmt, ##__VA_ARGS__) \
+
+#define LLBC_WARN_BLOG2(tag, fmt, ...)                                                    \
+    LLBC_NS LLBC_LoggerManagerSingleton->GetRootLogger()->                                \
+        BOutput(LLBC_NS LLBC_LogLevel::Warn, tag, __FILE__, __LINE__, fmt, ##__VA_ARGS__) \
+
+#define LLBC_ERROR_BLOG2(tag, fmt, ...)                                                    \
+    LLBC_NS LLBC_LoggerManagerSingleton->GetRootLogger()->                                 \
+        BOutput(LLBC_NS LLBC_LogLevel::Error, tag, __FILE__, __LINE__, fmt, ##__VA_ARGS__) \
+
+#define LLBC_FATAL_BLOG2(tag, fmt, ...)                                                    \
+    LLBC_NS LLBC_LoggerManagerSingleton->GetRootLogger()->                                 \
+        BOutput(LLBC_NS LLBC_LogLevel::Fatal, tag, __FILE__, __LINE__, fmt, ##__VA_ARGS__) \
+
+#define LLBC_DEBUG_BLOG_SPEC(logger, fmt, ...)                                              \
+    LLBC_NS LLBC_LoggerManagerSingleton->GetLogger(logger)->                                \
+        BOutput(LLBC_NS LLBC_LogLevel::Debug, NULL, __FILE__, __LINE__, fmt, ##__VA_ARGS__) \
+
+#define LLBC_INFO_BLOG_SPEC(logger, fmt, ...)                                              \
+    LLBC_NS LLBC_LoggerManagerSingleton->GetLogger(logger)->                               \
+        BOutput(LLBC_NS LLBC_LogLevel::Info, NULL, __FILE__, __LINE__, fmt, ##__VA_ARGS__) \
+
+#define LLBC_WARN_BLOG_SPEC(logger, fmt, ...)                                              \
+    LLBC_NS LLBC_LoggerManagerSingleton->GetLogger(logger)->                               \
+        BOutput(LLBC_NS LLBC_LogLevel::Warn, NULL, __FILE__, __LINE__, fmt, ##__VA_ARGS__) \
+
+#define LLBC_ERROR_BLOG_SPEC(logger, fmt, ...)                                              \
+    LLBC_NS LLBC_LoggerManagerSingleton->GetLogger(logger)->                                \
+        BOutput(LLBC_NS LLBC_LogLevel::Error, NULL, __FILE__, __LINE__, fmt, ##__VA_ARGS__) \
+
+#define LLBC_FATAL_BLOG_SPEC(logger, fmt, ...)                                              \
+    LLBC_NS LLBC_LoggerManagerSingleton->GetLogger(logger)->                                \
+        BOutput(LLBC_NS LLBC_LogLevel::Fatal, NULL, __FILE__, __LINE__, fmt, ##__VA_ARGS__) \
+
+#define LLBC_DEBUG_BLOG_SPEC2(logger, tag, fmt, ...)                                       \
+    LLBC_NS LLBC_LoggerManagerSingleton->GetLogger(logger)->                               \
+        BOutput(LLBC_NS LLBC_LogLevel::Debug, tag, __FILE__, __LINE__, fmt, ##__VA_ARGS__) \
+
+#define LLBC_INFO_BLOG_SPEC2(logger, tag, fmt, ...)                                       \
+    LLBC_NS LLBC_LoggerManagerSingleton->GetLogger(logger)->                              \
+        BOutput(LLBC_NS LLBC_LogLevel::Info, tag, __FILE__, __LINE__, fmt, ##__VA_ARGS__) \
+
+#define LLBC_WARN_BLOG_SPEC2(logger, tag, fmt, ...)                                       \
+    LLBC_NS LLBC_LoggerManagerSingleton->GetLogger(logger)->                              \
+        BOutput(LLBC_NS LLBC_LogLevel::Warn, tag, __FILE__, __LINE__, fmt, ##__VA_ARGS__) \
+
+#define LLBC_ERROR_BLOG_SPEC2(logger, tag, fmt, ...)                                       \
+    LLBC_NS LLBC_LoggerManagerSingleton->GetLogger(logger)->                               \
+        BOutput(LLBC_NS LLBC_LogLevel::Error, tag, __FILE__, __LINE__, fmt, ##__VA_ARGS__) \
+
+#define LLBC_FATAL_BLOG_SPEC2(logger, tag, fmt, ...)                                       \
+    LLBC_NS LLBC_LoggerManagerSingleton->GetLogger(logger)->                               \
+        BOutput(LLBC_NS LLBC_LogLevel::Fatal, tag, __FILE__, __LINE__, fmt, ##__VA_ARGS__) \
+
 __LLBC_NS_END
 
 #endif // !__LLBC_CORE_LOG_LOGGER_MANAGER_H__
@@ -119,7 +119,7 @@ inline sint32 LLBC_AtomicFetchAndAdd(volatile sint32 *ptr, sint32 value)
 #endif
 }
 
-inline sint64 LLBC_AtomicFetchAndAdd(volatile sint64 *ptr, sint32 value)
+inline sint64 LLBC_AtomicFetchAndAdd(volatile sint64 *ptr, sint64 value)
 {
 #if LLBC_TARGET_PLATFORM_LINUX
     return __sync_fetch_and_add(ptr, value);
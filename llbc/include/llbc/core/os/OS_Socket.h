@@ -43,6 +43,12 @@ LLBC_EXTERN LLBC_EXPORT int LLBC_CleanupNetLibrary();
  */
 LLBC_EXTERN LLBC_EXPORT LLBC_SocketHandle LLBC_CreateTcpSocket();
 
+/**
+ * Create UDP socket.
+ * @return LLBC_SocketHandle - socket handle, if failed, return LLBC_INVALID_SOCKET_HANDLE.
+ */
+LLBC_EXTERN LLBC_EXPORT LLBC_SocketHandle LLBC_CreateUdpSocket();
+
 /**
  * Create overlapped TCP socket. WIN32 specific, If in any non-win32 platform 
  * call this API, will like LLBC_CreateTcpSocket().
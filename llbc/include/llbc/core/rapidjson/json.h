@@ -2,6 +2,7 @@
 #define JSON_RAPIDJSON_H_INCLUDED
 
 #include "llbc/common/Common.h"
+#include "llbc/core/variant/Variant.h"
 
 #include "llbc/core/rapidjson/reader.h"
 #include "llbc/core/rapidjson/writer.h"
@@ -35,6 +36,32 @@ typedef LLBC_JsonValue::ConstMemberIterator LLBC_JsonMemberCIter;
  */
 LLBC_EXTERN LLBC_EXPORT void LLBC_JsonToString(const LLBC_JsonValue &value, LLBC_String &outStr, bool isPretty = false);
 
+/**
+ * Parse json string to LLBC_Variant directly(SAX parse, no intermediate json document).
+ *  - object:               dictionary(or hash dictionary if hashDict is true)
+ *  - array:                sequence
+ *  - string:               string
+ *  - integer/float number: int64(uint64 if out of int64 range)/double
+ *  - true/false:           bool
+ *  - null:                 nil
+ * @param[in] json      - the json string, not required null-terminated.
+ * @param[in] len       - the json string length.
+ * @param[out] var      - the parsed variant, set to nil if failed.
+ * @param[in] hashDict  - parse json object to hash dictionary or not, default is false.
+ * @return int - return 0 if success, otherwise return -1.
+ */
+LLBC_EXTERN LLBC_EXPORT int LLBC_JsonToVariant(const char *json, size_t len, LLBC_Variant &var, bool hashDict = false);
+LLBC_EXTERN LLBC_EXPORT int LLBC_JsonToVariant(const LLBC_String &json, LLBC_Variant &var, bool hashDict = false);
+
+/**
+ * Serialize LLBC_Variant to json string directly(no intermediate json document).
+ * non-string dictionary key will convert to string representation, NaN/Inf convert to null.
+ * @param[in] var       - the variant.
+ * @param[out] outStr   - output string, cleared before output, allocated memory reused.
+ * @param[in] isPretty  - when it is true, then json output a pretty string.
+ */
+LLBC_EXTERN LLBC_EXPORT void LLBC_VariantToJson(const LLBC_Variant &var, LLBC_String &outStr, bool isPretty = false);
+
 /**
  * LLBC_JsonValue output to stream operator function(in global ns).
  */
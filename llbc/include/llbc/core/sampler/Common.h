@@ -27,6 +27,8 @@
 #include "llbc/core/sampler/CountSampler.h"
 #include "llbc/core/sampler/IntervalSampler.h"
 #include "llbc/core/sampler/LimitSampler.h"
+#include "llbc/core/sampler/RateLimitSampler.h"
+#include "llbc/core/sampler/ProbabilitySampler.h"
 
 #include "llbc/core/sampler/SamplerGroup.h"
 
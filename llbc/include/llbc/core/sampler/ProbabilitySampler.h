@@ -0,0 +1,99 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef __LLBC_CORE_SAMPLER_PROBABILITY_SAMPLER_H__
+#define __LLBC_CORE_SAMPLER_PROBABILITY_SAMPLER_H__
+
+#include "llbc/common/Common.h"
+
+#include "llbc/core/random/Random.h"
+#include "llbc/core/sampler/BaseSampler.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The probability type sampler class encapsulation.
+ *        Every sampling will be accepted with given probability, otherwise will be suppressed.
+ */
+class LLBC_EXPORT LLBC_ProbabilitySampler : public LLBC_BaseSampler
+{
+    typedef LLBC_BaseSampler _Base;
+
+public:
+    LLBC_ProbabilitySampler();
+    virtual ~LLBC_ProbabilitySampler();
+
+public:
+    /**
+     * Get sampler type.
+     * @return int - sampler type.
+     */
+    virtual int GetType() const;
+
+    /**
+     * Reset sampler.
+     */
+    virtual void Reset();
+
+public:
+    /**
+     * Set accept probability.
+     * @param[in] probability - the accept probability, will be limited to [0.0, 1.0].
+     */
+    void SetProbability(double probability);
+
+    /**
+     * Get accept probability.
+     * @return double - the accept probability.
+     */
+    double GetProbability() const;
+
+public:
+    /**
+     * Sampling function.
+     * @param[in] value   - increment value.
+      *@param[in] appData - current time sampling value.
+     * @return int - return 0 if accepted, if suppressed, return -1, and last error set to LLBC_ERROR_LIMIT.
+     */
+    virtual int Sampling(sint64 value, void *appData = NULL);
+
+public:
+    /**
+     * Get suppressed sampling times.
+     * @return sint64 - suppressed sampling times.
+     */
+    sint64 GetSuppressedTimes() const;
+
+    /**
+     * Clear suppressed sampling times.
+     */
+    void ClearSuppressedTimes();
+
+private:
+    double _probability;
+    LLBC_Random _random;
+
+    sint64 _suppressedTimes;
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_CORE_SAMPLER_PROBABILITY_SAMPLER_H__
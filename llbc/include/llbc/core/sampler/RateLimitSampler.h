@@ -0,0 +1,109 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef __LLBC_CORE_SAMPLER_RATE_LIMIT_SAMPLER_H__
+#define __LLBC_CORE_SAMPLER_RATE_LIMIT_SAMPLER_H__
+
+#include "llbc/common/Common.h"
+
+#include "llbc/core/sampler/BaseSampler.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The rate limit type sampler class encapsulation(token bucket algorithm).
+ *        Every sampling consume <value> tokens, tokens refill at <rate> per second, bucket
+ *        can hold at most <burst> tokens, if tokens not enough, sampling will be suppressed.
+ */
+class LLBC_EXPORT LLBC_RateLimitSampler : public LLBC_BaseSampler
+{
+    typedef LLBC_BaseSampler _Base;
+
+public:
+    LLBC_RateLimitSampler();
+    virtual ~LLBC_RateLimitSampler();
+
+public:
+    /**
+     * Get sampler type.
+     * @return int - sampler type.
+     */
+    virtual int GetType() const;
+
+    /**
+     * Reset sampler.
+     */
+    virtual void Reset();
+
+public:
+    /**
+     * Set rate limit.
+     * @param[in] rate  - the rate limit, per second, if <= 0, means no limit.
+     * @param[in] burst - the max burst value, if <= 0, use rate as burst.
+     */
+    void SetLimit(sint64 rate, sint64 burst = 0);
+
+    /**
+     * Get rate limit.
+     * @return sint64 - the rate limit, per second.
+     */
+    sint64 GetRate() const;
+
+    /**
+     * Get max burst value.
+     * @return sint64 - the max burst value.
+     */
+    sint64 GetBurst() const;
+
+public:
+    /**
+     * Sampling function.
+     * @param[in] value   - increment value.
+      *@param[in] appData - current time sampling value.
+     * @return int - return 0 if success, if rate limit exceeded, return -1, and last error set to LLBC_ERROR_LIMIT.
+     */
+    virtual int Sampling(sint64 value, void *appData = NULL);
+
+public:
+    /**
+     * Get suppressed sampling times.
+     * @return sint64 - suppressed sampling times.
+     */
+    sint64 GetSuppressedTimes() const;
+
+    /**
+     * Clear suppressed sampling times.
+     */
+    void ClearSuppressedTimes();
+
+private:
+    sint64 _rate;
+    sint64 _burst;
+
+    sint64 _tokens; // In 1/1000 token.
+    sint64 _lastRefillTime;
+
+    sint64 _suppressedTimes;
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_CORE_SAMPLER_RATE_LIMIT_SAMPLER_H__
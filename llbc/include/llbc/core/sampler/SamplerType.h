@@ -39,6 +39,8 @@ public:
         CountSampler = Begin,
         IntervalSampler,
         LimitSampler,
+        RateLimitSampler,
+        ProbabilitySampler,
 
         End
     };
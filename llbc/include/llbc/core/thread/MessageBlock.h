@@ -43,6 +43,8 @@ __LLBC_NS_BEGIN
  */
 class LLBC_EXPORT LLBC_MessageBlock
 {
+    LLBC_ALLOCATOR_CLASS_OPS(LLBC_MemoryTag::MsgBlock)
+
 public:
     static const size_t npos = -1;
 
@@ -55,10 +57,12 @@ public:
 
     /**
      * Init and construct message block using external buffer.
-     * @param[in] buf  - buffer.
-     * @param[in] size - buffer size.
+     * @param[in] buf    - buffer.
+     * @param[in] size   - buffer size.
+     * @param[in] attach - attach flag, if false, message block will take over the buffer(must allocated by
+     *                     LLBC_Malloc/LLBC_Realloc, like LLBC_Stream buffer/segments), default is true.
      */
-    LLBC_MessageBlock(void *buf, size_t size);
+    LLBC_MessageBlock(void *buf, size_t size, bool attach = true);
 
     /**
      * Destructor.
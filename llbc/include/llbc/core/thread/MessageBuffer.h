@@ -93,6 +93,15 @@ public:
      */
     int Append(LLBC_MessageBlock *block);
 
+    /**
+     * Append stream data to buffer, stream buffer/segments will be taken over as message blocks(no copy),
+     * after appended, stream will be empty.
+     * Note: Attach attribute's stream data will be copied.
+     * @param[in] stream - the stream.
+     * @return int - return 0 if not error occurred, otherwise return -1.
+     */
+    int Append(LLBC_Stream &stream);
+
     /**
      * Remove specific length's data.
      * @param[in] length - length.
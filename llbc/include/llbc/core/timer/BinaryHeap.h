@@ -26,13 +26,24 @@
 
 __LLBC_NS_BEGIN
 
+/**
+ * \brief The binary heap default element index tracker, do nothing.
+ *        If you want to know element's heap index(use to DeleteElem()/UpdateElem() in O(logn)),
+ *        implement your tracker like this, index 0 means element not in heap.
+ */
+template <typename T>
+struct LLBC_BinaryHeapNullIndexTracker
+{
+    static void SetIndex(T &elem, size_t index) {  }
+};
+
 /**
  * \brief The binary heap template class encapsulation.
  */
-template <typename T, typename Comp = std::less<T> >
+template <typename T, typename Comp = std::less<T>, typename IndexTracker = LLBC_BinaryHeapNullIndexTracker<T> >
 class LLBC_BinaryHeap
 {
-    typedef LLBC_BinaryHeap<T, Comp> _This;
+    typedef LLBC_BinaryHeap<T, Comp, IndexTracker> _This;
 
 public:
     typedef std::vector<T> Container;
@@ -76,7 +87,7 @@ public:
     int DeleteTop(T &elem);
 
     /**
-     * Delete specific index's heap element.
+     * Delete specific index's heap element, O(logn).
      * @param[in] index - heap index.
      * @return int - return 0 if success, otherwise return -1.
      */
@@ -96,6 +107,13 @@ public:
      */
     int DeleteElem(size_t index, T &elem);
 
+    /**
+     * Update specific index's heap element position, call it after element key changed(increase/decrease key), O(logn).
+     * @param[in] index - heap index.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int UpdateElem(size_t index);
+
     /**
      * Cleanup heap.
      */
@@ -141,6 +159,20 @@ private:
      */
     void PercolateDown(int index);
 
+    /**
+     * Percolate heap element up.
+     * @param[in] index - index.
+     * @return size_t - the element final index.
+     */
+    size_t PercolateUp(size_t index);
+
+    /**
+     * Place element to specific index, and update element index.
+     * @param[in] index - index.
+     * @param[in] elem  - element.
+     */
+    void PlaceElem(size_t index, const T &elem);
+
 private:
     Comp _comp;
 
@@ -23,42 +23,42 @@
 
 __LLBC_NS_BEGIN
 
-template <typename T, typename Comp>
-LLBC_BinaryHeap<T, Comp>::LLBC_BinaryHeap(size_t capacity)
+template <typename T, typename Comp, typename IndexTracker>
+LLBC_BinaryHeap<T, Comp, IndexTracker>::LLBC_BinaryHeap(size_t capacity)
 {
     _size = 0;
     _elems.resize(capacity > 1 ? capacity : 1);
 }
 
-template <typename T, typename Comp>
-LLBC_BinaryHeap<T, Comp>::LLBC_BinaryHeap(const typename LLBC_BinaryHeap<T, Comp>::Container &elems)
+template <typename T, typename Comp, typename IndexTracker>
+LLBC_BinaryHeap<T, Comp, IndexTracker>::LLBC_BinaryHeap(const typename LLBC_BinaryHeap<T, Comp, IndexTracker>::Container &elems)
 {
     _size = elems.size();
     _elems.resize(elems.size() + 1);
 
     for (size_t i = 0; i < _size; ++i)
     {
-        _elems[i + 1] = elems[i];
+        this->PlaceElem(i + 1, elems[i]);
     }
 
     this->BuildHeap();
 }
 
-template <typename T, typename Comp>
-LLBC_BinaryHeap<T, Comp>::LLBC_BinaryHeap(const LLBC_BinaryHeap<T, Comp> &other)
+template <typename T, typename Comp, typename IndexTracker>
+LLBC_BinaryHeap<T, Comp, IndexTracker>::LLBC_BinaryHeap(const LLBC_BinaryHeap<T, Comp, IndexTracker> &other)
 {
     this->_size = other._size;
     this->_elems.insert(this->_elems.begin(), other._elems.begin(), other._elems.end());
 }
 
-template <typename T, typename Comp>
-inline bool LLBC_BinaryHeap<T, Comp>::IsEmpty() const
+template <typename T, typename Comp, typename IndexTracker>
+inline bool LLBC_BinaryHeap<T, Comp, IndexTracker>::IsEmpty() const
 {
     return _size == 0 ? true : false;
 }
 
-template <typename T, typename Comp>
-int LLBC_BinaryHeap<T, Comp>::FindTop(T &elem) const
+template <typename T, typename Comp, typename IndexTracker>
+int LLBC_BinaryHeap<T, Comp, IndexTracker>::FindTop(T &elem) const
 {
     if (this->IsEmpty())
     {
@@ -70,8 +70,8 @@ int LLBC_BinaryHeap<T, Comp>::FindTop(T &elem) const
     return LLBC_OK;
 }
 
-template <typename T, typename Comp>
-void LLBC_BinaryHeap<T, Comp>::Insert(const T &elem)
+template <typename T, typename Comp, typename IndexTracker>
+void LLBC_BinaryHeap<T, Comp, IndexTracker>::Insert(const T &elem)
 {
     size_t size = _elems.size();
     if (_size == size - 1)
@@ -83,56 +83,47 @@ void LLBC_BinaryHeap<T, Comp>::Insert(const T &elem)
     size_t parentPos = pos / 2;
     for (; pos > 1 && _comp(elem, _elems[parentPos]); pos = parentPos, parentPos /= 2)
     {
-        _elems[pos] = _elems[parentPos];
+        this->PlaceElem(pos, _elems[parentPos]);
     }
 
-    _elems[pos] = elem;
+    this->PlaceElem(pos, elem);
 }
 
-template <typename T, typename Comp>
-int LLBC_BinaryHeap<T, Comp>::DeleteTop()
+template <typename T, typename Comp, typename IndexTracker>
+int LLBC_BinaryHeap<T, Comp, IndexTracker>::DeleteTop()
 {
-    if (this->IsEmpty())
-    {
-        LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
-        return LLBC_FAILED;
-    }
-
-    if (_size != 1)
-    {
-        _elems[1] = _elems[_size];
-    }
-
-    _elems[_size--] = T();
+    T elem;
+    return this->DeleteElem(1, elem);
+}
 
-    this->PercolateDown(1);
+template <typename T, typename Comp, typename IndexTracker>
+int LLBC_BinaryHeap<T, Comp, IndexTracker>::DeleteTop(T &elem)
+{
+    return this->DeleteElem(1, elem);
+}
 
-    return LLBC_OK;
+template <typename T, typename Comp, typename IndexTracker>
+int LLBC_BinaryHeap<T, Comp, IndexTracker>::DeleteElem(size_t index)
+{
+    T elem;
+    return this->DeleteElem(index, elem);
 }
 
-template <typename T, typename Comp>
-int LLBC_BinaryHeap<T, Comp>::DeleteTop(T &elem)
+template<typename T, typename Comp, typename IndexTracker>
+int LLBC_BinaryHeap<T, Comp, IndexTracker>::DeleteElem(const T &elem)
 {
-    if (this->IsEmpty())
+    for (size_t i = 1; i <= _size; ++i)
     {
-        LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
-        return LLBC_FAILED;
+        if (_elems[i] == elem)
+            return this->DeleteElem(i);
     }
 
-    elem = _elems[1];
-
-    if (_size != 1)
-        _elems[1] = _elems[_size];
-
-    _elems[_size--] = T();
-
-    this->PercolateDown(1);
-
-    return LLBC_OK;
+    LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
+    return LLBC_FAILED;
 }
 
-template <typename T, typename Comp>
-int LLBC_BinaryHeap<T, Comp>::DeleteElem(size_t index)
+template <typename T, typename Comp, typename IndexTracker>
+int LLBC_BinaryHeap<T, Comp, IndexTracker>::DeleteElem(size_t index, T &elem)
 {
     if (this->IsEmpty())
     {
@@ -140,106 +131,95 @@ int LLBC_BinaryHeap<T, Comp>::DeleteElem(size_t index)
         return LLBC_FAILED;
     }
 
-    if (index <= 0 || index > static_cast<int>(_size))
+    if (index <= 0 || index > _size)
     {
         LLBC_SetLastError(LLBC_ERROR_RANGE);
         return LLBC_FAILED;
     }
 
-    for (size_t i = index; i < _size; ++i)
-        _elems[i] = _elems[i + 1];
-
-    _size -= 1;
-
-    this->BuildHeap();
+    elem = _elems[index];
+    IndexTracker::SetIndex(elem, 0);
 
-    return LLBC_OK;
-}
+    // Move the last element to the hole, and percolate it up or down.
+    if (index != _size)
+    {
+        this->PlaceElem(index, _elems[_size]);
+        _elems[_size--] = T();
 
-template<typename T, typename Comp>
-int LLBC_BinaryHeap<T, Comp>::DeleteElem(const T &elem)
-{
-    for (size_t i = 1; i <= _size; ++i)
+        if (this->PercolateUp(index) == index)
+            this->PercolateDown(static_cast<int>(index));
+    }
+    else
     {
-        if (_elems[i] == elem)
-            return this->DeleteElem(i);
+        _elems[_size--] = T();
     }
 
-    LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
-    return LLBC_FAILED;
+    return LLBC_OK;
 }
 
-template <typename T, typename Comp>
-int LLBC_BinaryHeap<T, Comp>::DeleteElem(size_t index, T &elem)
+template <typename T, typename Comp, typename IndexTracker>
+int LLBC_BinaryHeap<T, Comp, IndexTracker>::UpdateElem(size_t index)
 {
-    if (this->IsEmpty())
-    {
-        LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
-        return LLBC_FAILED;
-    }
-
     if (index <= 0 || index > _size)
     {
         LLBC_SetLastError(LLBC_ERROR_RANGE);
         return LLBC_FAILED;
     }
 
-    elem = _elems[index];
-    for (size_t i = index; i < _size; ++i)
-        _elems[i] = _elems[i + 1];
-
-    _size -= 1;
-
-    this->BuildHeap();
+    if (this->PercolateUp(index) == index)
+        this->PercolateDown(static_cast<int>(index));
 
     return LLBC_OK;
 }
 
-template <typename T, typename Comp>
-void LLBC_BinaryHeap<T, Comp>::MakeEmpty()
+template <typename T, typename Comp, typename IndexTracker>
+void LLBC_BinaryHeap<T, Comp, IndexTracker>::MakeEmpty()
 {
+    for (size_t i = 1; i <= _size; ++i)
+        IndexTracker::SetIndex(_elems[i], 0);
+
     _size = 0;
     _elems.resize(1);
 }
 
-template <typename T, typename Comp>
-size_t LLBC_BinaryHeap<T, Comp>::GetSize() const
+template <typename T, typename Comp, typename IndexTracker>
+size_t LLBC_BinaryHeap<T, Comp, IndexTracker>::GetSize() const
 {
     return _size;
 }
 
-template <typename T, typename Comp>
-const typename LLBC_BinaryHeap<T, Comp>::Container &LLBC_BinaryHeap<T, Comp>::GetData() const
+template <typename T, typename Comp, typename IndexTracker>
+const typename LLBC_BinaryHeap<T, Comp, IndexTracker>::Container &LLBC_BinaryHeap<T, Comp, IndexTracker>::GetData() const
 {
     return _elems;
 }
 
-template <typename T, typename Comp>
-typename LLBC_BinaryHeap<T, Comp>::_This &LLBC_BinaryHeap<
-    T, Comp>::operator =(const typename LLBC_BinaryHeap<T, Comp>::_This &right)
+template <typename T, typename Comp, typename IndexTracker>
+typename LLBC_BinaryHeap<T, Comp, IndexTracker>::_This &LLBC_BinaryHeap<
+    T, Comp, IndexTracker>::operator =(const typename LLBC_BinaryHeap<T, Comp, IndexTracker>::_This &right)
 {
     this->MakeEmpty();
 
     this->_size = right._size;
-    this->_elems.assign(right.begin(), right.end());
+    this->_elems.assign(right._elems.begin(), right._elems.end());
 
     return *this;
 }
 
-template <typename T, typename Comp>
-inline LLBC_BinaryHeap<T, Comp>::operator bool() const
+template <typename T, typename Comp, typename IndexTracker>
+inline LLBC_BinaryHeap<T, Comp, IndexTracker>::operator bool() const
 {
     return !this->IsEmpty();
 }
 
-template <typename T, typename Comp>
-inline bool LLBC_BinaryHeap<T, Comp>::operator !() const
+template <typename T, typename Comp, typename IndexTracker>
+inline bool LLBC_BinaryHeap<T, Comp, IndexTracker>::operator !() const
 {
     return this->IsEmpty();
 }
 
-template <typename T, typename Comp>
-void LLBC_BinaryHeap<T, Comp>::BuildHeap()
+template <typename T, typename Comp, typename IndexTracker>
+void LLBC_BinaryHeap<T, Comp, IndexTracker>::BuildHeap()
 {
     for (size_t i = _size / 2; i > 0; --i)
     {
@@ -247,8 +227,8 @@ void LLBC_BinaryHeap<T, Comp>::BuildHeap()
     }
 }
 
-template <typename T, typename Comp>
-void LLBC_BinaryHeap<T, Comp>::PercolateDown(int index)
+template <typename T, typename Comp, typename IndexTracker>
+void LLBC_BinaryHeap<T, Comp, IndexTracker>::PercolateDown(int index)
 {
     int child;
     T elem = _elems[index];
@@ -262,7 +242,7 @@ void LLBC_BinaryHeap<T, Comp>::PercolateDown(int index)
 
         if (_comp(_elems[child], elem))
         {
-            _elems[index] = _elems[child];
+            this->PlaceElem(index, _elems[child]);
         }
         else
         {
@@ -270,7 +250,29 @@ void LLBC_BinaryHeap<T, Comp>::PercolateDown(int index)
         }
     }
 
+    this->PlaceElem(index, elem);
+}
+
+template <typename T, typename Comp, typename IndexTracker>
+size_t LLBC_BinaryHeap<T, Comp, IndexTracker>::PercolateUp(size_t index)
+{
+    T elem = _elems[index];
+    size_t parentPos = index / 2;
+    for (; index > 1 && _comp(elem, _elems[parentPos]); index = parentPos, parentPos /= 2)
+    {
+        this->PlaceElem(index, _elems[parentPos]);
+    }
+
+    this->PlaceElem(index, elem);
+
+    return index;
+}
+
+template <typename T, typename Comp, typename IndexTracker>
+inline void LLBC_BinaryHeap<T, Comp, IndexTracker>::PlaceElem(size_t index, const T &elem)
+{
     _elems[index] = elem;
+    IndexTracker::SetIndex(_elems[index], index);
 }
 
 __LLBC_NS_END
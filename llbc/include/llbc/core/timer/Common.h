@@ -24,5 +24,6 @@
 
 #include "llbc/core/timer/Timer.h"
 #include "llbc/core/timer/TimerScheduler.h"
+#include "llbc/core/timer/TimerSchedulerStat.h"
 
 #endif // !__LLBC_CORE_TIMER_COMMON_H__
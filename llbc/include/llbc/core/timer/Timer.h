@@ -102,6 +102,36 @@ public:
     void SetCancelHandler(ObjectType *object, void (ObjectType::*cancelMeth)(LLBC_Timer *));
     void SetCancelHandler(LLBC_IDelegate1<void, LLBC_Timer *> *cancelDeleg);
 
+public:
+    /**
+     * Get timer slack.
+     * @return uint64 - timer slack, in milli-seconds.
+     */
+    uint64 GetSlack() const;
+
+    /**
+     * Set timer slack, scheduler may delay timer timeout at most <slack> milli-seconds,
+     * to coalesce timers timeout at the same time, take effect at next Schedule().
+     * @param[in] slack - timer slack, in milli-seconds, 0 means no slack(default).
+     */
+    void SetSlack(uint64 slack);
+
+    /**
+     * Get timer batch group.
+     * @return int - timer batch group.
+     */
+    int GetBatchGroup() const;
+
+    /**
+     * Set timer batch group, the same batch group timers timeout in the same scheduler Update() 
+     * will be fired through scheduler batch timeout handler in one call(see 
+     * LLBC_TimerScheduler::SetBatchTimeoutHandler()), take effect at next Schedule().
+     * Note: 
+     *      If scheduler not set the batch group timeout handler, OnTimeout() will be called.
+     * @param[in] batchGroup - the batch group, 0 means not batch(default).
+     */
+    void SetBatchGroup(int batchGroup);
+
 public:
     /**
      * Get timer data.
@@ -197,6 +227,9 @@ private:
     Scheduler *_scheduler;
     LLBC_TimerData *_timerData;
 
+    uint64 _slack;
+    int _batchGroup;
+
     LLBC_Variant *_data;
     LLBC_IDelegate1<void, LLBC_Timer *> *_timeoutDeleg;
     LLBC_IDelegate1<void, LLBC_Timer *> *_cancelDeleg;
@@ -37,8 +37,12 @@ __LLBC_NS_BEGIN
  */
 struct LLBC_HIDDEN LLBC_TimerData
 {
+    LLBC_ALLOCATOR_CLASS_OPS(LLBC_MemoryTag::Timer)
+
     // Timer handle, use to build timer heap.
     uint64 handle;
+    // Timer handle before apply slack.
+    uint64 nominalHandle;
 
     // Timer Id.
     LLBC_TimerId timerId;
@@ -51,6 +55,11 @@ struct LLBC_HIDDEN LLBC_TimerData
     // Repeat times.
     uint64 repeatTimes;
 
+    // Slack.
+    uint64 slack;
+    // Batch group.
+    int batchGroup;
+
     // timer object.
     LLBC_Timer *timer;
 
@@ -63,6 +72,24 @@ struct LLBC_HIDDEN LLBC_TimerData
 
     // ref count.
     uint8 refCount;
+
+    // Timing wheel slot list links(only used in timing wheel scheduler).
+    LLBC_TimerData *next;
+    LLBC_TimerData **pprev;
+
+    // Binary heap index, 0 means not in heap(only used in binary heap scheduler).
+    size_t heapIndex;
+};
+
+/**
+ * \brief The timer data binary heap index tracker.
+ */
+struct LLBC_HIDDEN LLBC_TimerDataHeapIndexTracker
+{
+    static void SetIndex(LLBC_TimerData *&data, size_t index)
+    {
+        data->heapIndex = index;
+    }
 };
 
 __LLBC_NS_END
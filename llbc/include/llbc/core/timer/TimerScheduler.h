@@ -24,17 +24,56 @@
 
 #include "llbc/common/Common.h"
 
+#include "llbc/core/utils/Util_DelegateImpl.h"
 #include "llbc/core/timer/BinaryHeap.h"
+#include "llbc/core/timer/TimerSchedulerStat.h"
 
 __LLBC_NS_BEGIN
 
 class LLBC_Timer;
 struct LLBC_TimerData;
+struct LLBC_TimerDataHeapIndexTracker;
+class LLBC_TimingWheel;
 
 __LLBC_NS_END
 
 __LLBC_NS_BEGIN
 
+/**
+ * \brief The timer scheduler type class encapsulation.
+ */
+class LLBC_EXPORT LLBC_TimerSchedulerType
+{
+public:
+    /**
+     * Scheduler type enumeration.
+     */
+    enum
+    {
+        Begin,
+
+        BinaryHeap = Begin, // Binary heap, schedule/cancel: O(logn).
+        TimingWheel,        // Hierarchical timing wheel, schedule/cancel: O(1).
+
+        End
+    };
+
+public:
+    /**
+     * Get specific scheduler type string describe.
+     * @param[in] type - the scheduler type.
+     * @return const LLBC_String & - the type describe.
+     */
+    static const LLBC_String &GetTypeDesc(int type);
+
+    /**
+     * Check giving scheduler type is legal or not.
+     * @param[in] type - the scheduler type.
+     * @return bool - return true if legal, otherwise return false.
+     */
+    static bool IsLegal(int type);
+};
+
 /**
  * \brief The timer scheduler class encapsulation.
  */
@@ -42,10 +81,17 @@ class LLBC_EXPORT LLBC_TimerScheduler
 {
     typedef LLBC_TimerScheduler _This;
 
-    typedef LLBC_BinaryHeap<LLBC_TimerData *> _Heap;
+    typedef LLBC_BinaryHeap<LLBC_TimerData *, 
+                            std::less<LLBC_TimerData *>,
+                            LLBC_TimerDataHeapIndexTracker> _Heap;
 
 public:
-    LLBC_TimerScheduler();
+    /**
+     * Constructor.
+     * @param[in] type - the scheduler type, see LLBC_TimerSchedulerType, 
+     *                   if is illegal, will use LLBC_TimerSchedulerType::BinaryHeap.
+     */
+    explicit LLBC_TimerScheduler(int type = LLBC_CFG_CORE_TIMER_DEFAULT_SCHEDULER_TYPE);
     virtual ~LLBC_TimerScheduler();
 
 public:
@@ -97,12 +143,77 @@ public:
      */
     void SetEnabled(bool enabled);
 
+    /**
+     * Get timer scheduler type.
+     * @return int - the scheduler type, see LLBC_TimerSchedulerType.
+     */
+    int GetSchedulerType() const;
+
     /**
      * Get timer count in this scheduler.
      * @return size_t - the timer count.
      */
     size_t GetTimerCount() const;
 
+    /**
+     * Stat timer scheduler, O(n).
+     * @param[out] stat - the timer scheduler statistic info.
+     */
+    void Stat(LLBC_TimerSchedulerStat &stat) const;
+
+public:
+    /**
+     * Set batch group timeout handler, when the batch group timers timeout in the same Update(),
+     * will call this handler once with all timeout timers(in contiguous memory), instead of
+     * call every timer's OnTimeout().
+     * Note:
+     *      - After handler called, the timers will be rescheduled by it's period, unless
+     *        Cancel()/Schedule() called in handler.
+     *      - The timers cancelled(or deleted) before handler called will not pass to handler,
+     *        if all timers cancelled, handler will not be called.
+     *      - Strict schedule(LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE) not apply to batch group timers.
+     * @param[in] batchGroup - the batch group, must be > 0.
+     * @param[in] handler    - the batch timeout handler, if is NULL, will remove the batch group handler,
+     *                         scheduler will take over handler.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SetBatchTimeoutHandler(int batchGroup, LLBC_IDelegate1<void, const std::vector<LLBC_Timer *> &> *handler);
+
+public:
+    /**
+     * Check timer scheduler instrument is enabled or not.
+     * @return bool - the instrument enabled flag.
+     */
+    bool IsInstrumentEnabled() const;
+
+    /**
+     * Set timer scheduler instrument enabled flag, when enabled, scheduler will record 
+     * timers fire lateness histogram, timeout handlers cost histogram, per timer class(timeout
+     * handler type) cost and Update() cost, disabled by default.
+     * Note: Disable instrument will drop all recorded instrument infos.
+     * @param[in] enabled - the instrument enabled flag.
+     */
+    void SetInstrumentEnabled(bool enabled);
+
+    /**
+     * Set instrument log interval, when instrument enabled and interval reached, scheduler will
+     * log the instrument statistic info to root logger(tag: TimerScheduler) and reset it.
+     * @param[in] interval - the log interval, in milli-seconds, 0 means not log(default).
+     */
+    void SetInstrumentLogInterval(uint64 interval);
+
+    /**
+     * Get instrument statistic info.
+     * @param[out] stat - the instrument statistic info.
+     * @return int - return 0 if success, otherwise return -1(instrument not enabled).
+     */
+    int InstrumentStat(LLBC_TimerInstrumentStat &stat) const;
+
+    /**
+     * Reset instrument statistic info.
+     */
+    void ResetInstrumentStat();
+
 public:
     /**
      * Cancel all timers.
@@ -137,6 +248,61 @@ private:
      */
     virtual int Cancel(LLBC_Timer *timer);
 
+private:
+    /**
+     * Process timeout timer data, after processed, will reschedule or release it.
+     * @param[in] data - the timeout timer data.
+     * @param[in] now  - the current time, in milli-seconds.
+     */
+    void ProcessTimeout(LLBC_TimerData *data, uint64 now);
+
+    /**
+     * Try add timeout timer data to it's batch group, if timer not batch or batch group handler not set, do nothing.
+     * @param[in] data - the timeout timer data.
+     * @param[in] now  - the current time, in milli-seconds.
+     * @return bool - return true if added to batch group, otherwise return false.
+     */
+    bool AddBatchTimeout(LLBC_TimerData *data, uint64 now);
+
+    /**
+     * Fire all batch groups timeout timers, after fired, will reschedule or release them.
+     * @param[in] now - the current time, in milli-seconds.
+     */
+    void ProcessBatchTimeouts(uint64 now);
+
+    /**
+     * Reschedule the timeout timer data by it's period.
+     * @param[in] data - the timeout timer data.
+     * @param[in] now  - the current time, in milli-seconds.
+     */
+    void Reschedule(LLBC_TimerData *data, uint64 now);
+
+    /**
+     * Release the timeout timer data(cancelled or rescheduled in timeout handler).
+     * @param[in] data - the timeout timer data.
+     */
+    void ReleaseTimeout(LLBC_TimerData *data);
+
+    /**
+     * Record timeout handler instrument info.
+     * @param[in] timerClass - the timer class(timeout handler raw type name).
+     * @param[in] cost       - the timeout handler cost, in micro-seconds.
+     */
+    void RecordCallbackCost(const char *timerClass, uint64 cost);
+
+    /**
+     * Record Update() instrument info, and log instrument statistic info if need.
+     * @param[in] now  - the Update() begin time, in milli-seconds.
+     * @param[in] cost - the Update() cost, in micro-seconds.
+     */
+    void RecordUpdateCost(uint64 now, uint64 cost);
+
+    /**
+     * Get all scheduling timer datas(included invalidate timer datas).
+     * @param[out] datas - the timer datas.
+     */
+    void GetAllTimerDatas(std::vector<LLBC_TimerData *> &datas) const;
+
 private:
     LLBC_DISABLE_ASSIGNMENT(LLBC_TimerScheduler);
 
@@ -145,7 +311,32 @@ private:
     bool _enabled;
     bool _destroyed;
 
+    int _type;
     _Heap _heap;
+    LLBC_TimingWheel *_wheel;
+
+    uint64 _timerDataAllocTimes;
+    uint64 _timerDataReuseTimes;
+
+    struct _BatchGroup
+    {
+        _BatchGroup(): handler(NULL), firingHandler(NULL), firingHandlerReplaced(false) {  }
+
+        LLBC_IDelegate1<void, const std::vector<LLBC_Timer *> &> *handler;
+        // The invoking handler, if replaced when invoking, delete it after invoke returned.
+        LLBC_IDelegate1<void, const std::vector<LLBC_Timer *> &> *firingHandler;
+        bool firingHandlerReplaced;
+        std::vector<LLBC_Timer *> timers;
+        std::vector<LLBC_TimerData *> datas;
+    };
+
+    std::map<int, _BatchGroup> _batchGroups;
+    std::vector<_BatchGroup *> _timeoutBatchGroups;
+
+    LLBC_TimerInstrumentStat *_instrument;
+    std::map<const char *, LLBC_TimerClassStat> _instrumentClasses;
+    uint64 _instrumentLogInterval;
+    uint64 _instrumentLogTime;
 };
 
 __LLBC_NS_END
@@ -0,0 +1,174 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef __LLBC_CORE_TIMER_TIMER_SCHEDULER_STAT_H__
+#define __LLBC_CORE_TIMER_TIMER_SCHEDULER_STAT_H__
+
+#include "llbc/common/Common.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The timer scheduler statistic info encapsulation.
+ */
+class LLBC_EXPORT LLBC_TimerSchedulerStat
+{
+public:
+    int schedulerType; // the scheduler type, see LLBC_TimerSchedulerType.
+
+    size_t timerCount; // the scheduling timers count.
+    size_t entryCount; // the binary heap/timing wheel entries count.
+    size_t deadEntryCount; // the invalidate(cancelled) entries count still in binary heap/timing wheel.
+
+    uint64 timerDataAllocTimes; // the timer data allocate times.
+    uint64 timerDataReuseTimes; // the timer data reuse times.
+
+public:
+    /**
+     * Constructor.
+     */
+    LLBC_TimerSchedulerStat();
+
+public:
+    /**
+     * Reset statistic info.
+     */
+    void Reset();
+
+public:
+    /**
+     * Get string representation.
+     * @return LLBC_String - the string representation.
+     */
+    LLBC_String ToString() const;
+};
+
+/**
+ * \brief The timer histogram encapsulation, use to statistic timer lateness/callback cost distribution.
+ */
+class LLBC_EXPORT LLBC_TimerHistogram
+{
+public:
+    /**
+     * Histogram buckets count, the last bucket is [bounds[BucketCount - 2], +inf).
+     */
+    enum { BucketCount = 12 };
+
+public:
+    /**
+     * Constructor.
+     * @param[in] bucketBounds - the buckets upper bounds(exclusive), must be ascending and
+     *                           has BucketCount - 1 elements, must be static lifetime.
+     * @param[in] valueUnit    - the value unit describe, must be static lifetime.
+     */
+    LLBC_TimerHistogram(const uint64 *bucketBounds, const char *valueUnit);
+
+public:
+    /**
+     * Record value.
+     * @param[in] value - the value.
+     */
+    void Record(uint64 value);
+
+    /**
+     * Reset histogram.
+     */
+    void Reset();
+
+    /**
+     * Get approximate percentile value(the bucket upper bound which percentile value in).
+     * @param[in] percentile - the percentile, in [0, 100].
+     * @return uint64 - the percentile value, if percentile value in last bucket, return max value.
+     */
+    uint64 GetPercentile(double percentile) const;
+
+    /**
+     * Get string representation.
+     * @return LLBC_String - the string representation.
+     */
+    LLBC_String ToString() const;
+
+public:
+    const uint64 *bounds; // the buckets upper bounds.
+    const char *unit; // the value unit.
+
+    uint64 counts[BucketCount]; // the buckets count.
+    uint64 count; // the total count.
+    uint64 sum; // the values sum.
+    uint64 maxValue; // the max value.
+};
+
+/**
+ * \brief The timer class(timeout handler type) cost statistic info encapsulation.
+ */
+class LLBC_EXPORT LLBC_TimerClassStat
+{
+public:
+    LLBC_String name; // the timer class name(timeout delegate/timer type name).
+
+    uint64 calls; // the timeout handler call times.
+    uint64 totalCost; // the timeout handler total cost, in micro-seconds.
+    uint64 maxCost; // the timeout handler max cost, in micro-seconds.
+
+public:
+    /**
+     * Constructor.
+     */
+    LLBC_TimerClassStat();
+};
+
+/**
+ * \brief The timer scheduler instrument statistic info encapsulation.
+ */
+class LLBC_EXPORT LLBC_TimerInstrumentStat
+{
+public:
+    LLBC_TimerHistogram lateness; // the timer fire lateness(now - timer handle) histogram, in milli-seconds.
+    LLBC_TimerHistogram callbackCost; // the timeout handler cost histogram, in micro-seconds.
+
+    uint64 updateTimes; // the scheduler Update() times.
+    uint64 updateCost; // the scheduler Update() total cost, in micro-seconds.
+    uint64 maxUpdateCost; // the scheduler Update() max cost, in micro-seconds.
+
+    std::vector<LLBC_TimerClassStat> topSlowClasses; // top N(by total cost) slowest timer classes.
+
+public:
+    /**
+     * Constructor.
+     */
+    LLBC_TimerInstrumentStat();
+
+public:
+    /**
+     * Reset statistic info.
+     */
+    void Reset();
+
+    /**
+     * Get string representation.
+     * @return LLBC_String - the string representation.
+     */
+    LLBC_String ToString() const;
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_CORE_TIMER_TIMER_SCHEDULER_STAT_H__
@@ -0,0 +1,130 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef __LLBC_CORE_TIMER_TIMING_WHEEL_H__
+#define __LLBC_CORE_TIMER_TIMING_WHEEL_H__
+
+#include "llbc/common/Common.h"
+
+__LLBC_NS_BEGIN
+
+struct LLBC_TimerData;
+
+__LLBC_NS_END
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The hierarchical timing wheel encapsulation, use to implement O(1) schedule/cancel timer scheduler.
+ *
+ *        Wheel tick is 1 milli-second, level 0 has 256 slots, level 1~4 has 64 slots per level,
+ *        can hold 2^32 milli-seconds(about 49.7 days) timers, longer timers will be placed in 
+ *        the highest level last slot and re-cascaded when it's slot expired.
+ */
+class LLBC_HIDDEN LLBC_TimingWheel
+{
+public:
+    /**
+     * Constructor.
+     * @param[in] now - the current time, in milli-seconds.
+     */
+    explicit LLBC_TimingWheel(uint64 now);
+    ~LLBC_TimingWheel();
+
+public:
+    /**
+     * Insert timer data to wheel, use timer data handle as the expire time.
+     * @param[in] data - the timer data.
+     */
+    void Insert(LLBC_TimerData *data);
+
+    /**
+     * Remove timer data from wheel(included expired list).
+     * @param[in] data - the timer data.
+     * @return int - return 0 if success, otherwise return -1(timer data not in wheel).
+     */
+    int Remove(LLBC_TimerData *data);
+
+    /**
+     * Advance the wheel to given time, all expired timer datas will be moved to expired list.
+     * @param[in] now - the current time, in milli-seconds.
+     */
+    void Advance(uint64 now);
+
+    /**
+     * Pop expired timer data, the popped timer data will be removed from wheel.
+     * @return LLBC_TimerData * - the expired timer data, if no expired timer, return NULL.
+     */
+    LLBC_TimerData *PopExpired();
+
+    /**
+     * Get the timer datas count in wheel(included expired list).
+     * @return size_t - the timer datas count.
+     */
+    size_t GetSize() const;
+
+    /**
+     * Get the first timer data from specific slot, use to iterate wheel.
+     * @param[in/out] slot - the begin slot, when found, will be set to found timer data slot.
+     * @return LLBC_TimerData * - the found timer data, if not found, return NULL.
+     */
+    LLBC_TimerData *GetFirst(size_t &slot) const;
+
+    /**
+     * Get all timer datas in wheel(included expired list).
+     * @param[out] datas - the timer datas.
+     */
+    void GetAll(std::vector<LLBC_TimerData *> &datas) const;
+
+private:
+    /**
+     * Link timer data to it's slot list, not change wheel size.
+     * @param[in] data - the timer data.
+     */
+    void Link(LLBC_TimerData *data);
+
+    /**
+     * Unlink timer data from it's list, not change wheel size.
+     * @param[in] data - the timer data.
+     */
+    static void Unlink(LLBC_TimerData *data);
+
+    /**
+     * Cascade specific level slot timer datas to lower levels.
+     * @param[in] level - the level, must be in [1, 4].
+     * @return size_t - the cascaded slot index.
+     */
+    size_t Cascade(int level);
+
+private:
+    LLBC_DISABLE_ASSIGNMENT(LLBC_TimingWheel);
+
+private:
+    uint64 _curTick;
+    size_t _size;
+
+    // All slot list heads, layout: [level 0 slots][level 1~4 slots][expired list].
+    LLBC_TimerData *_slots[256 + 64 * 4 + 1];
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_CORE_TIMER_TIMING_WHEEL_H__
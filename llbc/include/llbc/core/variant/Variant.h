@@ -24,6 +24,15 @@
 
 #include "llbc/common/Common.h"
 
+// The hash dictionary container, use C++11 std::unordered_map if supported, otherwise use TR1 version.
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1600)
+ #include <unordered_map>
+ #define __LLBC_VARIANT_HASH_MAP std::unordered_map
+#else
+ #include <tr1/unordered_map>
+ #define __LLBC_VARIANT_HASH_MAP std::tr1::unordered_map
+#endif
+
 __LLBC_NS_BEGIN
 
 /**
@@ -32,6 +41,8 @@ __LLBC_NS_BEGIN
  *          first_type:
  *              raw type:    The row data type, like int32, uint32 ...eg.
  *              string type: The string data type, use LLBC_String.
+ *              dict type:   The dictionary data type, ordered(std::map) or hashed.
+ *              seq type:    The sequence data type, use std::vector.
  *              Others... :  Not define.
  *          second type:
  *              ... ...
@@ -48,6 +59,7 @@ public:
         VT_RAW                  = 0x01000000,
         VT_STR                  = 0x02000000,
         VT_DICT                 = 0x04000000,
+        VT_SEQ                  = 0x08000000,
 
         // Row type enumeration.
         // Bit view(first type always equal VT_RAW):
@@ -80,6 +92,13 @@ public:
         //          [first type] [dictionary type]
         //              8 bits       24 bits
         VT_DICT_DFT             = 0x04000001,
+        VT_DICT_HASH            = 0x04000002,
+
+        // Sequence type enumeration.
+        // Bit view(first type always equal VT_SEQ):
+        //          [first type] [sequence type]
+        //              8 bits       24 bits
+        VT_SEQ_DFT              = 0x08000001,
 
         /////////////////////////////////////////////////////////////////////
 
@@ -114,6 +133,14 @@ __LLBC_NS_BEGIN
  */
 class LLBC_Variant;
 
+/**
+ * \brief The variant hash function object, use by hash dictionary type variant.
+ */
+struct LLBC_EXPORT LLBC_VariantHash
+{
+    size_t operator()(const LLBC_Variant &var) const;
+};
+
 __LLBC_NS_END
 
 /**
@@ -146,6 +173,12 @@ public:
     typedef Dict::reverse_iterator DictReverseIter;
     typedef Dict::const_reverse_iterator DictConstReverseIter;
 
+    typedef __LLBC_VARIANT_HASH_MAP<LLBC_Variant, LLBC_Variant, LLBC_VariantHash> HashDict;
+
+    typedef std::vector<LLBC_Variant> Seq;
+    typedef Seq::iterator SeqIter;
+    typedef Seq::const_iterator SeqConstIter;
+
     struct LLBC_EXPORT Holder
     {
         LLBC_VariantType::ENUM type;
@@ -158,12 +191,18 @@ public:
             double doubleVal;
         } raw;
 
+        // Heap allocated string/dictionary/sequence, shared(copy-on-write) between copied variants.
         union ObjType
         {
             Str *str;
             Dict *dict;
+            HashDict *hashDict;
+            Seq *seq;
         } obj;
 
+        // Short string inline storage, used when string type variant's obj.str is NULL(raw.uint64Val is the length).
+        char inlStr[LLBC_CFG_CORE_VARIANT_INLINE_STR_SIZE];
+
         Holder();
         ~Holder();
     };
@@ -191,7 +230,9 @@ public:
         DOUBLE = LLBC_VariantType::VT_RAW_DOUBLE,
 
         STR = LLBC_VariantType::VT_STR_DFT,
-        DICT = LLBC_VariantType::VT_DICT_DFT
+        DICT = LLBC_VariantType::VT_DICT_DFT,
+        HASH_DICT = LLBC_VariantType::VT_DICT_HASH,
+        SEQ = LLBC_VariantType::VT_SEQ_DFT
     };
 
     /**
@@ -226,9 +267,13 @@ public:
     explicit LLBC_Variant(const std::string &strVal);
     explicit LLBC_Variant(const LLBC_String &strVal);
     explicit LLBC_Variant(const Dict &dictVal);
+    explicit LLBC_Variant(const HashDict &hashDictVal);
+    explicit LLBC_Variant(const Seq &seqVal);
     LLBC_Variant(const LLBC_Variant &varVal);
 
     // Fetch variant data type and holder data.
+    // Note: Holder is the internal storage, string type variant's obj.str is NULL when string stored
+    //       inline(short string), use AsStr() to read string content.
     int GetType() const;
     const struct Holder &GetHolder() const;
 
@@ -253,6 +298,8 @@ public:
     bool IsDouble() const;
     bool IsStr() const;
     bool IsDict() const;
+    bool IsHashDict() const;
+    bool IsSeq() const;
 
     // Type convert.
     LLBC_Variant &BecomeNil();
@@ -272,6 +319,8 @@ public:
     LLBC_Variant &BecomeDouble();
     LLBC_Variant &BecomeStr();
     LLBC_Variant &BecomeDict();
+    LLBC_Variant &BecomeHashDict();
+    LLBC_Variant &BecomeSeq();
 
     // Real data fetch.
     bool AsBool() const;
@@ -291,6 +340,8 @@ public:
     double AsDouble() const;
     LLBC_String AsStr() const;
     const Dict &AsDict() const;
+    const HashDict &AsHashDict() const;
+    const Seq &AsSeq() const;
 
     operator bool () const;
     operator sint8 () const;
@@ -309,8 +360,12 @@ public:
     operator double () const;
     operator LLBC_String () const;
     operator const Dict &() const;
+    operator const HashDict &() const;
+    operator const Seq &() const;
 
     // Dictionary type variant object specify operate methods.
+    // Iterator based methods only support ordered dictionary, call them on hash dictionary will fail
+    // with LLBC_ERROR_NOT_ALLOW(Insert() also don't convert sequence, use operator [] or Erase(key) instead).
     DictIter Begin();
     DictIter End();
     DictConstIter Begin() const;
@@ -341,6 +396,10 @@ public:
     template <typename _Kty>
     Dict::size_type Erase(const _Kty &key);
 
+    // Subscript operators, dictionary/hash dictionary type variant index by key,
+    // sequence type variant index by key.AsInt64()(negative index count from back, non-const version
+    // append a nil element when index equal to size, other out of range index set LLBC_ERROR_RANGE
+    // and return a discarded element).
     Dict::mapped_type &operator [](const Dict::key_type &key);
     const Dict::mapped_type &operator [](const Dict::key_type &key) const;
 
@@ -349,6 +408,17 @@ public:
     template <typename _Kty>
     const Dict::mapped_type &operator [](const _Kty &key) const;
 
+    // Sequence type variant object specify operate methods(SeqPushBack() on dictionary/hash dictionary fail with LLBC_ERROR_NOT_ALLOW).
+    SeqIter SeqBegin();
+    SeqIter SeqEnd();
+    SeqConstIter SeqBegin() const;
+    SeqConstIter SeqEnd() const;
+
+    void SeqPushBack(const Seq::value_type &val);
+    template <typename _Ty>
+    void SeqPushBack(const _Ty &val);
+    void SeqPopBack();
+
     // assignment operators.
     LLBC_Variant &operator =(sint8 val);
     LLBC_Variant &operator =(uint8 val);
@@ -366,6 +436,8 @@ public:
     LLBC_Variant &operator =(const double &val);
     LLBC_Variant &operator =(const LLBC_String &val);
     LLBC_Variant &operator =(const Dict &val);
+    LLBC_Variant &operator =(const HashDict &val);
+    LLBC_Variant &operator =(const Seq &val);
     LLBC_Variant &operator =(const LLBC_Variant &val);
 
     // Relational operators.
@@ -408,6 +480,8 @@ public:
 
 private:
     friend class LLBC_VariantTraits;
+    friend struct LLBC_VariantHash;
+    friend class LLBC_VariantJsonHelper;
 
     void SetType(int type);
 
@@ -416,10 +490,34 @@ private:
     void CleanRawData();
     void CleanStrData();
     void CleanDictData();
+    void CleanSeqData();
     void CleanTypeData(int type);
 
     void OptimizePerformance();
 
+    // String data access/store support(inline short string or shared heap string).
+    const char *GetStrData() const;
+    size_t GetStrSize() const;
+    void SetStr(const char *str, size_t len);
+    void AssignStr(const LLBC_Variant &another);
+
+    // Dictionary/Hash dictionary/Sequence store/detach support(shared object copy-on-write).
+    void SetDict(const Dict &dict);
+    void AssignDict(const LLBC_Variant &another);
+    Dict *DetachDict(bool alloc, bool exposed);
+
+    void SetHashDict(const HashDict &hashDict);
+    void AssignHashDict(const LLBC_Variant &another);
+    HashDict *DetachHashDict(bool alloc, bool exposed);
+
+    void SetSeq(const Seq &seq);
+    void AssignSeq(const LLBC_Variant &another);
+    Seq *DetachSeq(bool alloc, bool exposed);
+
+    // Compact mode stream serialize support(varint type/integer values).
+    void SerializeCompact(LLBC_Stream &stream) const;
+    bool DeSerializeCompactHead(LLBC_Stream &stream);
+
 private:
     struct Holder _holder;
 };
@@ -118,21 +118,35 @@ inline LLBC_Variant::LLBC_Variant(const std::string &strVal)
 {
     _holder.type = LLBC_VariantType::VT_STR_DFT;
     if (!strVal.empty())
-        _holder.obj.str = LLBC_New2(LLBC_String, strVal.data(), strVal.size());
+        SetStr(strVal.data(), strVal.size());
 }
 
 inline LLBC_Variant::LLBC_Variant(const LLBC_String &strVal)
 {
     _holder.type = LLBC_VariantType::VT_STR_DFT;
     if (!strVal.empty())
-        _holder.obj.str = LLBC_New1(LLBC_String, strVal);
+        SetStr(strVal.data(), strVal.size());
 }
 
 inline LLBC_Variant::LLBC_Variant(const LLBC_Variant::Dict &dictVal)
 {
     _holder.type = LLBC_VariantType::VT_DICT_DFT;
     if (!dictVal.empty())
-        _holder.obj.dict = LLBC_New1(Dict, dictVal);
+        SetDict(dictVal);
+}
+
+inline LLBC_Variant::LLBC_Variant(const LLBC_Variant::HashDict &hashDictVal)
+{
+    _holder.type = LLBC_VariantType::VT_DICT_HASH;
+    if (!hashDictVal.empty())
+        SetHashDict(hashDictVal);
+}
+
+inline LLBC_Variant::LLBC_Variant(const LLBC_Variant::Seq &seqVal)
+{
+    _holder.type = LLBC_VariantType::VT_SEQ_DFT;
+    if (!seqVal.empty())
+        SetSeq(seqVal);
 }
 
 inline int LLBC_Variant::GetType() const
@@ -266,6 +280,18 @@ inline bool LLBC_Variant::IsDict() const
         LLBC_VariantType::VT_DICT_DFT);
 }
 
+inline bool LLBC_Variant::IsHashDict() const
+{
+    return ((_holder.type & LLBC_VariantType::VT_DICT_HASH) ==
+        LLBC_VariantType::VT_DICT_HASH);
+}
+
+inline bool LLBC_Variant::IsSeq() const
+{
+    return ((_holder.type & LLBC_VariantType::VT_SEQ_DFT) ==
+        LLBC_VariantType::VT_SEQ_DFT);
+}
+
 inline LLBC_Variant &LLBC_Variant::BecomeNil()
 {
     if (IsNil())
@@ -399,12 +425,32 @@ inline LLBC_Variant &LLBC_Variant::BecomeStr()
 
 inline LLBC_Variant &LLBC_Variant::BecomeDict()
 {
-    if (!IsDict())
+    if (IsHashDict())
+        *this = Dict(AsHashDict().begin(), AsHashDict().end());
+    else if (!IsDict())
         *this = AsDict();
 
     return *this;
 }
 
+inline LLBC_Variant &LLBC_Variant::BecomeHashDict()
+{
+    if (IsDict())
+        *this = HashDict(AsDict().begin(), AsDict().end());
+    else if (!IsHashDict())
+        *this = AsHashDict();
+
+    return *this;
+}
+
+inline LLBC_Variant &LLBC_Variant::BecomeSeq()
+{
+    if (!IsSeq())
+        *this = AsSeq();
+
+    return *this;
+}
+
 inline sint8 LLBC_Variant::AsInt8() const
 {
     return static_cast<sint8>(AsInt64());
@@ -537,6 +583,16 @@ inline LLBC_Variant::operator const LLBC_Variant::Dict &() const
     return AsDict();
 }
 
+inline LLBC_Variant::operator const LLBC_Variant::HashDict &() const
+{
+    return AsHashDict();
+}
+
+inline LLBC_Variant::operator const LLBC_Variant::Seq &() const
+{
+    return AsSeq();
+}
+
 template <typename _T>
 inline LLBC_Variant &LLBC_Variant::operator =(const _T * const &val)
 {
@@ -550,6 +606,16 @@ inline LLBC_Variant &LLBC_Variant::operator =(const _T * const &val)
     return *this;
 }
 
+inline const char *LLBC_Variant::GetStrData() const
+{
+    return _holder.obj.str ? _holder.obj.str->c_str() : _holder.inlStr;
+}
+
+inline size_t LLBC_Variant::GetStrSize() const
+{
+    return _holder.obj.str ? _holder.obj.str->size() : static_cast<size_t>(_holder.raw.uint64Val);
+}
+
 template <typename _Kty, typename _Ty>
 inline std::pair<LLBC_Variant::DictIter, bool> LLBC_Variant::Insert(const _Kty &key, const _Ty &val)
 {
@@ -557,6 +623,12 @@ inline std::pair<LLBC_Variant::DictIter, bool> LLBC_Variant::Insert(const _Kty &
         LLBC_Variant::Dict::mapped_type(val));
 }
 
+template <typename _Ty>
+inline void LLBC_Variant::SeqPushBack(const _Ty &val)
+{
+    SeqPushBack(LLBC_Variant::Seq::value_type(val));
+}
+
 template <typename _Kty>
 inline LLBC_Variant::DictIter LLBC_Variant::Find(const _Kty &key)
 {
@@ -71,6 +71,13 @@ public:
     static void sub_equal(LLBC_Variant &left, const LLBC_Variant &right);
     static void mul_equal(LLBC_Variant &left, const LLBC_Variant &right);
     static void div_equal(LLBC_Variant &left, const LLBC_Variant &right);
+
+private:
+    /**
+     * Dictionary like(dictionary/hash dictionary) and sequence type arithmetic operations.
+     */
+    static void dict_performs(LLBC_Variant &left, const LLBC_Variant &right, int type);
+    static void seq_performs(LLBC_Variant &left, const LLBC_Variant &right, int type);
 };
 
 __LLBC_NS_END
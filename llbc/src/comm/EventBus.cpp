@@ -0,0 +1,238 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/comm/IService.h"
+#include "llbc/comm/ServiceMgr.h"
+#include "llbc/comm/EventBus.h"
+
+__LLBC_NS_BEGIN
+
+LLBC_EventBus::LLBC_EventBus(LLBC_IService *svc, LLBC_ServiceMgr &svcMgr)
+: _svc(svc)
+, _svcMgr(svcMgr)
+
+, _pendingCount(0)
+{
+}
+
+LLBC_EventBus::~LLBC_EventBus()
+{
+    for (_Batches::iterator it = _svcBatches.begin();
+         it != _svcBatches.end();
+         ++it)
+        ClearBatch(it->second);
+
+    for (_Batches::iterator it = _topicBatches.begin();
+         it != _topicBatches.end();
+         ++it)
+        ClearBatch(it->second);
+}
+
+int LLBC_EventBus::SubscribeTopic(int topic)
+{
+    return _svcMgr.SubscribeTopic(topic, _svc->GetId());
+}
+
+int LLBC_EventBus::UnsubscribeTopic(int topic)
+{
+    return _svcMgr.UnsubscribeTopic(topic, _svc->GetId());
+}
+
+int LLBC_EventBus::Post(int svcId, LLBC_Event *ev, uint64 dedupKey)
+{
+    if (UNLIKELY(svcId <= 0 || !ev))
+    {
+        if (ev)
+            DeleteEvent(ev);
+
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    AddToBatch(_svcBatches[svcId], ev, dedupKey);
+
+    return LLBC_OK;
+}
+
+int LLBC_EventBus::Publish(int topic, LLBC_Event *ev, uint64 dedupKey)
+{
+    if (UNLIKELY(topic <= 0 || !ev))
+    {
+        if (ev)
+            DeleteEvent(ev);
+
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    // Topic event will be cloned for multiple subscribers, don't publish the event which can't be cloned.
+    if (UNLIKELY(!IsCloneable(ev)))
+    {
+        DeleteEvent(ev);
+
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+        return LLBC_FAILED;
+    }
+
+    // Topic events dedup in topic batch, fan out to subscribers when flushing.
+    AddToBatch(_topicBatches[topic], ev, dedupKey);
+
+    return LLBC_OK;
+}
+
+size_t LLBC_EventBus::GetPendingCount() const
+{
+    return _pendingCount;
+}
+
+void LLBC_EventBus::Flush()
+{
+    if (_pendingCount == 0)
+        return;
+
+    // Fan out topic events to subscribed services batches.
+    for (_Batches::iterator tIt = _topicBatches.begin();
+         tIt != _topicBatches.end();
+         ++tIt)
+    {
+        _Batch &topicBatch = tIt->second;
+        if (topicBatch.evs.empty())
+            continue;
+
+        _svcMgr.GetTopicSubscribers(tIt->first, _subscribers);
+        if (_subscribers.empty())
+        {
+            ClearBatch(topicBatch);
+            continue;
+        }
+
+        const size_t lastSubscriber = _subscribers.size() - 1;
+        for (size_t i = 0; i <= lastSubscriber; ++i)
+        {
+            std::vector<LLBC_Event *> &svcEvs = _svcBatches[_subscribers[i]].evs;
+            for (size_t j = 0; j < topicBatch.evs.size(); ++j)
+            {
+                LLBC_Event *&ev = topicBatch.evs[j];
+                if (i == lastSubscriber)
+                {
+                    svcEvs.push_back(ev);
+                    ev = NULL;
+                }
+                else
+                {
+                    svcEvs.push_back(ev->Clone());
+                }
+            }
+        }
+
+        topicBatch.evs.clear();
+        topicBatch.dedupIdxs.clear();
+    }
+
+    // Deliver every service batch through one queue push.
+    for (_Batches::iterator sIt = _svcBatches.begin();
+         sIt != _svcBatches.end();
+         ++sIt)
+    {
+        _Batch &svcBatch = sIt->second;
+        if (svcBatch.evs.empty())
+            continue;
+
+        LLBC_IService *svc = _svcMgr.GetService(sIt->first);
+        if (!svc)
+        {
+            ClearBatch(svcBatch);
+            continue;
+        }
+
+        svc->FireEvents(svcBatch.evs);
+        svcBatch.dedupIdxs.clear();
+    }
+
+    _pendingCount = 0;
+}
+
+void LLBC_EventBus::AddToBatch(_Batch &batch, LLBC_Event *ev, uint64 dedupKey)
+{
+    if (dedupKey != 0)
+    {
+        std::pair<_Batch::_DedupIndexes::iterator, bool> insertRet =
+            batch.dedupIdxs.insert(std::make_pair(std::make_pair(ev->GetId(), dedupKey), batch.evs.size()));
+        if (!insertRet.second)
+        {
+            LLBC_Event *&pendingEv = batch.evs[insertRet.first->second];
+            DeleteEvent(pendingEv);
+            pendingEv = ev;
+
+            return;
+        }
+    }
+
+    batch.evs.push_back(ev);
+    ++_pendingCount;
+}
+
+void LLBC_EventBus::ClearBatch(_Batch &batch)
+{
+    for (size_t i = 0; i < batch.evs.size(); ++i)
+    {
+        if (batch.evs[i])
+            DeleteEvent(batch.evs[i]);
+    }
+
+    batch.evs.clear();
+    batch.dedupIdxs.clear();
+}
+
+bool LLBC_EventBus::IsCloneable(const LLBC_Event *ev)
+{
+    const std::type_info &evType = typeid(*ev);
+    if (evType == typeid(LLBC_Event))
+        return true;
+
+    // Derived event, Clone() must be overridden(check once per event type).
+    _Cloneables::const_iterator it = _cloneables.find(&evType);
+    if (it != _cloneables.end())
+        return it->second;
+
+    LLBC_Event *clone = ev->Clone();
+    const bool cloneable = clone && typeid(*clone) == evType;
+    LLBC_XDelete(clone);
+
+    _cloneables.insert(std::make_pair(&evType, cloneable));
+
+    return cloneable;
+}
+
+void LLBC_EventBus::DeleteEvent(LLBC_Event *ev)
+{
+    // Same as LLBC_EventManager::FireEvent(), don't delete the event which set dont delete after fire option.
+    if (!ev->IsDontDelAfterFire())
+        LLBC_Delete(ev);
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
@@ -142,6 +142,7 @@ void LLBC_Packet::OnPoolInstCreate(LLBC_IObjectPoolInst &poolInst)
 void LLBC_Packet::Clear()
 {
     // Clear payload.
+    _payloadViewGuard.Invalidate();
     if (_payload)
     {
         if (_payloadDeleteDeleg)
@@ -266,6 +267,8 @@ LLBC_MessageBlock *LLBC_Packet::GiveUp()
     if (!_payload)
         return NULL;
 
+    _payloadViewGuard.Invalidate();
+
     LLBC_MessageBlock *block = _payload;
     _payload = NULL;
 
@@ -301,6 +304,34 @@ void LLBC_Packet::SetCodecError(const LLBC_String &codecErr)
     _codecError = LLBC_New2(LLBC_String, codecErr.c_str(), codecErr.length());
 }
 
+int LLBC_Packet::WriteSegmentedStream(const LLBC_Stream &stream)
+{
+    const size_t segmentCount = stream.GetSegmentCount();
+    if (segmentCount == 0)
+        return LLBC_OK;
+
+    // Reserve payload space first, avoid payload resize per segment.
+    const size_t size = stream.GetPos();
+    LLBC_MessageBlock *payload = CheckAndCreatePayload(size);
+    if (payload->GetWritableSize() < size)
+        payload->Resize(payload->GetWritePos() + size);
+
+    LLBC_StreamSegment stackSegments[16];
+    LLBC_StreamSegment *segments = stackSegments;
+    if (segmentCount > sizeof(stackSegments) / sizeof(stackSegments[0]))
+        segments = LLBC_Malloc(LLBC_StreamSegment, sizeof(LLBC_StreamSegment) * segmentCount);
+
+    int ret = LLBC_OK;
+    stream.GetSegments(segments, segmentCount);
+    for (size_t i = 0; i < segmentCount && ret == LLBC_OK; ++i)
+        ret = payload->Write(segments[i].buf, segments[i].len);
+
+    if (segments != stackSegments)
+        LLBC_Free(segments);
+
+    return ret;
+}
+
 void LLBC_Packet::CleanupPreHandleResult()
 {
     if (_preHandleResult)
@@ -321,6 +352,8 @@ void LLBC_Packet::CleanupPayload()
     if (!_payload)
         return;
 
+    _payloadViewGuard.Invalidate();
+
     if (_payloadDeleteDeleg)
         _payloadDeleteDeleg->Invoke(_payload);
 
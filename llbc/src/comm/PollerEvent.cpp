@@ -88,7 +88,7 @@ LLBC_MessageBlock *LLBC_PollerEvUtil::BuildCloseEv(int sessionId, const char *re
 
     if (reason != NULL)
     {
-        ev.un.closeReason = LLBC_Malloc(char, LLBC_StrLenA(reason) + 1);
+        ev.un.closeReason = LLBC_TagMalloc(LLBC_MemoryTag::Comm, char, LLBC_StrLenA(reason) + 1);
         LLBC_StrCpyA(ev.un.closeReason, reason);
     }
     else
@@ -109,7 +109,7 @@ LLBC_MessageBlock *LLBC_PollerEvUtil::BuildIocpMonitorEv(int ret,
     _Block *block = LLBC_New1(_Block, sizeof(_Ev));
     _Ev &ev = *reinterpret_cast<_Ev *>(block->GetData());
     ev.type = _Ev::Monitor;
-    ev.un.monitorEv = LLBC_Malloc(char, sizeof(int) + sizeof(LLBC_POverlapped) + sizeof(int) * 2);
+    ev.un.monitorEv = LLBC_TagMalloc(LLBC_MemoryTag::Comm, char, sizeof(int) + sizeof(LLBC_POverlapped) + sizeof(int) * 2);
 
     size_t off = 0;
     // Wait return value.
@@ -132,7 +132,7 @@ LLBC_MessageBlock *LLBC_PollerEvUtil::BuildEpollMonitorEv(const LLBC_EpollEvent
     _Block *block = LLBC_New1(_Block, sizeof(_Ev));
     _Ev &ev = *reinterpret_cast<_Ev *>(block->GetData());
     ev.type = _Ev::Monitor;
-    ev.un.monitorEv = LLBC_Malloc(char, sizeof(int) + sizeof(LLBC_EpollEvent) * count);
+    ev.un.monitorEv = LLBC_TagMalloc(LLBC_MemoryTag::Comm, char, sizeof(int) + sizeof(LLBC_EpollEvent) * count);
 
     // Write count.
     ::memcpy(ev.un.monitorEv, &count, sizeof(int));
@@ -167,7 +167,7 @@ LLBC_MessageBlock * LLBC_PollerEvUtil::BuildCtrlProtocolStackEv(int sessionId, i
     ev.sessionId = sessionId;
     ev.un.protocolStackCtrlInfo.ctrlCmd = ctrlCmd;
     ev.un.protocolStackCtrlInfo.ctrlDataLen = ctrlDataStream.GetSize();
-    ev.un.protocolStackCtrlInfo.ctrlData = LLBC_Malloc(void, ctrlDataStream.GetSize());
+    ev.un.protocolStackCtrlInfo.ctrlData = LLBC_TagMalloc(LLBC_MemoryTag::Comm, void, ctrlDataStream.GetSize());
     ::memcpy(ev.un.protocolStackCtrlInfo.ctrlData, ctrlDataStream.GetBuf(), ctrlDataStream.GetSize());
     ev.un.protocolStackCtrlInfo.ctrlDataClearDeleg = ctrlDataClearDeleg;
 
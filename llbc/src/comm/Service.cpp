@@ -53,6 +53,7 @@ LLBC_Service::_EvHandler LLBC_Service::_evHandlers[LLBC_SvcEvType::End] =
     &LLBC_Service::HandleEv_SubscribeEv,
     &LLBC_Service::HandleEv_UnsubscribeEv,
     &LLBC_Service::HandleEv_FireEv,
+    &LLBC_Service::HandleEv_FireEvBatch,
 
     &LLBC_Service::HandleEv_AppCfgReloaded,
 };
@@ -134,6 +135,7 @@ LLBC_Service::LLBC_Service(This::Type type,
 , _evManagerMaxListenerStub(0)
 
 , _svcMgr(*LLBC_ServiceMgrSingleton)
+, _evBus(this, _svcMgr)
 {
     // Create service name, if is empty.
     if (_name.empty())
@@ -982,6 +984,19 @@ void LLBC_Service::FireEvent(LLBC_Event *ev)
     Push(LLBC_SvcEvUtil::BuildFireEvEv(ev));
 }
 
+void LLBC_Service::FireEvents(std::vector<LLBC_Event *> &evs)
+{
+    if (evs.empty())
+        return;
+
+    Push(LLBC_SvcEvUtil::BuildFireEvBatchEv(evs));
+}
+
+LLBC_EventBus &LLBC_Service::GetEventBus()
+{
+    return _evBus;
+}
+
 int LLBC_Service::Post(LLBC_IDelegate2<void, LLBC_Service::Base *, const LLBC_Variant *> *deleg, LLBC_Variant *data)
 {
     if (UNLIKELY(!deleg))
@@ -1083,6 +1098,9 @@ void LLBC_Service::OnSvc(bool fullFrame)
     HandleFrameTasks(_afterFrameTasks, _handlingAfterFrameTasks);
     _handledBeforeFrameTasks = false;
 
+    // Deliver this frame's event bus events.
+    _evBus.Flush();
+
     // Process Idle.
     ProcessIdle(fullFrame);
 
@@ -1349,6 +1367,9 @@ void LLBC_Service::Cleanup()
     if (_driveMode == This::SelfDrive)
         _svcMgr.OnServiceStop(this);
 
+    // Remove event bus topic subscriptions.
+    _svcMgr.OnServiceCleanup(this);
+
     // Reset some variables.
     _relaxTimes = 0;
 
@@ -1727,6 +1748,20 @@ void LLBC_Service::HandleEv_FireEv(LLBC_ServiceEvent &_)
     ev.ev = NULL;
 }
 
+void LLBC_Service::HandleEv_FireEvBatch(LLBC_ServiceEvent &_)
+{
+    typedef LLBC_SvcEv_FireEvBatch _Ev;
+    _Ev &ev = static_cast<_Ev &>(_);
+
+    for (size_t i = 0; i < ev.evs.size(); ++i)
+    {
+        LLBC_Event *fireEv = ev.evs[i];
+        ev.evs[i] = NULL;
+
+        _evManager.FireEvent(fireEv);
+    }
+}
+
 void LLBC_Service::HandleEv_AppCfgReloaded(LLBC_ServiceEvent &_)
 {
     typedef LLBC_SvcEv_AppCfgReloadedEv _Ev;
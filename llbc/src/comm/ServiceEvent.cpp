@@ -157,6 +157,17 @@ LLBC_SvcEv_FireEv::~LLBC_SvcEv_FireEv()
     LLBC_XDelete(ev);
 }
 
+LLBC_SvcEv_FireEvBatch::LLBC_SvcEv_FireEvBatch()
+: Base(_EvType::FireEvBatch)
+{
+}
+
+LLBC_SvcEv_FireEvBatch::~LLBC_SvcEv_FireEvBatch()
+{
+    for (size_t i = 0; i < evs.size(); ++i)
+        LLBC_XDelete(evs[i]);
+}
+
 LLBC_MessageBlock *LLBC_SvcEvUtil::BuildSessionCreateEv(const LLBC_SockAddr_IN &local,
                                                         const LLBC_SockAddr_IN &peer,
                                                         bool isListen,
@@ -279,6 +290,18 @@ LLBC_MessageBlock *LLBC_SvcEvUtil::BuildFireEvEv(LLBC_Event *ev)
     return __CreateEvBlock(wrapEv);
 }
 
+LLBC_MessageBlock *LLBC_SvcEvUtil::BuildFireEvBatchEv(std::vector<LLBC_Event *> &evs)
+{
+    typedef LLBC_SvcEv_FireEvBatch _Ev;
+
+    // Copy event pointers(exactly sized), the caller's vector keep it's capacity for reuse.
+    _Ev *wrapEv = LLBC_New(_Ev);
+    wrapEv->evs.assign(evs.begin(), evs.end());
+    evs.clear();
+
+    return __CreateEvBlock(wrapEv);
+}
+
 LLBC_MessageBlock * LLBC_SvcEvUtil::BuildAppCfgReloadedEv(bool iniReloaded, bool propReloaded)
 {
     typedef LLBC_SvcEv_AppCfgReloadedEv _Ev;
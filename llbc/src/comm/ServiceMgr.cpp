@@ -38,6 +38,8 @@ LLBC_ServiceMgr::LLBC_ServiceMgr()
 
 , _id2Services()
 , _name2Services()
+
+, _topic2Services()
 {
 }
 
@@ -137,6 +139,81 @@ int LLBC_ServiceMgr::Stop()
     return LLBC_OK;
 }
 
+int LLBC_ServiceMgr::SubscribeTopic(int topic, int svcId)
+{
+    if (topic <= 0 || svcId <= 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    LLBC_LockGuard guard(_lock);
+    std::vector<int> &svcIds = _topic2Services[topic];
+    if (std::find(svcIds.begin(), svcIds.end(), svcId) != svcIds.end())
+    {
+        LLBC_SetLastError(LLBC_ERROR_REPEAT);
+        return LLBC_FAILED;
+    }
+
+    svcIds.push_back(svcId);
+
+    return LLBC_OK;
+}
+
+int LLBC_ServiceMgr::UnsubscribeTopic(int topic, int svcId)
+{
+    LLBC_LockGuard guard(_lock);
+    _Topic2Services::iterator tIt = _topic2Services.find(topic);
+    if (tIt == _topic2Services.end())
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
+        return LLBC_FAILED;
+    }
+
+    std::vector<int> &svcIds = tIt->second;
+    std::vector<int>::iterator sIt = std::find(svcIds.begin(), svcIds.end(), svcId);
+    if (sIt == svcIds.end())
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
+        return LLBC_FAILED;
+    }
+
+    svcIds.erase(sIt);
+    if (svcIds.empty())
+        _topic2Services.erase(tIt);
+
+    return LLBC_OK;
+}
+
+void LLBC_ServiceMgr::GetTopicSubscribers(int topic, std::vector<int> &svcIds)
+{
+    svcIds.clear();
+
+    LLBC_LockGuard guard(_lock);
+    _Topic2Services::const_iterator tIt = _topic2Services.find(topic);
+    if (tIt != _topic2Services.end())
+        svcIds.assign(tIt->second.begin(), tIt->second.end());
+}
+
+void LLBC_ServiceMgr::OnServiceCleanup(LLBC_IService *svc)
+{
+    LLBC_LockGuard guard(_lock);
+
+    // Remove service's topic subscriptions.
+    const int svcId = svc->GetId();
+    for (_Topic2Services::iterator tIt = _topic2Services.begin();
+         tIt != _topic2Services.end();
+         )
+    {
+        std::vector<int> &svcIds = tIt->second;
+        svcIds.erase(std::remove(svcIds.begin(), svcIds.end(), svcId), svcIds.end());
+        if (svcIds.empty())
+            _topic2Services.erase(tIt++);
+        else
+            ++tIt;
+    }
+}
+
 bool LLBC_ServiceMgr::InTls(const LLBC_IService *svc)
 {
     __LLBC_LibTls *tls = __LLBC_GetLibTls();
@@ -430,6 +430,32 @@ int LLBC_Socket::AsyncSend(LLBC_MessageBlock *block)
     return LLBC_OK;
 }
 
+int LLBC_Socket::AsyncSend(LLBC_Stream &stream)
+{
+#if LLBC_TARGET_PLATFORM_WIN32
+    // Iocp poller always merge will send blocks to send, flatten stream to one block.
+    if (_pollerType == _PollerType::IocpPoller)
+    {
+        const size_t size = stream.GetPos();
+        if (size == 0)
+            return LLBC_OK;
+
+        if (stream.IsAttach())
+        {
+            stream.SetPos(0);
+            return AsyncSend(reinterpret_cast<const char *>(stream.GetBuf()), static_cast<int>(size));
+        }
+
+        LLBC_MessageBlock *block = LLBC_New3(LLBC_MessageBlock, stream.Detach(), size, false);
+        block->SetWritePos(size);
+
+        return AsyncSend(block);
+    }
+#endif // LLBC_TARGET_PLATFORM_WIN32
+
+    return _willSend.Append(stream);
+}
+
 bool LLBC_Socket::IsExistNoSendData() const
 {
     return !!_willSend.FirstBlock();
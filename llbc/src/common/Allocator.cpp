@@ -0,0 +1,589 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/common/Common.h"
+#include "llbc/core/os/OS_Atomic.h"
+
+__LLBC_INTERNAL_NS_BEGIN
+
+static const char *__g_memTagDesc[LLBC_NS LLBC_MemoryTag::End + 1] =
+{
+    "Default",
+    "MsgBlock",
+    "Log",
+    "Timer",
+    "Event",
+    "Comm",
+    "User",
+
+    "Unknown"
+};
+
+/**
+ * \brief The block header, placed in front of every block allocated by library allocator.
+ *        Header size is 16 bytes, so user memory still keep 16 bytes aligned.
+ */
+struct __LLBC_MemBlockHeader
+{
+    LLBC_NS uint32 sizeClass; // Size class index, __LLBC_MEM_LARGE_CLASS means allocated from system allocator directly.
+    LLBC_NS uint32 tag;       // Memory tag.
+    LLBC_NS uint64 size;      // Block usable size.
+};
+
+/**
+ * \brief The free block node, reuse block header memory.
+ */
+struct __LLBC_MemFreeNode
+{
+    __LLBC_MemFreeNode *next;
+};
+
+/**
+ * \brief The thread cache free list.
+ */
+struct __LLBC_MemFreeList
+{
+    __LLBC_MemFreeNode *head;
+    size_t count;
+};
+
+#define __LLBC_MEM_HEADER_SIZE      (sizeof(LLBC_INL_NS __LLBC_MemBlockHeader))
+#define __LLBC_MEM_LARGE_CLASS      0xffffffffu
+#define __LLBC_MEM_MAX_CLASS_COUNT  128
+#define __LLBC_MEM_CLASS_ALIGN      16
+
+/**
+ * \brief The thread cache structure, per-thread free lists, access without any lock.
+ */
+struct __LLBC_MemThreadCache
+{
+    __LLBC_MemFreeList lists[__LLBC_MEM_MAX_CLASS_COUNT];
+};
+
+/**
+ * \brief The central lock, use platform primitive directly, allocator not depend on core/thread module.
+ */
+class __LLBC_MemLock
+{
+public:
+    void Init()
+    {
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+        pthread_mutex_init(&_lock, NULL);
+#else
+        ::InitializeCriticalSection(&_lock);
+#endif
+    }
+
+    void Lock()
+    {
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+        pthread_mutex_lock(&_lock);
+#else
+        ::EnterCriticalSection(&_lock);
+#endif
+    }
+
+    void Unlock()
+    {
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+        pthread_mutex_unlock(&_lock);
+#else
+        ::LeaveCriticalSection(&_lock);
+#endif
+    }
+
+private:
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    pthread_mutex_t _lock;
+#else
+    CRITICAL_SECTION _lock;
+#endif
+};
+
+/**
+ * \brief The central free list, shared by all threads, access with lock.
+ */
+struct __LLBC_MemCentralList
+{
+    __LLBC_MemLock lock;
+    __LLBC_MemFreeNode *head;
+    size_t count;
+};
+
+// Size class about tables.
+static int __g_classCount = 0;
+#if LLBC_CFG_COM_ALLOCATOR_BACKEND == 1
+static size_t __g_classSizes[__LLBC_MEM_MAX_CLASS_COUNT];
+static size_t __g_classBatches[__LLBC_MEM_MAX_CLASS_COUNT];
+static size_t __g_classCacheLimits[__LLBC_MEM_MAX_CLASS_COUNT];
+static LLBC_NS uint8 __g_size2Class[(LLBC_CFG_COM_ALLOCATOR_MAX_SMALL_SIZE + __LLBC_MEM_CLASS_ALIGN - 1) / __LLBC_MEM_CLASS_ALIGN + 1];
+#endif // LLBC_CFG_COM_ALLOCATOR_BACKEND == 1
+
+// Central free lists.
+static __LLBC_MemCentralList __g_centralLists[__LLBC_MEM_MAX_CLASS_COUNT];
+
+// Thread cache.
+static LLBC_THREAD_LOCAL __LLBC_MemThreadCache *__g_threadCache = NULL;
+#if LLBC_CFG_COM_ALLOCATOR_BACKEND == 1
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+static pthread_once_t __g_memInitOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t __g_threadCacheKey;
+#else
+static INIT_ONCE __g_memInitOnce = INIT_ONCE_STATIC_INIT;
+static DWORD __g_threadCacheKey = FLS_OUT_OF_INDEXES;
+#endif
+#endif // LLBC_CFG_COM_ALLOCATOR_BACKEND == 1
+
+// Memory tag statistic.
+static volatile LLBC_NS sint64 __g_tagInUseBytes[LLBC_NS LLBC_MemoryTag::End];
+static volatile LLBC_NS sint64 __g_tagInUseBlocks[LLBC_NS LLBC_MemoryTag::End];
+static volatile LLBC_NS sint64 __g_tagTotalAllocTimes[LLBC_NS LLBC_MemoryTag::End];
+
+static void __LLBC_MemReleaseToCentral(int cls, __LLBC_MemFreeList &list, size_t count)
+{
+    __LLBC_MemFreeNode *first = list.head;
+    __LLBC_MemFreeNode *last = first;
+    for (size_t i = 1; i < count; ++i)
+        last = last->next;
+
+    list.head = last->next;
+    list.count -= count;
+
+    __LLBC_MemCentralList &central = __g_centralLists[cls];
+    central.lock.Lock();
+    last->next = central.head;
+    central.head = first;
+    central.count += count;
+    central.lock.Unlock();
+}
+
+#if LLBC_CFG_COM_ALLOCATOR_BACKEND == 1
+static void __LLBC_MemFetchFromCentral(int cls, __LLBC_MemFreeList &list)
+{
+    const size_t batch = __g_classBatches[cls];
+
+    // Try fetch batch blocks from central free list.
+    __LLBC_MemCentralList &central = __g_centralLists[cls];
+    central.lock.Lock();
+    if (central.count > 0)
+    {
+        const size_t fetchCount = MIN(batch, central.count);
+
+        __LLBC_MemFreeNode *first = central.head;
+        __LLBC_MemFreeNode *last = first;
+        for (size_t i = 1; i < fetchCount; ++i)
+            last = last->next;
+
+        central.head = last->next;
+        central.count -= fetchCount;
+        central.lock.Unlock();
+
+        last->next = list.head;
+        list.head = first;
+        list.count += fetchCount;
+
+        return;
+    }
+    central.lock.Unlock();
+
+    // Central free list empty, carve a new span, span never give back to system.
+    const size_t classSize = __g_classSizes[cls];
+    const size_t spanBlocks = MAX(LLBC_CFG_COM_ALLOCATOR_SPAN_SIZE / classSize, static_cast<size_t>(1));
+    char *span = reinterpret_cast<char *>(::malloc(spanBlocks * classSize));
+    if (UNLIKELY(!span))
+        return;
+
+    // Keep batch blocks in thread cache, the remaining blocks give to central free list.
+    const size_t keepBlocks = MIN(batch, spanBlocks);
+    for (size_t i = 0; i < keepBlocks; ++i)
+    {
+        __LLBC_MemFreeNode *node = reinterpret_cast<__LLBC_MemFreeNode *>(span + i * classSize);
+        node->next = list.head;
+        list.head = node;
+    }
+    list.count += keepBlocks;
+
+    if (keepBlocks == spanBlocks)
+        return;
+
+    __LLBC_MemFreeNode *first = reinterpret_cast<__LLBC_MemFreeNode *>(span + keepBlocks * classSize);
+    __LLBC_MemFreeNode *last = first;
+    for (size_t i = keepBlocks + 1; i < spanBlocks; ++i)
+    {
+        __LLBC_MemFreeNode *node = reinterpret_cast<__LLBC_MemFreeNode *>(span + i * classSize);
+        last->next = node;
+        last = node;
+    }
+
+    central.lock.Lock();
+    last->next = central.head;
+    central.head = first;
+    central.count += spanBlocks - keepBlocks;
+    central.lock.Unlock();
+}
+#endif // LLBC_CFG_COM_ALLOCATOR_BACKEND == 1
+
+static void __LLBC_MemFlushThreadCache(__LLBC_MemThreadCache *tc)
+{
+    for (int cls = 0; cls < __g_classCount; ++cls)
+    {
+        __LLBC_MemFreeList &list = tc->lists[cls];
+        if (list.count > 0)
+            __LLBC_MemReleaseToCentral(cls, list, list.count);
+    }
+}
+
+#if LLBC_CFG_COM_ALLOCATOR_BACKEND == 1
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+static void __LLBC_MemDestroyThreadCache(void *arg)
+#else
+static void WINAPI __LLBC_MemDestroyThreadCache(void *arg)
+#endif
+{
+    __LLBC_MemThreadCache *tc = reinterpret_cast<__LLBC_MemThreadCache *>(arg);
+    if (!tc)
+        return;
+
+    __LLBC_MemFlushThreadCache(tc);
+    ::free(tc);
+
+    if (__g_threadCache == tc)
+        __g_threadCache = NULL;
+}
+
+static void __LLBC_MemInitSizeClasses()
+{
+    // Size classes: 16 bytes step until 128 bytes, after that, 4 classes per power of two.
+    size_t classSize = __LLBC_MEM_CLASS_ALIGN;
+    while (classSize <= LLBC_CFG_COM_ALLOCATOR_MAX_SMALL_SIZE &&
+           __g_classCount < __LLBC_MEM_MAX_CLASS_COUNT)
+    {
+        __g_classSizes[__g_classCount] = classSize;
+        __g_classBatches[__g_classCount] =
+            MAX(MIN(16384 / classSize, static_cast<size_t>(64)), static_cast<size_t>(1));
+        __g_classCacheLimits[__g_classCount] =
+            MAX(LLBC_CFG_COM_ALLOCATOR_THREAD_CACHE_CLASS_LIMIT / classSize, __g_classBatches[__g_classCount] * 2);
+        ++__g_classCount;
+
+        if (classSize < 128)
+        {
+            classSize += __LLBC_MEM_CLASS_ALIGN;
+        }
+        else
+        {
+            size_t pow2 = 128;
+            while (pow2 * 2 <= classSize)
+                pow2 *= 2;
+            classSize += pow2 / 4;
+        }
+    }
+
+    // Make sure the max class can hold the max small block.
+    const size_t maxSmallSize = (LLBC_CFG_COM_ALLOCATOR_MAX_SMALL_SIZE + __LLBC_MEM_CLASS_ALIGN - 1) /
+        __LLBC_MEM_CLASS_ALIGN * __LLBC_MEM_CLASS_ALIGN;
+    if (__g_classSizes[__g_classCount - 1] < maxSmallSize)
+    {
+        if (__g_classCount == __LLBC_MEM_MAX_CLASS_COUNT)
+            --__g_classCount;
+
+        __g_classSizes[__g_classCount] = maxSmallSize;
+        __g_classBatches[__g_classCount] = 1;
+        __g_classCacheLimits[__g_classCount] =
+            MAX(LLBC_CFG_COM_ALLOCATOR_THREAD_CACHE_CLASS_LIMIT / maxSmallSize, static_cast<size_t>(2));
+        ++__g_classCount;
+    }
+
+    // Build size -> class index map.
+    int cls = 0;
+    for (size_t idx = 0; idx < sizeof(__g_size2Class) / sizeof(__g_size2Class[0]); ++idx)
+    {
+        const size_t size = idx * __LLBC_MEM_CLASS_ALIGN;
+        while (cls < __g_classCount - 1 && __g_classSizes[cls] < size)
+            ++cls;
+
+        __g_size2Class[idx] = static_cast<LLBC_NS uint8>(cls);
+    }
+
+    for (int i = 0; i < __g_classCount; ++i)
+    {
+        __g_centralLists[i].lock.Init();
+        __g_centralLists[i].head = NULL;
+        __g_centralLists[i].count = 0;
+    }
+}
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+static void __LLBC_MemInit()
+{
+    __LLBC_MemInitSizeClasses();
+    (void)pthread_key_create(&__g_threadCacheKey, &__LLBC_MemDestroyThreadCache);
+}
+#else
+static BOOL CALLBACK __LLBC_MemInit(PINIT_ONCE, PVOID, PVOID *)
+{
+    __LLBC_MemInitSizeClasses();
+    __g_threadCacheKey = ::FlsAlloc(&__LLBC_MemDestroyThreadCache);
+
+    return TRUE;
+}
+#endif
+
+static __LLBC_MemThreadCache *__LLBC_MemGetThreadCache()
+{
+    if (LIKELY(__g_threadCache))
+        return __g_threadCache;
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    (void)pthread_once(&__g_memInitOnce, &__LLBC_MemInit);
+#else
+    (void)::InitOnceExecuteOnce(&__g_memInitOnce, &__LLBC_MemInit, NULL, NULL);
+#endif
+
+    __LLBC_MemThreadCache *tc =
+        reinterpret_cast<__LLBC_MemThreadCache *>(::calloc(1, sizeof(__LLBC_MemThreadCache)));
+    if (UNLIKELY(!tc))
+        return NULL;
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    (void)pthread_setspecific(__g_threadCacheKey, tc);
+#else
+    (void)::FlsSetValue(__g_threadCacheKey, tc);
+#endif
+
+    __g_threadCache = tc;
+
+    return tc;
+}
+#endif // LLBC_CFG_COM_ALLOCATOR_BACKEND == 1
+
+static LLBC_FORCE_INLINE void __LLBC_MemStatAlloc(LLBC_NS uint32 tag, LLBC_NS uint64 size)
+{
+#if LLBC_CFG_COM_ALLOCATOR_ENABLE_TAG_STAT
+    (void)LLBC_NS LLBC_AtomicFetchAndAdd(&__g_tagInUseBytes[tag], static_cast<LLBC_NS sint64>(size));
+    (void)LLBC_NS LLBC_AtomicFetchAndAdd(&__g_tagInUseBlocks[tag], 1);
+    (void)LLBC_NS LLBC_AtomicFetchAndAdd(&__g_tagTotalAllocTimes[tag], 1);
+#else
+    LLBC_UNUSED_PARAM(tag);
+    LLBC_UNUSED_PARAM(size);
+#endif
+}
+
+static LLBC_FORCE_INLINE void __LLBC_MemStatFree(LLBC_NS uint32 tag, LLBC_NS uint64 size)
+{
+#if LLBC_CFG_COM_ALLOCATOR_ENABLE_TAG_STAT
+    (void)LLBC_NS LLBC_AtomicFetchAndSub(&__g_tagInUseBytes[tag], static_cast<LLBC_NS sint64>(size));
+    (void)LLBC_NS LLBC_AtomicFetchAndSub(&__g_tagInUseBlocks[tag], 1);
+#else
+    LLBC_UNUSED_PARAM(tag);
+    LLBC_UNUSED_PARAM(size);
+#endif
+}
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+const char *LLBC_MemoryTag::GetTagDesc(int tag)
+{
+    return IsLegal(tag) ?
+        LLBC_INL_NS __g_memTagDesc[tag] : LLBC_INL_NS __g_memTagDesc[LLBC_MemoryTag::End];
+}
+
+bool LLBC_MemoryTag::IsLegal(int tag)
+{
+    return tag >= LLBC_MemoryTag::Begin && tag < LLBC_MemoryTag::End;
+}
+
+void *__LLBC_Malloc(int tag, size_t size)
+{
+    typedef LLBC_INL_NS __LLBC_MemBlockHeader _Header;
+
+    if (UNLIKELY(size > static_cast<size_t>(-1) - __LLBC_MEM_HEADER_SIZE))
+        return NULL;
+    if (UNLIKELY(!LLBC_MemoryTag::IsLegal(tag)))
+        tag = LLBC_MemoryTag::Default;
+
+    _Header *header;
+    const size_t totalSize = size + __LLBC_MEM_HEADER_SIZE;
+#if LLBC_CFG_COM_ALLOCATOR_BACKEND == 1
+    LLBC_INL_NS __LLBC_MemThreadCache *tc;
+    if (totalSize <= LLBC_CFG_COM_ALLOCATOR_MAX_SMALL_SIZE &&
+        LIKELY((tc = LLBC_INL_NS __LLBC_MemGetThreadCache()) != NULL))
+    {
+        const int cls = LLBC_INL_NS __g_size2Class[
+            (totalSize + __LLBC_MEM_CLASS_ALIGN - 1) / __LLBC_MEM_CLASS_ALIGN];
+
+        LLBC_INL_NS __LLBC_MemFreeList &list = tc->lists[cls];
+        if (UNLIKELY(!list.head))
+        {
+            LLBC_INL_NS __LLBC_MemFetchFromCentral(cls, list);
+            if (UNLIKELY(!list.head))
+                return NULL;
+        }
+
+        header = reinterpret_cast<_Header *>(list.head);
+        list.head = list.head->next;
+        --list.count;
+
+        header->sizeClass = static_cast<uint32>(cls);
+        header->size = LLBC_INL_NS __g_classSizes[cls] - __LLBC_MEM_HEADER_SIZE;
+    }
+    else
+#endif // LLBC_CFG_COM_ALLOCATOR_BACKEND == 1
+    {
+        if (UNLIKELY(!(header = reinterpret_cast<_Header *>(::malloc(totalSize)))))
+            return NULL;
+
+        header->sizeClass = __LLBC_MEM_LARGE_CLASS;
+        header->size = size;
+    }
+
+    header->tag = static_cast<uint32>(tag);
+    LLBC_INL_NS __LLBC_MemStatAlloc(header->tag, header->size);
+
+    return header + 1;
+}
+
+void *__LLBC_Calloc(int tag, size_t size)
+{
+    void *mem = __LLBC_Malloc(tag, size);
+    if (LIKELY(mem))
+        ::memset(mem, 0, size);
+
+    return mem;
+}
+
+void *__LLBC_Realloc(int tag, void *memblock, size_t size)
+{
+    typedef LLBC_INL_NS __LLBC_MemBlockHeader _Header;
+
+    if (!memblock)
+        return __LLBC_Malloc(tag, size);
+    else if (size == 0)
+    {
+        __LLBC_Free(memblock);
+        return NULL;
+    }
+
+    // Reallocated block keep original block tag.
+    _Header *header = reinterpret_cast<_Header *>(memblock) - 1;
+    if (header->sizeClass != __LLBC_MEM_LARGE_CLASS)
+    {
+        // Small block, if capacity enough, reuse it.
+        if (size <= header->size)
+            return memblock;
+
+        void *newBlock = __LLBC_Malloc(static_cast<int>(header->tag), size);
+        if (UNLIKELY(!newBlock))
+            return NULL;
+
+        ::memcpy(newBlock, memblock, static_cast<size_t>(header->size));
+        __LLBC_Free(memblock);
+
+        return newBlock;
+    }
+
+    // Large block, realloc from system allocator.
+    if (UNLIKELY(size > static_cast<size_t>(-1) - __LLBC_MEM_HEADER_SIZE))
+        return NULL;
+
+    const uint32 blockTag = header->tag;
+    const uint64 oldSize = header->size;
+    _Header *newHeader = reinterpret_cast<_Header *>(::realloc(header, size + __LLBC_MEM_HEADER_SIZE));
+    if (UNLIKELY(!newHeader))
+        return NULL;
+
+    newHeader->size = size;
+    LLBC_INL_NS __LLBC_MemStatFree(blockTag, oldSize);
+    LLBC_INL_NS __LLBC_MemStatAlloc(blockTag, size);
+
+    return newHeader + 1;
+}
+
+void __LLBC_Free(void *memblock)
+{
+    typedef LLBC_INL_NS __LLBC_MemBlockHeader _Header;
+
+    if (UNLIKELY(!memblock))
+        return;
+
+    _Header *header = reinterpret_cast<_Header *>(memblock) - 1;
+    LLBC_INL_NS __LLBC_MemStatFree(header->tag, header->size);
+
+#if LLBC_CFG_COM_ALLOCATOR_BACKEND == 1
+    LLBC_INL_NS __LLBC_MemThreadCache *tc;
+    if (header->sizeClass != __LLBC_MEM_LARGE_CLASS &&
+        LIKELY((tc = LLBC_INL_NS __LLBC_MemGetThreadCache()) != NULL))
+    {
+        const int cls = static_cast<int>(header->sizeClass);
+        LLBC_INL_NS __LLBC_MemFreeList &list = tc->lists[cls];
+
+        LLBC_INL_NS __LLBC_MemFreeNode *node = reinterpret_cast<LLBC_INL_NS __LLBC_MemFreeNode *>(header);
+        node->next = list.head;
+        list.head = node;
+
+        if (UNLIKELY(++list.count > LLBC_INL_NS __g_classCacheLimits[cls]))
+            LLBC_INL_NS __LLBC_MemReleaseToCentral(cls, list, LLBC_INL_NS __g_classBatches[cls]);
+
+        return;
+    }
+#endif // LLBC_CFG_COM_ALLOCATOR_BACKEND == 1
+
+    ::free(header);
+}
+
+int LLBC_GetMemoryTagStat(int tag, LLBC_MemoryTagStat &stat)
+{
+#if LLBC_CFG_COM_ALLOCATOR_ENABLE_TAG_STAT
+    if (UNLIKELY(!LLBC_MemoryTag::IsLegal(tag)))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    stat.inUseBytes = LLBC_AtomicGet(&LLBC_INL_NS __g_tagInUseBytes[tag]);
+    stat.inUseBlocks = LLBC_AtomicGet(&LLBC_INL_NS __g_tagInUseBlocks[tag]);
+    stat.totalAllocTimes = LLBC_AtomicGet(&LLBC_INL_NS __g_tagTotalAllocTimes[tag]);
+
+    return LLBC_OK;
+#else // !LLBC_CFG_COM_ALLOCATOR_ENABLE_TAG_STAT
+    LLBC_UNUSED_PARAM(tag);
+    LLBC_UNUSED_PARAM(stat);
+
+    LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
+    return LLBC_FAILED;
+#endif // LLBC_CFG_COM_ALLOCATOR_ENABLE_TAG_STAT
+}
+
+void LLBC_FlushAllocatorThreadCache()
+{
+    LLBC_INL_NS __LLBC_MemThreadCache *tc = LLBC_INL_NS __g_threadCache;
+    if (tc)
+        LLBC_INL_NS __LLBC_MemFlushThreadCache(tc);
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
@@ -23,8 +23,23 @@
 #include "llbc/common/BeforeIncl.h"
 
 #include "llbc/common/Config.h"
+#include "llbc/common/Compiler.h"
 #include "llbc/common/Endian.h"
 
+// SIMD(SSSE3/AVX2) reverse bytes kernels only available in x86/x86_64 processor & gcc/clang/msvc compiler.
+#if (LLBC_TARGET_PROCESSOR_X86 || LLBC_TARGET_PROCESSOR_X86_64) && \
+    (LLBC_CUR_COMP == LLBC_COMP_GCC || (LLBC_CUR_COMP == LLBC_COMP_MSVC && LLBC_COMP_VER >= 1700))
+ #define LLBC_REVERSE_BYTES_SIMD_ENABLED 1
+ #if LLBC_CUR_COMP == LLBC_COMP_GCC
+  #include <immintrin.h>
+ #else // MSVC
+  #include <intrin.h>
+  #include <immintrin.h>
+ #endif
+#else
+ #define LLBC_REVERSE_BYTES_SIMD_ENABLED 0
+#endif
+
 __LLBC_INTERNAL_NS_BEGIN
 
 static union
@@ -40,6 +55,166 @@ static const char *__g_endian_type_desc[LLBC_NS LLBC_Endian::UnknownEndian + 1]
     "unknown endian"
 };
 
+static void __ReverseBytesArray_Scalar(LLBC_NS uint8 *bytes, size_t elemSize, size_t count)
+{
+    const LLBC_NS uint8 *bytesEnd = bytes + elemSize * count;
+    switch (elemSize)
+    {
+    case 1:
+        break;
+
+    case 2:
+        for (; bytes != bytesEnd; bytes += 2)
+        {
+            LLBC_NS uint16 val;
+            memcpy(&val, bytes, 2);
+            val = static_cast<LLBC_NS uint16>((val >> 8) | (val << 8));
+            memcpy(bytes, &val, 2);
+        }
+        break;
+
+    case 4:
+        for (; bytes != bytesEnd; bytes += 4)
+        {
+            LLBC_NS uint32 val;
+            memcpy(&val, bytes, 4);
+            val = (val >> 24) | ((val >> 8) & 0x0000ff00) | ((val << 8) & 0x00ff0000) | (val << 24);
+            memcpy(bytes, &val, 4);
+        }
+        break;
+
+    case 8:
+        for (; bytes != bytesEnd; bytes += 8)
+        {
+            LLBC_NS uint32 part1, part2;
+            memcpy(&part1, bytes, 4);
+            memcpy(&part2, bytes + 4, 4);
+            part1 = (part1 >> 24) | ((part1 >> 8) & 0x0000ff00) | ((part1 << 8) & 0x00ff0000) | (part1 << 24);
+            part2 = (part2 >> 24) | ((part2 >> 8) & 0x0000ff00) | ((part2 << 8) & 0x00ff0000) | (part2 << 24);
+            memcpy(bytes, &part2, 4);
+            memcpy(bytes + 4, &part1, 4);
+        }
+        break;
+
+    default:
+        for (; bytes != bytesEnd; bytes += elemSize)
+        {
+            for (size_t i = 0; i < elemSize / 2; ++i)
+            {
+                const LLBC_NS uint8 byte = bytes[i];
+                bytes[i] = bytes[elemSize - i - 1];
+                bytes[elemSize - i - 1] = byte;
+            }
+        }
+        break;
+    }
+}
+
+#if LLBC_REVERSE_BYTES_SIMD_ENABLED
+// Byte shuffle masks of 16/32/64 bits elements, 32 bytes(AVX2 lane size * 2).
+static const LLBC_NS uint8 __g_reverseBytesMasks[3][32] =
+{
+    {1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14},
+    {3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12},
+    {7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8}
+};
+
+// SIMD reverse bytes kernel, return reversed bytes(multiple of 16 bytes).
+typedef size_t (*__ReverseBytesKernel)(LLBC_NS uint8 *bytes, size_t size, const LLBC_NS uint8 *mask);
+
+#if LLBC_CUR_COMP == LLBC_COMP_GCC
+__attribute__((target("ssse3")))
+#endif
+static size_t __ReverseBytesArray_SSSE3(LLBC_NS uint8 *bytes, size_t size, const LLBC_NS uint8 *mask)
+{
+    const __m128i shuffleMask = _mm_loadu_si128(reinterpret_cast<const __m128i *>(mask));
+
+    size_t reversed = 0;
+    for (; reversed + 16 <= size; reversed += 16)
+    {
+        __m128i *ptr = reinterpret_cast<__m128i *>(bytes + reversed);
+        _mm_storeu_si128(ptr, _mm_shuffle_epi8(_mm_loadu_si128(ptr), shuffleMask));
+    }
+
+    return reversed;
+}
+
+#if LLBC_CUR_COMP == LLBC_COMP_GCC
+__attribute__((target("avx2")))
+#endif
+static size_t __ReverseBytesArray_AVX2(LLBC_NS uint8 *bytes, size_t size, const LLBC_NS uint8 *mask)
+{
+    const __m256i shuffleMask = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(mask));
+
+    size_t reversed = 0;
+    for (; reversed + 32 <= size; reversed += 32)
+    {
+        __m256i *ptr = reinterpret_cast<__m256i *>(bytes + reversed);
+        _mm256_storeu_si256(ptr, _mm256_shuffle_epi8(_mm256_loadu_si256(ptr), shuffleMask));
+    }
+
+    // The remaining 16 bytes block(if exist).
+    if (reversed + 16 <= size)
+    {
+        __m128i *ptr = reinterpret_cast<__m128i *>(bytes + reversed);
+        _mm_storeu_si128(ptr, _mm_shuffle_epi8(_mm_loadu_si128(ptr), _mm256_castsi256_si128(shuffleMask)));
+        reversed += 16;
+    }
+
+    return reversed;
+}
+
+static void __DetectSIMDSupport(bool &ssse3Supported, bool &avx2Supported)
+{
+#if LLBC_CUR_COMP == LLBC_COMP_GCC
+    __builtin_cpu_init();
+    ssse3Supported = __builtin_cpu_supports("ssse3") != 0;
+    avx2Supported = __builtin_cpu_supports("avx2") != 0;
+#else // MSVC
+    int cpuInfo[4];
+    __cpuid(cpuInfo, 0);
+    const int maxLeaf = cpuInfo[0];
+
+    __cpuid(cpuInfo, 1);
+    ssse3Supported = (cpuInfo[2] & (1 << 9)) != 0;
+
+    // AVX2 need cpu support and OS enabled YMM state save(OSXSAVE + XCR0 bit 1/2).
+    avx2Supported = false;
+    const bool osxsave = (cpuInfo[2] & (1 << 27)) != 0;
+    const bool avx = (cpuInfo[2] & (1 << 28)) != 0;
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x06) == 0x06)
+    {
+        __cpuidex(cpuInfo, 7, 0);
+        avx2Supported = (cpuInfo[1] & (1 << 5)) != 0;
+    }
+#endif // LLBC_CUR_COMP == LLBC_COMP_GCC
+}
+
+static __ReverseBytesKernel __SelectReverseBytesKernel(const char *&kernelName)
+{
+    bool ssse3Supported, avx2Supported;
+    __DetectSIMDSupport(ssse3Supported, avx2Supported);
+    if (avx2Supported)
+    {
+        kernelName = "avx2";
+        return &__ReverseBytesArray_AVX2;
+    }
+    else if (ssse3Supported)
+    {
+        kernelName = "ssse3";
+        return &__ReverseBytesArray_SSSE3;
+    }
+
+    kernelName = "scalar";
+    return NULL;
+}
+
+static const char *__g_reverseBytesKernelName = "scalar";
+static __ReverseBytesKernel __g_reverseBytesKernel = __SelectReverseBytesKernel(__g_reverseBytesKernelName);
+#else // !LLBC_REVERSE_BYTES_SIMD_ENABLED
+static const char *__g_reverseBytesKernelName = "scalar";
+#endif // LLBC_REVERSE_BYTES_SIMD_ENABLED
+
 __LLBC_INTERNAL_NS_END
 
 __LLBC_NS_BEGIN
@@ -109,6 +284,31 @@ int LLBC_GetMachineEndianType()
         LLBC_Endian::LittleEndian : LLBC_Endian::BigEndian;
 }
 
+void LLBC_ReverseBytesArray(void *buf, size_t elemSize, size_t count)
+{
+    uint8 *bytes = reinterpret_cast<uint8 *>(buf);
+#if LLBC_REVERSE_BYTES_SIMD_ENABLED
+    // Use SIMD kernel to reverse 16/32/64 bits elements(16/32 bytes per loop), remaining elements use scalar impl.
+    if (LLBC_INTERNAL_NS __g_reverseBytesKernel &&
+        (elemSize == 2 || elemSize == 4 || elemSize == 8))
+    {
+        const int maskIdx = elemSize == 2 ? 0 : (elemSize == 4 ? 1 : 2);
+        const size_t reversed = (*LLBC_INTERNAL_NS __g_reverseBytesKernel)(
+            bytes, elemSize * count, LLBC_INTERNAL_NS __g_reverseBytesMasks[maskIdx]);
+
+        bytes += reversed;
+        count -= reversed / elemSize;
+    }
+#endif // LLBC_REVERSE_BYTES_SIMD_ENABLED
+
+    LLBC_INTERNAL_NS __ReverseBytesArray_Scalar(bytes, elemSize, count);
+}
+
+const char *LLBC_GetReverseBytesArrayImpl()
+{
+    return LLBC_INTERNAL_NS __g_reverseBytesKernelName;
+}
+
 __LLBC_NS_END
 
 #include "llbc/common/AfterIncl.h"
@@ -58,6 +58,19 @@ LLBC_Event::~LLBC_Event()
         LLBC_Delete(_strKeyParams);
 }
 
+LLBC_Event *LLBC_Event::Clone() const
+{
+    LLBC_Event *clone = LLBC_New1(LLBC_Event, _id);
+    if (_intKeyParams)
+        clone->_intKeyParams = LLBC_New1(_IntKeyParams, *_intKeyParams);
+    if (_constantStrKeyParams)
+        clone->_constantStrKeyParams = LLBC_New1(_ConstantStrKeyParams, *_constantStrKeyParams);
+    if (_strKeyParams)
+        clone->_strKeyParams = LLBC_New1(_StrKeyParams, *_strKeyParams);
+
+    return clone;
+}
+
 const LLBC_Variant &LLBC_Event::GetParam(int key) const
 {
     if (_intKeyParams == NULL)
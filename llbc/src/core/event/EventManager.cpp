@@ -35,6 +35,7 @@ LLBC_EventManager::_Listener::_Listener()
 
 , evId(0)
 , listener(NULL)
+, typedListener(NULL)
 {
 }
 
@@ -51,7 +52,8 @@ LLBC_EventManager::~LLBC_EventManager()
          ++it)
     {
         _Op &op = *it;
-        LLBC_Delete(op.listener.listener);
+        LLBC_XDelete(op.listener.listener);
+        LLBC_XDelete(op.listener.typedListener);
     }
 
     for (_ListenersMap::iterator mIt = _listeners.begin();
@@ -67,26 +69,74 @@ LLBC_EventManager::~LLBC_EventManager()
             LLBC_Delete(listener.listener);
         }
     }
+
+    for (_TypedListenersTable::iterator tIt = _typedListeners.begin();
+         tIt != _typedListeners.end();
+         ++tIt)
+    {
+        _Listeners &listeners = *tIt;
+        for (_Listeners::iterator lIt = listeners.begin();
+             lIt != listeners.end();
+             ++lIt)
+        {
+            _Listener &listener = *lIt;
+            LLBC_Delete(listener.typedListener);
+        }
+    }
 }
 
 LLBC_ListenerStub LLBC_EventManager::AddListener(int id,
                                                  LLBC_IDelegate1<void, LLBC_Event *> *listener,
                                                  const LLBC_ListenerStub &bindedStub)
 {
-    if (id <= 0 || listener == NULL)
+    if (listener == NULL)
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_INVALID_LISTENER_STUB;
+    }
+
+    return AddListenerImpl(id, listener, NULL, NULL, bindedStub);
+}
+
+LLBC_ListenerStub LLBC_EventManager::AddListenerImpl(int id,
+                                                     LLBC_IDelegate1<void, LLBC_Event *> *listener,
+                                                     LLBC_IDelegate1<void, const void *> *typedListener,
+                                                     const void *typedEventTag,
+                                                     const LLBC_ListenerStub &bindedStub)
+{
+    if (id <= 0)
     {
         LLBC_XDelete(listener);
+        LLBC_XDelete(typedListener);
 
         LLBC_SetLastError(LLBC_ERROR_ARG);
         return LLBC_INVALID_LISTENER_STUB;
     }
+    else if (typedListener && id > LLBC_CFG_CORE_EVENT_TYPED_EVENT_MAX_ID)
+    {
+        LLBC_Delete(typedListener);
+
+        LLBC_SetLastError(LLBC_ERROR_LIMIT);
+        return LLBC_INVALID_LISTENER_STUB;
+    }
+    else if (typedListener &&
+             static_cast<size_t>(id) < _typedEventTags.size() &&
+             _typedEventTags[id] != NULL &&
+             _typedEventTags[id] != typedEventTag)
+    {
+        LLBC_Delete(typedListener);
+
+        LLBC_SetLastError(LLBC_ERROR_INVALID);
+        return LLBC_INVALID_LISTENER_STUB;
+    }
 
     LLBC_ListenerStub stub;
     if (bindedStub != LLBC_INVALID_LISTENER_STUB)
     {
         if (SearchStub(bindedStub))
         {
-            LLBC_Delete(listener);
+            LLBC_XDelete(listener);
+            LLBC_XDelete(typedListener);
 
             LLBC_SetLastError(LLBC_ERROR_REPEAT);
             return LLBC_INVALID_LISTENER_STUB;
@@ -97,11 +147,20 @@ LLBC_ListenerStub LLBC_EventManager::AddListener(int id,
     else
         stub = ++_maxListenerStub;
 
+    // Bind event type to event Id when first typed listener added.
+    if (typedListener)
+    {
+        if (static_cast<size_t>(id) >= _typedEventTags.size())
+            _typedEventTags.resize(id + 1, NULL);
+        _typedEventTags[id] = typedEventTag;
+    }
+
     _Op op;
     op.addOp = true;
     op.listener.evId = id;
     op.listener.stub = stub;
     op.listener.listener = listener;
+    op.listener.typedListener = typedListener;
 
     if (IsFiring())
     {
@@ -113,7 +172,8 @@ LLBC_ListenerStub LLBC_EventManager::AddListener(int id,
 
     if (ProcessEventOperation(op) != LLBC_OK)
     {
-        LLBC_Delete(listener);
+        LLBC_XDelete(listener);
+        LLBC_XDelete(typedListener);
         return LLBC_INVALID_LISTENER_STUB;
     }
 
@@ -198,12 +258,22 @@ int LLBC_EventManager::ProcessEventOperation(LLBC_EventManager::_Op &op)
     _Listener &listener = op.listener;
     if (op.addOp)
     {
-        _ListenersMap::iterator mIt = _listeners.find(listener.evId);
-        if (mIt == _listeners.end())
-            mIt = _listeners.insert(std::make_pair(listener.evId, std::vector<_Listener>())).first;
+        if (listener.typedListener)
+        {
+            if (static_cast<size_t>(listener.evId) >= _typedListeners.size())
+                _typedListeners.resize(listener.evId + 1);
 
-        _Listeners &listeners = mIt->second;
-        listeners.push_back(listener);
+            _typedListeners[listener.evId].push_back(listener);
+        }
+        else
+        {
+            _ListenersMap::iterator mIt = _listeners.find(listener.evId);
+            if (mIt == _listeners.end())
+                mIt = _listeners.insert(std::make_pair(listener.evId, std::vector<_Listener>())).first;
+
+            _Listeners &listeners = mIt->second;
+            listeners.push_back(listener);
+        }
 
         _stubListeners.insert(std::make_pair(listener.stub, listener));
     }
@@ -211,25 +281,48 @@ int LLBC_EventManager::ProcessEventOperation(LLBC_EventManager::_Op &op)
     {
         if (listener.evId > 0)
         {
+            bool found = false;
             _ListenersMap::iterator mIt = _listeners.find(listener.evId);
-            if (mIt == _listeners.end())
+            if (mIt != _listeners.end())
             {
-                LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
-                return LLBC_FAILED;
+                _Listeners &listeners = mIt->second;
+                for (_Listeners::iterator lIt = listeners.begin();
+                     lIt != listeners.end();
+                     lIt++)
+                {
+                    _Listener &l = *lIt;
+
+                    _stubListeners.erase(l.stub);
+                    LLBC_Delete(l.listener);
+                }
+
+                _listeners.erase(mIt);
+                found = true;
             }
 
-            _Listeners &listeners = mIt->second;
-            for (_Listeners::iterator lIt = listeners.begin();
-                 lIt != listeners.end();
-                 lIt++)
+            if (static_cast<size_t>(listener.evId) < _typedListeners.size() &&
+                !_typedListeners[listener.evId].empty())
             {
-                _Listener &l = *lIt;
+                _Listeners &listeners = _typedListeners[listener.evId];
+                for (_Listeners::iterator lIt = listeners.begin();
+                     lIt != listeners.end();
+                     lIt++)
+                {
+                    _Listener &l = *lIt;
 
-                _stubListeners.erase(l.stub);
-                LLBC_Delete(l.listener);
+                    _stubListeners.erase(l.stub);
+                    LLBC_Delete(l.typedListener);
+                }
+
+                listeners.clear();
+                found = true;
             }
 
-            _listeners.erase(mIt);
+            if (!found)
+            {
+                LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
+                return LLBC_FAILED;
+            }
         }
         else
         {
@@ -241,6 +334,27 @@ int LLBC_EventManager::ProcessEventOperation(LLBC_EventManager::_Op &op)
             }
             
             const int evId = stubIt->second.evId;
+            if (stubIt->second.typedListener)
+            {
+                _Listeners &listeners = _typedListeners[evId];
+                for (_Listeners::iterator lIt = listeners.begin();
+                     lIt != listeners.end();
+                     lIt++)
+                {
+                    _Listener &l = *lIt;
+                    if (l.stub == listener.stub)
+                    {
+                        LLBC_Delete(l.typedListener);
+                        listeners.erase(lIt);
+                        break;
+                    }
+                }
+
+                _stubListeners.erase(stubIt);
+
+                return LLBC_OK;
+            }
+
             _ListenersMap::iterator mIt = _listeners.find(evId);
 
             _Listeners &listeners = mIt->second;
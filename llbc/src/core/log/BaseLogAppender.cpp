@@ -22,7 +22,9 @@
 #include "llbc/common/Export.h"
 #include "llbc/common/BeforeIncl.h"
 
+#include "llbc/core/log/LogData.h"
 #include "llbc/core/log/LogLevel.h"
+#include "llbc/core/log/LogFormatCache.h"
 #include "llbc/core/log/LogTokenChain.h"
 #include "llbc/core/log/BaseLogAppender.h"
 
@@ -33,6 +35,8 @@ LLBC_BaseLogAppender::LLBC_BaseLogAppender()
 
 , _chain(NULL)
 , _next(NULL)
+
+, _formattedData()
 {
 }
 
@@ -67,10 +71,26 @@ void LLBC_BaseLogAppender::Finalize()
     _level = LLBC_LogLevel::End;
 }
 
+const LLBC_String &LLBC_BaseLogAppender::FormatLogData(const LLBC_LogData &data)
+{
+    if (LIKELY(data.fmtCache))
+        return data.fmtCache->Format(_chain, data);
+
+    _formattedData.clear();
+    _chain->Format(data, _formattedData);
+
+    return _formattedData;
+}
+
 void LLBC_BaseLogAppender::Flush()
 {
 }
 
+bool LLBC_BaseLogAppender::HasPendingOutput() const
+{
+    return false;
+}
+
 __LLBC_NS_END
 
 #include "llbc/common/AfterIncl.h"
@@ -22,9 +22,11 @@
 #include "llbc/common/Export.h"
 #include "llbc/common/BeforeIncl.h"
 
+#include "llbc/core/os/OS_Atomic.h"
 #include "llbc/core/os/OS_Console.h"
 #include "llbc/core/thread/Guard.h"
 #include "llbc/core/utils/Util_Debug.h"
+#include "llbc/core/objectpool/Common.h"
 
 #include "llbc/core/log/Logger.h"
 #include "llbc/core/log/LoggerManager.h"
@@ -51,6 +53,7 @@ LLBC_LogHelper &__LLBC_GetLogHelper()
 
 LLBC_Logger *LLBC_LogHelper::_rootLogger = NULL;
 LLBC_LoggerManager *LLBC_LogHelper::_loggerManager = NULL;
+volatile sint32 LLBC_LogHelper::_minLogLevel = LLBC_LogLevel::Begin;
 
 #define __LLBC_LOG_TO_ROOT(level, fmt)                                        \
     do                                                                        \
@@ -58,13 +61,13 @@ LLBC_LoggerManager *LLBC_LogHelper::_loggerManager = NULL;
         if (LIKELY(_rootLogger))                                              \
         {                                                                     \
             if (level < _rootLogger->GetLogLevel())                           \
+                break;                                                        \
+            if (_rootLogger->_rateLimiter && _rootLogger->IsSuppressed(NULL)) \
                 break;                                                        \
                                                                               \
             char *fmttedMsg; int msgLen;                                      \
             LLBC_FormatArg(fmt, fmttedMsg, msgLen);                           \
-            _rootLogger->OutputNonFormat(level, NULL, __FILE__, __LINE__, fmttedMsg, msgLen); \
-                                                                              \
-            LLBC_Free(fmttedMsg);                                             \
+            _rootLogger->DirectOutput(level, NULL, __FILE__, __LINE__, fmttedMsg, msgLen); \
         }                                                                     \
         else                                                                  \
         {                                                                     \
@@ -76,46 +79,72 @@ LLBC_LoggerManager *LLBC_LogHelper::_loggerManager = NULL;
         }                                                                     \
     } while (0)                                                               \
 
-#define __LLBC_LOG_TO_SPEC(logger, level, tag, fmt)                           \
+#define __LLBC_LOG_TO_LOGGER(l, level, tag, fmt)                             \
     do                                                                        \
     {                                                                         \
-        if (UNLIKELY(!_rootLogger))                                           \
+        if (LIKELY(l))                                                        \
+        {                                                                     \
+            if (level < l->GetLogLevel())                                     \
+                break;                                                        \
+            if (l->_rateLimiter && l->IsSuppressed(tag))                      \
+                break;                                                        \
+                                                                              \
+            char *fmttedMsg; int msgLen;                                      \
+            LLBC_FormatArg(fmt, fmttedMsg, msgLen);                           \
+            l->DirectOutput(level, tag, __FILE__, __LINE__, fmttedMsg, msgLen); \
+        }                                                                     \
+        else if (UNLIKELY(!_rootLogger))                                      \
         {                                                                     \
             char *fmttedMsg; int msgLen;                                      \
             LLBC_FormatArg(fmt, fmttedMsg, msgLen);                           \
             UnInitOutput(level >= _LV::Warn ? stderr : stdout, fmttedMsg);    \
                                                                               \
             LLBC_Free(fmttedMsg);                                             \
-            break;                                                            \
         }                                                                     \
+    } while (0)                                                               \
+
+#define __LLBC_LOG_TO_SPEC(logger, level, tag, fmt)                           \
+    do                                                                        \
+    {                                                                         \
+        if (level < _minLogLevel)                                             \
+            break;                                                            \
                                                                               \
         LLBC_Logger *l = NULL;                                                \
         if (logger == NULL)                                                   \
             l = _rootLogger;                                                  \
-        else                                                                  \
+        else if (LIKELY(_loggerManager))                                      \
             l = _loggerManager->GetLogger(logger);                            \
                                                                               \
-        if (LIKELY(l))                                                        \
-        {                                                                     \
-            if (level < l->GetLogLevel())                                     \
-                break;                                                        \
+        __LLBC_LOG_TO_LOGGER(l, level, tag, fmt);                             \
+    } while (0)                                                               \
+
+#define __LLBC_JLOG_TO_LOGGER(l, tag, lv)                                     \
+    if (LIKELY(l))                                                            \
+    {                                                                         \
+        if (lv < l->GetLogLevel())                                            \
+            return LLBC_LogJsonMsg::_disabledMsg;                             \
+    }                                                                         \
+    else if (LIKELY(_rootLogger))                                             \
+    {                                                                         \
+        return LLBC_LogJsonMsg::_disabledMsg;                                 \
+    }                                                                         \
                                                                               \
-            char *fmttedMsg; int msgLen;                                      \
-            LLBC_FormatArg(fmt, fmttedMsg, msgLen);                           \
-            l->OutputNonFormat(level, tag, __FILE__, __LINE__, fmttedMsg, msgLen); \
+    LLBC_LogJsonMsg *jsonMsg = LLBC_GetObjectFromUnsafetyPool<LLBC_LogJsonMsg>(); \
+    jsonMsg->Init(_rootLogger != NULL, l, tag, lv);                           \
                                                                               \
-            LLBC_Free(fmttedMsg);                                             \
-        }                                                                     \
-    } while (0)                                                               \
+    return *jsonMsg;                                                          \
 
 #define __LLBC_JLOG_TO_SPEC(logger, tag, lv)                                  \
+    if (lv < _minLogLevel)                                                    \
+        return LLBC_LogJsonMsg::_disabledMsg;                                 \
+                                                                              \
     LLBC_Logger *l = NULL;                                                    \
     if (logger == NULL)                                                       \
         l = _rootLogger;                                                      \
     else if (LIKELY(_loggerManager))                                          \
         l = _loggerManager->GetLogger(logger);                                \
                                                                               \
-    return *LLBC_New4(LLBC_LogJsonMsg, _rootLogger != NULL, l, tag, lv);      \
+    __LLBC_JLOG_TO_LOGGER(l, tag, lv)                                         \
 
 
 int LLBC_LogHelper::init(const LLBC_String &cfgFile)
@@ -128,7 +157,7 @@ void LLBC_LogHelper::destroy()
     LLBC_LoggerManagerSingleton->Finalize();
 }
 
-void LLBC_LogHelper::Initialize(LLBC_LoggerManager *loggerManager)
+void LLBC_LogHelper::Initialize(LLBC_LoggerManager *loggerManager, int minLogLevel)
 {
     if (UNLIKELY(_rootLogger))
     {
@@ -138,6 +167,7 @@ void LLBC_LogHelper::Initialize(LLBC_LoggerManager *loggerManager)
 
     _loggerManager = loggerManager;
     _rootLogger = _loggerManager->GetRootLogger();
+    LLBC_AtomicSet(&_minLogLevel, minLogLevel);
 }
 
 void LLBC_LogHelper::Finalize()
@@ -148,10 +178,43 @@ void LLBC_LogHelper::Finalize()
         return;
     }
 
+    LLBC_AtomicSet(&_minLogLevel, LLBC_LogLevel::Begin);
     _loggerManager = NULL;
     _rootLogger = NULL;
 }
 
+void LLBC_LogHelper::LowerMinLogLevel(int level)
+{
+    sint32 minLogLevel = _minLogLevel;
+    while (level < minLogLevel)
+    {
+        const sint32 oldMinLogLevel = LLBC_AtomicCompareAndExchange(&_minLogLevel, level, minLogLevel);
+        if (oldMinLogLevel == minLogLevel)
+            break;
+
+        minLogLevel = oldMinLogLevel;
+    }
+}
+
+LLBC_Logger *LLBC_LogHelper::GetLogger(const char *logger)
+{
+    if (logger == NULL)
+    {
+        if (UNLIKELY(!_rootLogger))
+            LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+
+        return _rootLogger;
+    }
+
+    if (UNLIKELY(!_loggerManager))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return NULL;
+    }
+
+    return _loggerManager->GetLogger(logger);
+}
+
 void LLBC_LogHelper::d(const char *fmt, ...)
 {
     __LLBC_LOG_TO_ROOT(_LV::Debug, fmt);
@@ -192,6 +255,16 @@ LLBC_LogJsonMsg &LLBC_LogHelper::jd4(const char *logger, const char *tag)
     __LLBC_JLOG_TO_SPEC(logger, tag, _LV::Debug);
 }
 
+void LLBC_LogHelper::d5(LLBC_Logger *logger, const char *tag, const char *fmt, ...)
+{
+    __LLBC_LOG_TO_LOGGER(logger, _LV::Debug, tag, fmt);
+}
+
+LLBC_LogJsonMsg &LLBC_LogHelper::jd5(LLBC_Logger *logger, const char *tag)
+{
+    __LLBC_JLOG_TO_LOGGER(logger, tag, _LV::Debug);
+}
+
 void LLBC_LogHelper::i(const char *fmt, ...)
 {
     __LLBC_LOG_TO_ROOT(_LV::Info, fmt);
@@ -232,6 +305,16 @@ LLBC_LogJsonMsg &LLBC_LogHelper::ji4(const char *logger, const char *tag)
     __LLBC_JLOG_TO_SPEC(logger, tag, _LV::Info);
 }
 
+void LLBC_LogHelper::i5(LLBC_Logger *logger, const char *tag, const char *fmt, ...)
+{
+    __LLBC_LOG_TO_LOGGER(logger, _LV::Info, tag, fmt);
+}
+
+LLBC_LogJsonMsg &LLBC_LogHelper::ji5(LLBC_Logger *logger, const char *tag)
+{
+    __LLBC_JLOG_TO_LOGGER(logger, tag, _LV::Info);
+}
+
 void LLBC_LogHelper::w(const char *fmt, ...)
 {
     __LLBC_LOG_TO_ROOT(_LV::Warn, fmt);
@@ -272,6 +355,16 @@ LLBC_LogJsonMsg &LLBC_LogHelper::jw4(const char *logger, const char *tag)
     __LLBC_JLOG_TO_SPEC(logger, tag, _LV::Warn);
 }
 
+void LLBC_LogHelper::w5(LLBC_Logger *logger, const char *tag, const char *fmt, ...)
+{
+    __LLBC_LOG_TO_LOGGER(logger, _LV::Warn, tag, fmt);
+}
+
+LLBC_LogJsonMsg &LLBC_LogHelper::jw5(LLBC_Logger *logger, const char *tag)
+{
+    __LLBC_JLOG_TO_LOGGER(logger, tag, _LV::Warn);
+}
+
 void LLBC_LogHelper::e(const char *fmt, ...)
 {
     __LLBC_LOG_TO_ROOT(_LV::Error, fmt);
@@ -312,6 +405,16 @@ LLBC_LogJsonMsg &LLBC_LogHelper::je4(const char *logger, const char *tag)
     __LLBC_JLOG_TO_SPEC(logger, tag, _LV::Error);
 }
 
+void LLBC_LogHelper::e5(LLBC_Logger *logger, const char *tag, const char *fmt, ...)
+{
+    __LLBC_LOG_TO_LOGGER(logger, _LV::Error, tag, fmt);
+}
+
+LLBC_LogJsonMsg &LLBC_LogHelper::je5(LLBC_Logger *logger, const char *tag)
+{
+    __LLBC_JLOG_TO_LOGGER(logger, tag, _LV::Error);
+}
+
 void LLBC_LogHelper::f(const char *fmt, ...)
 {
     __LLBC_LOG_TO_ROOT(_LV::Fatal, fmt);
@@ -352,6 +455,16 @@ LLBC_LogJsonMsg &LLBC_LogHelper::jf4(const char *logger, const char *tag)
     __LLBC_JLOG_TO_SPEC(logger, tag, _LV::Fatal);
 }
 
+void LLBC_LogHelper::f5(LLBC_Logger *logger, const char *tag, const char *fmt, ...)
+{
+    __LLBC_LOG_TO_LOGGER(logger, _LV::Fatal, tag, fmt);
+}
+
+LLBC_LogJsonMsg &LLBC_LogHelper::jf5(LLBC_Logger *logger, const char *tag)
+{
+    __LLBC_JLOG_TO_LOGGER(logger, tag, _LV::Fatal);
+}
+
 void LLBC_LogHelper::UnInitOutput(FILE *to, const char *msg)
 {
     LLBC_FilePrint(to, "[Log] %s\n", msg);
@@ -361,7 +474,9 @@ void LLBC_LogHelper::UnInitOutput(FILE *to, const char *msg)
 
 //! At latest, undef code define macros.
 #undef __LLBC_LOG_TO_ROOT
+#undef __LLBC_LOG_TO_LOGGER
 #undef __LLBC_LOG_TO_SPEC
+#undef __LLBC_JLOG_TO_LOGGER
 #undef __LLBC_JLOG_TO_SPEC
 
 __LLBC_NS_END
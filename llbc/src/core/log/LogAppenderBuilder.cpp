@@ -24,6 +24,7 @@
 
 #include "llbc/core/log/LogConsoleAppender.h"
 #include "llbc/core/log/LogFileAppender.h"
+#include "llbc/core/log/LogMmapFileAppender.h"
 #include "llbc/core/log/LogNetworkAppender.h"
 
 #include "llbc/core/log/LogAppenderBuilder.h"
@@ -55,6 +56,10 @@ LLBC_ILogAppender *LLBC_LogAppenderBuilder::BuildAppender(int type) const
         appender = LLBC_New0(LLBC_LogNetworkAppender);
         break;
 
+    case LLBC_LogAppenderType::MmapFile:
+        appender = LLBC_New0(LLBC_LogMmapFileAppender);
+        break;
+
     default:
         break;
     }
@@ -0,0 +1,416 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/core/log/LogData.h"
+#include "llbc/core/log/LogArg.h"
+#include "llbc/core/log/LogJsonMsg.h"
+
+#if LLBC_TARGET_PLATFORM_WIN32
+#pragma warning(disable:4996)
+#endif
+
+__LLBC_INTERNAL_NS_BEGIN
+
+/**
+ * The serialized argument structure.
+ */
+struct __LLBC_LogSerializedArg
+{
+    int type;
+    union
+    {
+        LLBC_NS sint64 sintVal;
+        LLBC_NS uint64 uintVal;
+        double doubleVal;
+        const void *ptrVal;
+    } val;
+
+    const char *str;
+    LLBC_NS uint32 strLen;
+};
+
+/**
+ * Read next serialized argument.
+ */
+static bool __ReadArg(const char *&args, const char *argsEnd, __LLBC_LogSerializedArg &arg)
+{
+    if (args >= argsEnd)
+        return false;
+
+    arg.type = static_cast<LLBC_NS uint8>(*args++);
+    if (arg.type == LLBC_NS LLBC_LogArg::Str)
+    {
+        ::memcpy(&arg.strLen, args, sizeof(LLBC_NS uint32));
+        args += sizeof(LLBC_NS uint32);
+
+        arg.str = args;
+        args += arg.strLen;
+
+        arg.val.uintVal = 0;
+    }
+    else
+    {
+        ::memcpy(&arg.val, args, sizeof(LLBC_NS uint64));
+        args += sizeof(LLBC_NS uint64);
+    }
+
+    return true;
+}
+
+/**
+ * Get serialized argument integer value.
+ */
+static LLBC_NS sint64 __GetArgSInt(const __LLBC_LogSerializedArg &arg)
+{
+    switch (arg.type)
+    {
+    case LLBC_NS LLBC_LogArg::UInt:
+        return static_cast<LLBC_NS sint64>(arg.val.uintVal);
+    case LLBC_NS LLBC_LogArg::Double:
+        return static_cast<LLBC_NS sint64>(arg.val.doubleVal);
+    case LLBC_NS LLBC_LogArg::Ptr:
+        return static_cast<LLBC_NS sint64>(reinterpret_cast<size_t>(arg.val.ptrVal));
+    default:
+        return arg.val.sintVal;
+    }
+}
+
+/**
+ * Get serialized argument floating point value.
+ */
+static double __GetArgDouble(const __LLBC_LogSerializedArg &arg)
+{
+    switch (arg.type)
+    {
+    case LLBC_NS LLBC_LogArg::Double:
+        return arg.val.doubleVal;
+    case LLBC_NS LLBC_LogArg::UInt:
+        return static_cast<double>(arg.val.uintVal);
+    default:
+        return static_cast<double>(__GetArgSInt(arg));
+    }
+}
+
+/**
+ * Append formatted string to output.
+ */
+static void __AppendFormatted(LLBC_NS LLBC_String &out, const char *spec, ...)
+{
+    char buf[128];
+
+    va_list ap;
+    va_start(ap, spec);
+    int len = vsnprintf(buf, sizeof(buf), spec, ap);
+    va_end(ap);
+
+    if (len < 0)
+        return;
+    if (len < static_cast<int>(sizeof(buf)))
+    {
+        out.append(buf, len);
+        return;
+    }
+
+    const size_t oldSize = out.size();
+    out.resize(oldSize + len + 1);
+
+    va_start(ap, spec);
+    vsnprintf(&out[oldSize], len + 1, spec, ap);
+    va_end(ap);
+
+    out.resize(oldSize + len);
+}
+
+/**
+ * Format one conversion specification with given argument.
+ * @param[in] out   - the output string.
+ * @param[in] spec  - the conversion specification without length modifier and conversion character.
+ * @param[in] conv  - the conversion character.
+ * @param[in] arg   - the argument.
+ */
+static void __FormatArg(LLBC_NS LLBC_String &out,
+                        LLBC_NS LLBC_String &spec,
+                        char conv,
+                        const __LLBC_LogSerializedArg &arg)
+{
+    // String argument always format as string, and string conversion always use argument real type to format.
+    if (arg.type == LLBC_NS LLBC_LogArg::Str)
+    {
+        if (spec.size() == 1)
+        {
+            out.append(arg.str, arg.strLen);
+        }
+        else
+        {
+            const LLBC_NS LLBC_String str(arg.str, arg.strLen);
+            spec.append(1, 's');
+            __AppendFormatted(out, spec.c_str(), str.c_str());
+        }
+
+        return;
+    }
+    else if (conv == 's')
+    {
+        if (arg.type == LLBC_NS LLBC_LogArg::SInt)
+            conv = 'd';
+        else if (arg.type == LLBC_NS LLBC_LogArg::UInt)
+            conv = 'u';
+        else if (arg.type == LLBC_NS LLBC_LogArg::Double)
+            conv = 'g';
+        else
+            conv = 'p';
+    }
+
+    switch (conv)
+    {
+    case 'd':
+    case 'i':
+        spec.append("lld");
+        __AppendFormatted(out, spec.c_str(), static_cast<long long>(__GetArgSInt(arg)));
+        break;
+
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+        spec.append("ll").append(1, conv);
+        __AppendFormatted(out, spec.c_str(), static_cast<unsigned long long>(__GetArgSInt(arg)));
+        break;
+
+    case 'c':
+        spec.append(1, 'c');
+        __AppendFormatted(out, spec.c_str(), static_cast<int>(__GetArgSInt(arg)));
+        break;
+
+    case 'e':
+    case 'E':
+    case 'f':
+    case 'F':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        spec.append(1, conv);
+        __AppendFormatted(out, spec.c_str(), __GetArgDouble(arg));
+        break;
+
+    case 'p':
+        spec.append(1, 'p');
+        __AppendFormatted(out, spec.c_str(), arg.type == LLBC_NS LLBC_LogArg::Ptr ?
+            arg.val.ptrVal : reinterpret_cast<const void *>(static_cast<size_t>(__GetArgSInt(arg))));
+        break;
+
+    default: // Unsupported conversion(include %n), ignore.
+        break;
+    }
+}
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+void LLBC_LogArg::Serialize(const char *fmt, const LLBC_LogArg *args, int argCount, LLBC_LogData &data)
+{
+    data.binFmt = fmt ? fmt : "";
+
+    // Calculate serialized arguments size.
+    size_t needSize = 0;
+    for (int i = 0; i < argCount; ++i)
+    {
+        if (args[i]._type == Serialized)
+        {
+            needSize += args[i]._strLen;
+            continue;
+        }
+
+        needSize += sizeof(uint8);
+        if (args[i]._type == Str)
+            needSize += sizeof(uint32) + args[i]._strLen;
+        else
+            needSize += sizeof(uint64);
+    }
+
+    if (data.binArgsSize < needSize)
+    {
+        data.binArgs = LLBC_TagRealloc(LLBC_MemoryTag::Log, char, data.binArgs, needSize);
+        data.binArgsSize = static_cast<uint32>(needSize);
+    }
+
+    // Serialize arguments.
+    char *buf = data.binArgs;
+    for (int i = 0; i < argCount; ++i)
+    {
+        const LLBC_LogArg &arg = args[i];
+        if (arg._type == Serialized)
+        {
+            ::memcpy(buf, arg._str, arg._strLen);
+            buf += arg._strLen;
+
+            continue;
+        }
+
+        *buf++ = static_cast<char>(arg._type);
+        if (arg._type == Str)
+        {
+            const uint32 strLen = static_cast<uint32>(arg._strLen);
+            ::memcpy(buf, &strLen, sizeof(uint32));
+            buf += sizeof(uint32);
+
+            ::memcpy(buf, arg._str, strLen);
+            buf += strLen;
+        }
+        else
+        {
+            ::memcpy(buf, &arg._val, sizeof(uint64));
+            buf += sizeof(uint64);
+        }
+    }
+
+    data.binArgsLen = static_cast<uint32>(needSize);
+}
+
+void LLBC_LogArg::Format(LLBC_LogData &data)
+{
+    if (!data.binFmt || data.msg)
+        return;
+
+    if (data.binFmt == LLBC_LogJsonMsg::deferredFmt)
+    {
+        LLBC_LogJsonMsg::Format(data);
+        return;
+    }
+
+    LLBC_String out;
+    out.reserve(strlen(data.binFmt) + data.binArgsLen);
+
+    LLBC_String spec;
+    LLBC_INL_NS __LLBC_LogSerializedArg arg = LLBC_INL_NS __LLBC_LogSerializedArg();
+
+    const char *args = data.binArgs;
+    const char *argsEnd = data.binArgs + data.binArgsLen;
+
+    const char *fmt = data.binFmt;
+    while (*fmt)
+    {
+        // Copy plain text.
+        if (*fmt != '%')
+        {
+            const char *nextSpec = strchr(fmt, '%');
+            if (!nextSpec)
+            {
+                out.append(fmt);
+                break;
+            }
+
+            out.append(fmt, nextSpec - fmt);
+            fmt = nextSpec;
+
+            continue;
+        }
+
+        // Process "%%".
+        if (fmt[1] == '%')
+        {
+            out.append(1, '%');
+            fmt += 2;
+
+            continue;
+        }
+
+        // Parse conversion specification: %[flags][width][.precision][length]conversion
+        const char *specBeg = fmt++;
+        spec.assign("%", 1);
+        while (*fmt && strchr("-+ #0", *fmt))
+            spec.append(1, *fmt++);
+
+        bool argMissing = false;
+        for (int part = 0; part < 2; ++part)
+        {
+            if (part == 1)
+            {
+                if (*fmt != '.')
+                    break;
+                spec.append(1, *fmt++);
+            }
+
+            if (*fmt == '*')
+            {
+                // Width/Precision from argument.
+                ++fmt;
+                if (!LLBC_INL_NS __ReadArg(args, argsEnd, arg))
+                {
+                    argMissing = true;
+                    break;
+                }
+
+                char numBuf[32];
+                snprintf(numBuf, sizeof(numBuf), "%d", static_cast<int>(LLBC_INL_NS __GetArgSInt(arg)));
+                spec.append(numBuf);
+            }
+            else
+            {
+                while (*fmt >= '0' && *fmt <= '9')
+                    spec.append(1, *fmt++);
+            }
+        }
+
+        // Skip length modifiers, argument real type will be used.
+        while (*fmt && strchr("hlLqjztI", *fmt))
+        {
+            if (*fmt == 'I' && ((fmt[1] == '6' && fmt[2] == '4') || (fmt[1] == '3' && fmt[2] == '2')))
+                fmt += 2;
+            ++fmt;
+        }
+
+        const char conv = *fmt;
+        if (conv == '\0')
+        {
+            out.append(specBeg);
+            break;
+        }
+
+        ++fmt;
+        if (argMissing || !LLBC_INL_NS __ReadArg(args, argsEnd, arg))
+        {
+            // No argument for this conversion specification, output the specification as is.
+            out.append(specBeg, fmt - specBeg);
+            continue;
+        }
+
+        LLBC_INL_NS __FormatArg(out, spec, conv, arg);
+    }
+
+    data.msgLen = static_cast<uint32>(out.size());
+    data.msg = LLBC_TagMalloc(LLBC_MemoryTag::Log, char, out.size() + 1);
+    ::memcpy(data.msg, out.data(), out.size());
+    data.msg[out.size()] = '\0';
+}
+
+__LLBC_NS_END
+
+#if LLBC_TARGET_PLATFORM_WIN32
+#pragma warning(default:4996)
+#endif
+
+#include "llbc/common/AfterIncl.h"
@@ -75,8 +75,7 @@ void LLBC_LogConsoleAppender::Finalize()
 
 int LLBC_LogConsoleAppender::Output(const LLBC_LogData &data)
 {
-    LLBC_LogTokenChain *chain = NULL;
-    if (UNLIKELY(!(chain = GetTokenChain())))
+    if (UNLIKELY(!GetTokenChain()))
     {
         LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
         return LLBC_FAILED;
@@ -88,8 +87,7 @@ int LLBC_LogConsoleAppender::Output(const LLBC_LogData &data)
 
     FILE * const out = logLevel >= _LogLevel::Warn ? stderr : stdout;
 
-    LLBC_String formattedData;
-    chain->Format(data, formattedData);
+    const LLBC_String &formattedData = FormatLogData(data);
 
 #if LLBC_TARGET_PLATFORM_WIN32
     LLBC_LockGuard colorLock(_colorLock);
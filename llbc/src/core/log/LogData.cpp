@@ -46,6 +46,13 @@ LLBC_LogData::LLBC_LogData()
 
 , threadId(LLBC_INVALID_NATIVE_THREAD_ID)
 
+, binFmt(NULL)
+, binArgs(NULL)
+, binArgsSize(0)
+, binArgsLen(0)
+
+, fmtCache(NULL)
+
 , _poolInst(NULL)
 {
 }
@@ -54,6 +61,7 @@ LLBC_LogData::~LLBC_LogData()
 {
     LLBC_XFree(msg);
     LLBC_XFree(others);
+    LLBC_XFree(binArgs);
 }
 
 void LLBC_LogData::Clear()
@@ -74,6 +82,11 @@ void LLBC_LogData::Clear()
     line = 0;
 
     threadId = LLBC_INVALID_NATIVE_THREAD_ID;
+
+    binFmt = NULL;
+    binArgsLen = 0;
+
+    fmtCache = NULL;
 }
 
 bool LLBC_LogData::IsPoolObject() const
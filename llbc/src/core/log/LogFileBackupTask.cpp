@@ -0,0 +1,243 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+#include <spawn.h>
+#include <sys/wait.h>
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+
+#include "llbc/core/file/File.h"
+#include "llbc/core/thread/MessageBlock.h"
+#include "llbc/core/utils/Util_Debug.h"
+
+#include "llbc/core/log/LogFileBackupTask.h"
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+extern char **environ;
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+
+__LLBC_INTERNAL_NS_BEGIN
+
+static void __WriteString(LLBC_NS LLBC_MessageBlock *block, const LLBC_NS LLBC_String &str)
+{
+    const LLBC_NS uint32 len = static_cast<LLBC_NS uint32>(str.size());
+    block->Write(&len, sizeof(LLBC_NS uint32));
+    block->Write(str.data(), len);
+}
+
+static void __ReadString(LLBC_NS LLBC_MessageBlock *block, LLBC_NS LLBC_String &str)
+{
+    LLBC_NS uint32 len = 0;
+    block->Read(&len, sizeof(LLBC_NS uint32));
+
+    str.resize(len);
+    if (len > 0)
+        block->Read(&str[0], len);
+}
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+LLBC_LogFileBackupTask::LLBC_LogFileBackupTask(int maxBackupIndex, bool gzipBackupFile)
+: _stoped(false)
+, _maxBackupIndex(maxBackupIndex)
+, _gzipBackupFile(gzipBackupFile)
+{
+}
+
+LLBC_LogFileBackupTask::~LLBC_LogFileBackupTask()
+{
+}
+
+void LLBC_LogFileBackupTask::Svc()
+{
+    LLBC_MessageBlock *block = NULL;
+    while (LIKELY(!_stoped))
+    {
+        if (TimedPop(block, 50) != LLBC_OK)
+            continue;
+
+        BackupRolledFile(block);
+    }
+}
+
+void LLBC_LogFileBackupTask::Cleanup()
+{
+    LLBC_MessageBlock *block = NULL;
+    while (TryPop(block) == LLBC_OK)
+        BackupRolledFile(block);
+}
+
+void LLBC_LogFileBackupTask::PushRolledFile(const LLBC_String &rolledFile,
+                                            const LLBC_String &fileName,
+                                            const LLBC_String &fileSuffix)
+{
+    LLBC_MessageBlock *block = LLBC_New(LLBC_MessageBlock);
+    LLBC_INL_NS __WriteString(block, rolledFile);
+    LLBC_INL_NS __WriteString(block, fileName);
+    LLBC_INL_NS __WriteString(block, fileSuffix);
+
+    Push(block);
+}
+
+void LLBC_LogFileBackupTask::Stop()
+{
+    _stoped = true;
+}
+
+void LLBC_LogFileBackupTask::BackupRolledFile(LLBC_MessageBlock *block)
+{
+    LLBC_String rolledFile, fileName, fileSuffix;
+    LLBC_INL_NS __ReadString(block, rolledFile);
+    LLBC_INL_NS __ReadString(block, fileName);
+    LLBC_INL_NS __ReadString(block, fileSuffix);
+    LLBC_Delete(block);
+
+    if (!LLBC_File::Exists(rolledFile))
+        return;
+
+    const LLBC_String fileNameNonSuffix = 
+        fileName.substr(0, fileName.size() - fileSuffix.size());
+
+    // Find available backup index, if all backup indexes used, remove the last backup file.
+    int availableIndex = 0;
+    while (availableIndex < _maxBackupIndex)
+    {
+        availableIndex += 1;
+        const LLBC_String backupFile = FindBackupFile(fileNameNonSuffix, availableIndex, fileSuffix);
+        if (backupFile.empty())
+            break;
+        else if (availableIndex == _maxBackupIndex)
+            LLBC_File::DeleteFile(backupFile);
+    }
+
+    // Shift backup files index, backup file keep its compressed/uncompressed extension.
+    for (int willMoveIndex = availableIndex - 1; willMoveIndex > 0; --willMoveIndex)
+    {
+        const LLBC_String willMove = FindBackupFile(fileNameNonSuffix, willMoveIndex, fileSuffix);
+        if (willMove.empty())
+            continue;
+
+        LLBC_String moveTo = BuildBackupFileName(fileNameNonSuffix, willMoveIndex + 1, fileSuffix);
+        if (willMove.size() > 3 &&
+            ::memcmp(willMove.data() + willMove.size() - 3, ".gz", 3) == 0)
+            moveTo.append(".gz");
+
+        if (LLBC_File::MoveFile(willMove, moveTo, true) != LLBC_OK)
+        {
+#ifdef LLBC_DEBUG
+            traceline("LLBC_LogFileBackupTask::BackupRolledFile(): Backup failed, %s -> %s, reason: %s", 
+                willMove.c_str(), moveTo.c_str(), LLBC_FormatLastError());
+#endif
+        }
+    }
+
+    // Move rolled file to first backup file, and compress it(if enabled).
+    const LLBC_String firstBackupFile = BuildBackupFileName(fileNameNonSuffix, 1, fileSuffix);
+    if (LLBC_File::MoveFile(rolledFile, firstBackupFile, true) != LLBC_OK)
+    {
+#ifdef LLBC_DEBUG
+        traceline("LLBC_LogFileBackupTask::BackupRolledFile(): Backup failed, %s -> %s, reason: %s", 
+            rolledFile.c_str(), firstBackupFile.c_str(), LLBC_FormatLastError());
+#endif
+        return;
+    }
+
+    if (_gzipBackupFile && GzipFile(firstBackupFile) != LLBC_OK)
+    {
+#ifdef LLBC_DEBUG
+        traceline("LLBC_LogFileBackupTask::BackupRolledFile(): Gzip backup file failed, file: %s, reason: %s",
+            firstBackupFile.c_str(), LLBC_FormatLastError());
+#endif
+    }
+}
+
+LLBC_String LLBC_LogFileBackupTask::BuildBackupFileName(const LLBC_String &fileNameNonSuffix,
+                                                        int index,
+                                                        const LLBC_String &fileSuffix) const
+{
+    LLBC_String backupFile;
+    return backupFile.format("%s.%d%s", fileNameNonSuffix.c_str(), index, fileSuffix.c_str());
+}
+
+LLBC_String LLBC_LogFileBackupTask::FindBackupFile(const LLBC_String &fileNameNonSuffix,
+                                                   int index,
+                                                   const LLBC_String &fileSuffix) const
+{
+    // Backup file maybe compressed or uncompressed(gzip failed or gzip option changed).
+    LLBC_String backupFile = BuildBackupFileName(fileNameNonSuffix, index, fileSuffix);
+    if (LLBC_File::Exists(backupFile + ".gz"))
+        return backupFile + ".gz";
+    else if (LLBC_File::Exists(backupFile))
+        return backupFile;
+
+    return LLBC_String();
+}
+
+int LLBC_LogFileBackupTask::GzipFile(const LLBC_String &backupFile) const
+{
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    // Use gzip utility to compress backup file, llbc core library don't depend on compression library.
+    char *argv[] = {const_cast<char *>("gzip"),
+                    const_cast<char *>("-f"),
+                    const_cast<char *>("--"),
+                    const_cast<char *>(backupFile.c_str()),
+                    NULL};
+
+    pid_t pid;
+    const int spawnRet = ::posix_spawnp(&pid, "gzip", NULL, NULL, argv, environ);
+    if (spawnRet != 0)
+    {
+        errno = spawnRet;
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return LLBC_FAILED;
+    }
+
+    int status = 0;
+    while (::waitpid(pid, &status, 0) == -1)
+    {
+        if (errno != EINTR)
+        {
+            LLBC_SetLastError(LLBC_ERROR_CLIB);
+            return LLBC_FAILED;
+        }
+    }
+
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_UNKNOWN);
+        return LLBC_FAILED;
+    }
+
+    return LLBC_OK;
+#else // Win32
+    LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
+    return LLBC_FAILED;
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
@@ -0,0 +1,122 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/core/log/LogData.h"
+#include "llbc/core/log/LogTokenChain.h"
+#include "llbc/core/log/LogFormatCache.h"
+
+__LLBC_NS_BEGIN
+
+const size_t LLBC_LogFormatCache::TimePrefixLen;
+
+LLBC_LogFormatCache::LLBC_LogFormatCache()
+: _entries()
+, _timePrefixSecond(-1)
+{
+    ::memset(_timePrefix, 0, sizeof(_timePrefix));
+}
+
+LLBC_LogFormatCache::~LLBC_LogFormatCache()
+{
+    for (size_t i = 0; i < _entries.size(); ++i)
+        LLBC_Delete(_entries[i]);
+}
+
+void LLBC_LogFormatCache::Reset()
+{
+    for (size_t i = 0; i < _entries.size(); ++i)
+        _entries[i]->formatted = false;
+}
+
+const LLBC_String &LLBC_LogFormatCache::Format(const LLBC_LogTokenChain *chain, const LLBC_LogData &data)
+{
+    // Find entry, first match token chain, then match pattern.
+    _Entry *entry = NULL;
+    const size_t entryCount = _entries.size();
+    for (size_t i = 0; i < entryCount; ++i)
+    {
+        if (_entries[i]->chain == chain)
+        {
+            entry = _entries[i];
+            break;
+        }
+    }
+
+    if (!entry)
+    {
+        const LLBC_String &pattern = chain->GetPattern();
+        for (size_t i = 0; i < entryCount; ++i)
+        {
+            if (_entries[i]->pattern == pattern)
+            {
+                entry = _entries[i];
+                break;
+            }
+        }
+
+        if (!entry)
+        {
+            entry = LLBC_New(_Entry);
+            entry->pattern = pattern;
+            entry->formatted = false;
+
+            _entries.push_back(entry);
+        }
+
+        entry->chain = chain;
+    }
+
+    // If already formatted by same pattern token chain, return it.
+    if (entry->formatted)
+        return entry->formattedData;
+
+    entry->formattedData.clear();
+    chain->Format(data, entry->formattedData);
+    entry->formatted = true;
+
+    return entry->formattedData;
+}
+
+const char *LLBC_LogFormatCache::GetTimePrefix(sint64 logTime)
+{
+    const time_t timeInSecond = static_cast<time_t>(logTime / 1000);
+    if (timeInSecond == _timePrefixSecond)
+        return _timePrefix;
+
+    struct tm timeStruct;
+#if LLBC_TARGET_PLATFORM_WIN32
+    localtime_s(&timeStruct, &timeInSecond);
+#else
+    localtime_r(&timeInSecond, &timeStruct);
+#endif
+
+    strftime(_timePrefix, sizeof(_timePrefix), "%y-%m-%d %H:%M:%S.", &timeStruct);
+    _timePrefixSecond = timeInSecond;
+
+    return _timePrefix;
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
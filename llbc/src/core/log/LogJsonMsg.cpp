@@ -26,6 +26,9 @@
 #include "llbc/core/objectpool/Common.h"
 
 #include "llbc/core/log/LogLevel.h"
+#include "llbc/core/log/LogData.h"
+#include "llbc/core/log/LogArg.h"
+#include "llbc/core/log/LoggerConfigInfo.h"
 #include "llbc/core/log/Logger.h"
 
 #include "llbc/core/log/LogJsonMsg.h"
@@ -42,60 +45,209 @@ namespace
     typedef LLBC_NS LLBC_LogLevel _LV;
 }
 
-LLBC_LogJsonMsg::LLBC_LogJsonMsg(bool loggerInited, LLBC_Logger *logger, const char *tag, int lv)
-: _loggerInited(loggerInited)
-, _logger(logger)
-, _tag(tag)
-, _lv(lv)
-, _doc(*LLBC_GetObjectFromUnsafetyPool<LLBC_Json::Document>())
+const char * const LLBC_LogJsonMsg::deferredFmt = "{json}";
+LLBC_LogJsonMsg LLBC_LogJsonMsg::_disabledMsg;
+
+LLBC_LogJsonMsg::LLBC_LogJsonMsg()
+: _enabled(false)
+, _deferred(false)
+, _loggerInited(false)
+, _logger(NULL)
+, _tag(NULL)
+, _lv(_LV::Debug)
+
+, _buf(NULL, LLBC_CFG_LOG_JSON_BUFFER_SIZE)
+, _writer(_buf)
+, _deferredArgs()
 {
 }
 
 LLBC_LogJsonMsg::~LLBC_LogJsonMsg()
 {
-    LLBC_ReleaseObjectToUnsafetyPool(&_doc);
 }
 
-void LLBC_LogJsonMsg::Finish(const char *fmt, ...)
+void LLBC_LogJsonMsg::Init(bool loggerInited, LLBC_Logger *logger, const char *tag, int lv)
 {
+    _loggerInited = loggerInited;
+    _logger = logger;
+    _tag = tag;
+    _lv = lv;
+
+    // Check level and rate limit before any serializing.
     if (UNLIKELY(!_loggerInited))
+        _enabled = true;
+    else if (_logger && _lv >= _logger->GetLogLevel())
+        _enabled = !(_logger->_rateLimiter && _logger->IsSuppressed(_tag));
+    else
+        _enabled = false;
+
+    if (!_enabled)
+        return;
+
+    _deferred = _loggerInited && _logger->_config->IsDeferJsonFormat();
+    if (!_deferred)
+    {
+        _writer.Reset(_buf);
+        _writer.StartObject();
+    }
+}
+
+void LLBC_LogJsonMsg::Finish(const char *fmt, ...)
+{
+    if (!_enabled)
+    {
+        if (this != &_disabledMsg)
+            LLBC_ReleaseObjectToUnsafetyPool(this);
+        return;
+    }
+
+    // Format message, try to use stack buffer first.
+    char stackMsg[512];
+    char *fmttedMsg = stackMsg;
+    int msgLen = 0;
+    if (fmt)
     {
-        char *fmttedMsg; int msgLen;
-        LLBC_FormatArg(fmt, fmttedMsg, msgLen);
+        va_list ap;
+        va_start(ap, fmt);
+        msgLen = vsnprintf(stackMsg, sizeof(stackMsg), fmt, ap);
+        va_end(ap);
 
-        // doc add string with not copy
-        _doc.AddMember("msg", LLBC_JsonValue(fmttedMsg, msgLen).Move(), _doc.GetAllocator());
-        
-        // _doc stringify
-        LLBC_Json::StringBuffer buffer;
-        LLBC_Json::Writer<LLBC_Json::StringBuffer> writer(buffer);
-        _doc.Accept(writer);
+        if (msgLen < 0 || msgLen >= static_cast<int>(sizeof(stackMsg)))
+            LLBC_FormatArg(fmt, fmttedMsg, msgLen);
+    }
 
-        // free fmttedMsg should after _doc stringify
-        LLBC_Free(fmttedMsg);
+    WriteStr("msg", 3);
+    WriteStr(fmttedMsg ? fmttedMsg : "", fmttedMsg ? msgLen : 0);
+    if (fmttedMsg != stackMsg)
+        LLBC_XFree(fmttedMsg);
 
-        UnInitOutput(_lv >= _LV::Warn ? stderr : stdout, buffer.GetString());
+    if (UNLIKELY(!_loggerInited))
+    {
+        // Not initialized, output to console.
+        _writer.EndObject();
+        UnInitOutput(_lv >= _LV::Warn ? stderr : stdout, _buf.GetString());
     }
-    else if (_logger && _lv >= _logger->GetLogLevel())
+    else if (_deferred)
+    {
+        // Deferred, serialize key/value pairs to log data, json string will build in log thread.
+        const LLBC_LogArg args = LLBC_LogArg::FromSerialized(_deferredArgs.data(), _deferredArgs.size());
+        _logger->DirectOutput(_lv, _tag, __FILE__, __LINE__, NULL, 0, deferredFmt, &args, 1);
+    }
+    else
     {
-        char *fmttedMsg; int msgLen;
-        LLBC_FormatArg(fmt, fmttedMsg, msgLen);
+        // Copy json string to log message, log data will take over the message.
+        _writer.EndObject();
 
-        // _doc add string with not copy
-        _doc.AddMember("msg", LLBC_JsonValue(fmttedMsg, msgLen).Move(), _doc.GetAllocator());
+        const size_t len = _buf.GetSize();
+        char *message = LLBC_TagMalloc(LLBC_MemoryTag::Log, char, len + 1);
+        ::memcpy(message, _buf.GetString(), len);
+        message[len] = '\0';
 
-        // _doc convert to string
-        LLBC_Json::StringBuffer buffer;
-        LLBC_Json::Writer<LLBC_Json::StringBuffer> writer(buffer);
-        _doc.Accept(writer);
+        _logger->DirectOutput(_lv, _tag, __FILE__, __LINE__, message, static_cast<int>(len));
+    }
+
+    LLBC_ReleaseObjectToUnsafetyPool(this);
+}
+
+void LLBC_LogJsonMsg::Clear()
+{
+    _enabled = false;
+    _deferred = false;
+    _loggerInited = false;
+    _logger = NULL;
+    _tag = NULL;
+    _lv = _LV::Debug;
+
+    // Keep buffers for reuse, but if buffer too large, release it.
+    const bool bufTooLarge = _buf.GetSize() > LLBC_CFG_LOG_JSON_MAX_REUSED_BUFFER_SIZE;
+    _buf.Clear();
+    if (bufTooLarge)
+        _buf.ShrinkToFit();
+
+    if (_deferredArgs.capacity() > LLBC_CFG_LOG_JSON_MAX_REUSED_BUFFER_SIZE)
+        LLBC_String().swap(_deferredArgs);
+    else
+        _deferredArgs.clear();
+}
+
+void LLBC_LogJsonMsg::Format(LLBC_LogData &data)
+{
+    if (data.binFmt != deferredFmt || data.msg)
+        return;
+
+    // Use current thread's json message object to build json string.
+    LLBC_LogJsonMsg *jsonMsg = LLBC_GetObjectFromUnsafetyPool<LLBC_LogJsonMsg>();
 
-        // free fmttedMsg should after _doc call Accept function
-        LLBC_Free(fmttedMsg);
+    LLBC_Json::StringBuffer &buf = jsonMsg->_buf;
+    LLBC_Json::Writer<LLBC_Json::StringBuffer> &writer = jsonMsg->_writer;
+    writer.Reset(buf);
+    writer.StartObject();
 
-        _logger->OutputNonFormat(_lv, _tag, __FILE__, __LINE__, buffer.GetString(), buffer.GetLength());
+    bool isKey = true;
+    const char *args = data.binArgs;
+    const char *argsEnd = data.binArgs + data.binArgsLen;
+    while (args < argsEnd)
+    {
+        const int type = static_cast<uint8>(*args++);
+        if (type == DeferredStr)
+        {
+            uint32 strLen;
+            if (UNLIKELY(args + sizeof(uint32) > argsEnd))
+                break;
+            ::memcpy(&strLen, args, sizeof(uint32));
+            args += sizeof(uint32);
+
+            if (UNLIKELY(args + strLen > argsEnd))
+                break;
+            writer.String(args, strLen);
+            args += strLen;
+        }
+        else
+        {
+            if (UNLIKELY(isKey || args + sizeof(uint64) > argsEnd))
+                break;
+
+            union
+            {
+                sint64 sintVal;
+                uint64 uintVal;
+                double doubleVal;
+            } val;
+            ::memcpy(&val, args, sizeof(uint64));
+            args += sizeof(uint64);
+
+            if (type == DeferredBool)
+                writer.Bool(val.sintVal != 0);
+            else if (type == DeferredSInt)
+                writer.Int64(val.sintVal);
+            else if (type == DeferredUInt)
+                writer.Uint64(val.uintVal);
+            else if (val.doubleVal - val.doubleVal == 0.0)
+                writer.Double(val.doubleVal);
+            else // NaN or Inf, json not support.
+                writer.Null();
+        }
+
+        isKey = !isKey;
     }
 
-    LLBC_Delete(this);
+    // Malformed arguments, complete the key/value pair.
+    if (!isKey)
+        writer.Null();
+    writer.EndObject();
+
+    data.msgLen = static_cast<uint32>(buf.GetSize());
+    data.msg = LLBC_TagMalloc(LLBC_MemoryTag::Log, char, data.msgLen + 1);
+    ::memcpy(data.msg, buf.GetString(), data.msgLen);
+    data.msg[data.msgLen] = '\0';
+
+    LLBC_ReleaseObjectToUnsafetyPool(jsonMsg);
+}
+
+void LLBC_LogJsonMsg::AppendDeferred(int type, const void *val)
+{
+    _deferredArgs.append(1, static_cast<char>(type));
+    _deferredArgs.append(reinterpret_cast<const char *>(val), sizeof(uint64));
 }
 
 void LLBC_LogJsonMsg::UnInitOutput(FILE *to, const char *msg)
@@ -0,0 +1,481 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+#include <sys/mman.h>
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+
+#include "llbc/core/os/OS_Time.h"
+
+#include "llbc/core/file/File.h"
+#include "llbc/core/file/Directory.h"
+#include "llbc/core/utils/Util_Math.h"
+#include "llbc/core/utils/Util_Debug.h"
+
+#include "llbc/core/log/LogData.h"
+#include "llbc/core/log/LogFileAppender.h"
+#include "llbc/core/log/LogFileBackupTask.h"
+#include "llbc/core/log/LogMmapFileAppender.h"
+
+__LLBC_INTERNAL_NS_BEGIN
+const static int __LogFileCheckInterval = 500;
+const static size_t __TrimScanBlockSize = 4096;
+
+#if LLBC_TARGET_PLATFORM_LINUX
+/**
+ * Check log directory's file system support posix_fallocate() or not.
+ */
+static bool __IsFileAllocSupported(const LLBC_NS LLBC_String &logDir)
+{
+    LLBC_NS LLBC_String probeFile = logDir.empty() ? LLBC_NS LLBC_String(".") : logDir;
+    probeFile.append("/.llbc_fallocate_probe.XXXXXX");
+
+    std::vector<char> probeFileBuf(probeFile.begin(), probeFile.end());
+    probeFileBuf.push_back('\0');
+
+    const int fd = ::mkstemp(&probeFileBuf[0]);
+    if (fd == -1)
+        return false;
+
+    const int allocRet = ::posix_fallocate(fd, 0, static_cast<off_t>(::sysconf(_SC_PAGESIZE)));
+
+    ::close(fd);
+    ::unlink(&probeFileBuf[0]);
+
+    return allocRet == 0;
+}
+#endif // LLBC_TARGET_PLATFORM_LINUX
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+LLBC_LogMmapFileAppender::LLBC_LogMmapFileAppender()
+: _basePath()
+, _baseName()
+, _fileSuffix()
+
+, _isDailyRolling(true)
+, _maxFileSize(LONG_MAX)
+, _maxBackupIndex(INT_MAX)
+
+, _windowSize(0)
+, _backupTask(NULL)
+
+, _fileName()
+
+, _fd(-1)
+, _fileSize(0)
+
+, _window(NULL)
+, _windowBeg(0)
+, _windowEnd(0)
+, _windowDirty(false)
+
+, _logfileLastCheckTime(0)
+, _rolledFileSeq(0)
+{
+}
+
+LLBC_LogMmapFileAppender::~LLBC_LogMmapFileAppender()
+{
+    Finalize();
+}
+
+int LLBC_LogMmapFileAppender::GetType() const
+{
+    return LLBC_LogAppenderType::MmapFile;
+}
+
+int LLBC_LogMmapFileAppender::Initialize(const LLBC_LogAppenderInitInfo &initInfo)
+{
+#if !LLBC_TARGET_PLATFORM_LINUX
+    LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
+    return LLBC_FAILED;
+#else // Linux
+    if (_Base::Initialize(initInfo) != LLBC_OK)
+        return LLBC_FAILED;
+
+    if (initInfo.file.empty() || initInfo.fileMmapWindowSize <= 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    _baseName = initInfo.file;
+    _fileSuffix = initInfo.fileSuffix;
+    LLBC_String logDir = LLBC_Directory::DirName(_baseName);
+
+    if (initInfo.forceAppLogPath)
+    {
+        _basePath = LLBC_Directory::ModuleFileDir();
+        logDir = LLBC_Directory::Join(_basePath, logDir);
+    }
+
+    if (!logDir.empty() && !LLBC_Directory::Exists(logDir))
+    {
+        if (LLBC_Directory::Create(logDir) != LLBC_OK)
+            return LLBC_FAILED;
+    }
+
+    // Mapped log file blocks must be allocated, if file system not support, don't map sparse file.
+    if (!LLBC_INL_NS __IsFileAllocSupported(logDir))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
+        return LLBC_FAILED;
+    }
+
+    _isDailyRolling = initInfo.dailyRolling;
+    _maxFileSize = initInfo.maxFileSize > 0 ? initInfo.maxFileSize : LONG_MAX;
+    _maxBackupIndex = MAX(0, initInfo.maxBackupIndex);
+
+    // Window size must be multiple of page size(mmap offset must be page aligned).
+    const size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    _windowSize = MIN(static_cast<size_t>(initInfo.fileMmapWindowSize),
+                      static_cast<size_t>(LLBC_CFG_LOG_MAX_FILE_MMAP_WINDOW_SIZE));
+    _windowSize = (_windowSize + pageSize - 1) / pageSize * pageSize;
+
+    if (_maxBackupIndex > 0)
+    {
+        _backupTask = LLBC_New2(LLBC_LogFileBackupTask, _maxBackupIndex, initInfo.gzipBackupFile);
+        if (_backupTask->Activate() != LLBC_OK)
+        {
+            LLBC_XDelete(_backupTask);
+            return LLBC_FAILED;
+        }
+    }
+
+    const sint64 now = LLBC_GetMilliSeconds();
+    if (initInfo.lazyCreateLogFile)
+        return LLBC_OK;
+
+    _fileName = LLBC_LogFileAppender::BuildLogFileName(_basePath, _baseName, _fileSuffix, _isDailyRolling, now);
+    if (OpenFile(_fileName, false) != LLBC_OK)
+        return LLBC_FAILED;
+
+    // If exist log file already exceed max file size, roll it.
+    if (_fileSize >= _maxFileSize)
+    {
+        CloseFile();
+        RollFile(now);
+        if (OpenFile(_fileName, true) != LLBC_OK)
+            return LLBC_FAILED;
+    }
+
+    _logfileLastCheckTime = now;
+
+    return LLBC_OK;
+#endif // !LLBC_TARGET_PLATFORM_LINUX
+}
+
+void LLBC_LogMmapFileAppender::Finalize()
+{
+    CloseFile();
+
+    if (_backupTask)
+    {
+        _backupTask->Stop();
+        _backupTask->Wait();
+        LLBC_XDelete(_backupTask);
+    }
+
+    _basePath.clear();
+    _baseName.clear();
+    _fileSuffix.clear();
+
+    _isDailyRolling = false;
+    _maxFileSize = LONG_MAX;
+    _maxBackupIndex = INT_MAX;
+
+    _windowSize = 0;
+
+    _fileName.clear();
+    _logfileLastCheckTime = 0;
+
+    _Base::Finalize();
+}
+
+int LLBC_LogMmapFileAppender::Output(const LLBC_LogData &data)
+{
+    if (UNLIKELY(!GetTokenChain()))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return LLBC_FAILED;
+    }
+
+    if (data.level < GetLogLevel())
+        return LLBC_OK;
+
+    CheckAndUpdateLogFile(data.logTime);
+
+    const LLBC_String &formattedData = FormatLogData(data);
+
+    return Write(formattedData.data(), formattedData.size());
+}
+
+void LLBC_LogMmapFileAppender::Flush()
+{
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    // Data already in page cache, only schedule write back, never block log thread.
+    if (!_windowDirty)
+        return;
+
+    ::msync(_window, _windowSize, MS_ASYNC);
+    _windowDirty = false;
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+}
+
+int LLBC_LogMmapFileAppender::Write(const char *data, size_t len)
+{
+    if (UNLIKELY(_fd == -1))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_OPEN);
+        return LLBC_FAILED;
+    }
+
+    while (len > 0)
+    {
+        if (_fileSize >= _windowEnd &&
+            MapWindow(_fileSize) != LLBC_OK)
+            return LLBC_FAILED;
+
+        const size_t copyLen = MIN(len, static_cast<size_t>(_windowEnd - _fileSize));
+        ::memcpy(_window + (_fileSize - _windowBeg), data, copyLen);
+
+        _fileSize += copyLen;
+        data += copyLen;
+        len -= copyLen;
+    }
+
+    _windowDirty = true;
+
+    return LLBC_OK;
+}
+
+int LLBC_LogMmapFileAppender::MapWindow(sint64 offset)
+{
+#if LLBC_TARGET_PLATFORM_LINUX
+    UnmapWindow();
+
+    const sint64 windowBeg = offset / _windowSize * _windowSize;
+    const sint64 windowEnd = windowBeg + _windowSize;
+
+    // Pre-size log file to window end and allocate disk blocks, never map sparse file range,
+    // otherwise write to mapped window will SIGBUS when disk full.
+    const int allocRet = ::posix_fallocate(_fd, windowBeg, static_cast<off_t>(_windowSize));
+    if (allocRet != 0)
+    {
+        errno = allocRet;
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return LLBC_FAILED;
+    }
+
+    void *window = ::mmap(NULL, _windowSize, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, static_cast<off_t>(windowBeg));
+    if (window == MAP_FAILED)
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return LLBC_FAILED;
+    }
+
+    _window = reinterpret_cast<char *>(window);
+    _windowBeg = windowBeg;
+    _windowEnd = windowEnd;
+
+    return LLBC_OK;
+#else // Non-Linux
+    LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
+    return LLBC_FAILED;
+#endif // LLBC_TARGET_PLATFORM_LINUX
+}
+
+void LLBC_LogMmapFileAppender::UnmapWindow()
+{
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    if (!_window)
+        return;
+
+    // Unmapped dirty pages still in page cache, will be written back by kernel.
+    ::munmap(_window, _windowSize);
+
+    _window = NULL;
+    _windowBeg = 0;
+    _windowEnd = 0;
+    _windowDirty = false;
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+}
+
+void LLBC_LogMmapFileAppender::CheckAndUpdateLogFile(sint64 now)
+{
+    if (_fileSize < _maxFileSize &&
+        LLBC_Abs(_logfileLastCheckTime - now) < LLBC_INL_NS __LogFileCheckInterval)
+        return;
+
+    _logfileLastCheckTime = now;
+
+    bool clear = false, backup = false;
+    const LLBC_String newFileName =
+        LLBC_LogFileAppender::BuildLogFileName(_basePath, _baseName, _fileSuffix, _isDailyRolling, now);
+    if (_fileSize >= _maxFileSize)
+    {
+        clear = true;
+        backup = true;
+    }
+    else if (newFileName != _fileName)
+    {
+        clear = false;
+    }
+    else if (!LLBC_File::Exists(newFileName))
+    {
+        clear = true;
+    }
+    else
+    {
+        return;
+    }
+
+    CloseFile();
+    if (backup)
+        RollFile(now);
+
+    OpenFile(newFileName, clear);
+}
+
+int LLBC_LogMmapFileAppender::OpenFile(const LLBC_String &fileName, bool clear)
+{
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    CloseFile();
+
+    int flags = O_RDWR | O_CREAT;
+    if (clear)
+        flags |= O_TRUNC;
+
+    _fd = ::open(fileName.c_str(), flags, 0644);
+    if (_fd == -1)
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+#ifdef LLBC_DEBUG
+        traceline("LLBC_LogMmapFileAppender::OpenFile(): Open file failed, name:%s, clear:%d, reason:%s",
+            fileName.c_str(), clear, LLBC_FormatLastError());
+#endif
+        return LLBC_FAILED;
+    }
+
+    struct stat fileStat;
+    if (::fstat(_fd, &fileStat) != 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        ::close(_fd);
+        _fd = -1;
+
+        return LLBC_FAILED;
+    }
+
+    // Trim pre-sized zero tail(if last process crashed), new log data will follow the written data.
+    _fileName = fileName;
+    _fileSize = GetWrittenSize(static_cast<sint64>(fileStat.st_size));
+
+    return LLBC_OK;
+#else // Win32
+    LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
+    return LLBC_FAILED;
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+}
+
+void LLBC_LogMmapFileAppender::CloseFile()
+{
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    if (_fd == -1)
+        return;
+
+    UnmapWindow();
+
+    // Truncate pre-sized tail.
+    if (::ftruncate(_fd, static_cast<off_t>(_fileSize)) != 0)
+    {
+#ifdef LLBC_DEBUG
+        traceline("LLBC_LogMmapFileAppender::CloseFile(): Truncate file failed, name:%s, size:%lld",
+            _fileName.c_str(), _fileSize);
+#endif
+    }
+
+    ::close(_fd);
+    _fd = -1;
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+}
+
+sint64 LLBC_LogMmapFileAppender::GetWrittenSize(sint64 fileSize) const
+{
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    // Pre-sized tail at most one window, scan backward to find the last non-zero byte.
+    const sint64 scanEnd = MAX(0, fileSize - static_cast<sint64>(_windowSize));
+
+    char buf[LLBC_INL_NS __TrimScanBlockSize];
+    sint64 pos = fileSize;
+    while (pos > scanEnd)
+    {
+        const size_t readLen = static_cast<size_t>(MIN(pos - scanEnd, static_cast<sint64>(sizeof(buf))));
+        const ssize_t actuallyRead = ::pread(_fd, buf, readLen, static_cast<off_t>(pos - readLen));
+        if (actuallyRead != static_cast<ssize_t>(readLen))
+            return fileSize;
+
+        for (size_t i = readLen; i > 0; --i)
+        {
+            if (buf[i - 1] != '\0')
+                return pos - readLen + i;
+        }
+
+        pos -= readLen;
+    }
+
+    return pos;
+#else // Win32
+    return fileSize;
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+}
+
+void LLBC_LogMmapFileAppender::RollFile(sint64 now)
+{
+    if (!LLBC_File::Exists(_fileName))
+        return;
+
+    // Not backup log files, new log file will be cleared.
+    if (!_backupTask)
+        return;
+
+    LLBC_String rolledFile;
+    rolledFile.format("%s.rolling.%lld.%u", _fileName.c_str(), now, ++_rolledFileSeq);
+    if (LLBC_File::MoveFile(_fileName, rolledFile, true) != LLBC_OK)
+    {
+#ifdef LLBC_DEBUG
+        traceline("LLBC_LogMmapFileAppender::RollFile(): Roll file failed, %s -> %s, reason: %s",
+            _fileName.c_str(), rolledFile.c_str(), LLBC_FormatLastError());
+#endif
+        return;
+    }
+
+    _backupTask->PushRolledFile(rolledFile, _fileName, _fileSuffix);
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
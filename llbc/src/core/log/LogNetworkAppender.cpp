@@ -22,13 +22,86 @@
 #include "llbc/common/Export.h"
 #include "llbc/common/BeforeIncl.h"
 
+#include "llbc/core/os/OS_Time.h"
+#include "llbc/core/os/OS_Atomic.h"
+#include "llbc/core/os/OS_Select.h"
+#include "llbc/core/os/OS_Socket.h"
+#include "llbc/core/utils/Util_Text.h"
+
+#include "llbc/core/log/LogData.h"
 #include "llbc/core/log/LogNetworkAppender.h"
 
+__LLBC_INTERNAL_NS_BEGIN
+
+static const LLBC_NS LLBC_String __networkProtocolDesc[LLBC_NS LLBC_LogNetworkProtocol::End + 1] =
+{
+    "UDP",
+    "TCP",
+
+    "UNKNOWN"
+};
+
+#if defined(MSG_NOSIGNAL)
+static const int __networkSendFlags = MSG_NOSIGNAL;
+#else
+static const int __networkSendFlags = 0;
+#endif
+
+__LLBC_INTERNAL_NS_END
+
 __LLBC_NS_BEGIN
 
+const LLBC_String &LLBC_LogNetworkProtocol::GetProtocolDesc(int protocol)
+{
+    return (IsLegal(protocol) ?
+        LLBC_INTERNAL_NS __networkProtocolDesc[protocol] : LLBC_INTERNAL_NS __networkProtocolDesc[End]);
+}
+
+int LLBC_LogNetworkProtocol::Str2Protocol(const char *str)
+{
+    if (UNLIKELY(!str))
+        return End;
+
+    const LLBC_String upperStr = LLBC_ToUpper(str);
+    for (int protocol = Begin; protocol != End; ++protocol)
+    {
+        if (upperStr == LLBC_INTERNAL_NS __networkProtocolDesc[protocol])
+            return protocol;
+    }
+
+    return End;
+}
+
+bool LLBC_LogNetworkProtocol::IsLegal(int protocol)
+{
+    return (Begin <= protocol && protocol < End);
+}
+
 LLBC_LogNetworkAppender::LLBC_LogNetworkAppender()
-: _ip("127.0.0.1")
+: _ip(LLBC_CFG_LOG_DEFAULT_NETWORK_IP)
 , _port(0)
+, _protocol(LLBC_LogNetworkProtocol::Udp)
+
+, _sock(LLBC_INVALID_SOCKET_HANDLE)
+, _connState(Disconnected)
+, _connBeginTime(0)
+
+, _initReconnectInterval(LLBC_CFG_LOG_DEFAULT_NETWORK_RECONNECT_INTERVAL)
+, _maxReconnectInterval(LLBC_CFG_LOG_DEFAULT_NETWORK_MAX_RECONNECT_INTERVAL)
+, _reconnectInterval(LLBC_CFG_LOG_DEFAULT_NETWORK_RECONNECT_INTERVAL)
+, _nextConnectTime(0)
+
+, _buf(NULL)
+, _bufCap(0)
+, _head(0)
+, _tail(0)
+, _sendPos(0)
+, _batchSize(0)
+, _batchEnd(0)
+, _batchFrameCount(0)
+
+, _sentLogCount(0)
+, _droppedLogCount(0)
 {
 }
 
@@ -44,22 +117,335 @@ int LLBC_LogNetworkAppender::GetType() const
 
 int LLBC_LogNetworkAppender::Initialize(const LLBC_LogAppenderInitInfo &initInfo)
 {
-    _ip = "127.0.0.1";
-    _port = 0;
+    if (initInfo.ip.empty() ||
+        initInfo.port == 0 ||
+        !LLBC_LogNetworkProtocol::IsLegal(initInfo.networkProtocol))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    if (_Base::Initialize(initInfo) != LLBC_OK)
+        return LLBC_FAILED;
+
+    _ip = initInfo.ip;
+    _port = initInfo.port;
+    _protocol = initInfo.networkProtocol;
 
-    LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
-    return LLBC_FAILED;
+    _initReconnectInterval = MAX(1, initInfo.reconnectInterval);
+    _maxReconnectInterval = MAX(_initReconnectInterval, initInfo.maxReconnectInterval);
+    _reconnectInterval = _initReconnectInterval;
+    _nextConnectTime = 0;
+
+    // Udp frame never be splitted, so batch size limit to max datagram size.
+    _batchSize = static_cast<size_t>(MAX(static_cast<int>(sizeof(uint32)) + 1, initInfo.networkBatchSize));
+    if (_protocol == LLBC_LogNetworkProtocol::Udp)
+        _batchSize = MIN(_batchSize, static_cast<size_t>(LLBC_CFG_LOG_MAX_NETWORK_DATAGRAM_SIZE));
+
+    _bufCap = MAX(_batchSize, static_cast<size_t>(MAX(0, initInfo.networkBufferSize)));
+    _buf = LLBC_TagMalloc(LLBC_MemoryTag::Log, char, _bufCap);
+    _head = _tail = _sendPos = _batchEnd = 0;
+    _batchFrameCount = 0;
+
+    // Try connect at initialize, if failed, will reconnect when output.
+    CheckConnection();
+
+    return LLBC_OK;
 }
 
 void LLBC_LogNetworkAppender::Finalize()
 {
+    // Send buffered log records as many as possible, the remaining log records will be dropped.
+    if (_buf)
+    {
+        SendBuffered();
+        if (_sendPos != _head)
+            DropPartialBatch();
+
+        sint64 unsentCount = 0;
+        for (size_t frameBeg = _sendPos; frameBeg < _tail; ++unsentCount)
+        {
+            uint32 recordLen;
+            ::memcpy(&recordLen, _buf + frameBeg, sizeof(uint32));
+            frameBeg += sizeof(uint32) + LLBC_Net2Host2(recordLen);
+        }
+
+        DropLogs(unsentCount);
+    }
+
+    if (_sock != LLBC_INVALID_SOCKET_HANDLE)
+    {
+        LLBC_CloseSocket(_sock);
+        _sock = LLBC_INVALID_SOCKET_HANDLE;
+    }
+    _connState = Disconnected;
+
+    LLBC_XFree(_buf);
+    _bufCap = 0;
+    _head = _tail = _sendPos = _batchEnd = 0;
+    _batchFrameCount = 0;
+
     _Base::Finalize();
 }
 
 int LLBC_LogNetworkAppender::Output(const LLBC_LogData &data)
 {
-    LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
-    return LLBC_FAILED;
+    if (UNLIKELY(!GetTokenChain()))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return LLBC_FAILED;
+    }
+
+    if (data.level < GetLogLevel())
+        return LLBC_OK;
+
+    // Too large log record, drop it(udp frame must be sent in one datagram).
+    const LLBC_String &formattedData = FormatLogData(data);
+    const size_t frameSize = sizeof(uint32) + formattedData.size();
+    if (frameSize > (_protocol == LLBC_LogNetworkProtocol::Udp ? _batchSize : _bufCap))
+    {
+        DropLogs(1);
+        return LLBC_OK;
+    }
+
+    // Buffer full, try send buffered log records, if still full, drop it.
+    // Note: drop log record is not an output error, must not break other appenders' output.
+    if (_bufCap - (_tail - _head) < frameSize)
+    {
+        SendBuffered();
+        if (_bufCap - (_tail - _head) < frameSize)
+        {
+            DropLogs(1);
+            return LLBC_OK;
+        }
+    }
+
+    // Compact buffer if tail space not enough.
+    if (_bufCap - _tail < frameSize)
+    {
+        ::memmove(_buf, _buf + _head, _tail - _head);
+        _tail -= _head;
+        _sendPos -= _head;
+        _batchEnd -= _head;
+        _head = 0;
+    }
+
+    // Append frame: [uint32 length(network order)][formatted log record].
+    const uint32 recordLen = LLBC_Host2Net2(static_cast<uint32>(formattedData.size()));
+    ::memcpy(_buf + _tail, &recordLen, sizeof(uint32));
+    ::memcpy(_buf + _tail + sizeof(uint32), formattedData.data(), formattedData.size());
+    _tail += frameSize;
+
+    if (_tail - _sendPos >= _batchSize)
+        SendBuffered();
+
+    return LLBC_OK;
+}
+
+sint64 LLBC_LogNetworkAppender::GetSentLogCount() const
+{
+    return LLBC_AtomicGet(const_cast<volatile sint64 *>(&_sentLogCount));
+}
+
+sint64 LLBC_LogNetworkAppender::GetDroppedLogCount() const
+{
+    return LLBC_AtomicGet(const_cast<volatile sint64 *>(&_droppedLogCount));
+}
+
+void LLBC_LogNetworkAppender::Flush()
+{
+    SendBuffered();
+}
+
+bool LLBC_LogNetworkAppender::HasPendingOutput() const
+{
+    return _sendPos != _tail;
+}
+
+void LLBC_LogNetworkAppender::SendBuffered()
+{
+    while (_sendPos != _tail)
+    {
+        if (!CheckConnection())
+            return;
+
+        // Previous batch all sent, build new batch.
+        if (_sendPos == _batchEnd)
+        {
+            _head = _sendPos;
+            _batchEnd = _head + BuildBatch(_batchFrameCount);
+        }
+
+        const int ret = LLBC_Send(_sock,
+                                  _buf + _sendPos,
+                                  static_cast<int>(_batchEnd - _sendPos),
+                                  LLBC_INL_NS __networkSendFlags);
+        if (ret == LLBC_FAILED)
+        {
+            // Collector too slow, wait next send.
+            const int errNo = LLBC_GetLastError();
+            if (errNo == LLBC_ERROR_WBLOCK || errNo == LLBC_ERROR_AGAIN)
+                return;
+
+            // Connection broken, reconnect later.
+            CloseAndScheduleReconnect();
+            return;
+        }
+
+        _sendPos += ret;
+        if (_sendPos == _batchEnd)
+            LLBC_AtomicFetchAndAdd(&_sentLogCount, static_cast<sint64>(_batchFrameCount));
+    }
+
+    // All sent, reset buffer.
+    _head = _tail = _sendPos = _batchEnd = 0;
+    _batchFrameCount = 0;
+}
+
+bool LLBC_LogNetworkAppender::CheckConnection()
+{
+    if (LIKELY(_connState == Connected))
+        return true;
+
+    const sint64 now = LLBC_GetMilliSeconds();
+    if (_connState == Disconnected)
+    {
+        if (now < _nextConnectTime)
+            return false;
+
+        _sock = _protocol == LLBC_LogNetworkProtocol::Udp ? LLBC_CreateUdpSocket() : LLBC_CreateTcpSocket();
+        if (_sock == LLBC_INVALID_SOCKET_HANDLE)
+        {
+            CloseAndScheduleReconnect();
+            return false;
+        }
+
+#if defined(SO_NOSIGPIPE)
+        int noSigPipe = 1;
+        LLBC_SetSocketOption(_sock, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+        if (LLBC_SetNonBlocking(_sock) != LLBC_OK)
+        {
+            CloseAndScheduleReconnect();
+            return false;
+        }
+
+        // Udp protocol connect to peer just bind the peer address, will not block.
+        if (LLBC_ConnectToPeer(_sock, LLBC_SockAddr_IN(_ip.c_str(), _port)) == LLBC_OK)
+        {
+            _connState = Connected;
+            _reconnectInterval = _initReconnectInterval;
+
+            return true;
+        }
+
+        if (LLBC_GetLastError() != LLBC_ERROR_WBLOCK)
+        {
+            CloseAndScheduleReconnect();
+            return false;
+        }
+
+        _connState = Connecting;
+        _connBeginTime = now;
+    }
+
+    // Connecting, check connect result(non-blocking).
+    LLBC_FdSet writeFds;
+    LLBC_ZeroFdSet(&writeFds);
+    LLBC_SetFd(_sock, &writeFds);
+
+    const int selectRet = LLBC_Select(static_cast<int>(_sock) + 1, NULL, &writeFds, NULL, 0);
+    if (selectRet == 0)
+    {
+        if (now - _connBeginTime >= LLBC_CFG_LOG_NETWORK_CONNECT_TIMEOUT)
+            CloseAndScheduleReconnect();
+
+        return false;
+    }
+
+    int sockErr = 0;
+    LLBC_SocketLen sockErrLen = sizeof(sockErr);
+    if (selectRet < 0 ||
+        LLBC_GetSocketOption(_sock, SOL_SOCKET, SO_ERROR, &sockErr, &sockErrLen) != LLBC_OK ||
+        sockErr != 0)
+    {
+        CloseAndScheduleReconnect();
+        return false;
+    }
+
+    _connState = Connected;
+    _reconnectInterval = _initReconnectInterval;
+
+    return true;
+}
+
+void LLBC_LogNetworkAppender::CloseAndScheduleReconnect()
+{
+    // Tcp connection broken when batch partial sent, the partial sent frame can't resend.
+    if (_sendPos != _head)
+        DropPartialBatch();
+    else
+        _batchEnd = _sendPos;
+
+    if (_sock != LLBC_INVALID_SOCKET_HANDLE)
+    {
+        LLBC_CloseSocket(_sock);
+        _sock = LLBC_INVALID_SOCKET_HANDLE;
+    }
+
+    _connState = Disconnected;
+
+    // Exponential backoff.
+    _nextConnectTime = LLBC_GetMilliSeconds() + _reconnectInterval;
+    if (_reconnectInterval > _maxReconnectInterval / 2)
+        _reconnectInterval = _maxReconnectInterval;
+    else
+        _reconnectInterval *= 2;
+}
+
+size_t LLBC_LogNetworkAppender::BuildBatch(size_t &frameCount) const
+{
+    size_t batchSize = 0;
+    frameCount = 0;
+    while (_head + batchSize < _tail)
+    {
+        uint32 recordLen;
+        ::memcpy(&recordLen, _buf + _head + batchSize, sizeof(uint32));
+        const size_t frameSize = sizeof(uint32) + LLBC_Net2Host2(recordLen);
+        if (batchSize > 0 && batchSize + frameSize > _batchSize)
+            break;
+
+        batchSize += frameSize;
+        ++frameCount;
+    }
+
+    return batchSize;
+}
+
+void LLBC_LogNetworkAppender::DropPartialBatch()
+{
+    size_t sentFrameCount = 0;
+    size_t frameEnd = _head;
+    while (frameEnd < _sendPos)
+    {
+        uint32 recordLen;
+        ::memcpy(&recordLen, _buf + frameEnd, sizeof(uint32));
+        frameEnd += sizeof(uint32) + LLBC_Net2Host2(recordLen);
+        if (frameEnd <= _sendPos)
+            ++sentFrameCount;
+    }
+
+    LLBC_AtomicFetchAndAdd(&_sentLogCount, static_cast<sint64>(sentFrameCount));
+    if (frameEnd != _sendPos)
+        DropLogs(1);
+
+    // The unsent frames will be sent in new batch.
+    _head = _sendPos = _batchEnd = frameEnd;
+}
+
+void LLBC_LogNetworkAppender::DropLogs(sint64 count)
+{
+    LLBC_AtomicFetchAndAdd(&_droppedLogCount, count);
 }
 
 __LLBC_NS_END
@@ -0,0 +1,339 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/core/os/OS_Time.h"
+#include "llbc/core/os/OS_Atomic.h"
+#include "llbc/core/thread/Guard.h"
+#include "llbc/core/utils/Util_Text.h"
+
+#include "llbc/core/log/LoggerConfigInfo.h"
+#include "llbc/core/log/LogRateLimiter.h"
+
+__LLBC_INTERNAL_NS_BEGIN
+
+// Max tags count listed in suppressed report.
+static const size_t __maxReportTagsCount = 16;
+
+// Thread local sampling random state(xorshift32), 0 means not seeded.
+static LLBC_THREAD_LOCAL LLBC_NS uint32 __sampleRandState = 0;
+
+static LLBC_NS uint32 __SampleRand()
+{
+    LLBC_NS uint32 x = __sampleRandState;
+    if (UNLIKELY(x == 0))
+    {
+        x = static_cast<LLBC_NS uint32>(LLBC_NS LLBC_GetMicroSeconds()) ^
+            static_cast<LLBC_NS uint32>(reinterpret_cast<size_t>(&__sampleRandState));
+        if (x == 0)
+            x = 0x9e3779b9;
+    }
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    __sampleRandState = x;
+
+    return x;
+}
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+LLBC_LogRateLimiter::_TokenBucket::_TokenBucket()
+: rate(0)
+, capacity(0)
+, tokens(0)
+, lastRefillTime(0)
+{
+}
+
+void LLBC_LogRateLimiter::_TokenBucket::SetLimit(sint64 rate, sint64 burst)
+{
+    this->rate = MAX(0, rate);
+    capacity = (burst > 0 ? burst : this->rate) * 1000;
+
+    tokens = capacity;
+    lastRefillTime = LLBC_GetMilliSeconds();
+}
+
+bool LLBC_LogRateLimiter::_TokenBucket::Acquire()
+{
+    if (rate == 0)
+        return true;
+
+    // Fast path, just take token, only tokens exhausted need read clock to refill.
+    if (LIKELY(TryTake()))
+        return true;
+
+    return Refill() && TryTake();
+}
+
+bool LLBC_LogRateLimiter::_TokenBucket::TryTake()
+{
+    sint64 curTokens = tokens;
+    while (curTokens >= 1000)
+    {
+        const sint64 oldTokens = LLBC_AtomicCompareAndExchange(&tokens, curTokens - 1000, curTokens);
+        if (oldTokens == curTokens)
+            return true;
+
+        curTokens = oldTokens;
+    }
+
+    return false;
+}
+
+bool LLBC_LogRateLimiter::_TokenBucket::Refill()
+{
+    const sint64 now = LLBC_GetMilliSeconds();
+    const sint64 lastTime = lastRefillTime;
+    if (now <= lastTime)
+        return false;
+
+    // Only one thread can refill the elapsed time, other threads just retry take token.
+    if (LLBC_AtomicCompareAndExchange(&lastRefillTime, now, lastTime) != lastTime)
+        return true;
+
+    // Rate is per second, so elapsed milli-seconds * rate is the refill 1/1000 tokens.
+    sint64 curTokens = tokens;
+    while (true)
+    {
+        const sint64 newTokens = MIN(curTokens + (now - lastTime) * rate, capacity);
+        const sint64 oldTokens = LLBC_AtomicCompareAndExchange(&tokens, newTokens, curTokens);
+        if (oldTokens == curTokens)
+            break;
+
+        curTokens = oldTokens;
+    }
+
+    return true;
+}
+
+LLBC_LogRateLimiter::LLBC_LogRateLimiter()
+: _lock()
+
+, _bucket()
+, _sampling(false)
+, _sampleThreshold(0)
+
+, _tagRateLimit(0)
+, _tagRateLimits()
+, _tagSlots(NULL)
+, _tagSlotMask(0)
+, _tagCount(0)
+
+, _reportInterval(LLBC_CFG_LOG_DEFAULT_SUPPRESSED_REPORT_INTERVAL)
+, _lastReportTime(0)
+, _lastReportTotalCount(0)
+
+, _rateLimitedCount(0)
+, _sampledOutCount(0)
+, _totalSuppressedCount(0)
+{
+}
+
+LLBC_LogRateLimiter::~LLBC_LogRateLimiter()
+{
+    if (!_tagSlots)
+        return;
+
+    for (size_t i = 0; i <= _tagSlotMask; ++i)
+        LLBC_XDelete(_tagSlots[i]);
+
+    LLBC_Free(const_cast<_TagLimiter **>(_tagSlots));
+}
+
+void LLBC_LogRateLimiter::Initialize(const LLBC_LoggerConfigInfo &config)
+{
+    LLBC_LockGuard guard(_lock);
+
+    _bucket.SetLimit(config.GetRateLimit(), config.GetRateLimitBurst());
+
+    const double sampleRate = MIN(MAX(0.0, config.GetSampleRate()), 1.0);
+    _sampling = sampleRate < 1.0;
+    _sampleThreshold = static_cast<uint32>(sampleRate * 4294967295.0);
+
+    _tagRateLimit = config.GetTagRateLimit();
+    _tagRateLimits = config.GetTagRateLimits();
+    if ((_tagRateLimit > 0 || !_tagRateLimits.empty()) && !_tagSlots)
+    {
+        // Keep load factor <= 0.5, make sure probe sequence always stop at an empty slot.
+        size_t slotCount = 4;
+        while (slotCount < LLBC_CFG_LOG_MAX_RATE_LIMIT_TAGS * 2)
+            slotCount <<= 1;
+
+        _tagSlots = LLBC_TagCalloc(LLBC_MemoryTag::Log, _TagLimiter * volatile, sizeof(_TagLimiter *) * slotCount);
+        _tagSlotMask = slotCount - 1;
+    }
+
+    _reportInterval = config.GetSuppressedReportInterval();
+    _lastReportTime = LLBC_GetMilliSeconds();
+}
+
+bool LLBC_LogRateLimiter::Allow(const char *tag)
+{
+    if (tag && _tagSlots)
+    {
+        _TagLimiter *tagLimiter = GetTagLimiter(tag);
+        if (tagLimiter && !tagLimiter->bucket.Acquire())
+        {
+            LLBC_AtomicFetchAndAdd(&tagLimiter->suppressedCount, 1);
+            LLBC_AtomicFetchAndAdd(&_totalSuppressedCount, 1);
+
+            return false;
+        }
+    }
+
+    if (!_bucket.Acquire())
+    {
+        LLBC_AtomicFetchAndAdd(&_rateLimitedCount, 1);
+        LLBC_AtomicFetchAndAdd(&_totalSuppressedCount, 1);
+
+        return false;
+    }
+
+    if (_sampling && LLBC_INL_NS __SampleRand() >= _sampleThreshold)
+    {
+        LLBC_AtomicFetchAndAdd(&_sampledOutCount, 1);
+        LLBC_AtomicFetchAndAdd(&_totalSuppressedCount, 1);
+
+        return false;
+    }
+
+    return true;
+}
+
+bool LLBC_LogRateLimiter::BuildReport(LLBC_String &report)
+{
+    // Check without lock first, most of calls has nothing to report.
+    if (_totalSuppressedCount == _lastReportTotalCount)
+        return false;
+
+    const sint64 now = LLBC_GetMilliSeconds();
+    if (now - _lastReportTime < _reportInterval)
+        return false;
+
+    LLBC_LockGuard guard(_lock);
+    if (now - _lastReportTime < _reportInterval)
+        return false;
+
+    const sint64 totalCount = LLBC_AtomicGet(&_totalSuppressedCount);
+    const sint64 rateLimitedCount = FetchAndClear(&_rateLimitedCount);
+    const sint64 sampledOutCount = FetchAndClear(&_sampledOutCount);
+
+    report.format("suppressed %lld log messages in last %lld ms(rate limited: %lld, sampled out: %lld",
+                  totalCount - _lastReportTotalCount,
+                  now - _lastReportTime,
+                  rateLimitedCount,
+                  sampledOutCount);
+
+    size_t reportedTagsCount = 0;
+    for (size_t i = 0; _tagSlots && i <= _tagSlotMask; ++i)
+    {
+        _TagLimiter *tagLimiter = _tagSlots[i];
+        if (!tagLimiter)
+            continue;
+
+        const sint64 tagSuppressedCount = FetchAndClear(&tagLimiter->suppressedCount);
+        if (tagSuppressedCount == 0)
+            continue;
+
+        if (reportedTagsCount < LLBC_INL_NS __maxReportTagsCount)
+            report.append_format("%s%s: %lld",
+                                 reportedTagsCount == 0 ? ", tag rate limited: {" : ", ",
+                                 tagLimiter->tag.c_str(),
+                                 tagSuppressedCount);
+        else if (reportedTagsCount == LLBC_INL_NS __maxReportTagsCount)
+            report.append(", ...");
+
+        ++reportedTagsCount;
+    }
+
+    report.append(reportedTagsCount > 0 ? "})" : ")");
+
+    _lastReportTotalCount = totalCount;
+    _lastReportTime = now;
+
+    return true;
+}
+
+sint64 LLBC_LogRateLimiter::GetSuppressedCount() const
+{
+    LLBC_LogRateLimiter *ncThis = const_cast<LLBC_LogRateLimiter *>(this);
+    return LLBC_AtomicGet(&ncThis->_totalSuppressedCount);
+}
+
+LLBC_LogRateLimiter::_TagLimiter *LLBC_LogRateLimiter::GetTagLimiter(const char *tag)
+{
+    // Lock free lookup, tag limiter never removed before rate limiter destroy.
+    const int hash = LLBC_HashString(tag);
+    size_t idx = static_cast<size_t>(hash) & _tagSlotMask;
+    for (_TagLimiter *tagLimiter = _tagSlots[idx];
+         tagLimiter;
+         idx = (idx + 1) & _tagSlotMask, tagLimiter = _tagSlots[idx])
+    {
+        if (tagLimiter->hash == hash && ::strcmp(tagLimiter->tag.c_str(), tag) == 0)
+            return tagLimiter;
+    }
+
+    // First time seen tag, create tag limiter under lock(other thread may create it already).
+    LLBC_LockGuard guard(_lock);
+    for (; _tagSlots[idx]; idx = (idx + 1) & _tagSlotMask)
+    {
+        _TagLimiter *tagLimiter = _tagSlots[idx];
+        if (tagLimiter->hash == hash && ::strcmp(tagLimiter->tag.c_str(), tag) == 0)
+            return tagLimiter;
+    }
+
+    if (_tagCount >= LLBC_CFG_LOG_MAX_RATE_LIMIT_TAGS)
+        return NULL;
+
+    // Specific tag rate limit first, the limiter owned the tag string.
+    _TagLimiter *tagLimiter = LLBC_New(_TagLimiter);
+    tagLimiter->hash = hash;
+    tagLimiter->tag.append(tag);
+    tagLimiter->suppressedCount = 0;
+
+    std::map<LLBC_String, int>::const_iterator rateIt = _tagRateLimits.find(tagLimiter->tag);
+    tagLimiter->bucket.SetLimit(rateIt != _tagRateLimits.end() ? rateIt->second : _tagRateLimit, 0);
+
+    // Publish tag limiter after limiter fully constructed.
+    _tagSlots[idx] = tagLimiter;
+    ++_tagCount;
+
+    return tagLimiter;
+}
+
+sint64 LLBC_LogRateLimiter::FetchAndClear(volatile sint64 *count)
+{
+    const sint64 oldCount = LLBC_AtomicGet(count);
+    LLBC_AtomicFetchAndSub(count, oldCount);
+
+    return oldCount;
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
@@ -0,0 +1,177 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/core/os/OS_Atomic.h"
+#include "llbc/core/utils/Util_Text.h"
+
+#include "llbc/core/log/LogRing.h"
+
+__LLBC_INTERNAL_NS_BEGIN
+
+static const LLBC_NS LLBC_String __overflowPolicyDesc[LLBC_NS LLBC_LogRingOverflowPolicy::End + 1] =
+{
+    "BLOCK",
+    "DROP",
+    "SYNC",
+
+    "UNKNOWN"
+};
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+const LLBC_String &LLBC_LogRingOverflowPolicy::GetPolicyDesc(int policy)
+{
+    return (IsLegal(policy) ?
+        LLBC_INTERNAL_NS __overflowPolicyDesc[policy] : LLBC_INTERNAL_NS __overflowPolicyDesc[End]);
+}
+
+int LLBC_LogRingOverflowPolicy::Str2Policy(const char *str)
+{
+    if (UNLIKELY(!str))
+        return End;
+
+    const LLBC_String upperStr = LLBC_ToUpper(str);
+    for (int policy = Begin; policy != End; ++policy)
+    {
+        if (upperStr == LLBC_INTERNAL_NS __overflowPolicyDesc[policy])
+            return policy;
+    }
+
+    return End;
+}
+
+bool LLBC_LogRingOverflowPolicy::IsLegal(int policy)
+{
+    return (Begin <= policy && policy < End);
+}
+
+LLBC_LogRing::Slot::Slot()
+: owner(NULL)
+, data()
+{
+}
+
+LLBC_LogRing::LLBC_LogRing(size_t capacity)
+: _capacity(1)
+, _mask(0)
+, _slots(NULL)
+
+, _head(0)
+, _cachedTail(0)
+
+, _tail(0)
+, _cachedHead(0)
+
+, _state(InUse)
+{
+    while (_capacity < capacity)
+        _capacity <<= 1;
+
+    _mask = static_cast<sint64>(_capacity - 1);
+    _slots = LLBC_News(Slot, _capacity);
+}
+
+LLBC_LogRing::~LLBC_LogRing()
+{
+    LLBC_XDeletes(_slots);
+}
+
+size_t LLBC_LogRing::GetCapacity() const
+{
+    return _capacity;
+}
+
+size_t LLBC_LogRing::GetSize() const
+{
+    LLBC_LogRing *nonConstThis = const_cast<LLBC_LogRing *>(this);
+    return static_cast<size_t>(LLBC_AtomicGet(&nonConstThis->_tail) - LLBC_AtomicGet(&nonConstThis->_head));
+}
+
+LLBC_LogRing::Slot *LLBC_LogRing::BeginWrite()
+{
+    // Only reload consumer head when cached head show ring is full.
+    if (_tail - _cachedHead >= static_cast<sint64>(_capacity))
+    {
+        _cachedHead = LLBC_AtomicGet(&_head);
+        if (_tail - _cachedHead >= static_cast<sint64>(_capacity))
+            return NULL;
+    }
+
+    return &_slots[_tail & _mask];
+}
+
+void LLBC_LogRing::EndWrite()
+{
+    // Full barrier, make sure slot data visible to consumer before tail updated.
+    LLBC_AtomicFetchAndAdd(&_tail, 1);
+}
+
+LLBC_LogRing::Slot *LLBC_LogRing::Front()
+{
+    // Only reload producer tail when cached tail show ring is empty.
+    if (_head == _cachedTail)
+    {
+        _cachedTail = LLBC_AtomicGet(&_tail);
+        if (_head == _cachedTail)
+            return NULL;
+    }
+
+    return &_slots[_head & _mask];
+}
+
+void LLBC_LogRing::PopFront()
+{
+    Slot &slot = _slots[_head & _mask];
+    slot.owner = NULL;
+    slot.data.Clear();
+
+    LLBC_AtomicFetchAndAdd(&_head, 1);
+}
+
+void LLBC_LogRing::Release()
+{
+    // Full barrier, make sure all published slots visible before ring released.
+    LLBC_AtomicSet(&_state, Released);
+}
+
+bool LLBC_LogRing::Reclaim()
+{
+    if (_state != Released || Front())
+        return false;
+
+    return LLBC_AtomicCompareAndExchange(&_state, Reclaimed, Released) == Released;
+}
+
+bool LLBC_LogRing::Reuse()
+{
+    // Producer side members keep consistent after producer thread exited, new producer just continue to write.
+    return _state == Reclaimed &&
+        LLBC_AtomicCompareAndExchange(&_state, InUse, Reclaimed) == Reclaimed;
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
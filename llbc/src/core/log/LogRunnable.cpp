@@ -23,46 +23,101 @@
 #include "llbc/common/BeforeIncl.h"
 
 #include "llbc/core/os/OS_Time.h"
+#include "llbc/core/os/OS_Atomic.h"
+#include "llbc/core/thread/Guard.h"
 #include "llbc/core/thread/MessageBlock.h"
 #include "llbc/core/objectpool/PoolObjectReflection.h"
 
+#include "llbc/core/log/LogArg.h"
 #include "llbc/core/log/LogData.h"
+#include "llbc/core/log/LogRing.h"
+#include "llbc/core/log/LogFormatCache.h"
 #include "llbc/core/log/ILogAppender.h"
+#include "llbc/core/log/Logger.h"
 #include "llbc/core/log/LogRunnable.h"
 
+__LLBC_INTERNAL_NS_BEGIN
+
+/**
+ * Thread ring key destructor, release producer thread's log ring when thread exit.
+ */
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+static void __ReleaseThreadRing(void *ring)
+#else
+static void WINAPI __ReleaseThreadRing(void *ring)
+#endif
+{
+    if (ring)
+        reinterpret_cast<LLBC_NS LLBC_LogRing *>(ring)->Release();
+}
+
+__LLBC_INTERNAL_NS_END
+
 __LLBC_NS_BEGIN
 
 LLBC_LogRunnable::LLBC_LogRunnable()
 : _stoped(false)
 , _head(NULL)
+, _dirty(false)
+, _suppressedReporter(NULL)
 
 , _lastFlushTime(0)
 , _flushInterval(LLBC_CFG_LOG_DEFAULT_LOG_FLUSH_INTERVAL)
+
+, _ringBufferSize(0)
+, _threadRingKey()
+, _ringLock()
+, _ringCount(0)
+
+, _outputLock()
+
+, _threadFmtCache()
+, _fmtCacheLock()
 {
+    LLBC_MemSet(_rings, 0, sizeof(_rings));
+
+    // Use thread key destructor(Tls not support) to release producer thread's log ring when thread exit.
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    (void)pthread_key_create(&_threadRingKey, &LLBC_INL_NS __ReleaseThreadRing);
+#else
+    _threadRingKey = ::FlsAlloc(&LLBC_INL_NS __ReleaseThreadRing);
+#endif
 }
 
 LLBC_LogRunnable::~LLBC_LogRunnable()
 {
+    // Free thread ring key before delete rings, after key freed, thread exit will not release ring.
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    (void)pthread_key_delete(_threadRingKey);
+#else
+    (void)::FlsFree(_threadRingKey);
+#endif
+
+    for (sint32 i = 0; i < _ringCount; ++i)
+        LLBC_XDelete(_rings[i]);
+
+    for (size_t i = 0; i < _fmtCaches.size(); ++i)
+        LLBC_Delete(_fmtCaches[i]);
 }
 
 void LLBC_LogRunnable::Cleanup()
 {
+    LLBC_LockGuard guard(_outputLock);
+
+    // Output all log data in rings.
+    while (DrainRings() > 0);
+
     // Output all queued log messages.
-    LLBC_LogData *logData = NULL;
     LLBC_MessageBlock *block = NULL;
     while (TryPop(block) == LLBC_OK)
-    {
-        block->Read(&logData, sizeof(LLBC_LogData *));
-
-        Output(logData);
-        LLBC_Recycle(logData);
-
-        LLBC_Recycle(block);
-    }
+        OutputQueuedLogData(block);
 
     // Flush all appenders(force).
     FlushAppenders(true);
 
+    // Served runnables' appenders owned by served runnables, just clear.
+    _servedRunnables.clear();
+
     // Delete all appender.
     while (_head)
     {
@@ -75,23 +130,30 @@ void LLBC_LogRunnable::Cleanup()
 
 void LLBC_LogRunnable::Svc()
 {
-    LLBC_LogData *logData = NULL;
     LLBC_MessageBlock *block = NULL;
     while (LIKELY(!_stoped))
     {
-        // Flush all appenders(not force).
-        FlushAppenders(false);
+        // Flush all appenders(not force), and drain all log rings.
+        size_t drainedCount;
+        {
+            LLBC_LockGuard guard(_outputLock);
 
-        // Try pop log message to output.
-        if (TimedPop(block, 50) != LLBC_OK)
-            continue;
+            FlushAppenders(false);
+            drainedCount = DrainRings();
+        }
 
-        block->Read(&logData, sizeof(LLBC_LogData *));
+        // Try pop log message to output, if has log rings, use ring drain interval to wait.
+        int popRet;
+        if (drainedCount > 0)
+            popRet = TryPop(block);
+        else
+            popRet = TimedPop(block, _ringCount > 0 ? LLBC_CFG_LOG_RING_DRAIN_INTERVAL : 50);
 
-        Output(logData);
-        LLBC_Recycle(logData);
+        if (popRet != LLBC_OK)
+            continue;
 
-        LLBC_Recycle(block);
+        LLBC_LockGuard guard(_outputLock);
+        OutputQueuedLogData(block);
     }
 }
 
@@ -100,6 +162,16 @@ void LLBC_LogRunnable::SetFlushInterval(sint64 flushInterval)
     _flushInterval = flushInterval;
 }
 
+void LLBC_LogRunnable::SetRingBufferSize(size_t ringBufferSize)
+{
+    _ringBufferSize = ringBufferSize;
+}
+
+void LLBC_LogRunnable::SetSuppressedReporter(LLBC_Logger *reporter)
+{
+    _suppressedReporter = reporter;
+}
+
 void LLBC_LogRunnable::AddAppender(LLBC_ILogAppender *appender)
 {
     appender->SetAppenderNext(NULL);
@@ -118,6 +190,23 @@ void LLBC_LogRunnable::AddAppender(LLBC_ILogAppender *appender)
     tmpAppender->SetAppenderNext(appender);
 }
 
+void LLBC_LogRunnable::AddServedRunnable(LLBC_LogRunnable *runnable)
+{
+    if (std::find(_servedRunnables.begin(),
+                  _servedRunnables.end(),
+                  runnable) != _servedRunnables.end())
+        return;
+
+    if (_servedRunnables.empty() && !_head)
+        _flushInterval = runnable->_flushInterval;
+    else
+        _flushInterval = MIN(_flushInterval, runnable->_flushInterval);
+
+    _ringBufferSize = MAX(_ringBufferSize, runnable->_ringBufferSize);
+
+    _servedRunnables.push_back(runnable);
+}
+
 int LLBC_LogRunnable::Output(LLBC_LogData *data)
 {
     LLBC_ILogAppender *appender = _head;
@@ -125,18 +214,107 @@ int LLBC_LogRunnable::Output(LLBC_LogData *data)
     {
         return LLBC_OK;
     }
-    
+
+    // If is binary log data, format it first(only format once, all appenders share the formatted message).
+    LLBC_LogArg::Format(*data);
+
+    // Attach output thread's format cache, appenders which have same pattern only format once.
+    LLBC_LogFormatCache *fmtCache = GetThreadFormatCache();
+    fmtCache->Reset();
+    data->fmtCache = fmtCache;
+
+    int ret = LLBC_OK;
+    _dirty = true;
     while (appender)
     {
         if (appender->Output(*data) != LLBC_OK)
         {
-            return LLBC_FAILED;
+            ret = LLBC_FAILED;
+            break;
         }
 
         appender = appender->GetAppenderNext();
     }
 
-    return LLBC_OK;
+    data->fmtCache = NULL;
+
+    return ret;
+}
+
+void LLBC_LogRunnable::PushLogData(LLBC_LogRunnable *owner, LLBC_LogData *data, LLBC_MessageBlock *block)
+{
+    block->Write(&owner, sizeof(LLBC_LogRunnable *));
+    block->Write(&data, sizeof(LLBC_LogData *));
+
+    Push(block);
+}
+
+LLBC_LogRing *LLBC_LogRunnable::GetThreadRing()
+{
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    LLBC_LogRing *ring = reinterpret_cast<LLBC_LogRing *>(pthread_getspecific(_threadRingKey));
+#else
+    LLBC_LogRing *ring = reinterpret_cast<LLBC_LogRing *>(::FlsGetValue(_threadRingKey));
+#endif
+    if (LIKELY(ring) || _ringBufferSize == 0)
+        return ring;
+
+    LLBC_LockGuard guard(_ringLock);
+
+    // Reuse the ring which released by exited producer thread and reclaimed by log thread first.
+    for (sint32 i = 0; i < _ringCount; ++i)
+    {
+        if (_rings[i]->Reuse())
+        {
+            ring = _rings[i];
+            break;
+        }
+    }
+
+    if (!ring)
+    {
+        if (_ringCount >= LLBC_CFG_LOG_MAX_RING_COUNT)
+            return NULL;
+
+        // Publish ring to consumer after ring pointer stored.
+        ring = LLBC_New1(LLBC_LogRing, _ringBufferSize);
+        _rings[_ringCount] = ring;
+        LLBC_AtomicFetchAndAdd(&_ringCount, 1);
+    }
+
+    // Ring owned by runnable, thread key value just used to release ring when thread exit.
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    (void)pthread_setspecific(_threadRingKey, ring);
+#else
+    (void)::FlsSetValue(_threadRingKey, ring);
+#endif
+
+    return ring;
+}
+
+LLBC_LogFormatCache *LLBC_LogRunnable::GetThreadFormatCache()
+{
+    LLBC_LogFormatCache *fmtCache = _threadFmtCache.GetValue();
+    if (LIKELY(fmtCache))
+        return fmtCache;
+
+    LLBC_LockGuard guard(_fmtCacheLock);
+
+    fmtCache = LLBC_New(LLBC_LogFormatCache);
+    _fmtCaches.push_back(fmtCache);
+
+    // Format cache owned by runnable, so don't clear tls value when runnable destroy.
+    _threadFmtCache.SetValue(fmtCache);
+
+    return fmtCache;
+}
+
+int LLBC_LogRunnable::SyncOutput(LLBC_LogRing *ring, LLBC_LogRunnable *owner, LLBC_LogData *data)
+{
+    LLBC_LockGuard guard(_outputLock);
+
+    DrainRing(ring);
+    return owner->Output(data);
 }
 
 void LLBC_LogRunnable::Stop()
@@ -153,18 +331,116 @@ void LLBC_LogRunnable::FlushAppenders(bool force)
         sint64 diff = now - _lastFlushTime;
         if (diff >= 0 && diff < _flushInterval)
             return;
+
+        // Flush tick, report suppressed log messages, the reports will be flushed with appenders.
+        ReportSuppressed();
     }
 
-    // Foreach appenders to flush.
-    LLBC_ILogAppender *appender = _head;
-    while (appender)
+    // Foreach appenders to flush(if appender still has pending output, keep dirty to flush it again).
+    if (_dirty || force)
     {
-        appender->Flush();
-        appender = appender->GetAppenderNext();
+        _dirty = false;
+
+        LLBC_ILogAppender *appender = _head;
+        while (appender)
+        {
+            appender->Flush();
+            if (appender->HasPendingOutput())
+                _dirty = true;
+
+            appender = appender->GetAppenderNext();
+        }
+    }
+
+    // Batch flush all dirty served runnables.
+    for (std::vector<LLBC_LogRunnable *>::iterator it = _servedRunnables.begin();
+         it != _servedRunnables.end();
+         ++it)
+    {
+        if ((*it)->_dirty)
+            (*it)->FlushAppenders(true);
     }
 
     // Update last flush time(use flushed time to avoid logger performance problem).
-    _lastFlushTime = LLBC_GetMicroSeconds();
+    _lastFlushTime = LLBC_GetMilliSeconds();
+}
+
+void LLBC_LogRunnable::ReportSuppressed()
+{
+    if (_suppressedReporter)
+        _suppressedReporter->ReportSuppressed();
+
+    for (std::vector<LLBC_LogRunnable *>::iterator it = _servedRunnables.begin();
+         it != _servedRunnables.end();
+         ++it)
+    {
+        if ((*it)->_suppressedReporter)
+            (*it)->_suppressedReporter->ReportSuppressed();
+    }
+}
+
+void LLBC_LogRunnable::OutputQueuedLogData(LLBC_MessageBlock *block)
+{
+    LLBC_LogRunnable *owner = NULL;
+    LLBC_LogData *logData = NULL;
+    block->Read(&owner, sizeof(LLBC_LogRunnable *));
+    block->Read(&logData, sizeof(LLBC_LogData *));
+
+    owner->Output(logData);
+    LLBC_Recycle(logData);
+
+    LLBC_Recycle(block);
+}
+
+size_t LLBC_LogRunnable::DrainRings()
+{
+    const sint32 ringCount = LLBC_AtomicGet(&_ringCount);
+    if (ringCount == 0)
+        return 0;
+
+    size_t drainedCount = 0;
+    while (drainedCount < LLBC_CFG_LOG_RING_DRAIN_BATCH_SIZE)
+    {
+        // Select the earliest log data from all rings' front slot.
+        LLBC_LogRing *earliestRing = NULL;
+        LLBC_LogRing::Slot *earliestSlot = NULL;
+        for (sint32 i = 0; i < ringCount; ++i)
+        {
+            LLBC_LogRing::Slot *slot = _rings[i]->Front();
+            if (slot && (!earliestSlot || slot->data.logTime < earliestSlot->data.logTime))
+            {
+                earliestRing = _rings[i];
+                earliestSlot = slot;
+            }
+        }
+
+        if (!earliestSlot)
+            break;
+
+        earliestSlot->owner->Output(&earliestSlot->data);
+        earliestRing->PopFront();
+
+        ++drainedCount;
+    }
+
+    // All rings drained, reclaim the rings which released by exited producer threads.
+    if (drainedCount < LLBC_CFG_LOG_RING_DRAIN_BATCH_SIZE)
+    {
+        for (sint32 i = 0; i < ringCount; ++i)
+            _rings[i]->Reclaim();
+    }
+
+    return drainedCount;
+}
+
+void LLBC_LogRunnable::DrainRing(LLBC_LogRing *ring)
+{
+    LLBC_LogRing::Slot *slot;
+    while ((slot = ring->Front()) != NULL)
+    {
+        slot->owner->Output(&slot->data);
+        ring->PopFront();
+    }
 }
 
 __LLBC_NS_END
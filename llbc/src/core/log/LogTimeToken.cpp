@@ -25,6 +25,7 @@
 #include "llbc/core/time/Time.h"
 
 #include "llbc/core/log/LogData.h"
+#include "llbc/core/log/LogFormatCache.h"
 #include "llbc/core/log/LogFormattingInfo.h"
 #include "llbc/core/log/LogTimeToken.h"
 
@@ -51,24 +52,35 @@ int LLBC_LogTimeToken::GetType() const
 
 void LLBC_LogTimeToken::Format(const LLBC_LogData &data, LLBC_String &formattedData) const
 {
-    // Format non millisecond part.
+    // Format non millisecond part(if has format cache, only rebuild it when second changed).
     int index = static_cast<int>(formattedData.size());
-    time_t timeInSecond = static_cast<time_t>(data.logTime / 1000);
-
-    struct tm timeStruct;
+    if (data.fmtCache)
+    {
+        formattedData.append(data.fmtCache->GetTimePrefix(data.logTime), LLBC_LogFormatCache::TimePrefixLen);
+    }
+    else
+    {
+        time_t timeInSecond = static_cast<time_t>(data.logTime / 1000);
+
+        struct tm timeStruct;
 #if LLBC_TARGET_PLATFORM_WIN32
-    localtime_s(&timeStruct, &timeInSecond);
+        localtime_s(&timeStruct, &timeInSecond);
 #else
-    localtime_r(&timeInSecond, &timeStruct);
+        localtime_r(&timeInSecond, &timeStruct);
 #endif
 
-    char fmttedBuf[19];
-    strftime(fmttedBuf, sizeof(fmttedBuf), "%y-%m-%d %H:%M:%S.", &timeStruct);
+        char fmttedBuf[19];
+        strftime(fmttedBuf, sizeof(fmttedBuf), "%y-%m-%d %H:%M:%S.", &timeStruct);
 
-    formattedData.append(fmttedBuf, 18);
+        formattedData.append(fmttedBuf, 18);
+    }
 
     // Format millisecond part.
-    formattedData.append_format("%03llu", data.logTime % 1000);
+    const int milliSecond = static_cast<int>(data.logTime % 1000);
+    const char milliSecondBuf[3] = {static_cast<char>('0' + milliSecond / 100),
+                                    static_cast<char>('0' + milliSecond / 10 % 10),
+                                    static_cast<char>('0' + milliSecond % 10)};
+    formattedData.append(milliSecondBuf, sizeof(milliSecondBuf));
 
     LLBC_LogFormattingInfo *formatter = GetFormatter();
     formatter->Format(formattedData, index);
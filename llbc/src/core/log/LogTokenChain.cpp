@@ -48,7 +48,8 @@ __LLBC_INTERNAL_NS_END
 __LLBC_NS_BEGIN
 
 LLBC_LogTokenChain::LLBC_LogTokenChain()
-: _head(NULL)
+: _pattern()
+, _head(NULL)
 {
 }
 
@@ -85,6 +86,8 @@ int LLBC_LogTokenChain::Build(const LLBC_String &pattern)
         patternLength = pattern.size();
     }
 
+    _pattern.assign(curPattern, patternLength);
+
     for (size_t i = 0; i < patternLength;)
     {
         ch = curPattern[i++];
@@ -207,6 +210,11 @@ void LLBC_LogTokenChain::Format(const LLBC_LogData &data, LLBC_String &formatted
     }
 }
 
+const LLBC_String &LLBC_LogTokenChain::GetPattern() const
+{
+    return _pattern;
+}
+
 void LLBC_LogTokenChain::Cleanup()
 {
     while (_head)
@@ -216,6 +224,8 @@ void LLBC_LogTokenChain::Cleanup()
         LLBC_Delete(_head);
         _head = next;
     }
+
+    _pattern.clear();
 }
 
 void LLBC_LogTokenChain::AppendToken(LLBC_ILogToken *token)
@@ -1,418 +1,688 @@
-// The MIT License (MIT)
-
-// Copyright (c) 2013 lailongwei<lailongwei@126.com>
-// 
-// Permission is hereby granted, free of charge, to any person obtaining a copy of 
-// this software and associated documentation files (the "Software"), to deal in 
-// the Software without restriction, including without limitation the rights to 
-// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
-// the Software, and to permit persons to whom the Software is furnished to do so, 
-// subject to the following conditions:
-// 
-// The above copyright notice and this permission notice shall be included in all 
-// copies or substantial portions of the Software.
-// 
-// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
-// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
-// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
-// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
-// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
-// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
-
-#include "llbc/common/Export.h"
-#include "llbc/common/BeforeIncl.h"
-
-#include "llbc/core/utils/Util_Text.h"
-
-#include "llbc/core/os/OS_Time.h"
-
-#include "llbc/core/thread/Guard.h"
-#include "llbc/core/thread/MessageBlock.h"
-
-#include "llbc/core/log/LogLevel.h"
-#include "llbc/core/log/LogData.h"
-#include "llbc/core/log/LoggerConfigInfo.h"
-#include "llbc/core/log/ILogAppender.h"
-#include "llbc/core/log/LogAppenderBuilder.h"
-#include "llbc/core/log/LogRunnable.h"
-#include "llbc/core/log/Logger.h"
-
-#if LLBC_TARGET_PLATFORM_WIN32
-#pragma warning(disable:4996)
-#endif
-
-__LLBC_INTERNAL_NS_BEGIN
-
-static const LLBC_NS LLBC_String __g_invalidLoggerName;
-
-__LLBC_INTERNAL_NS_END
-
-__LLBC_NS_BEGIN
-
-LLBC_Logger::LLBC_Logger()
-: _lock()
-, _name()
-, _logLevel(LLBC_LogLevel::Debug)
-, _config(NULL)
-, _logRunnable(NULL)
-, _msgBlockPoolInst(*_objPool.GetPoolInst<LLBC_MessageBlock>())
-, _logDataPoolInst(*_objPool.GetPoolInst<LLBC_LogData>())
-{
-    LLBC_MemSet(_hookDelegs, 0, sizeof(_hookDelegs));
-}
-
-LLBC_Logger::~LLBC_Logger()
-{
-    Finalize();
-}
-
-int LLBC_Logger::Initialize(const LLBC_String &name, const LLBC_LoggerConfigInfo *config)
-{
-    if (name.empty() || !config)
-    {
-        LLBC_SetLastError(LLBC_ERROR_ARG);
-        return LLBC_FAILED;
-    }
-    else if (IsInit())
-    {
-        LLBC_SetLastError(LLBC_ERROR_REENTRY);
-        return LLBC_FAILED;
-    }
-
-    LLBC_LockGuard guard(_lock);
-    _name.append(name);
-
-    _config = config;
-
-    _logLevel = MIN(_config->GetConsoleLogLevel(), _config->GetFileLogLevel());
-
-    _logRunnable = LLBC_New0(LLBC_LogRunnable);
-    _logRunnable->SetFlushInterval(_config->GetFlushInterval());
-
-    if (_config->IsLogToConsole())
-    {
-        LLBC_LogAppenderInitInfo appenderInitInfo;
-        appenderInitInfo.level = _config->GetConsoleLogLevel();
-        appenderInitInfo.pattern = _config->GetConsolePattern();
-        appenderInitInfo.colourfulOutput = _config->IsColourfulOutput();
-
-        LLBC_ILogAppender *appender = 
-            LLBC_LogAppenderBuilderSingleton->BuildAppender(LLBC_LogAppenderType::Console);
-        if (appender->Initialize(appenderInitInfo) != LLBC_OK)
-        {
-            LLBC_XDelete(appender);
-            return LLBC_FAILED;
-        }
-
-        _logRunnable->AddAppender(appender);
-    }
-
-    if (_config->IsLogToFile())
-    {
-        LLBC_LogAppenderInitInfo appenderInitInfo;
-        appenderInitInfo.level = _config->GetFileLogLevel();
-        appenderInitInfo.pattern = _config->GetFilePattern();
-        appenderInitInfo.file = _config->GetLogFile();
-        appenderInitInfo.fileSuffix = _config->GetLogFileSuffix();
-        appenderInitInfo.forceAppLogPath = _config->IsForceAppLogPath();
-        appenderInitInfo.dailyRolling = _config->IsDailyRollingMode();
-        appenderInitInfo.maxFileSize = _config->GetMaxFileSize();
-        appenderInitInfo.maxBackupIndex = _config->GetMaxBackupIndex();
-        appenderInitInfo.lazyCreateLogFile = _config->IsLazyCreateLogFile();
-
-        if (!_config->IsAsyncMode())
-            appenderInitInfo.fileBufferSize = 0;
-        else
-            appenderInitInfo.fileBufferSize = _config->GetFileBufferSize();
-
-        LLBC_ILogAppender *appender =
-            LLBC_LogAppenderBuilderSingleton->BuildAppender(LLBC_LogAppenderType::File);
-        if (appender->Initialize(appenderInitInfo) != LLBC_OK)
-        {
-            LLBC_XDelete(appender);
-            return LLBC_FAILED;
-        }
-
-        _logRunnable->AddAppender(appender);
-    }
-
-    if (_config->IsAsyncMode())
-        _logRunnable->Activate(1);
-
-    return LLBC_OK;
-}
-
-bool LLBC_Logger::IsInit() const
-{
-    LLBC_Logger *ncThis = const_cast<LLBC_Logger *>(this);
-    LLBC_LockGuard guard(ncThis->_lock);
-
-    return (_logRunnable ? true : false);
-}
-
-void LLBC_Logger::Finalize()
-{
-    LLBC_LockGuard guard(_lock);
-    if (!_logRunnable)
-        return;
-
-    for (int level = LLBC_LogLevel::Begin; level != LLBC_LogLevel::End; ++level)
-        UninstallHook(level);
-
-    if (_config->IsAsyncMode())
-    {
-        _logRunnable->Stop();
-        _logRunnable->Wait();
-    }
-    else
-    {
-        _logRunnable->Cleanup();
-    }
-
-    LLBC_XDelete(_logRunnable);
-
-    _name.clear();
-    _config = NULL;
-}
-
-const LLBC_String &LLBC_Logger::GetLoggerName() const
-{
-    LLBC_Logger *nonConstThis = const_cast<LLBC_Logger *>(this);
-    LLBC_LockGuard guard(nonConstThis->_lock);
-    if (!_logRunnable)
-    {
-        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
-        return LLBC_INTERNAL_NS __g_invalidLoggerName;
-    }
-
-    LLBC_SetLastError(LLBC_ERROR_SUCCESS);
-    return _name;
-}
-
-int LLBC_Logger::GetLogLevel() const
-{
-    return _logLevel;
-}
-
-void LLBC_Logger::SetLogLevel(int level)
-{
-    LLBC_LockGuard guard(_lock);
-
-    _logLevel = MIN(MAX(LLBC_LogLevel::Begin, level), LLBC_LogLevel::End - 1);
-}
-
-bool LLBC_Logger::IsTakeOver() const
-{
-    LLBC_Logger *ncThis = const_cast<LLBC_Logger *>(this);
-    LLBC_LockGuard guard(ncThis->_lock);
-
-    return _config->IsTakeOver();
-}
-
-int LLBC_Logger::InstallHook(int level, LLBC_IDelegate1<void, const LLBC_LogData *> *hookDeleg)
-{
-    if (UNLIKELY(!LLBC_LogLevel::IsLegal(level) ||
-        !hookDeleg))
-    {
-        LLBC_SetLastError(LLBC_ERROR_ARG);
-        return LLBC_FAILED;
-    }
-
-    LLBC_LockGuard guard(_lock);
-
-    UninstallHook(level);
-    _hookDelegs[level] = hookDeleg;
-
-    return LLBC_OK;
-}
-
-void LLBC_Logger::UninstallHook(int level)
-{
-    LLBC_LockGuard guard(_lock);
-
-    if (LIKELY(LLBC_LogLevel::IsLegal(level)))
-        LLBC_XDelete(_hookDelegs[level]);
-}
-
-int LLBC_Logger::Debug(const char *tag, const char *file, int line, const char *fmt, ...)
-{
-    if (LLBC_LogLevel::Debug < _logLevel)
-        return LLBC_OK;
-
-    char *fmttedMsg; int msgLen;
-    LLBC_FormatArg(fmt, fmttedMsg, msgLen);
-
-    return DirectOutput(LLBC_LogLevel::Debug, tag, file, line, fmttedMsg, msgLen);
-}
-
-int LLBC_Logger::Info(const char *tag, const char *file, int line, const char *fmt, ...)
-{
-    if (LLBC_LogLevel::Info < _logLevel)
-        return LLBC_OK;
-
-    char *fmttedMsg; int msgLen;
-    LLBC_FormatArg(fmt, fmttedMsg, msgLen);
-
-    return DirectOutput(LLBC_LogLevel::Info, tag, file, line, fmttedMsg, msgLen);
-}
-
-int LLBC_Logger::Warn(const char *tag, const char *file, int line, const char *fmt, ...)
-{
-    if (LLBC_LogLevel::Warn < _logLevel)
-        return LLBC_OK;
-
-    char *fmttedMsg; int msgLen;
-    LLBC_FormatArg(fmt, fmttedMsg, msgLen);
-
-    return DirectOutput(LLBC_LogLevel::Warn, tag, file, line, fmttedMsg, msgLen);
-}
-
-int LLBC_Logger::Error(const char *tag, const char *file, int line, const char *fmt, ...)
-{
-    if (LLBC_LogLevel::Error < _logLevel)
-        return LLBC_OK;
-
-    char *fmttedMsg; int msgLen;
-    LLBC_FormatArg(fmt, fmttedMsg, msgLen);
-
-    return DirectOutput(LLBC_LogLevel::Error, tag, file, line, fmttedMsg, msgLen);
-}
-
-int LLBC_Logger::Fatal(const char *tag, const char *file, int line, const char *fmt, ...)
-{
-    if (LLBC_LogLevel::Fatal < _logLevel)
-        return LLBC_OK;
-
-    char *fmttedMsg; int msgLen;
-    LLBC_FormatArg(fmt, fmttedMsg, msgLen);
-
-    return DirectOutput(LLBC_LogLevel::Fatal, tag, file, line, fmttedMsg, msgLen);
-}
-
-int LLBC_Logger::Output(int level, const char *tag, const char *file, int line, const char *fmt, ...) 
-{
-    if (level < _logLevel)
-        return LLBC_OK;
-
-    char *fmttedMsg; int msgLen;
-    LLBC_FormatArg(fmt, fmttedMsg, msgLen);
-
-    return DirectOutput(level, tag, file, line, fmttedMsg, msgLen);
-}
-
-int LLBC_Logger::OutputNonFormat(int level, const char *tag, const char *file, int line, const char *message, size_t messageLen)
-{
-    if (level < _logLevel)
-        return LLBC_OK;
-
-    if (UNLIKELY(message == NULL))
-        return DirectOutput(level, tag, file, line, NULL, 0);
-
-    char *copyMessage = LLBC_Malloc(char, messageLen + 1);
-    LLBC_MemCpy(copyMessage, message, messageLen);
-    copyMessage[messageLen] = '\0';
-
-    return DirectOutput(level, tag, file, line, copyMessage, static_cast<int>(messageLen));
-}
-
-int LLBC_Logger::DirectOutput(int level, const char *tag, const char *file, int line, char *message, int len) 
-{
-    LLBC_LogData *data = BuildLogData(level, tag, file, line, message, len);
-    if (_hookDelegs[level])
-        _hookDelegs[level]->Invoke(data);
-
-    if (!_config->IsAsyncMode())
-    {
-        const int ret = _logRunnable->Output(data);
-        LLBC_Recycle(data);
-
-        return ret;
-    }
-
-    LLBC_MessageBlock *block = _msgBlockPoolInst.GetObject();
-    block->Write(&data, sizeof(LLBC_LogData *));
-
-    _logRunnable->Push(block);
-
-    return LLBC_OK;
-}
-
-LLBC_LogData *LLBC_Logger::BuildLogData(int level,
-                                        const char *tag,
-                                        const char *file,
-                                        int line,
-                                        char *message,
-                                        int len)
-{
-    LLBC_LogData *data = _logDataPoolInst.GetObject();
-    
-    data->level = level;
-    data->loggerName = _name.c_str();
-
-    data->tagLen = tag ? LLBC_StrLenA(tag) : 0;
-
-    if (file)
-    {
-        data->fileLen = LLBC_StrLenA(file);
-        if (!_config->IsLogCodeFilePath())
-        {
-#if LLBC_TARGET_PLATFORM_WIN32
-            const char *ps = strrchr(file, '\\');
-#else // Non-Win32
-            const char *ps = strrchr(file, '/');
-#endif // Win32
-            if (ps != NULL)
-            {
-                data->fileLen -= (static_cast<uint32>(ps - file) + 1);
-                file = ps + 1;
-            }
-#if LLBC_TARGET_PLATFORM_WIN32 // In Win32 platform, search '/' again
-            else
-            {
-                if ((ps = strrchr(file, '/')) != NULL)
-                {
-                    data->fileLen -= (static_cast<uint32>(ps - file) + 1);
-                    file = ps + 1;
-                }
-            }
-#endif // Win32
-        }
-    }
-
-    data->fileBeg = data->tagLen;
-
-    const uint32 othersSize = data->tagLen + data->fileLen;
-    if (othersSize != 0)
-    {
-        if (data->othersSize < othersSize)
-        {
-            data->othersSize = othersSize;
-            data->others = LLBC_Realloc(char, data->others, othersSize);
-        }
-
-        if (tag)
-            ::memcpy(data->others + data->tagBeg, tag, data->tagLen);
-        if (file)
-            ::memcpy(data->others + data->fileBeg, file, data->fileLen);
-    }
-
-    data->logTime = LLBC_GetMilliSeconds();
-
-    data->line = line;
-
-    data->msg = message;
-    data->msgLen = len;
-
-    __LLBC_LibTls *tls = __LLBC_GetLibTls();
-    data->threadId = tls->coreTls.threadId;
-
-    return data;
-}
-
-__LLBC_NS_END
-
-#if LLBC_TARGET_PLATFORM_WIN32
-#pragma warning(default:4996)
-#endif
-
-#include "llbc/common/AfterIncl.h"
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/core/utils/Util_Text.h"
+
+#include "llbc/core/os/OS_Time.h"
+#include "llbc/core/os/OS_Atomic.h"
+#include "llbc/core/os/OS_Thread.h"
+
+#include "llbc/core/thread/Guard.h"
+#include "llbc/core/thread/MessageBlock.h"
+
+#include "llbc/core/log/LogLevel.h"
+#include "llbc/core/log/LogData.h"
+#include "llbc/core/log/LogRing.h"
+#include "llbc/core/log/LoggerConfigInfo.h"
+#include "llbc/core/log/ILogAppender.h"
+#include "llbc/core/log/LogAppenderBuilder.h"
+#include "llbc/core/log/LogNetworkAppender.h"
+#include "llbc/core/log/LogRateLimiter.h"
+#include "llbc/core/log/LogRunnable.h"
+#include "llbc/core/log/Logger.h"
+#include "llbc/core/log/Log.h"
+
+#if LLBC_TARGET_PLATFORM_WIN32
+#pragma warning(disable:4996)
+#endif
+
+__LLBC_INTERNAL_NS_BEGIN
+
+static const LLBC_NS LLBC_String __g_invalidLoggerName;
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+LLBC_Logger::LLBC_Logger()
+: _lock()
+, _name()
+, _logLevel(LLBC_LogLevel::Debug)
+, _config(NULL)
+, _logRunnable(NULL)
+, _sharedLogRunnable(NULL)
+, _droppedLogCount(0)
+, _networkAppender(NULL)
+, _rateLimiter(NULL)
+, _msgBlockPoolInst(*_objPool.GetPoolInst<LLBC_MessageBlock>())
+, _logDataPoolInst(*_objPool.GetPoolInst<LLBC_LogData>())
+{
+    LLBC_MemSet(_hookDelegs, 0, sizeof(_hookDelegs));
+}
+
+LLBC_Logger::~LLBC_Logger()
+{
+    Finalize();
+}
+
+int LLBC_Logger::Initialize(const LLBC_String &name,
+                            const LLBC_LoggerConfigInfo *config,
+                            LLBC_LogRunnable *sharedLogRunnable)
+{
+    if (name.empty() || !config)
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+    else if (IsInit())
+    {
+        LLBC_SetLastError(LLBC_ERROR_REENTRY);
+        return LLBC_FAILED;
+    }
+
+    LLBC_LockGuard guard(_lock);
+    _name.append(name);
+
+    _config = config;
+
+    _logLevel = MIN(_config->GetConsoleLogLevel(), _config->GetFileLogLevel());
+    if (_config->IsLogToNetwork())
+        _logLevel = MIN(_logLevel, _config->GetNetworkLogLevel());
+
+    _logRunnable = LLBC_New0(LLBC_LogRunnable);
+    _logRunnable->SetFlushInterval(_config->GetFlushInterval());
+    _logRunnable->SetRingBufferSize(_config->GetRingBufferSize());
+
+    if (_config->IsRateLimitEnabled())
+    {
+        _rateLimiter = LLBC_New(LLBC_LogRateLimiter);
+        _rateLimiter->Initialize(*_config);
+
+        // Asynchronous logger's suppressed log messages reported by log thread.
+        if (_config->IsAsyncMode())
+            _logRunnable->SetSuppressedReporter(this);
+    }
+
+    if (_config->IsLogToConsole())
+    {
+        LLBC_LogAppenderInitInfo appenderInitInfo;
+        appenderInitInfo.level = _config->GetConsoleLogLevel();
+        appenderInitInfo.pattern = _config->GetConsolePattern();
+        appenderInitInfo.colourfulOutput = _config->IsColourfulOutput();
+
+        LLBC_ILogAppender *appender = 
+            LLBC_LogAppenderBuilderSingleton->BuildAppender(LLBC_LogAppenderType::Console);
+        if (appender->Initialize(appenderInitInfo) != LLBC_OK)
+        {
+            LLBC_XDelete(appender);
+            return LLBC_FAILED;
+        }
+
+        _logRunnable->AddAppender(appender);
+    }
+
+    if (_config->IsLogToFile())
+    {
+        LLBC_LogAppenderInitInfo appenderInitInfo;
+        appenderInitInfo.level = _config->GetFileLogLevel();
+        appenderInitInfo.pattern = _config->GetFilePattern();
+        appenderInitInfo.file = _config->GetLogFile();
+        appenderInitInfo.fileSuffix = _config->GetLogFileSuffix();
+        appenderInitInfo.forceAppLogPath = _config->IsForceAppLogPath();
+        appenderInitInfo.dailyRolling = _config->IsDailyRollingMode();
+        appenderInitInfo.maxFileSize = _config->GetMaxFileSize();
+        appenderInitInfo.maxBackupIndex = _config->GetMaxBackupIndex();
+        appenderInitInfo.lazyCreateLogFile = _config->IsLazyCreateLogFile();
+        appenderInitInfo.fileChunkSize = _config->GetFileChunkSize();
+        appenderInitInfo.gzipBackupFile = _config->IsGzipBackupFile();
+        appenderInitInfo.fileMmapWindowSize = _config->GetFileMmapWindowSize();
+
+        if (!_config->IsAsyncMode())
+            appenderInitInfo.fileBufferSize = 0;
+        else
+            appenderInitInfo.fileBufferSize = _config->GetFileBufferSize();
+
+        // If mmap window size configured, use memory-mapped file appender.
+        const int appenderType = appenderInitInfo.fileMmapWindowSize > 0 ?
+            LLBC_LogAppenderType::MmapFile : LLBC_LogAppenderType::File;
+        LLBC_ILogAppender *appender =
+            LLBC_LogAppenderBuilderSingleton->BuildAppender(appenderType);
+        int initRet = appender->Initialize(appenderInitInfo);
+
+        // Memory-mapped file not supported(platform or file system), fallback to file appender.
+        if (initRet != LLBC_OK &&
+            appenderType == LLBC_LogAppenderType::MmapFile &&
+            LLBC_GetLastError() == LLBC_ERROR_NOT_IMPL)
+        {
+            LLBC_XDelete(appender);
+
+            appenderInitInfo.fileMmapWindowSize = 0;
+            appender = LLBC_LogAppenderBuilderSingleton->BuildAppender(LLBC_LogAppenderType::File);
+            initRet = appender->Initialize(appenderInitInfo);
+        }
+
+        if (initRet != LLBC_OK)
+        {
+            LLBC_XDelete(appender);
+            return LLBC_FAILED;
+        }
+
+        _logRunnable->AddAppender(appender);
+    }
+
+    if (_config->IsLogToNetwork())
+    {
+        LLBC_LogAppenderInitInfo appenderInitInfo;
+        appenderInitInfo.level = _config->GetNetworkLogLevel();
+        appenderInitInfo.pattern = _config->GetNetworkPattern();
+        appenderInitInfo.ip = _config->GetNetworkIp();
+        appenderInitInfo.port = _config->GetNetworkPort();
+        appenderInitInfo.networkProtocol = _config->GetNetworkProtocol();
+        appenderInitInfo.networkBufferSize = _config->GetNetworkBufferSize();
+        appenderInitInfo.networkBatchSize = _config->GetNetworkBatchSize();
+        appenderInitInfo.reconnectInterval = _config->GetNetworkReconnectInterval();
+        appenderInitInfo.maxReconnectInterval = _config->GetNetworkMaxReconnectInterval();
+
+        LLBC_ILogAppender *appender =
+            LLBC_LogAppenderBuilderSingleton->BuildAppender(LLBC_LogAppenderType::Network);
+        if (appender->Initialize(appenderInitInfo) != LLBC_OK)
+        {
+            LLBC_XDelete(appender);
+            return LLBC_FAILED;
+        }
+
+        _logRunnable->AddAppender(appender);
+        _networkAppender = static_cast<LLBC_LogNetworkAppender *>(appender);
+    }
+
+    if (_config->IsAsyncMode())
+    {
+        // If using shared log runnable, register to shared log runnable, otherwise activate self log thread.
+        if (sharedLogRunnable)
+        {
+            _sharedLogRunnable = sharedLogRunnable;
+            _sharedLogRunnable->AddServedRunnable(_logRunnable);
+        }
+        else
+        {
+            _logRunnable->Activate(1);
+        }
+    }
+
+    return LLBC_OK;
+}
+
+bool LLBC_Logger::IsInit() const
+{
+    LLBC_Logger *ncThis = const_cast<LLBC_Logger *>(this);
+    LLBC_LockGuard guard(ncThis->_lock);
+
+    return (_logRunnable ? true : false);
+}
+
+void LLBC_Logger::Finalize()
+{
+    LLBC_LockGuard guard(_lock);
+    if (!_logRunnable)
+        return;
+
+    for (int level = LLBC_LogLevel::Begin; level != LLBC_LogLevel::End; ++level)
+        UninstallHook(level);
+
+    // Shared log runnable must be stopped before logger finalize(see LLBC_LoggerManager::Finalize()),
+    // so in shared mode, the logger runnable just need cleanup.
+    if (_config->IsAsyncMode() && !_sharedLogRunnable)
+    {
+        _logRunnable->Stop();
+        _logRunnable->Wait();
+    }
+    else
+    {
+        _logRunnable->Cleanup();
+    }
+
+    LLBC_XDelete(_logRunnable);
+    _sharedLogRunnable = NULL;
+    _networkAppender = NULL;
+    LLBC_XDelete(_rateLimiter);
+
+    _name.clear();
+    _config = NULL;
+}
+
+const LLBC_String &LLBC_Logger::GetLoggerName() const
+{
+    LLBC_Logger *nonConstThis = const_cast<LLBC_Logger *>(this);
+    LLBC_LockGuard guard(nonConstThis->_lock);
+    if (!_logRunnable)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return LLBC_INTERNAL_NS __g_invalidLoggerName;
+    }
+
+    LLBC_SetLastError(LLBC_ERROR_SUCCESS);
+    return _name;
+}
+
+void LLBC_Logger::SetLogLevel(int level)
+{
+    level = MIN(MAX(LLBC_LogLevel::Begin, level), LLBC_LogLevel::End - 1);
+    LLBC_AtomicSet(&_logLevel, level);
+
+    // Let Log helper's fast level filter pass the new level.
+    LLBC_LogHelper::LowerMinLogLevel(level);
+}
+
+bool LLBC_Logger::IsTakeOver() const
+{
+    LLBC_Logger *ncThis = const_cast<LLBC_Logger *>(this);
+    LLBC_LockGuard guard(ncThis->_lock);
+
+    return _config->IsTakeOver();
+}
+
+sint64 LLBC_Logger::GetDroppedLogCount() const
+{
+    LLBC_Logger *ncThis = const_cast<LLBC_Logger *>(this);
+    return LLBC_AtomicGet(&ncThis->_droppedLogCount);
+}
+
+sint64 LLBC_Logger::GetNetworkSentLogCount() const
+{
+    LLBC_Logger *ncThis = const_cast<LLBC_Logger *>(this);
+    LLBC_LockGuard guard(ncThis->_lock);
+
+    return _networkAppender ? _networkAppender->GetSentLogCount() : 0;
+}
+
+sint64 LLBC_Logger::GetNetworkDroppedLogCount() const
+{
+    LLBC_Logger *ncThis = const_cast<LLBC_Logger *>(this);
+    LLBC_LockGuard guard(ncThis->_lock);
+
+    return _networkAppender ? _networkAppender->GetDroppedLogCount() : 0;
+}
+
+sint64 LLBC_Logger::GetSuppressedLogCount() const
+{
+    LLBC_Logger *ncThis = const_cast<LLBC_Logger *>(this);
+    LLBC_LockGuard guard(ncThis->_lock);
+
+    return _rateLimiter ? _rateLimiter->GetSuppressedCount() : 0;
+}
+
+int LLBC_Logger::InstallHook(int level, LLBC_IDelegate1<void, const LLBC_LogData *> *hookDeleg)
+{
+    if (UNLIKELY(!LLBC_LogLevel::IsLegal(level) ||
+        !hookDeleg))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    LLBC_LockGuard guard(_lock);
+
+    UninstallHook(level);
+    _hookDelegs[level] = hookDeleg;
+
+    return LLBC_OK;
+}
+
+void LLBC_Logger::UninstallHook(int level)
+{
+    LLBC_LockGuard guard(_lock);
+
+    if (LIKELY(LLBC_LogLevel::IsLegal(level)))
+        LLBC_XDelete(_hookDelegs[level]);
+}
+
+int LLBC_Logger::Debug(const char *tag, const char *file, int line, const char *fmt, ...)
+{
+    if (LLBC_LogLevel::Debug < _logLevel)
+        return LLBC_OK;
+    if (_rateLimiter && IsSuppressed(tag))
+        return LLBC_OK;
+
+    char *fmttedMsg; int msgLen;
+    LLBC_FormatArg(fmt, fmttedMsg, msgLen);
+
+    return DirectOutput(LLBC_LogLevel::Debug, tag, file, line, fmttedMsg, msgLen);
+}
+
+int LLBC_Logger::Info(const char *tag, const char *file, int line, const char *fmt, ...)
+{
+    if (LLBC_LogLevel::Info < _logLevel)
+        return LLBC_OK;
+    if (_rateLimiter && IsSuppressed(tag))
+        return LLBC_OK;
+
+    char *fmttedMsg; int msgLen;
+    LLBC_FormatArg(fmt, fmttedMsg, msgLen);
+
+    return DirectOutput(LLBC_LogLevel::Info, tag, file, line, fmttedMsg, msgLen);
+}
+
+int LLBC_Logger::Warn(const char *tag, const char *file, int line, const char *fmt, ...)
+{
+    if (LLBC_LogLevel::Warn < _logLevel)
+        return LLBC_OK;
+    if (_rateLimiter && IsSuppressed(tag))
+        return LLBC_OK;
+
+    char *fmttedMsg; int msgLen;
+    LLBC_FormatArg(fmt, fmttedMsg, msgLen);
+
+    return DirectOutput(LLBC_LogLevel::Warn, tag, file, line, fmttedMsg, msgLen);
+}
+
+int LLBC_Logger::Error(const char *tag, const char *file, int line, const char *fmt, ...)
+{
+    if (LLBC_LogLevel::Error < _logLevel)
+        return LLBC_OK;
+    if (_rateLimiter && IsSuppressed(tag))
+        return LLBC_OK;
+
+    char *fmttedMsg; int msgLen;
+    LLBC_FormatArg(fmt, fmttedMsg, msgLen);
+
+    return DirectOutput(LLBC_LogLevel::Error, tag, file, line, fmttedMsg, msgLen);
+}
+
+int LLBC_Logger::Fatal(const char *tag, const char *file, int line, const char *fmt, ...)
+{
+    if (LLBC_LogLevel::Fatal < _logLevel)
+        return LLBC_OK;
+    if (_rateLimiter && IsSuppressed(tag))
+        return LLBC_OK;
+
+    char *fmttedMsg; int msgLen;
+    LLBC_FormatArg(fmt, fmttedMsg, msgLen);
+
+    return DirectOutput(LLBC_LogLevel::Fatal, tag, file, line, fmttedMsg, msgLen);
+}
+
+int LLBC_Logger::Output(int level, const char *tag, const char *file, int line, const char *fmt, ...) 
+{
+    if (level < _logLevel)
+        return LLBC_OK;
+    if (_rateLimiter && IsSuppressed(tag))
+        return LLBC_OK;
+
+    char *fmttedMsg; int msgLen;
+    LLBC_FormatArg(fmt, fmttedMsg, msgLen);
+
+    return DirectOutput(level, tag, file, line, fmttedMsg, msgLen);
+}
+
+int LLBC_Logger::OutputNonFormat(int level, const char *tag, const char *file, int line, const char *message, size_t messageLen)
+{
+    if (level < _logLevel)
+        return LLBC_OK;
+    if (_rateLimiter && IsSuppressed(tag))
+        return LLBC_OK;
+
+    if (UNLIKELY(message == NULL))
+        return DirectOutput(level, tag, file, line, NULL, 0);
+
+    char *copyMessage = LLBC_TagMalloc(LLBC_MemoryTag::Log, char, messageLen + 1);
+    LLBC_MemCpy(copyMessage, message, messageLen);
+    copyMessage[messageLen] = '\0';
+
+    return DirectOutput(level, tag, file, line, copyMessage, static_cast<int>(messageLen));
+}
+
+int LLBC_Logger::BinOutput(int level,
+                           const char *tag,
+                           const char *file,
+                           int line,
+                           const char *fmt,
+                           const LLBC_LogArg *args,
+                           int argCount)
+{
+    if (level < _logLevel)
+        return LLBC_OK;
+    if (_rateLimiter && IsSuppressed(tag))
+        return LLBC_OK;
+
+    return DirectOutput(level, tag, file, line, NULL, 0, fmt, args, argCount);
+}
+
+bool LLBC_Logger::IsSuppressed(const char *tag)
+{
+    if (LIKELY(_rateLimiter->Allow(tag)))
+        return false;
+
+    // Asynchronous logger's suppressed report output by log thread's flush tick,
+    // synchronous logger has no log thread, only check report in suppressed path.
+    if (!_config->IsAsyncMode())
+        ReportSuppressed();
+
+    return true;
+}
+
+void LLBC_Logger::ReportSuppressed()
+{
+    LLBC_String report;
+    if (!_rateLimiter->BuildReport(report))
+        return;
+
+    const int level = MAX(static_cast<int>(LLBC_LogLevel::Warn), _logLevel);
+    char *message = LLBC_TagMalloc(LLBC_MemoryTag::Log, char, report.size() + 1);
+    LLBC_MemCpy(message, report.c_str(), report.size() + 1);
+
+    // Direct output to appenders(in log thread or synchronous logger's calling thread), bypass log ring and queue.
+    LLBC_LogData *data = BuildLogData(level, NULL, __FILE__, __LINE__, message, static_cast<int>(report.size()));
+    if (_hookDelegs[level])
+        _hookDelegs[level]->Invoke(data);
+
+    _logRunnable->Output(data);
+    LLBC_Recycle(data);
+}
+
+int LLBC_Logger::DirectOutput(int level,
+                              const char *tag,
+                              const char *file,
+                              int line,
+                              char *message,
+                              int len,
+                              const char *binFmt,
+                              const LLBC_LogArg *binArgs,
+                              int binArgCount)
+{
+    // If enabled log ring, output to producer thread's log ring.
+    LLBC_LogRunnable *consumer = _sharedLogRunnable ? _sharedLogRunnable : _logRunnable;
+    if (_config->GetRingBufferSize() > 0)
+    {
+        LLBC_LogRing *ring = consumer->GetThreadRing();
+        if (LIKELY(ring))
+            return RingOutput(consumer, ring, level, tag, file, line, message, len, binFmt, binArgs, binArgCount);
+    }
+
+    // Build log data, if is binary log, hook will see the formatted log data.
+    LLBC_LogData *data = BuildLogData(level, tag, file, line, message, len);
+    if (binFmt)
+        LLBC_LogArg::Serialize(binFmt, binArgs, binArgCount, *data);
+    if (_hookDelegs[level])
+    {
+        LLBC_LogArg::Format(*data);
+        _hookDelegs[level]->Invoke(data);
+    }
+
+    if (!_config->IsAsyncMode())
+    {
+        const int ret = _logRunnable->Output(data);
+        LLBC_Recycle(data);
+
+        return ret;
+    }
+
+    LLBC_MessageBlock *block = _msgBlockPoolInst.GetObject();
+    consumer->PushLogData(_logRunnable, data, block);
+
+    return LLBC_OK;
+}
+
+int LLBC_Logger::RingOutput(LLBC_LogRunnable *consumer,
+                            LLBC_LogRing *ring,
+                            int level,
+                            const char *tag,
+                            const char *file,
+                            int line,
+                            char *message,
+                            int len,
+                            const char *binFmt,
+                            const LLBC_LogArg *binArgs,
+                            int binArgCount)
+{
+    LLBC_LogRing::Slot *slot = ring->BeginWrite();
+    if (UNLIKELY(!slot))
+    {
+        const int overflowPolicy = _config->GetRingOverflowPolicy();
+        if (overflowPolicy == LLBC_LogRingOverflowPolicy::Drop)
+        {
+            LLBC_AtomicFetchAndAdd(&_droppedLogCount, 1);
+            LLBC_XFree(message);
+
+            return LLBC_OK;
+        }
+        else if (overflowPolicy == LLBC_LogRingOverflowPolicy::Sync)
+        {
+            LLBC_LogData *data = BuildLogData(level, tag, file, line, message, len);
+            if (binFmt)
+                LLBC_LogArg::Serialize(binFmt, binArgs, binArgCount, *data);
+            if (_hookDelegs[level])
+            {
+                LLBC_LogArg::Format(*data);
+                _hookDelegs[level]->Invoke(data);
+            }
+
+            const int ret = consumer->SyncOutput(ring, _logRunnable, data);
+            LLBC_Recycle(data);
+
+            return ret;
+        }
+
+        // Block policy, wait log thread drain ring, yield first, then backoff sleep(max to ring drain interval).
+        int sleepTime = 0;
+        while (!(slot = ring->BeginWrite()))
+        {
+            LLBC_Sleep(sleepTime);
+            sleepTime = MIN(sleepTime + 1, LLBC_CFG_LOG_RING_DRAIN_INTERVAL);
+        }
+    }
+
+    slot->owner = _logRunnable;
+    FillLogData(&slot->data, level, tag, file, line, message, len);
+    if (binFmt)
+        LLBC_LogArg::Serialize(binFmt, binArgs, binArgCount, slot->data);
+    if (_hookDelegs[level])
+    {
+        LLBC_LogArg::Format(slot->data);
+        _hookDelegs[level]->Invoke(&slot->data);
+    }
+
+    ring->EndWrite();
+
+    return LLBC_OK;
+}
+
+LLBC_LogData *LLBC_Logger::BuildLogData(int level,
+                                        const char *tag,
+                                        const char *file,
+                                        int line,
+                                        char *message,
+                                        int len)
+{
+    LLBC_LogData *data = _logDataPoolInst.GetObject();
+    FillLogData(data, level, tag, file, line, message, len);
+
+    return data;
+}
+
+void LLBC_Logger::FillLogData(LLBC_LogData *data,
+                              int level,
+                              const char *tag,
+                              const char *file,
+                              int line,
+                              char *message,
+                              int len)
+{
+    data->level = level;
+    data->loggerName = _name.c_str();
+
+    data->tagLen = tag ? LLBC_StrLenA(tag) : 0;
+
+    if (file)
+    {
+        data->fileLen = LLBC_StrLenA(file);
+        if (!_config->IsLogCodeFilePath())
+        {
+#if LLBC_TARGET_PLATFORM_WIN32
+            const char *ps = strrchr(file, '\\');
+#else // Non-Win32
+            const char *ps = strrchr(file, '/');
+#endif // Win32
+            if (ps != NULL)
+            {
+                data->fileLen -= (static_cast<uint32>(ps - file) + 1);
+                file = ps + 1;
+            }
+#if LLBC_TARGET_PLATFORM_WIN32 // In Win32 platform, search '/' again
+            else
+            {
+                if ((ps = strrchr(file, '/')) != NULL)
+                {
+                    data->fileLen -= (static_cast<uint32>(ps - file) + 1);
+                    file = ps + 1;
+                }
+            }
+#endif // Win32
+        }
+    }
+
+    data->fileBeg = data->tagLen;
+
+    const uint32 othersSize = data->tagLen + data->fileLen;
+    if (othersSize != 0)
+    {
+        if (data->othersSize < othersSize)
+        {
+            data->othersSize = othersSize;
+            data->others = LLBC_TagRealloc(LLBC_MemoryTag::Log, char, data->others, othersSize);
+        }
+
+        if (tag)
+            ::memcpy(data->others + data->tagBeg, tag, data->tagLen);
+        if (file)
+            ::memcpy(data->others + data->fileBeg, file, data->fileLen);
+    }
+
+    data->logTime = LLBC_GetMilliSeconds();
+
+    data->line = line;
+
+    data->msg = message;
+    data->msgLen = len;
+
+    __LLBC_LibTls *tls = __LLBC_GetLibTls();
+    data->threadId = tls->coreTls.threadId;
+}
+
+__LLBC_NS_END
+
+#if LLBC_TARGET_PLATFORM_WIN32
+#pragma warning(default:4996)
+#endif
+
+#include "llbc/common/AfterIncl.h"
@@ -28,6 +28,8 @@
 #include "llbc/core/config/Property.h"
 
 #include "llbc/core/log/LogLevel.h"
+#include "llbc/core/log/LogRing.h"
+#include "llbc/core/log/LogNetworkAppender.h"
 #include "llbc/core/log/LoggerConfigInfo.h"
 
 __LLBC_NS_BEGIN
@@ -53,9 +55,36 @@ LLBC_LoggerConfigInfo::LLBC_LoggerConfigInfo()
 , _maxFileSize(INT_MAX)
 , _maxBackupIndex(0)
 , _fileBufferSize(0)
+, _fileChunkSize(0)
+, _gzipBackupFile(false)
+, _fileMmapWindowSize(0)
 
 , _takeOver(false)
 , _lazyCreateLogFile(false)
+, _sharedLogThreadCount(0)
+
+, _ringBufferSize(0)
+, _ringOverflowPolicy(LLBC_LogRingOverflowPolicy::Block)
+
+, _deferJsonFormat(false)
+
+, _logToNetwork(false)
+, _networkLogLevel(LLBC_LogLevel::End)
+, _networkPattern()
+, _networkIp()
+, _networkPort(0)
+, _networkProtocol(LLBC_LogNetworkProtocol::Udp)
+, _networkBufferSize(0)
+, _networkBatchSize(0)
+, _networkReconnectInterval(0)
+, _networkMaxReconnectInterval(0)
+
+, _rateLimit(0)
+, _rateLimitBurst(0)
+, _tagRateLimit(0)
+, _tagRateLimits()
+, _sampleRate(1.0)
+, _suppressedReportInterval(0)
 {
 }
 
@@ -91,6 +120,8 @@ int LLBC_LoggerConfigInfo::Initialize(const LLBC_Property &cfg)
 
     // Misc configs.
     _takeOver = (cfg.HasProperty("takeOver") ? cfg.GetValue("takeOver").AsBool() : LLBC_CFG_LOG_ROOT_LOGGER_TAKE_OVER_UNCONFIGED);
+    _sharedLogThreadCount = (cfg.HasProperty("sharedLogThreadCount") ?
+            cfg.GetValue("sharedLogThreadCount").AsInt32() : LLBC_CFG_LOG_DEFAULT_SHARED_LOG_THREAD_COUNT);
 
     if (_asyncMode)
         _fileBufferSize = (cfg.HasProperty("fileBufferSize") ? 
@@ -98,6 +129,77 @@ int LLBC_LoggerConfigInfo::Initialize(const LLBC_Property &cfg)
     else
         _fileBufferSize = 0;
 
+    // File chunk configs(only available in asynchronous mode).
+    if (_asyncMode)
+        _fileChunkSize = (cfg.HasProperty("fileChunkSize") ?
+                cfg.GetValue("fileChunkSize").AsInt32() : LLBC_CFG_LOG_DEFAULT_LOG_FILE_CHUNK_SIZE);
+    else
+        _fileChunkSize = 0;
+    _gzipBackupFile = (cfg.HasProperty("gzipBackupFile") ?
+            cfg.GetValue("gzipBackupFile").AsBool() : LLBC_CFG_LOG_DEFAULT_GZIP_BACKUP_FILE);
+
+    // File mmap configs.
+    _fileMmapWindowSize = (cfg.HasProperty("fileMmapWindowSize") ?
+            cfg.GetValue("fileMmapWindowSize").AsInt32() : LLBC_CFG_LOG_DEFAULT_FILE_MMAP_WINDOW_SIZE);
+
+    // Log ring configs(only available in asynchronous mode).
+    if (_asyncMode)
+        _ringBufferSize = (cfg.HasProperty("ringBufferSize") ?
+                cfg.GetValue("ringBufferSize").AsInt32() : LLBC_CFG_LOG_DEFAULT_RING_BUFFER_SIZE);
+    else
+        _ringBufferSize = 0;
+    _ringOverflowPolicy = LLBC_LogRingOverflowPolicy::Str2Policy(cfg.HasProperty("ringOverflowPolicy") ?
+            cfg.GetValue("ringOverflowPolicy").AsStr().c_str() : LLBC_CFG_LOG_DEFAULT_RING_OVERFLOW_POLICY);
+
+    // Json log configs(only available in asynchronous mode).
+    if (_asyncMode)
+        _deferJsonFormat = (cfg.HasProperty("deferJsonFormat") ?
+                cfg.GetValue("deferJsonFormat").AsBool() : LLBC_CFG_LOG_DEFAULT_DEFER_JSON_FORMAT);
+    else
+        _deferJsonFormat = false;
+
+    // Network log configs.
+    _logToNetwork = (cfg.HasProperty("logToNetwork") ? cfg.GetValue("logToNetwork").AsBool() : LLBC_CFG_LOG_DEFAULT_LOG_TO_NETWORK);
+    _networkLogLevel = (cfg.HasProperty("networkLogLevel") ? LLBC_LogLevel::Str2Level(cfg.GetValue("networkLogLevel").AsStr().c_str()) : _logLevel);
+    _networkPattern = (cfg.HasProperty("networkPattern") ? cfg.GetValue("networkPattern").AsStr() : LLBC_CFG_LOG_DEFAULT_NETWORK_LOG_PATTERN);
+    _networkIp = (cfg.HasProperty("networkIp") ? cfg.GetValue("networkIp").AsStr() : LLBC_CFG_LOG_DEFAULT_NETWORK_IP);
+    const int networkPort = (cfg.HasProperty("networkPort") ? cfg.GetValue("networkPort").AsInt32() : 0);
+    _networkProtocol = LLBC_LogNetworkProtocol::Str2Protocol(cfg.HasProperty("networkProtocol") ?
+            cfg.GetValue("networkProtocol").AsStr().c_str() : LLBC_CFG_LOG_DEFAULT_NETWORK_PROTOCOL);
+    _networkBufferSize = (cfg.HasProperty("networkBufferSize") ?
+            cfg.GetValue("networkBufferSize").AsInt32() : LLBC_CFG_LOG_DEFAULT_NETWORK_BUFFER_SIZE);
+    _networkBatchSize = (cfg.HasProperty("networkBatchSize") ?
+            cfg.GetValue("networkBatchSize").AsInt32() : LLBC_CFG_LOG_DEFAULT_NETWORK_BATCH_SIZE);
+    _networkReconnectInterval = (cfg.HasProperty("networkReconnectInterval") ?
+            cfg.GetValue("networkReconnectInterval").AsInt32() : LLBC_CFG_LOG_DEFAULT_NETWORK_RECONNECT_INTERVAL);
+    _networkMaxReconnectInterval = (cfg.HasProperty("networkMaxReconnectInterval") ?
+            cfg.GetValue("networkMaxReconnectInterval").AsInt32() : LLBC_CFG_LOG_DEFAULT_NETWORK_MAX_RECONNECT_INTERVAL);
+
+    // Rate limit & sampling configs.
+    _rateLimit = (cfg.HasProperty("rateLimit") ? cfg.GetValue("rateLimit").AsInt32() : LLBC_CFG_LOG_DEFAULT_RATE_LIMIT);
+    _rateLimitBurst = (cfg.HasProperty("rateLimitBurst") ? cfg.GetValue("rateLimitBurst").AsInt32() : 0);
+    _tagRateLimit = (cfg.HasProperty("tagRateLimit") ? cfg.GetValue("tagRateLimit").AsInt32() : LLBC_CFG_LOG_DEFAULT_TAG_RATE_LIMIT);
+    _sampleRate = (cfg.HasProperty("sampleRate") ? cfg.GetValue("sampleRate").AsDouble() : LLBC_CFG_LOG_DEFAULT_SAMPLE_RATE);
+    _suppressedReportInterval = (cfg.HasProperty("suppressedReportInterval") ?
+            cfg.GetValue("suppressedReportInterval").AsInt32() : LLBC_CFG_LOG_DEFAULT_SUPPRESSED_REPORT_INTERVAL);
+
+    // Specific tags rate limits, format: tag1:rateLimit1,tag2:rateLimit2,...
+    _tagRateLimits.clear();
+    if (cfg.HasProperty("tagRateLimits"))
+    {
+        const std::vector<LLBC_String> tagRateLimits = cfg.GetValue("tagRateLimits").AsStr().split(',', -1, true);
+        for (size_t i = 0; i < tagRateLimits.size(); ++i)
+        {
+            const std::vector<LLBC_String> tagRateLimit = tagRateLimits[i].split(':', 1);
+            if (tagRateLimit.size() != 2)
+                continue;
+
+            const LLBC_String tag = tagRateLimit[0].strip();
+            if (!tag.empty())
+                _tagRateLimits[tag] = MAX(0, LLBC_Str2Int32(tagRateLimit[1].strip().c_str()));
+        }
+    }
+
     // Check configs.
     if (!LLBC_LogLevel::IsLegal(_logLevel))
         _logLevel = LLBC_CFG_LOG_DEFAULT_LEVEL;
@@ -105,10 +207,30 @@ int LLBC_LoggerConfigInfo::Initialize(const LLBC_Property &cfg)
         _consoleLogLevel = _logLevel;
     if (!LLBC_LogLevel::IsLegal(_fileLogLevel))
         _fileLogLevel = _logLevel;
+    if (!LLBC_LogLevel::IsLegal(_networkLogLevel))
+        _networkLogLevel = _logLevel;
 
     _maxFileSize = MAX(1, _maxFileSize);
     _maxBackupIndex = MAX(0, _maxBackupIndex);
     _flushInterval = MIN(MAX(0, _flushInterval), LLBC_CFG_LOG_MAX_LOG_FLUSH_INTERVAL);
+    _sharedLogThreadCount = MIN(MAX(0, _sharedLogThreadCount), LLBC_CFG_LOG_MAX_SHARED_LOG_THREAD_COUNT);
+    _fileChunkSize = MIN(MAX(0, _fileChunkSize), LLBC_CFG_LOG_MAX_LOG_FILE_CHUNK_SIZE);
+    _fileMmapWindowSize = MIN(MAX(0, _fileMmapWindowSize), LLBC_CFG_LOG_MAX_FILE_MMAP_WINDOW_SIZE);
+    _ringBufferSize = MAX(0, _ringBufferSize);
+    if (!LLBC_LogRingOverflowPolicy::IsLegal(_ringOverflowPolicy))
+        _ringOverflowPolicy = LLBC_LogRingOverflowPolicy::Block;
+    _networkPort = static_cast<uint16>(MIN(MAX(0, networkPort), USHRT_MAX));
+    if (!LLBC_LogNetworkProtocol::IsLegal(_networkProtocol))
+        _networkProtocol = LLBC_LogNetworkProtocol::Udp;
+    _networkBufferSize = MAX(0, _networkBufferSize);
+    _networkBatchSize = MAX(1, _networkBatchSize);
+    _networkReconnectInterval = MAX(1, _networkReconnectInterval);
+    _networkMaxReconnectInterval = MAX(_networkReconnectInterval, _networkMaxReconnectInterval);
+    _rateLimit = MAX(0, _rateLimit);
+    _rateLimitBurst = MAX(0, _rateLimitBurst);
+    _tagRateLimit = MAX(0, _tagRateLimit);
+    _sampleRate = MIN(MAX(0.0, _sampleRate), 1.0);
+    _suppressedReportInterval = MAX(1, _suppressedReportInterval);
 
     // Normallize log file name.
     NormalizeLogFileName();
@@ -70,7 +70,7 @@ int LLBC_LoggerConfigurator::Initialize(const LLBC_String &cfgFile)
     return LLBC_OK;
 }
 
-int LLBC_LoggerConfigurator::Config(const LLBC_String &name, LLBC_Logger *logger) const
+int LLBC_LoggerConfigurator::Config(const LLBC_String &name, LLBC_Logger *logger, LLBC_LogRunnable *sharedLogRunnable) const
 {
     if (name.empty() || !logger)
     {
@@ -99,7 +99,7 @@ int LLBC_LoggerConfigurator::Config(const LLBC_String &name, LLBC_Logger *logger
         iter = nonConstThis->_configs.insert(std::make_pair(name, info)).first;
     }
 
-    return logger->Initialize(name, iter->second);
+    return logger->Initialize(name, iter->second, sharedLogRunnable);
 }
 
 const std::map<LLBC_String, LLBC_LoggerConfigInfo *> &LLBC_LoggerConfigurator::GetAllConfigInfos() const
@@ -23,10 +23,13 @@
 #include "llbc/common/BeforeIncl.h"
 
 #include "llbc/core/helper/STLHelper.h"
+#include "llbc/core/utils/Util_Text.h"
 
 #include "llbc/core/thread/Guard.h"
 
 #include "llbc/core/log/Logger.h"
+#include "llbc/core/log/LogRunnable.h"
+#include "llbc/core/log/LoggerConfigInfo.h"
 #include "llbc/core/log/LoggerConfigurator.h"
 #include "llbc/core/log/LoggerManager.h"
 #include "llbc/core/log/Log.h"
@@ -39,7 +42,13 @@ LLBC_LoggerManager::LLBC_LoggerManager()
 : _lock()
 , _root(NULL)
 , _loggers()
+, _lookupTable(NULL)
+, _lookupTableMask(0)
+, _rootTakeOver(false)
 , _configurator(NULL)
+
+, _nextSharedLogRunnable(0)
+, _sharedLogRunnables()
 {
 }
 
@@ -65,11 +74,15 @@ int LLBC_LoggerManager::Initialize(const LLBC_String &cfgFile)
         return LLBC_FAILED;
     }
 
+    // Create shared log runnables, if configured.
+    CreateSharedLogRunnables();
+
     // First, config root logger.
     _root = LLBC_New0(LLBC_Logger);
-    if (_configurator->Config(_rootLoggerName, _root) != LLBC_OK)
+    if (_configurator->Config(_rootLoggerName, _root, AllocSharedLogRunnable(_rootLoggerName)) != LLBC_OK)
     {
         LLBC_XDelete(_root);
+        DestroySharedLogRunnables();
         LLBC_XDelete(_configurator);
 
         return LLBC_FAILED;
@@ -86,7 +99,7 @@ int LLBC_LoggerManager::Initialize(const LLBC_String &cfgFile)
             continue;
 
         LLBC_Logger *logger = LLBC_New0(LLBC_Logger);
-        if (_configurator->Config(iter->first, logger) != LLBC_OK)
+        if (_configurator->Config(iter->first, logger, AllocSharedLogRunnable(iter->first)) != LLBC_OK)
         {
             LLBC_Delete(logger);
             Finalize();
@@ -96,8 +109,12 @@ int LLBC_LoggerManager::Initialize(const LLBC_String &cfgFile)
         _loggers.insert(std::make_pair(iter->first, logger));
     }
 
-    // Init Log helper class.
-    LLBC_LogHelper::Initialize(this);
+    // Activate shared log runnables(all loggers served by shared log runnables are configured).
+    for (size_t i = 0; i < _sharedLogRunnables.size(); ++i)
+        _sharedLogRunnables[i]->Activate(1);
+
+    // Build logger lookup table and init Log helper class.
+    LLBC_LogHelper::Initialize(this, BuildLookupTable());
 
     return LLBC_OK;
 }
@@ -116,8 +133,12 @@ void LLBC_LoggerManager::Finalize()
     if (_root == NULL)
         return;
 
-    // Finalize Log helper class.
+    // Finalize Log helper class and destroy logger lookup table.
     LLBC_LogHelper::Finalize();
+    DestroyLookupTable();
+
+    // Stop shared log runnables first, all queued log data will output to loggers' appenders.
+    DestroySharedLogRunnables();
 
     // Delete all loggers and set _root logger to NULL.
     _root = NULL;
@@ -171,6 +192,141 @@ LLBC_Logger *LLBC_LoggerManager::GetLogger(const LLBC_String &name) const
     return iter->second;
 }
 
+LLBC_Logger *LLBC_LoggerManager::GetLogger(const char *name) const
+{
+    if (UNLIKELY(name == NULL || name[0] == '\0'))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return NULL;
+    }
+
+    const _LookupSlot *table = _lookupTable;
+    if (UNLIKELY(!table))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return NULL;
+    }
+
+    const int hash = LLBC_HashString(name);
+    for (size_t idx = static_cast<size_t>(hash) & _lookupTableMask;
+         table[idx].logger;
+         idx = (idx + 1) & _lookupTableMask)
+    {
+        const _LookupSlot &slot = table[idx];
+        if (slot.hash == hash && ::strcmp(slot.name, name) == 0)
+        {
+            LLBC_SetLastError(LLBC_ERROR_SUCCESS);
+            return slot.logger;
+        }
+    }
+
+    if (_rootTakeOver)
+        return _root;
+
+    LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
+    return NULL;
+}
+
+int LLBC_LoggerManager::BuildLookupTable()
+{
+    // Keep load factor <= 0.5, make sure probe sequence always stop at an empty slot.
+    size_t slotCount = 4;
+    while (slotCount < _loggers.size() * 2)
+        slotCount <<= 1;
+
+    _LookupSlot *table = LLBC_TagCalloc(LLBC_MemoryTag::Log, _LookupSlot, sizeof(_LookupSlot) * slotCount);
+    _lookupTableMask = slotCount - 1;
+
+    int minLogLevel = LLBC_LogLevel::End;
+    std::map<LLBC_String, LLBC_Logger *>::const_iterator it = _loggers.begin();
+    for (; it != _loggers.end(); ++it)
+    {
+        const int hash = LLBC_HashString(it->first);
+        size_t idx = static_cast<size_t>(hash) & _lookupTableMask;
+        while (table[idx].logger)
+            idx = (idx + 1) & _lookupTableMask;
+
+        table[idx].hash = hash;
+        table[idx].name = it->first.c_str();
+        table[idx].logger = it->second;
+
+        minLogLevel = MIN(minLogLevel, it->second->GetLogLevel());
+    }
+
+    _rootTakeOver = _root->IsTakeOver();
+    _lookupTable = table;
+
+    return minLogLevel;
+}
+
+void LLBC_LoggerManager::DestroyLookupTable()
+{
+    _LookupSlot *table = _lookupTable;
+    _lookupTable = NULL;
+    _lookupTableMask = 0;
+    _rootTakeOver = false;
+
+    LLBC_XFree(table);
+}
+
+void LLBC_LoggerManager::CreateSharedLogRunnables()
+{
+    const std::map<LLBC_String, LLBC_LoggerConfigInfo *> &configs = _configurator->GetAllConfigInfos();
+    std::map<LLBC_String, LLBC_LoggerConfigInfo *>::const_iterator rootIt = configs.find(_rootLoggerName);
+    if (rootIt == configs.end())
+        return;
+
+    // Don't create more shared log threads than asynchronous loggers.
+    int asyncLoggerCount = 0;
+    std::map<LLBC_String, LLBC_LoggerConfigInfo *>::const_iterator it = configs.begin();
+    for (; it != configs.end(); ++it)
+    {
+        if (it->second->IsAsyncMode())
+            ++asyncLoggerCount;
+    }
+
+    const int threadCount = MIN(rootIt->second->GetSharedLogThreadCount(), asyncLoggerCount);
+    for (int i = 0; i < threadCount; ++i)
+        _sharedLogRunnables.push_back(LLBC_New0(LLBC_LogRunnable));
+
+    _nextSharedLogRunnable = 0;
+}
+
+LLBC_LogRunnable *LLBC_LoggerManager::AllocSharedLogRunnable(const LLBC_String &name)
+{
+    if (_sharedLogRunnables.empty())
+        return NULL;
+
+    const std::map<LLBC_String, LLBC_LoggerConfigInfo *> &configs = _configurator->GetAllConfigInfos();
+    std::map<LLBC_String, LLBC_LoggerConfigInfo *>::const_iterator it = configs.find(name);
+    if (it == configs.end() || !it->second->IsAsyncMode())
+        return NULL;
+
+    // Round-robin allocate, one logger always output in the same log thread, so the logger output order is preserved.
+    LLBC_LogRunnable *runnable = _sharedLogRunnables[_nextSharedLogRunnable];
+    _nextSharedLogRunnable = (_nextSharedLogRunnable + 1) % _sharedLogRunnables.size();
+
+    return runnable;
+}
+
+void LLBC_LoggerManager::DestroySharedLogRunnables()
+{
+    for (size_t i = 0; i < _sharedLogRunnables.size(); ++i)
+    {
+        LLBC_LogRunnable *runnable = _sharedLogRunnables[i];
+        if (runnable->IsActivated())
+        {
+            runnable->Stop();
+            runnable->Wait();
+        }
+
+        LLBC_Delete(runnable);
+    }
+
+    _sharedLogRunnables.clear();
+    _nextSharedLogRunnable = 0;
+}
+
 __LLBC_NS_END
 
 #include "llbc/common/AfterIncl.h"
@@ -185,6 +185,27 @@ LLBC_SocketHandle LLBC_CreateTcpSocket()
 #endif // LLBC_TARGET_PLATFORM_NON_WIN32
 }
 
+LLBC_SocketHandle LLBC_CreateUdpSocket()
+{
+    LLBC_SocketHandle handle = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    if (handle == -1)
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+    }
+
+    return handle;
+#else // LLBC_TARGET_PLATFORM_WIN32
+    if (handle == INVALID_SOCKET)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NETAPI);
+    }
+
+    return handle;
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+}
+
 LLBC_SocketHandle LLBC_CreateTcpSocketEx()
 {
 #if LLBC_TARGET_PLATFORM_NON_WIN32
@@ -22,6 +22,7 @@
 #include "llbc/common/Export.h"
 #include "llbc/common/BeforeIncl.h"
 
+#include "llbc/core/rapidjson/memorystream.h"
 #include "llbc/core/rapidjson/json.h"
 
 #if LLBC_TARGET_PLATFORM_WIN32
@@ -47,6 +48,302 @@ void LLBC_JsonToString(const LLBC_JsonValue &value, LLBC_String &outStr, bool is
     outStr = buffer.GetString();
 }
 
+/**
+ * \brief The json <-> variant convert helper, access variant internal storage directly, avoid
+ *        unnecessary string copy and mark variant container unshareable.
+ */
+class LLBC_VariantJsonHelper
+{
+public:
+    /**
+     * The SAX handler, build variant directly when json parsing.
+     */
+    class Handler : public LLBC_Json::BaseReaderHandler<LLBC_Json::UTF8<>, Handler>
+    {
+    public:
+        Handler(LLBC_Variant &root, bool hashDict)
+        : _root(root)
+        , _hashDict(hashDict)
+        , _key("")
+        {
+        }
+
+    public:
+        bool Null() { Add(); return true; }
+        bool Bool(bool b) { Add() = LLBC_Variant(b); return true; }
+        bool Int(int i) { Add() = static_cast<sint64>(i); return true; }
+        bool Uint(unsigned u) { Add() = static_cast<sint64>(u); return true; }
+        bool Int64(int64_t i) { Add() = static_cast<sint64>(i); return true; }
+        bool Double(double d) { Add() = d; return true; }
+
+        bool Uint64(uint64_t u)
+        {
+            // Integers stored as int64, except out of int64 range.
+            if (u > static_cast<uint64_t>(std::numeric_limits<sint64>::max()))
+                Add() = static_cast<uint64>(u);
+            else
+                Add() = static_cast<sint64>(u);
+
+            return true;
+        }
+
+        bool String(const char *str, size_t len, bool)
+        {
+            LLBC_Variant &val = Add();
+            val.SetType(LLBC_VariantType::VT_STR_DFT);
+            if (len != 0)
+                val.SetStr(str, len);
+
+            return true;
+        }
+
+        bool Key(const char *str, size_t len, bool)
+        {
+            _key.SetStr(str, len);
+            return true;
+        }
+
+        bool StartObject()
+        {
+            return Push(_hashDict ? LLBC_VariantType::VT_DICT_HASH : LLBC_VariantType::VT_DICT_DFT);
+        }
+
+        bool EndObject(size_t)
+        {
+            _stack.pop_back();
+            return true;
+        }
+
+        bool StartArray()
+        {
+            return Push(LLBC_VariantType::VT_SEQ_DFT);
+        }
+
+        bool EndArray(size_t)
+        {
+            _stack.pop_back();
+            return true;
+        }
+
+    private:
+        // The opening container, only one of the object pointers is non-null.
+        struct Container
+        {
+            LLBC_Variant::Seq *seq;
+            LLBC_Variant::Dict *dict;
+            LLBC_Variant::HashDict *hashDict;
+
+            Container() : seq(NULL), dict(NULL), hashDict(NULL) {  }
+        };
+
+        // Add new value to current container(or root), return the nil value slot.
+        LLBC_Variant &Add()
+        {
+            if (_stack.empty())
+                return _root;
+
+            Container &container = _stack.back();
+            if (container.seq)
+            {
+                container.seq->push_back(LLBC_Variant::nil);
+                return container.seq->back();
+            }
+            else if (container.hashDict)
+            {
+                return (*container.hashDict)[_key];
+            }
+            else
+            {
+                return (*container.dict)[_key];
+            }
+        }
+
+        bool Push(int containerType)
+        {
+            // The container never be modified until all nested containers popped, pointer keep valid.
+            LLBC_Variant &var = Add();
+            var.BecomeNil();
+            var.SetType(containerType);
+
+            // Container variant not exposed to user when parsing, detach once without mark unshareable.
+            Container container;
+            if (containerType == LLBC_VariantType::VT_SEQ_DFT)
+                container.seq = var.DetachSeq(true, false);
+            else if (containerType == LLBC_VariantType::VT_DICT_HASH)
+                container.hashDict = var.DetachHashDict(true, false);
+            else
+                container.dict = var.DetachDict(true, false);
+
+            _stack.push_back(container);
+
+            return true;
+        }
+
+    private:
+        LLBC_Variant &_root;
+        bool _hashDict;
+
+        LLBC_Variant _key;
+        std::vector<Container> _stack;
+    };
+
+    /**
+     * The LLBC_String output stream, use by json writer.
+     */
+    class OutputStream
+    {
+    public:
+        typedef char Ch;
+
+        explicit OutputStream(LLBC_String &str)
+        : _str(str)
+        {
+        }
+
+        void Put(char c) { _str.push_back(c); }
+        void Flush() {  }
+
+    private:
+        LLBC_String &_str;
+    };
+
+public:
+    static int Parse(const char *json, size_t len, LLBC_Variant &var, bool hashDict)
+    {
+        var.BecomeNil();
+
+        // Use iterative parsing, deep nested json will not overflow the call stack.
+        LLBC_Json::Reader reader;
+        LLBC_Json::MemoryStream stream(json, len);
+        Handler handler(var, hashDict);
+        if (!reader.Parse<LLBC_Json::kParseIterativeFlag>(stream, handler))
+        {
+            var.BecomeNil();
+            LLBC_SetLastError(LLBC_ERROR_FORMAT);
+
+            return LLBC_FAILED;
+        }
+
+        return LLBC_OK;
+    }
+
+    template <typename _Writer>
+    static void Write(const LLBC_Variant &var, _Writer &writer)
+    {
+        if (var.IsStr())
+        {
+            writer.String(var.GetStrData(), var.GetStrSize());
+        }
+        else if (var.IsRaw())
+        {
+            if (var.IsBool())
+            {
+                writer.Bool(var.AsBool());
+            }
+            else if (var.IsFloat() || var.IsDouble())
+            {
+                const double dblVal = var.AsDouble();
+                if (LIKELY(dblVal - dblVal == 0.0))
+                    writer.Double(dblVal);
+                else // NaN or Inf, json not support.
+                    writer.Null();
+            }
+            else if (var.IsSignedRaw())
+            {
+                writer.Int64(var.AsInt64());
+            }
+            else
+            {
+                writer.Uint64(var.AsUInt64());
+            }
+        }
+        else if (var.IsSeq())
+        {
+            writer.StartArray();
+
+            const LLBC_Variant::Seq &seq = var.AsSeq();
+            for (LLBC_Variant::SeqConstIter it = seq.begin(); it != seq.end(); ++it)
+                Write(*it, writer);
+
+            writer.EndArray();
+        }
+        else if (var.IsDict())
+        {
+            writer.StartObject();
+            WriteMembers(var.AsDict(), writer);
+            writer.EndObject();
+        }
+        else if (var.IsHashDict())
+        {
+            writer.StartObject();
+            WriteMembers(var.AsHashDict(), writer);
+            writer.EndObject();
+        }
+        else
+        {
+            writer.Null();
+        }
+    }
+
+private:
+    template <typename _Dict, typename _Writer>
+    static void WriteMembers(const _Dict &dict, _Writer &writer)
+    {
+        // Json object key must be string, non-string key convert to string representation.
+        for (typename _Dict::const_iterator it = dict.begin(); it != dict.end(); ++it)
+        {
+            const LLBC_Variant &key = it->first;
+            if (key.IsStr())
+            {
+                writer.Key(key.GetStrData(), key.GetStrSize());
+            }
+            else
+            {
+                const LLBC_String keyStr = key.AsStr();
+                writer.Key(keyStr.data(), keyStr.size());
+            }
+
+            Write(it->second, writer);
+        }
+    }
+};
+
+int LLBC_JsonToVariant(const char *json, size_t len, LLBC_Variant &var, bool hashDict)
+{
+    if (UNLIKELY(json == NULL && len != 0))
+    {
+        var.BecomeNil();
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+
+        return LLBC_FAILED;
+    }
+
+    return LLBC_VariantJsonHelper::Parse(json, len, var, hashDict);
+}
+
+int LLBC_JsonToVariant(const LLBC_String &json, LLBC_Variant &var, bool hashDict)
+{
+    return LLBC_VariantJsonHelper::Parse(json.data(), json.size(), var, hashDict);
+}
+
+void LLBC_VariantToJson(const LLBC_Variant &var, LLBC_String &outStr, bool isPretty)
+{
+    // Output buffer reused, only clear content.
+    outStr.clear();
+
+    LLBC_VariantJsonHelper::OutputStream stream(outStr);
+    if (isPretty)
+    {
+        LLBC_Json::PrettyWriter<LLBC_VariantJsonHelper::OutputStream> writer(stream);
+        LLBC_VariantJsonHelper::Write(var, writer);
+    }
+    else
+    {
+        LLBC_Json::Writer<LLBC_VariantJsonHelper::OutputStream> writer(stream);
+        LLBC_VariantJsonHelper::Write(var, writer);
+    }
+}
+
 std::ostream &operator <<(std::ostream &o, const LLBC_JsonValue &value)
 {
     LLBC_Json::StringBuffer buffer;
@@ -0,0 +1,97 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/core/os/OS_Time.h"
+
+#include "llbc/core/sampler/SamplerType.h"
+#include "llbc/core/sampler/ProbabilitySampler.h"
+
+__LLBC_NS_BEGIN
+
+LLBC_ProbabilitySampler::LLBC_ProbabilitySampler()
+: _probability(1.0)
+, _random(static_cast<int>(LLBC_GetMicroSeconds()))
+
+, _suppressedTimes(0)
+{
+}
+
+LLBC_ProbabilitySampler::~LLBC_ProbabilitySampler()
+{
+}
+
+int LLBC_ProbabilitySampler::GetType() const
+{
+    return LLBC_SamplerType::ProbabilitySampler;
+}
+
+void LLBC_ProbabilitySampler::Reset()
+{
+    _suppressedTimes = 0;
+
+    _Base::Reset();
+}
+
+void LLBC_ProbabilitySampler::SetProbability(double probability)
+{
+    _probability = MIN(MAX(0.0, probability), 1.0);
+}
+
+double LLBC_ProbabilitySampler::GetProbability() const
+{
+    return _probability;
+}
+
+int LLBC_ProbabilitySampler::Sampling(sint64 value, void *appData)
+{
+    if (_Base::Sampling(value, appData) != LLBC_OK)
+    {
+        return LLBC_FAILED;
+    }
+
+    if (_probability >= 1.0 ||
+        _random.RandReal() < _probability)
+    {
+        return LLBC_OK;
+    }
+
+    _suppressedTimes += 1;
+
+    LLBC_SetLastError(LLBC_ERROR_LIMIT);
+    return LLBC_FAILED;
+}
+
+sint64 LLBC_ProbabilitySampler::GetSuppressedTimes() const
+{
+    return _suppressedTimes;
+}
+
+void LLBC_ProbabilitySampler::ClearSuppressedTimes()
+{
+    _suppressedTimes = 0;
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
@@ -0,0 +1,126 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/core/os/OS_Time.h"
+
+#include "llbc/core/sampler/SamplerType.h"
+#include "llbc/core/sampler/RateLimitSampler.h"
+
+__LLBC_NS_BEGIN
+
+LLBC_RateLimitSampler::LLBC_RateLimitSampler()
+: _rate(0)
+, _burst(0)
+
+, _tokens(0)
+, _lastRefillTime(0)
+
+, _suppressedTimes(0)
+{
+}
+
+LLBC_RateLimitSampler::~LLBC_RateLimitSampler()
+{
+}
+
+int LLBC_RateLimitSampler::GetType() const
+{
+    return LLBC_SamplerType::RateLimitSampler;
+}
+
+void LLBC_RateLimitSampler::Reset()
+{
+    _tokens = _burst * 1000;
+    _lastRefillTime = LLBC_GetMilliSeconds();
+
+    _suppressedTimes = 0;
+
+    _Base::Reset();
+}
+
+void LLBC_RateLimitSampler::SetLimit(sint64 rate, sint64 burst)
+{
+    _rate = MAX(0, rate);
+    _burst = burst > 0 ? burst : _rate;
+
+    _tokens = _burst * 1000;
+    _lastRefillTime = LLBC_GetMilliSeconds();
+}
+
+sint64 LLBC_RateLimitSampler::GetRate() const
+{
+    return _rate;
+}
+
+sint64 LLBC_RateLimitSampler::GetBurst() const
+{
+    return _burst;
+}
+
+int LLBC_RateLimitSampler::Sampling(sint64 value, void *appData)
+{
+    if (_Base::Sampling(value, appData) != LLBC_OK)
+    {
+        return LLBC_FAILED;
+    }
+
+    if (_rate == 0)
+    {
+        return LLBC_OK;
+    }
+
+    // Refill tokens, rate is per second, so elapsed milli-seconds * rate is the refill 1/1000 tokens.
+    const sint64 now = LLBC_GetMilliSeconds();
+    if (now > _lastRefillTime)
+    {
+        _tokens = MIN(_tokens + (now - _lastRefillTime) * _rate, _burst * 1000);
+        _lastRefillTime = now;
+    }
+
+    if (_tokens < value * 1000)
+    {
+        _suppressedTimes += 1;
+
+        LLBC_SetLastError(LLBC_ERROR_LIMIT);
+        return LLBC_FAILED;
+    }
+
+    _tokens -= value * 1000;
+
+    return LLBC_OK;
+}
+
+sint64 LLBC_RateLimitSampler::GetSuppressedTimes() const
+{
+    return _suppressedTimes;
+}
+
+void LLBC_RateLimitSampler::ClearSuppressedTimes()
+{
+    _suppressedTimes = 0;
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
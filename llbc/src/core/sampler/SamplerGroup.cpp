@@ -28,6 +28,8 @@
 #include "llbc/core/sampler/CountSampler.h"
 #include "llbc/core/sampler/LimitSampler.h"
 #include "llbc/core/sampler/IntervalSampler.h"
+#include "llbc/core/sampler/RateLimitSampler.h"
+#include "llbc/core/sampler/ProbabilitySampler.h"
 
 #include "llbc/core/sampler/SamplerGroup.h"
 
@@ -73,6 +75,14 @@ int LLBC_SamplerGroup::AddSampler(int type, const LLBC_String &name)
         sampler = LLBC_New0(LLBC_IntervalSampler);
         break;
 
+    case LLBC_SamplerType::RateLimitSampler:
+        sampler = LLBC_New0(LLBC_RateLimitSampler);
+        break;
+
+    case LLBC_SamplerType::ProbabilitySampler:
+        sampler = LLBC_New0(LLBC_ProbabilitySampler);
+        break;
+
     default:
         ASSERT(false && "llbc library internal error, unknown sampler type!");
         break;
@@ -44,11 +44,11 @@ LLBC_MessageBlock::LLBC_MessageBlock(size_t size)
 , _poolInst(NULL)
 {
     if (LIKELY(size > 0))
-        _buf = LLBC_Malloc(char, size);
+        _buf = LLBC_TagMalloc(LLBC_MemoryTag::MsgBlock, char, size);
 }
 
-LLBC_MessageBlock::LLBC_MessageBlock(void *buf, size_t size)
-: _attach(true)
+LLBC_MessageBlock::LLBC_MessageBlock(void *buf, size_t size, bool attach)
+: _attach(attach)
 , _buf(reinterpret_cast<char *>(buf))
 , _size(size)
 , _readPos(0)
@@ -331,7 +331,7 @@ void LLBC_MessageBlock::Resize(size_t newSize)
 {
     ASSERT(!_attach && newSize > _size);
 
-    _buf = LLBC_Realloc(char, _buf, newSize);
+    _buf = LLBC_TagRealloc(LLBC_MemoryTag::MsgBlock, char, _buf, newSize);
     _size = newSize;
 }
 
@@ -242,6 +242,47 @@ int LLBC_MessageBuffer::Append(LLBC_MessageBlock *block)
     return LLBC_OK;
 }
 
+int LLBC_MessageBuffer::Append(LLBC_Stream &stream)
+{
+    // Attach attribute's stream, copy data.
+    if (stream.IsAttach())
+    {
+        const size_t pos = stream.GetPos();
+        if (pos == 0)
+            return LLBC_OK;
+
+        const int ret = Write(reinterpret_cast<const char *>(stream.GetBuf()), pos);
+        if (ret == LLBC_OK)
+            stream.SetPos(0);
+
+        return ret;
+    }
+
+    // Detach stream segments, and take over as message blocks.
+    const size_t segmentCount = stream.GetSegmentCount();
+    if (segmentCount == 0)
+        return LLBC_OK;
+
+    LLBC_StreamSegment stackSegments[16];
+    LLBC_StreamSegment *segments = stackSegments;
+    if (segmentCount > sizeof(stackSegments) / sizeof(stackSegments[0]))
+        segments = LLBC_Malloc(LLBC_StreamSegment, sizeof(LLBC_StreamSegment) * segmentCount);
+
+    stream.DetachSegments(segments, segmentCount);
+    for (size_t i = 0; i < segmentCount; ++i)
+    {
+        LLBC_MessageBlock *block = LLBC_New3(LLBC_MessageBlock, segments[i].buf, segments[i].len, false);
+        block->SetWritePos(segments[i].len);
+
+        Append(block);
+    }
+
+    if (segments != stackSegments)
+        LLBC_Free(segments);
+
+    return LLBC_OK;
+}
+
 size_t LLBC_MessageBuffer::Remove(size_t length)
 {
     if (UNLIKELY(length <= 0))
@@ -37,6 +37,9 @@ LLBC_Timer::LLBC_Timer(LLBC_IDelegate1<void, LLBC_Timer *> *timeoutDeleg,
 : _scheduler(NULL)
 , _timerData(NULL)
 
+, _slack(0)
+, _batchGroup(0)
+
 , _data(NULL)
 , _timeoutDeleg(timeoutDeleg)
 , _cancelDeleg(cancelDeleg)
@@ -116,6 +119,26 @@ void LLBC_Timer::SetCancelHandler(LLBC_IDelegate1<void, LLBC_Timer *> *cancelDel
     _cancelDeleg = cancelDeleg;
 }
 
+uint64 LLBC_Timer::GetSlack() const
+{
+    return _slack;
+}
+
+void LLBC_Timer::SetSlack(uint64 slack)
+{
+    _slack = slack;
+}
+
+int LLBC_Timer::GetBatchGroup() const
+{
+    return _batchGroup;
+}
+
+void LLBC_Timer::SetBatchGroup(int batchGroup)
+{
+    _batchGroup = batchGroup;
+}
+
 LLBC_Variant &LLBC_Timer::GetTimerData()
 {
     if (!_data)
@@ -1,290 +1,718 @@
-// The MIT License (MIT)
-
-// Copyright (c) 2013 lailongwei<lailongwei@126.com>
-// 
-// Permission is hereby granted, free of charge, to any person obtaining a copy of 
-// this software and associated documentation files (the "Software"), to deal in 
-// the Software without restriction, including without limitation the rights to 
-// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
-// the Software, and to permit persons to whom the Software is furnished to do so, 
-// subject to the following conditions:
-// 
-// The above copyright notice and this permission notice shall be included in all 
-// copies or substantial portions of the Software.
-// 
-// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
-// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
-// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
-// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
-// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
-// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
-
-#include "llbc/common/Export.h"
-#include "llbc/common/BeforeIncl.h"
-
-#include "llbc/core/os/OS_Time.h"
-
-#include "llbc/core/timer/Timer.h"
-#include "llbc/core/timer/TimerData.h"
-
-#include "llbc/core/timer/TimerScheduler.h"
-
-__LLBC_INTERNAL_NS_BEGIN
-
-static LLBC_NS LLBC_TimerScheduler *__g_entryThreadTimerScheduler = NULL;
-
-__LLBC_INTERNAL_NS_END
-
-__LLBC_NS_BEGIN
-
-LLBC_TimerScheduler::LLBC_TimerScheduler()
-: _maxTimerId(0)
-, _enabled(true)
-, _destroyed(false)
-{
-}
-
-LLBC_TimerScheduler::~LLBC_TimerScheduler()
-{
-    _destroyed = true;
-
-    const size_t size = _heap.GetSize();
-    const _Heap::Container &elems = _heap.GetData();
-    for (size_t i = 1; i <= size; ++i)
-    {
-        LLBC_TimerData *data = const_cast<LLBC_TimerData *>(elems[i]);
-        if (data->validate)
-        {
-            data->validate = false;
-            data->cancelling = true;
-            data->timer->OnCancel();
-            data->cancelling = false;
-        }
-
-        if (--data->refCount == 0)
-            LLBC_Delete(data);
-    }
-}
-
-int LLBC_TimerScheduler::CreateEntryThreadScheduler()
-{
-    __LLBC_LibTls *tls = __LLBC_GetLibTls();
-    if (!tls->coreTls.entryThread)
-    {
-        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
-        return LLBC_FAILED;
-    }
-    else if (tls->coreTls.timerScheduler)
-    {
-        LLBC_SetLastError(LLBC_ERROR_REENTRY);
-        return LLBC_FAILED;
-    }
-
-    tls->coreTls.timerScheduler = 
-        LLBC_INTERNAL_NS __g_entryThreadTimerScheduler = LLBC_New0(LLBC_TimerScheduler);
-
-    return LLBC_OK;
-}
-
-int LLBC_TimerScheduler::DestroyEntryThreadScheduler()
-{
-    __LLBC_LibTls *tls = __LLBC_GetLibTls();
-    if (!tls->coreTls.entryThread)
-    {
-        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
-        return LLBC_FAILED;
-    }
-    else if (!tls->coreTls.timerScheduler)
-    {
-        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
-        return LLBC_FAILED;
-    }
-
-    tls->coreTls.timerScheduler = NULL;
-
-    LLBC_Delete(LLBC_INTERNAL_NS __g_entryThreadTimerScheduler);
-    LLBC_INTERNAL_NS __g_entryThreadTimerScheduler = NULL;
-
-    return LLBC_OK;
-}
-
-LLBC_TimerScheduler::_This *LLBC_TimerScheduler::GetEntryThreadScheduler()
-{
-    return LLBC_INTERNAL_NS __g_entryThreadTimerScheduler;
-}
-
-LLBC_TimerScheduler::_This *LLBC_TimerScheduler::GetCurrentThreadScheduler()
-{
-    __LLBC_LibTls *tls = __LLBC_GetLibTls();
-    return reinterpret_cast<_This *>(tls->coreTls.timerScheduler);
-}
-
-void LLBC_TimerScheduler::Update()
-{
-    if (UNLIKELY(!_enabled))
-        return;
-
-    LLBC_TimerData *data;
-    uint64 now = LLBC_GetMilliSeconds();
-    while (_heap.FindTop(data) == LLBC_OK)
-    {
-        if (now < data->handle)
-            break;
-
-        _heap.DeleteTop();
-        if (!data->validate)
-        {
-            if (--data->refCount == 0)
-                LLBC_Delete(data);
-
-            continue;
-        }
-
-        data->timeouting = true;
-
-        bool reSchedule = true;
-        LLBC_Timer *timer = data->timer;
-#if LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
-        uint64 pseudoNow = now;
-        while (pseudoNow >= data->handle)
-#endif // LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
-        {
-            ++data->repeatTimes;
-            timer->OnTimeout();
-
-            // Cancel() or Schedule() called.
-            if (!data->validate)
-            {
-                reSchedule = false;
-#if LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
-                break;
-#endif // LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
-            }
-
-#if LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
-            if (data->period == 0)
-                break;
-
-            if (UNLIKELY(pseudoNow < data->period))
-                break;
-
-            pseudoNow -= data->period;
-#endif // LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
-        }
-
-        data->timeouting = false;
-        if (reSchedule)
-        {
-            uint64 delay = (data->period != 0) ? (now - data->handle) % data->period : 0;
-            data->handle = now + data->period - delay;
-
-            _heap.Insert(data);
-        }
-        else
-        {
-            if (--data->refCount == 0)
-                LLBC_Delete(data);
-        }
-    }
-}
-
-bool LLBC_TimerScheduler::IsEnabled() const
-{
-    return _enabled;
-}
-
-void LLBC_TimerScheduler::SetEnabled(bool enabled)
-{
-    _enabled = enabled;
-}
-
-size_t LLBC_TimerScheduler::GetTimerCount() const
-{
-    return _heap.GetSize();
-}
-
-bool LLBC_TimerScheduler::IsDstroyed() const
-{
-    return _destroyed;
-}
-
-int LLBC_TimerScheduler::Schedule(LLBC_Timer *timer, uint64 dueTime, uint64 period)
-{
-    if (UNLIKELY(_destroyed))
-        return LLBC_ERROR_INVALID;
-
-    LLBC_TimerData *data = LLBC_New0(LLBC_TimerData);
-    ::memset(data, 0, sizeof(LLBC_TimerData));
-    data->handle = LLBC_GetMilliSeconds() + dueTime;
-    data->timerId = ++ _maxTimerId;
-    data->dueTime = dueTime;
-    data->period = period;
-    // data->repeatTimes = 0;
-    data->timer = timer;
-    data->validate = true;
-    // data->timeouting = false;
-    // data->cancelling = false;
-    data->refCount = 2;
-
-    if (timer->_timerData)
-    {
-        if (--timer->_timerData->refCount == 0)
-            LLBC_Delete(timer->_timerData);
-    }
-
-    timer->_timerData = data;
-    _heap.Insert(data);
-
-    return LLBC_OK;
-}
-
-int LLBC_TimerScheduler::Cancel(LLBC_Timer *timer)
-{
-    if (UNLIKELY(_destroyed))
-        return LLBC_ERROR_INVALID;
-
-    LLBC_TimerData *data = timer->_timerData;
-    ASSERT(data->timer == timer && 
-        "Timer manager internal error, LLBC_TimerData::timer != argument: timer!");
-
-    data->validate = false;
-    data->cancelling = true;
-    timer->OnCancel();
-    data->cancelling = false;
-
-    if (data->timeouting)
-        return LLBC_OK;
-
-    if (static_cast<sint64>(data->handle) - 
-            LLBC_GetMilliSeconds() >= LLBC_CFG_CORE_TIMER_LONG_TIMEOUT_TIME)
-    {
-        int delElemRet = _heap.DeleteElem(data);
-        ASSERT(delElemRet == LLBC_OK &&
-            "Timer manager internal error, Could not found timer data when Cancel long timeout timer!");
-        if (--data->refCount == 0)
-            LLBC_Delete(data);
-    }
-
-    return LLBC_OK;
-}
-
-void LLBC_TimerScheduler::CancelAll()
-{
-    if (UNLIKELY(_destroyed))
-        return;
-
-    const size_t size = _heap.GetSize();
-    _Heap::Container copyElems(_heap.GetData());
-    for (size_t i = 1; i <= size; ++i)
-    {
-        LLBC_TimerData *data = copyElems[i];
-        if (UNLIKELY(!data->validate))
-            return;
-
-        data->timer->Cancel();
-    }
-}
-
-__LLBC_NS_END
-
-#include "llbc/common/AfterIncl.h"
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/core/os/OS_Time.h"
+#include "llbc/core/log/Log.h"
+
+#include "llbc/core/timer/Timer.h"
+#include "llbc/core/timer/TimerData.h"
+#include "llbc/core/timer/TimingWheel.h"
+
+#include "llbc/core/timer/TimerScheduler.h"
+#include "llbc/core/timer/TimerSchedulerStat.h"
+
+__LLBC_INTERNAL_NS_BEGIN
+
+static LLBC_NS LLBC_TimerScheduler *__g_entryThreadTimerScheduler = NULL;
+
+static const LLBC_NS LLBC_String __schedulerType2StrDesc[LLBC_NS LLBC_TimerSchedulerType::End + 1] =
+{
+    "BinaryHeap",
+    "TimingWheel",
+
+    "Unknown"
+};
+
+// Apply slack to timer handle, return the time in [handle, handle + slack] which has the most trailing zero bits,
+// so the timers with slack are coalesced to the same time.
+static LLBC_NS uint64 __ApplySlack(LLBC_NS uint64 handle, LLBC_NS uint64 slack)
+{
+    if (slack == 0)
+        return handle;
+
+    const LLBC_NS uint64 limit = handle + slack;
+    LLBC_NS uint64 mask = handle ^ limit;
+    if (mask == 0)
+        return handle;
+
+    int bit = 63;
+    while ((mask & (1ULL << bit)) == 0)
+        --bit;
+
+    mask = (1ULL << bit) - 1;
+    return limit & ~mask;
+}
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+const LLBC_String &LLBC_TimerSchedulerType::GetTypeDesc(int type)
+{
+    return IsLegal(type) ? LLBC_INTERNAL_NS __schedulerType2StrDesc[type] :
+        LLBC_INTERNAL_NS __schedulerType2StrDesc[LLBC_TimerSchedulerType::End];
+}
+
+bool LLBC_TimerSchedulerType::IsLegal(int type)
+{
+    return type >= LLBC_TimerSchedulerType::Begin && type < LLBC_TimerSchedulerType::End;
+}
+
+LLBC_TimerScheduler::LLBC_TimerScheduler(int type)
+: _maxTimerId(0)
+, _enabled(true)
+, _destroyed(false)
+
+, _type(LLBC_TimerSchedulerType::IsLegal(type) ? type : LLBC_TimerSchedulerType::BinaryHeap)
+, _wheel(NULL)
+
+, _timerDataAllocTimes(0)
+, _timerDataReuseTimes(0)
+
+, _instrument(NULL)
+, _instrumentLogInterval(0)
+, _instrumentLogTime(0)
+{
+    if (_type == LLBC_TimerSchedulerType::TimingWheel)
+        _wheel = LLBC_New1(LLBC_TimingWheel, LLBC_GetMilliSeconds());
+}
+
+LLBC_TimerScheduler::~LLBC_TimerScheduler()
+{
+    _destroyed = true;
+
+    std::vector<LLBC_TimerData *> datas;
+    GetAllTimerDatas(datas);
+
+    const size_t size = datas.size();
+    for (size_t i = 0; i < size; ++i)
+    {
+        LLBC_TimerData *data = datas[i];
+        if (data->validate)
+        {
+            data->validate = false;
+            data->cancelling = true;
+            data->timer->OnCancel();
+            data->cancelling = false;
+        }
+
+        if (--data->refCount == 0)
+            LLBC_Delete(data);
+    }
+
+    LLBC_XDelete(_wheel);
+    LLBC_XDelete(_instrument);
+
+    for (std::map<int, _BatchGroup>::iterator it = _batchGroups.begin();
+         it != _batchGroups.end();
+         ++it)
+        LLBC_XDelete(it->second.handler);
+}
+
+int LLBC_TimerScheduler::CreateEntryThreadScheduler()
+{
+    __LLBC_LibTls *tls = __LLBC_GetLibTls();
+    if (!tls->coreTls.entryThread)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+        return LLBC_FAILED;
+    }
+    else if (tls->coreTls.timerScheduler)
+    {
+        LLBC_SetLastError(LLBC_ERROR_REENTRY);
+        return LLBC_FAILED;
+    }
+
+    tls->coreTls.timerScheduler = 
+        LLBC_INTERNAL_NS __g_entryThreadTimerScheduler = LLBC_New0(LLBC_TimerScheduler);
+
+    return LLBC_OK;
+}
+
+int LLBC_TimerScheduler::DestroyEntryThreadScheduler()
+{
+    __LLBC_LibTls *tls = __LLBC_GetLibTls();
+    if (!tls->coreTls.entryThread)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+        return LLBC_FAILED;
+    }
+    else if (!tls->coreTls.timerScheduler)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return LLBC_FAILED;
+    }
+
+    tls->coreTls.timerScheduler = NULL;
+
+    LLBC_Delete(LLBC_INTERNAL_NS __g_entryThreadTimerScheduler);
+    LLBC_INTERNAL_NS __g_entryThreadTimerScheduler = NULL;
+
+    return LLBC_OK;
+}
+
+LLBC_TimerScheduler::_This *LLBC_TimerScheduler::GetEntryThreadScheduler()
+{
+    return LLBC_INTERNAL_NS __g_entryThreadTimerScheduler;
+}
+
+LLBC_TimerScheduler::_This *LLBC_TimerScheduler::GetCurrentThreadScheduler()
+{
+    __LLBC_LibTls *tls = __LLBC_GetLibTls();
+    return reinterpret_cast<_This *>(tls->coreTls.timerScheduler);
+}
+
+void LLBC_TimerScheduler::Update()
+{
+    if (UNLIKELY(!_enabled))
+        return;
+
+    LLBC_TimerData *data;
+    uint64 now = LLBC_GetMilliSeconds();
+    const sint64 beginTime = UNLIKELY(_instrument) ? LLBC_GetMicroSeconds() : 0;
+    if (_wheel)
+    {
+        _wheel->Advance(now);
+        while ((data = _wheel->PopExpired()) != NULL)
+        {
+            if (!AddBatchTimeout(data, now))
+                ProcessTimeout(data, now);
+        }
+    }
+    else
+    {
+        while (_heap.FindTop(data) == LLBC_OK)
+        {
+            if (now < data->handle)
+                break;
+
+            if (!data->validate)
+            {
+                _heap.DeleteTop();
+                if (--data->refCount == 0)
+                    LLBC_Delete(data);
+
+                continue;
+            }
+
+            // Keep timer data in heap, after timeout, will update it's position or delete it in place.
+            if (!AddBatchTimeout(data, now))
+                ProcessTimeout(data, now);
+        }
+    }
+
+    ProcessBatchTimeouts(now);
+
+    if (UNLIKELY(beginTime != 0))
+        RecordUpdateCost(now, static_cast<uint64>(LLBC_GetMicroSeconds() - beginTime));
+}
+
+void LLBC_TimerScheduler::ProcessTimeout(LLBC_TimerData *data, uint64 now)
+{
+    data->timeouting = true;
+
+    bool reSchedule = true;
+    LLBC_Timer *timer = data->timer;
+
+    // Fetch timer class before timeout, timer maybe deleted in timeout handler.
+    sint64 beginTime = 0;
+    const char *timerClass = NULL;
+    if (UNLIKELY(_instrument))
+    {
+        _instrument->lateness.Record(now - data->handle);
+        timerClass = timer->_timeoutDeleg ? typeid(*timer->_timeoutDeleg).name() : typeid(*timer).name();
+        beginTime = LLBC_GetMicroSeconds();
+    }
+
+#if LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
+    uint64 pseudoNow = now;
+    while (pseudoNow >= data->handle)
+#endif // LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
+    {
+        ++data->repeatTimes;
+        timer->OnTimeout();
+
+        // Cancel() or Schedule() called.
+        if (!data->validate)
+        {
+            reSchedule = false;
+#if LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
+            break;
+#endif // LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
+        }
+
+#if LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
+        if (data->period == 0)
+            break;
+
+        if (UNLIKELY(pseudoNow < data->period))
+            break;
+
+        pseudoNow -= data->period;
+#endif // LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
+    }
+
+    if (UNLIKELY(timerClass != NULL))
+        RecordCallbackCost(timerClass, static_cast<uint64>(LLBC_GetMicroSeconds() - beginTime));
+
+    data->timeouting = false;
+    if (reSchedule)
+        Reschedule(data, now);
+    else
+        ReleaseTimeout(data);
+}
+
+bool LLBC_TimerScheduler::AddBatchTimeout(LLBC_TimerData *data, uint64 now)
+{
+    if (data->batchGroup == 0)
+        return false;
+
+    std::map<int, _BatchGroup>::iterator it = _batchGroups.find(data->batchGroup);
+    if (it == _batchGroups.end() || !it->second.handler)
+        return false;
+
+    // Batch timeout timer data will be removed from heap, after batch fired, re-insert to heap.
+    if (!_wheel)
+        _heap.DeleteElem(data->heapIndex);
+
+    data->timeouting = true;
+    if (UNLIKELY(_instrument))
+        _instrument->lateness.Record(now - data->handle);
+
+    _BatchGroup &group = it->second;
+    if (group.datas.empty())
+        _timeoutBatchGroups.push_back(&group);
+
+    group.datas.push_back(data);
+
+    return true;
+}
+
+void LLBC_TimerScheduler::ProcessBatchTimeouts(uint64 now)
+{
+    for (size_t i = 0; i < _timeoutBatchGroups.size(); ++i)
+    {
+        _BatchGroup &group = *_timeoutBatchGroups[i];
+
+        // Batch timeout timers maybe cancelled(or deleted) by other timers in this Update(),
+        // only pass validate timers to handler.
+        const size_t count = group.datas.size();
+        for (size_t j = 0; j < count; ++j)
+        {
+            LLBC_TimerData *data = group.datas[j];
+            if (data->validate)
+            {
+                ++data->repeatTimes;
+                group.timers.push_back(data->timer);
+            }
+        }
+
+        if (group.timers.empty())
+        {
+            // All batch timeout timers cancelled(or deleted), don't call handler.
+        }
+        else if (LIKELY(group.handler))
+        {
+            // Handler maybe replaced(or removed) in handler, fetch handler class before invoke.
+            const char *handlerClass = NULL;
+            sint64 beginTime = 0;
+            if (UNLIKELY(_instrument))
+            {
+                handlerClass = typeid(*group.handler).name();
+                beginTime = LLBC_GetMicroSeconds();
+            }
+
+            group.firingHandler = group.handler;
+            group.firingHandler->Invoke(group.timers);
+            if (group.firingHandlerReplaced)
+            {
+                LLBC_Delete(group.firingHandler);
+                group.firingHandlerReplaced = false;
+            }
+            group.firingHandler = NULL;
+
+            if (UNLIKELY(handlerClass))
+                RecordCallbackCost(handlerClass,
+                                   static_cast<uint64>(LLBC_GetMicroSeconds() - beginTime));
+        }
+        else
+        {
+            // Batch timeout handler removed in timeout handler, fire one by one.
+            for (size_t j = 0; j < count; ++j)
+            {
+                if (group.datas[j]->validate)
+                    group.datas[j]->timer->OnTimeout();
+            }
+        }
+
+        for (size_t j = 0; j < count; ++j)
+        {
+            LLBC_TimerData *data = group.datas[j];
+            data->timeouting = false;
+            if (data->validate)
+                Reschedule(data, now);
+            else
+                ReleaseTimeout(data);
+        }
+
+        group.timers.clear();
+        group.datas.clear();
+    }
+
+    _timeoutBatchGroups.clear();
+}
+
+void LLBC_TimerScheduler::Reschedule(LLBC_TimerData *data, uint64 now)
+{
+    uint64 delay = (data->period != 0) ? (now - data->nominalHandle) % data->period : 0;
+    data->nominalHandle = now + data->period - delay;
+    data->handle = LLBC_INL_NS __ApplySlack(data->nominalHandle, data->slack);
+
+    if (_wheel)
+        _wheel->Insert(data);
+    else if (data->heapIndex != 0)
+        _heap.UpdateElem(data->heapIndex);
+    else
+        _heap.Insert(data);
+}
+
+void LLBC_TimerScheduler::ReleaseTimeout(LLBC_TimerData *data)
+{
+    if (!_wheel && data->heapIndex != 0)
+        _heap.DeleteElem(data->heapIndex);
+
+    if (--data->refCount == 0)
+        LLBC_Delete(data);
+}
+
+void LLBC_TimerScheduler::RecordCallbackCost(const char *timerClass, uint64 cost)
+{
+    // Instrument maybe disabled in timeout handler.
+    if (UNLIKELY(!_instrument))
+        return;
+
+    _instrument->callbackCost.Record(cost);
+
+    LLBC_TimerClassStat &classStat = _instrumentClasses[timerClass];
+    ++classStat.calls;
+    classStat.totalCost += cost;
+    if (cost > classStat.maxCost)
+        classStat.maxCost = cost;
+}
+
+void LLBC_TimerScheduler::RecordUpdateCost(uint64 now, uint64 cost)
+{
+    if (UNLIKELY(!_instrument))
+        return;
+
+    ++_instrument->updateTimes;
+    _instrument->updateCost += cost;
+    if (cost > _instrument->maxUpdateCost)
+        _instrument->maxUpdateCost = cost;
+
+    if (_instrumentLogInterval == 0)
+        return;
+
+    if (_instrumentLogTime == 0)
+    {
+        _instrumentLogTime = now;
+    }
+    else if (now - _instrumentLogTime >= _instrumentLogInterval)
+    {
+        LLBC_TimerInstrumentStat stat;
+        InstrumentStat(stat);
+        LLBC_LogHelper::i2("TimerScheduler", "Timer scheduler instrument stat:\n%s", stat.ToString().c_str());
+
+        ResetInstrumentStat();
+        _instrumentLogTime = now;
+    }
+}
+
+bool LLBC_TimerScheduler::IsEnabled() const
+{
+    return _enabled;
+}
+
+void LLBC_TimerScheduler::SetEnabled(bool enabled)
+{
+    _enabled = enabled;
+}
+
+int LLBC_TimerScheduler::GetSchedulerType() const
+{
+    return _type;
+}
+
+size_t LLBC_TimerScheduler::GetTimerCount() const
+{
+    return _wheel ? _wheel->GetSize() : _heap.GetSize();
+}
+
+void LLBC_TimerScheduler::Stat(LLBC_TimerSchedulerStat &stat) const
+{
+    stat.Reset();
+
+    std::vector<LLBC_TimerData *> datas;
+    GetAllTimerDatas(datas);
+
+    stat.schedulerType = _type;
+    stat.entryCount = datas.size();
+    for (size_t i = 0; i < datas.size(); ++i)
+    {
+        if (datas[i]->validate)
+            ++stat.timerCount;
+        else
+            ++stat.deadEntryCount;
+    }
+
+    stat.timerDataAllocTimes = _timerDataAllocTimes;
+    stat.timerDataReuseTimes = _timerDataReuseTimes;
+}
+
+bool LLBC_TimerScheduler::IsInstrumentEnabled() const
+{
+    return _instrument != NULL;
+}
+
+void LLBC_TimerScheduler::SetInstrumentEnabled(bool enabled)
+{
+    if (enabled == IsInstrumentEnabled())
+        return;
+
+    if (enabled)
+    {
+        _instrument = LLBC_New(LLBC_TimerInstrumentStat);
+        _instrumentLogTime = 0;
+    }
+    else
+    {
+        LLBC_XDelete(_instrument);
+        _instrumentClasses.clear();
+    }
+}
+
+void LLBC_TimerScheduler::SetInstrumentLogInterval(uint64 interval)
+{
+    _instrumentLogInterval = interval;
+    _instrumentLogTime = 0;
+}
+
+int LLBC_TimerScheduler::InstrumentStat(LLBC_TimerInstrumentStat &stat) const
+{
+    if (UNLIKELY(!_instrument))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return LLBC_FAILED;
+    }
+
+    stat = *_instrument;
+
+    // Stat top N slowest(by total cost) timer classes.
+    std::vector<std::pair<uint64, const char *> > classCosts;
+    classCosts.reserve(_instrumentClasses.size());
+    for (std::map<const char *, LLBC_TimerClassStat>::const_iterator it = _instrumentClasses.begin();
+         it != _instrumentClasses.end();
+         ++it)
+        classCosts.push_back(std::make_pair(it->second.totalCost, it->first));
+
+    const size_t topN = MIN(classCosts.size(), static_cast<size_t>(LLBC_CFG_CORE_TIMER_INSTRUMENT_TOP_N));
+    std::partial_sort(classCosts.begin(), 
+                      classCosts.begin() + topN,
+                      classCosts.end(),
+                      std::greater<std::pair<uint64, const char *> >());
+
+    stat.topSlowClasses.resize(topN);
+    for (size_t i = 0; i < topN; ++i)
+    {
+        LLBC_TimerClassStat &classStat = stat.topSlowClasses[i];
+        classStat = _instrumentClasses.find(classCosts[i].second)->second;
+        classStat.name = __LLBC_GetTypeName(classCosts[i].second);
+    }
+
+    return LLBC_OK;
+}
+
+void LLBC_TimerScheduler::ResetInstrumentStat()
+{
+    if (!_instrument)
+        return;
+
+    _instrument->Reset();
+    _instrumentClasses.clear();
+}
+
+int LLBC_TimerScheduler::SetBatchTimeoutHandler(int batchGroup, 
+                                                LLBC_IDelegate1<void, const std::vector<LLBC_Timer *> &> *handler)
+{
+    if (UNLIKELY(batchGroup <= 0))
+    {
+        LLBC_XDelete(handler);
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    // Not erase batch group, batch group maybe firing.
+    _BatchGroup &group = _batchGroups[batchGroup];
+    if (group.handler != handler)
+    {
+        // The invoking handler will be deleted after invoke returned.
+        if (group.handler && group.handler == group.firingHandler)
+            group.firingHandlerReplaced = true;
+        else
+            LLBC_XDelete(group.handler);
+
+        // Reset the invoking handler back, not delete it.
+        if (handler && handler == group.firingHandler)
+            group.firingHandlerReplaced = false;
+
+        group.handler = handler;
+    }
+
+    return LLBC_OK;
+}
+
+bool LLBC_TimerScheduler::IsDstroyed() const
+{
+    return _destroyed;
+}
+
+int LLBC_TimerScheduler::Schedule(LLBC_Timer *timer, uint64 dueTime, uint64 period)
+{
+    if (UNLIKELY(_destroyed))
+        return LLBC_ERROR_INVALID;
+
+    // If the timer data only referenced by timer(not in heap/wheel and not timeouting), reuse it.
+    LLBC_TimerData *data = timer->_timerData;
+    if (data && data->refCount == 1 && !data->timeouting)
+    {
+        ++_timerDataReuseTimes;
+    }
+    else
+    {
+        if (data && --data->refCount == 0)
+            LLBC_Delete(data);
+
+        data = LLBC_New0(LLBC_TimerData);
+        ++_timerDataAllocTimes;
+    }
+
+    ::memset(data, 0, sizeof(LLBC_TimerData));
+    data->nominalHandle = LLBC_GetMilliSeconds() + dueTime;
+    data->handle = LLBC_INL_NS __ApplySlack(data->nominalHandle, timer->_slack);
+    data->timerId = ++ _maxTimerId;
+    data->dueTime = dueTime;
+    data->period = period;
+    // data->repeatTimes = 0;
+    data->slack = timer->_slack;
+    data->batchGroup = timer->_batchGroup;
+    data->timer = timer;
+    data->validate = true;
+    // data->timeouting = false;
+    // data->cancelling = false;
+    data->refCount = 2;
+
+    timer->_timerData = data;
+    if (_wheel)
+        _wheel->Insert(data);
+    else
+        _heap.Insert(data);
+
+    return LLBC_OK;
+}
+
+int LLBC_TimerScheduler::Cancel(LLBC_Timer *timer)
+{
+    if (UNLIKELY(_destroyed))
+        return LLBC_ERROR_INVALID;
+
+    LLBC_TimerData *data = timer->_timerData;
+    ASSERT(data->timer == timer && 
+        "Timer manager internal error, LLBC_TimerData::timer != argument: timer!");
+
+    data->validate = false;
+    data->cancelling = true;
+    timer->OnCancel();
+    data->cancelling = false;
+
+    if (data->timeouting)
+        return LLBC_OK;
+
+    int removeRet = _wheel ? _wheel->Remove(data) : _heap.DeleteElem(data->heapIndex);
+    ASSERT(removeRet == LLBC_OK &&
+        "Timer manager internal error, Could not found timer data when Cancel timer!");
+    if (--data->refCount == 0)
+        LLBC_Delete(data);
+
+    return LLBC_OK;
+}
+
+void LLBC_TimerScheduler::CancelAll()
+{
+    if (UNLIKELY(_destroyed))
+        return;
+
+    if (_wheel)
+    {
+        // Cancel timer will remove timer data from wheel, so always cancel the first one.
+        size_t slot = 0;
+        LLBC_TimerData *data;
+        while ((data = _wheel->GetFirst(slot)) != NULL)
+            data->timer->Cancel();
+
+        return;
+    }
+
+    // Cancel timer will remove timer data from heap, so always cancel the first cancelable one,
+    // the timeouting timer data(CancelAll() called in timeout handler) will be skipped.
+    size_t index = 1;
+    while (index <= _heap.GetSize())
+    {
+        LLBC_TimerData *data = _heap.GetData()[index];
+        if (!data->validate || data->timeouting)
+        {
+            ++index;
+            continue;
+        }
+
+        data->timer->Cancel();
+        index = 1;
+    }
+}
+
+void LLBC_TimerScheduler::GetAllTimerDatas(std::vector<LLBC_TimerData *> &datas) const
+{
+    if (_wheel)
+    {
+        _wheel->GetAll(datas);
+        return;
+    }
+
+    const size_t size = _heap.GetSize();
+    const _Heap::Container &elems = _heap.GetData();
+    datas.insert(datas.end(), elems.begin() + 1, elems.begin() + 1 + size);
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
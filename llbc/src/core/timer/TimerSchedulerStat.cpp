@@ -0,0 +1,188 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/core/timer/TimerScheduler.h"
+#include "llbc/core/timer/TimerSchedulerStat.h"
+
+__LLBC_INTERNAL_NS_BEGIN
+
+// Timer lateness histogram buckets upper bounds, in milli-seconds.
+static const LLBC_NS uint64 __latenessBounds[LLBC_NS LLBC_TimerHistogram::BucketCount - 1] =
+    {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 5000};
+
+// Timer callback cost histogram buckets upper bounds, in micro-seconds.
+static const LLBC_NS uint64 __callbackCostBounds[LLBC_NS LLBC_TimerHistogram::BucketCount - 1] =
+    {10, 50, 100, 500, 1000, 5000, 10000, 50000, 100000, 500000, 1000000};
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+LLBC_TimerSchedulerStat::LLBC_TimerSchedulerStat()
+{
+    Reset();
+}
+
+void LLBC_TimerSchedulerStat::Reset()
+{
+    schedulerType = LLBC_TimerSchedulerType::End;
+
+    timerCount = 0;
+    entryCount = 0;
+    deadEntryCount = 0;
+
+    timerDataAllocTimes = 0;
+    timerDataReuseTimes = 0;
+}
+
+LLBC_String LLBC_TimerSchedulerStat::ToString() const
+{
+    return LLBC_String().format(
+        "type: %s, timers: %lu, entries: %lu, dead entries: %lu, timer data alloc times: %llu, reuse times: %llu",
+        LLBC_TimerSchedulerType::GetTypeDesc(schedulerType).c_str(),
+        timerCount, entryCount, deadEntryCount, timerDataAllocTimes, timerDataReuseTimes);
+}
+
+LLBC_TimerHistogram::LLBC_TimerHistogram(const uint64 *bucketBounds, const char *valueUnit)
+: bounds(bucketBounds)
+, unit(valueUnit)
+{
+    Reset();
+}
+
+void LLBC_TimerHistogram::Record(uint64 value)
+{
+    int bucket = 0;
+    for (; bucket < BucketCount - 1; ++bucket)
+    {
+        if (value < bounds[bucket])
+            break;
+    }
+
+    ++counts[bucket];
+
+    ++count;
+    sum += value;
+    if (value > maxValue)
+        maxValue = value;
+}
+
+void LLBC_TimerHistogram::Reset()
+{
+    ::memset(counts, 0, sizeof(counts));
+
+    count = 0;
+    sum = 0;
+    maxValue = 0;
+}
+
+uint64 LLBC_TimerHistogram::GetPercentile(double percentile) const
+{
+    if (count == 0)
+        return 0;
+
+    const uint64 threshold = static_cast<uint64>(count * MIN(MAX(percentile, 0.0), 100.0) / 100.0);
+
+    uint64 accumulated = 0;
+    for (int bucket = 0; bucket < BucketCount - 1; ++bucket)
+    {
+        accumulated += counts[bucket];
+        if (accumulated >= threshold)
+            return MIN(bounds[bucket], maxValue);
+    }
+
+    return maxValue;
+}
+
+LLBC_String LLBC_TimerHistogram::ToString() const
+{
+    LLBC_String repr;
+    repr.format("count: %llu, avg: %.2f%s, p50: %llu%s, p99: %llu%s, max: %llu%s, buckets: [",
+                count, count > 0 ? static_cast<double>(sum) / count : 0.0, unit,
+                GetPercentile(50), unit, GetPercentile(99), unit, maxValue, unit);
+
+    for (int bucket = 0; bucket < BucketCount; ++bucket)
+    {
+        if (bucket != 0)
+            repr.append(", ");
+
+        if (bucket != BucketCount - 1)
+            repr.append_format("<%llu: %llu", bounds[bucket], counts[bucket]);
+        else
+            repr.append_format(">=%llu: %llu", bounds[bucket - 1], counts[bucket]);
+    }
+
+    repr.append("]");
+
+    return repr;
+}
+
+LLBC_TimerClassStat::LLBC_TimerClassStat()
+: calls(0)
+, totalCost(0)
+, maxCost(0)
+{
+}
+
+LLBC_TimerInstrumentStat::LLBC_TimerInstrumentStat()
+: lateness(LLBC_INL_NS __latenessBounds, "ms")
+, callbackCost(LLBC_INL_NS __callbackCostBounds, "us")
+{
+    Reset();
+}
+
+void LLBC_TimerInstrumentStat::Reset()
+{
+    lateness.Reset();
+    callbackCost.Reset();
+
+    updateTimes = 0;
+    updateCost = 0;
+    maxUpdateCost = 0;
+
+    topSlowClasses.clear();
+}
+
+LLBC_String LLBC_TimerInstrumentStat::ToString() const
+{
+    LLBC_String repr;
+    repr.format("update times: %llu, update cost: %llu us, max update cost: %llu us\n",
+                updateTimes, updateCost, maxUpdateCost);
+    repr.append_format("lateness: %s\n", lateness.ToString().c_str());
+    repr.append_format("callback cost: %s\n", callbackCost.ToString().c_str());
+
+    repr.append("top slow timer classes:");
+    for (size_t i = 0; i < topSlowClasses.size(); ++i)
+    {
+        const LLBC_TimerClassStat &classStat = topSlowClasses[i];
+        repr.append_format("\n  %s: calls: %llu, total cost: %llu us, max cost: %llu us",
+                           classStat.name.c_str(), classStat.calls, classStat.totalCost, classStat.maxCost);
+    }
+
+    return repr;
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
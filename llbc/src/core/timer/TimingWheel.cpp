@@ -0,0 +1,243 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/core/timer/TimerData.h"
+#include "llbc/core/timer/TimingWheel.h"
+
+__LLBC_INTERNAL_NS_BEGIN
+
+// Level 0 slot bits/size/mask.
+static const int __lv0Bits = 8;
+static const LLBC_NS uint64 __lv0Size = 1 << __lv0Bits;
+static const LLBC_NS uint64 __lv0Mask = __lv0Size - 1;
+
+// Level 1~4 slot bits/size/mask.
+static const int __lvnBits = 6;
+static const LLBC_NS uint64 __lvnSize = 1 << __lvnBits;
+static const LLBC_NS uint64 __lvnMask = __lvnSize - 1;
+
+// Max levels count.
+static const int __levels = 5;
+// Max wheel span ticks.
+static const LLBC_NS uint64 __maxSpan = 0xffffffffULL;
+
+// Expired list slot index.
+static const size_t __expiredSlot = static_cast<size_t>(__lv0Size + __lvnSize * (__levels - 1));
+
+// Get specific level(>= 1) slot index.
+inline size_t __LvnSlot(int level, LLBC_NS uint64 expires)
+{
+    return static_cast<size_t>(__lv0Size + __lvnSize * (level - 1) + 
+        ((expires >> (__lv0Bits + (level - 1) * __lvnBits)) & __lvnMask));
+}
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+LLBC_TimingWheel::LLBC_TimingWheel(uint64 now)
+: _curTick(now)
+, _size(0)
+{
+    ::memset(_slots, 0, sizeof(_slots));
+}
+
+LLBC_TimingWheel::~LLBC_TimingWheel()
+{
+}
+
+void LLBC_TimingWheel::Insert(LLBC_TimerData *data)
+{
+    Link(data);
+    ++_size;
+}
+
+int LLBC_TimingWheel::Remove(LLBC_TimerData *data)
+{
+    if (UNLIKELY(!data->pprev))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
+        return LLBC_FAILED;
+    }
+
+    Unlink(data);
+    --_size;
+
+    return LLBC_OK;
+}
+
+void LLBC_TimingWheel::Advance(uint64 now)
+{
+    if (_size == 0)
+    {
+        if (now >= _curTick)
+            _curTick = now + 1;
+
+        return;
+    }
+
+    LLBC_TimerData **tail = &_slots[LLBC_INL_NS __expiredSlot];
+    while (*tail)
+        tail = &(*tail)->next;
+
+    while (_curTick <= now)
+    {
+        const size_t index = static_cast<size_t>(_curTick & LLBC_INL_NS __lv0Mask);
+        if (index == 0)
+        {
+            for (int level = 1; level < LLBC_INL_NS __levels; ++level)
+            {
+                if (Cascade(level) != 0)
+                    break;
+            }
+        }
+
+        ++_curTick;
+
+        LLBC_TimerData *list = _slots[index];
+        if (list)
+        {
+            _slots[index] = NULL;
+
+            *tail = list;
+            list->pprev = tail;
+            while (*tail)
+                tail = &(*tail)->next;
+        }
+    }
+}
+
+LLBC_TimerData *LLBC_TimingWheel::PopExpired()
+{
+    LLBC_TimerData *data = _slots[LLBC_INL_NS __expiredSlot];
+    if (data)
+    {
+        Unlink(data);
+        --_size;
+    }
+
+    return data;
+}
+
+size_t LLBC_TimingWheel::GetSize() const
+{
+    return _size;
+}
+
+LLBC_TimerData *LLBC_TimingWheel::GetFirst(size_t &slot) const
+{
+    for (; slot <= LLBC_INL_NS __expiredSlot; ++slot)
+    {
+        if (_slots[slot])
+            return _slots[slot];
+    }
+
+    return NULL;
+}
+
+void LLBC_TimingWheel::GetAll(std::vector<LLBC_TimerData *> &datas) const
+{
+    datas.reserve(datas.size() + _size);
+    for (size_t slot = 0; slot <= LLBC_INL_NS __expiredSlot; ++slot)
+    {
+        for (LLBC_TimerData *data = _slots[slot]; data; data = data->next)
+            datas.push_back(data);
+    }
+}
+
+void LLBC_TimingWheel::Link(LLBC_TimerData *data)
+{
+    LLBC_TimerData **head;
+    uint64 expires = data->handle;
+    if (expires < _curTick)
+    {
+        head = &_slots[_curTick & LLBC_INL_NS __lv0Mask];
+    }
+    else
+    {
+        uint64 span = expires - _curTick;
+        if (span < LLBC_INL_NS __lv0Size)
+        {
+            head = &_slots[expires & LLBC_INL_NS __lv0Mask];
+        }
+        else
+        {
+            int level = 1;
+            for (; level < LLBC_INL_NS __levels - 1; ++level)
+            {
+                if (span < (1ULL << (LLBC_INL_NS __lv0Bits + level * LLBC_INL_NS __lvnBits)))
+                    break;
+            }
+
+            if (span > LLBC_INL_NS __maxSpan)
+                expires = _curTick + LLBC_INL_NS __maxSpan;
+
+            head = &_slots[LLBC_INL_NS __LvnSlot(level, expires)];
+        }
+    }
+
+    data->next = *head;
+    if (*head)
+        (*head)->pprev = &data->next;
+
+    *head = data;
+    data->pprev = head;
+}
+
+void LLBC_TimingWheel::Unlink(LLBC_TimerData *data)
+{
+    *data->pprev = data->next;
+    if (data->next)
+        data->next->pprev = data->pprev;
+
+    data->next = NULL;
+    data->pprev = NULL;
+}
+
+size_t LLBC_TimingWheel::Cascade(int level)
+{
+    const size_t index = static_cast<size_t>(
+        (_curTick >> (LLBC_INL_NS __lv0Bits + (level - 1) * LLBC_INL_NS __lvnBits)) & LLBC_INL_NS __lvnMask);
+
+    LLBC_TimerData *&head = _slots[LLBC_INL_NS __LvnSlot(level, _curTick)];
+    LLBC_TimerData *data = head;
+    head = NULL;
+
+    while (data)
+    {
+        LLBC_TimerData *next = data->next;
+        data->next = NULL;
+        data->pprev = NULL;
+
+        Link(data);
+
+        data = next;
+    }
+
+    return index;
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
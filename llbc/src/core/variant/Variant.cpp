@@ -22,6 +22,7 @@
 #include "llbc/common/Export.h"
 #include "llbc/common/BeforeIncl.h"
 
+#include "llbc/core/os/OS_Atomic.h"
 #include "llbc/core/comstring/ComString.h"
 
 #include "llbc/core/utils/Util_Text.h"
@@ -38,6 +39,12 @@ namespace
     typedef LLBC_NS LLBC_Variant::DictConstIter DictConstIter;
     typedef LLBC_NS LLBC_Variant::DictReverseIter DictReverseIter;
     typedef LLBC_NS LLBC_Variant::DictConstReverseIter DictConstReverseIter;
+
+    typedef LLBC_NS LLBC_Variant::HashDict HashDict;
+
+    typedef LLBC_NS LLBC_Variant::Seq Seq;
+    typedef LLBC_NS LLBC_Variant::SeqIter SeqIter;
+    typedef LLBC_NS LLBC_Variant::SeqConstIter SeqConstIter;
 }
 
 __LLBC_INTERNAL_NS_BEGIN
@@ -45,14 +52,197 @@ __LLBC_INTERNAL_NS_BEGIN
 static const Str __g_nullStr;
 static const Str __g_trueStr = "true";
 static const Dict __g_nullDict;
+static const HashDict __g_nullHashDict;
+static const Seq __g_nullSeq;
 static const LLBC_NS LLBC_Variant __g_nilVariant;
 
-static void BecomeAndAllocDict(LLBC_NS LLBC_Variant &var, LLBC_NS LLBC_Variant::Holder &holder)
+// The discarded sequence element, non-const subscript return it when sequence index out of range(per thread, reset to nil when returned).
+static LLBC_THREAD_LOCAL LLBC_NS LLBC_Variant *__g_discardedSeqElem = NULL;
+
+/**
+ * \brief The variant shared heap string, all heap strings in variant holder are allocated as this type.
+ *        Heap strings never modified after shared, so copy variant only need add reference.
+ */
+struct __LLBC_VariantSharedStr : public Str
+{
+    volatile LLBC_NS sint32 refs;
+
+    __LLBC_VariantSharedStr(const char *str, size_t len)
+    : Str(str, len)
+    , refs(1)
+    {
+    }
+};
+
+/**
+ * \brief The variant shared heap object(dictionary/hash dictionary/sequence), all heap objects in variant
+ *        holder are allocated as this type.
+ *        Object detached(copy-on-write) before modify, once the mutable iterator/element reference
+ *        exposed to user, object become unshareable, copy variant will deep copy object, and object
+ *        become shareable again(exposed iterators/references can't be used to modify after copied).
+ */
+template <typename _Obj>
+struct __LLBC_VariantSharedObj : public _Obj
+{
+    volatile LLBC_NS sint32 refs;
+    bool shareable;
+
+    __LLBC_VariantSharedObj()
+    : refs(1)
+    , shareable(true)
+    {
+    }
+
+    explicit __LLBC_VariantSharedObj(const _Obj &obj)
+    : _Obj(obj)
+    , refs(1)
+    , shareable(true)
+    {
+    }
+};
+
+static inline __LLBC_VariantSharedStr *__AsSharedStr(const Str *str)
+{
+    return static_cast<__LLBC_VariantSharedStr *>(const_cast<Str *>(str));
+}
+
+template <typename _Obj>
+static inline __LLBC_VariantSharedObj<_Obj> *__AsSharedObj(const _Obj *obj)
+{
+    return static_cast<__LLBC_VariantSharedObj<_Obj> *>(const_cast<_Obj *>(obj));
+}
+
+static void ReleaseStr(Str *&str)
+{
+    if (str == NULL)
+        return;
+
+    __LLBC_VariantSharedStr *sharedStr = __AsSharedStr(str);
+    if (LLBC_NS LLBC_AtomicFetchAndSub(&sharedStr->refs, 1) == 1)
+        LLBC_Delete(sharedStr);
+
+    str = NULL;
+}
+
+template <typename _Obj>
+static void ReleaseObj(_Obj *&obj)
+{
+    if (obj == NULL)
+        return;
+
+    __LLBC_VariantSharedObj<_Obj> *sharedObj = __AsSharedObj(obj);
+    if (LLBC_NS LLBC_AtomicFetchAndSub(&sharedObj->refs, 1) == 1)
+        LLBC_Delete(sharedObj);
+
+    obj = NULL;
+}
+
+template <typename _Obj>
+static void SetObj(_Obj *&heapObj, const _Obj &obj)
+{
+    if (&obj == heapObj)
+        return;
+
+    if (obj.empty())
+    {
+        ReleaseObj(heapObj);
+        return;
+    }
+
+    __LLBC_VariantSharedObj<_Obj> *sharedObj = __AsSharedObj(heapObj);
+    if (sharedObj && sharedObj->refs == 1)
+    {
+        // All elements replaced, exposed iterators/references invalidated, become shareable again.
+        *heapObj = obj;
+        sharedObj->shareable = true;
+    }
+    else
+    {
+        _Obj *newObj = LLBC_New1(__LLBC_VariantSharedObj<_Obj>, obj);
+        ReleaseObj(heapObj);
+
+        heapObj = newObj;
+    }
+}
+
+template <typename _Obj>
+static void AssignObj(_Obj *&heapObj, const _Obj *rObj)
+{
+    if (rObj == NULL || rObj->empty())
+    {
+        ReleaseObj(heapObj);
+        return;
+    }
+
+    __LLBC_VariantSharedObj<_Obj> *rSharedObj = __AsSharedObj(rObj);
+    if (!rSharedObj->shareable)
+    {
+        // Mutable iterators/references exposed, deep copy.
+        SetObj(heapObj, *rObj);
+        return;
+    }
+
+    if (heapObj == rObj)
+        return;
+
+    LLBC_NS LLBC_AtomicFetchAndAdd(&rSharedObj->refs, 1);
+    ReleaseObj(heapObj);
+
+    heapObj = rSharedObj;
+}
+
+template <typename _Obj>
+static _Obj *DetachObj(_Obj *&heapObj, bool alloc, bool exposed)
+{
+    if (heapObj == NULL)
+    {
+        if (!alloc)
+            return NULL;
+
+        heapObj = LLBC_New0(__LLBC_VariantSharedObj<_Obj>);
+    }
+    else if (__AsSharedObj(heapObj)->refs != 1)
+    {
+        _Obj *newObj = LLBC_New1(__LLBC_VariantSharedObj<_Obj>, *heapObj);
+        ReleaseObj(heapObj);
+
+        heapObj = newObj;
+    }
+
+    if (exposed)
+        __AsSharedObj(heapObj)->shareable = false;
+
+    return heapObj;
+}
+
+template <typename _Dict>
+static void DictValueToString(const _Dict *dict, LLBC_NS LLBC_String &content)
 {
-    if (!var.IsDict())
-        var.BecomeDict();
-    if (!holder.obj.dict)
-        holder.obj.dict = LLBC_New0(Dict);
+    content.append("{");
+    if (dict)
+    {
+        for (typename _Dict::const_iterator it = dict->begin();
+             it != dict->end();
+             )
+        {
+            content.append(it->first.ValueToString());
+            content.append(":");
+            content.append(it->second.ValueToString());
+
+            if (++it != dict->end())
+                content.append("|");
+        }
+    }
+
+    content.append("}");
+}
+
+static inline size_t HashMix(size_t hash, LLBC_NS uint64 val)
+{
+    val *= 0x9E3779B97F4A7C15ULL;
+    val ^= (val >> 32);
+
+    return hash ^ (static_cast<size_t>(val) + 0x9E3779B9 + (hash << 6) + (hash >> 2));
 }
 
 __LLBC_INTERNAL_NS_END
@@ -92,6 +282,9 @@ void LLBC_VariantType::InitType2StrDict()
         _typeDescs.insert(std::make_pair(VT_STR_DFT, "string"));
 
         _typeDescs.insert(std::make_pair(VT_DICT_DFT, "dictionary"));
+        _typeDescs.insert(std::make_pair(VT_DICT_HASH, "hash dictionary"));
+
+        _typeDescs.insert(std::make_pair(VT_SEQ_DFT, "sequence"));
 
         _typeDescs.insert(std::make_pair(VT_NIL, "Nil"));
     }
@@ -113,14 +306,32 @@ LLBC_Variant::Holder::Holder()
 {
     raw.uint64Val = 0;
     obj.str = NULL;
+    inlStr[0] = '\0';
 }
 
 LLBC_Variant::Holder::~Holder()
 {
-    if (type == LLBC_VariantType::VT_STR_DFT)
-        LLBC_XDelete(obj.str);
-    else if (type == LLBC_VariantType::VT_DICT_DFT)
-        LLBC_XDelete(obj.dict);
+    switch (type)
+    {
+    case LLBC_VariantType::VT_STR_DFT:
+        LLBC_INL_NS ReleaseStr(obj.str);
+        break;
+
+    case LLBC_VariantType::VT_DICT_DFT:
+        LLBC_INL_NS ReleaseObj(obj.dict);
+        break;
+
+    case LLBC_VariantType::VT_DICT_HASH:
+        LLBC_INL_NS ReleaseObj(obj.hashDict);
+        break;
+
+    case LLBC_VariantType::VT_SEQ_DFT:
+        LLBC_INL_NS ReleaseObj(obj.seq);
+        break;
+
+    default:
+        break;
+    }
 }
 
 LLBC_Variant::LLBC_Variant(const char *cstrVal)
@@ -130,7 +341,7 @@ LLBC_Variant::LLBC_Variant(const char *cstrVal)
     {
         size_t strLen = LLBC_StrLenA(cstrVal);
         if (strLen != 0)
-            _holder.obj.str = LLBC_New2(LLBC_String, cstrVal, strLen);
+            SetStr(cstrVal, strLen);
     }
 }
 
@@ -145,17 +356,17 @@ bool LLBC_Variant::AsBool() const
     {
         return false;
     }
-    else if (IsDict())
+    else if (IsDict() || IsHashDict() || IsSeq())
     {
         return false;
     }
     else if (IsStr())
     {
-        const Str *str= _holder.obj.str;
-        if (!str || str->empty())
+        const size_t strSize = GetStrSize();
+        if (strSize == 0)
             return false;
 
-        const Str trimedData = str->strip();
+        const Str trimedData = Str(GetStrData(), strSize).strip();
         if (trimedData.size() == 4 && trimedData.isalpha())
             return trimedData.tolower() == LLBC_INL_NS __g_trueStr;
         else
@@ -169,10 +380,10 @@ sint64 LLBC_Variant::AsInt64() const
 {
     if (IsNil())
         return 0;
-    else if (IsDict())
+    else if (IsDict() || IsHashDict() || IsSeq())
         return 0;
     else if (IsStr())
-        return (_holder.obj.str && !_holder.obj.str->empty()) ? LLBC_Str2Int64(_holder.obj.str->c_str()) : 0;
+        return GetStrSize() != 0 ? LLBC_Str2Int64(GetStrData()) : 0;
 
     if (IsDouble() || IsFloat())
         return static_cast<sint64>(_holder.raw.doubleVal);
@@ -184,10 +395,10 @@ uint64 LLBC_Variant::AsUInt64() const
 {
     if (IsNil())
         return 0;
-    else if (IsDict())
+    else if (IsDict() || IsHashDict() || IsSeq())
         return 0;
     else if (IsStr())
-        return (_holder.obj.str && !_holder.obj.str->empty()) ? LLBC_Str2UInt64(_holder.obj.str->c_str()) : 0;
+        return GetStrSize() != 0 ? LLBC_Str2UInt64(GetStrData()) : 0;
 
     if (IsDouble() || IsFloat())
         return static_cast<uint64>(_holder.raw.doubleVal);
@@ -199,10 +410,10 @@ double LLBC_Variant::AsDouble() const
 {
     if (IsNil())
         return 0.0;
-    else if (IsDict())
+    else if (IsDict() || IsHashDict() || IsSeq())
         return 0.0;
     else if (IsStr())
-        return (_holder.obj.str && !_holder.obj.str->empty()) ? LLBC_Str2Double(_holder.obj.str->c_str()) : 0;
+        return GetStrSize() != 0 ? LLBC_Str2Double(GetStrData()) : 0;
 
     if (IsDouble() || IsFloat())
         return _holder.raw.doubleVal;
@@ -232,7 +443,7 @@ LLBC_String LLBC_Variant::AsStr() const
     }
     else if (IsStr())
     {
-        return _holder.obj.str ? *_holder.obj.str : LLBC_INL_NS __g_nullStr;
+        return _holder.obj.str ? *_holder.obj.str : Str(_holder.inlStr, static_cast<size_t>(_holder.raw.uint64Val));
     }
     else
     {
@@ -248,68 +459,100 @@ const Dict &LLBC_Variant::AsDict() const
     return LLBC_INL_NS __g_nullDict;
 }
 
+const HashDict &LLBC_Variant::AsHashDict() const
+{
+    if (IsHashDict() && _holder.obj.hashDict)
+        return *_holder.obj.hashDict;
+
+    return LLBC_INL_NS __g_nullHashDict;
+}
+
+const Seq &LLBC_Variant::AsSeq() const
+{
+    if (IsSeq() && _holder.obj.seq)
+        return *_holder.obj.seq;
+
+    return LLBC_INL_NS __g_nullSeq;
+}
+
 DictIter LLBC_Variant::Begin()
 {
     if (IsDict() && _holder.obj.dict)
-        return _holder.obj.dict->begin();
-    else
-        return const_cast<Dict &>(LLBC_INL_NS __g_nullDict).begin();
+        return DetachDict(false, true)->begin();
+
+    if (IsHashDict())
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+    return const_cast<Dict &>(LLBC_INL_NS __g_nullDict).begin();
 }
 
 DictConstIter LLBC_Variant::Begin() const
 {
     if (IsDict() && _holder.obj.dict)
         return _holder.obj.dict->begin();
-    else
-        return LLBC_INL_NS __g_nullDict.begin();
+
+    if (IsHashDict())
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+    return LLBC_INL_NS __g_nullDict.begin();
 }
 
 DictIter LLBC_Variant::End()
 {
     if (IsDict() && _holder.obj.dict)
-        return _holder.obj.dict->end();
-    else
-        return const_cast<Dict &>(LLBC_INL_NS __g_nullDict).end();
+        return DetachDict(false, true)->end();
+
+    if (IsHashDict())
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+    return const_cast<Dict &>(LLBC_INL_NS __g_nullDict).end();
 }
 
 DictConstIter LLBC_Variant::End() const
 {
     if (IsDict() && _holder.obj.dict)
         return _holder.obj.dict->end();
-    else
-        return LLBC_INL_NS __g_nullDict.end();
+
+    if (IsHashDict())
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+    return LLBC_INL_NS __g_nullDict.end();
 }
 
 DictReverseIter LLBC_Variant::ReverseBegin()
 {
     if (IsDict() && _holder.obj.dict)
-        return _holder.obj.dict->rbegin();
-    else
-        return const_cast<Dict &>(LLBC_INL_NS __g_nullDict).rbegin();
+        return DetachDict(false, true)->rbegin();
+
+    if (IsHashDict())
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+    return const_cast<Dict &>(LLBC_INL_NS __g_nullDict).rbegin();
 }
 
 DictConstReverseIter LLBC_Variant::ReverseBegin() const
 {
     if (IsDict() && _holder.obj.dict)
         return _holder.obj.dict->rbegin();
-    else
-        return LLBC_INL_NS __g_nullDict.rbegin();
+
+    if (IsHashDict())
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+    return LLBC_INL_NS __g_nullDict.rbegin();
 }
 
 DictReverseIter LLBC_Variant::ReverseEnd()
 {
     if (IsDict() && _holder.obj.dict)
-        return _holder.obj.dict->rend();
-    else
-        return const_cast<Dict &>(LLBC_INL_NS __g_nullDict).rend();
+        return DetachDict(false, true)->rend();
+
+    if (IsHashDict())
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+    return const_cast<Dict &>(LLBC_INL_NS __g_nullDict).rend();
 }
 
 DictConstReverseIter LLBC_Variant::ReverseEnd() const
 {
     if (IsDict() && _holder.obj.dict)
         return _holder.obj.dict->rend();
-    else
-        return LLBC_INL_NS __g_nullDict.rend();
+
+    if (IsHashDict())
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+    return LLBC_INL_NS __g_nullDict.rend();
 }
 
 std::pair<DictIter, bool> LLBC_Variant::Insert(const Dict::key_type &key, const Dict::mapped_type &val)
@@ -319,36 +562,53 @@ std::pair<DictIter, bool> LLBC_Variant::Insert(const Dict::key_type &key, const
 
 std::pair<DictIter, bool> LLBC_Variant::Insert(const Dict::value_type &val)
 {
-    LLBC_INL_NS BecomeAndAllocDict(*this, _holder);
-    return _holder.obj.dict->insert(val);
+    // Don't silently discard hash dictionary/sequence.
+    if (IsHashDict() || IsSeq())
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+        return std::make_pair(const_cast<Dict &>(LLBC_INL_NS __g_nullDict).end(), false);
+    }
+
+    if (!IsDict())
+        BecomeDict();
+
+    return DetachDict(true, true)->insert(val);
 }
 
 DictIter LLBC_Variant::Find(const Dict::key_type &key)
 {
     if (IsDict() && _holder.obj.dict)
-        return _holder.obj.dict->find(key);
-    else
-        return const_cast<Dict &>(LLBC_INL_NS __g_nullDict).end();
+        return DetachDict(false, true)->find(key);
+
+    if (IsHashDict())
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+    return const_cast<Dict &>(LLBC_INL_NS __g_nullDict).end();
 }
 
 DictConstIter LLBC_Variant::Find(const Dict::key_type &key) const
 {
     if (IsDict() && _holder.obj.dict)
         return _holder.obj.dict->find(key);
-    else
-        return LLBC_INL_NS __g_nullDict.end();
+
+    if (IsHashDict())
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+    return LLBC_INL_NS __g_nullDict.end();
 }
 
 void LLBC_Variant::Erase(DictIter it)
 {
     if (IsDict() && _holder.obj.dict)
-        _holder.obj.dict->erase(it);
+        DetachDict(false, false)->erase(it);
+    else if (IsHashDict())
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
 }
 
 Dict::size_type LLBC_Variant::Erase(const Dict::key_type &key)
 {
     if (IsDict() && _holder.obj.dict)
-        return _holder.obj.dict->erase(key);
+        return DetachDict(false, false)->erase(key);
+    else if (IsHashDict() && _holder.obj.hashDict)
+        return DetachHashDict(false, false)->erase(key);
     else
         return 0;
 }
@@ -356,13 +616,51 @@ Dict::size_type LLBC_Variant::Erase(const Dict::key_type &key)
 void LLBC_Variant::Erase(DictIter first, DictIter last)
 {
     if (IsDict() && _holder.obj.dict)
-        _holder.obj.dict->erase(first, last);
+        DetachDict(false, false)->erase(first, last);
+    else if (IsHashDict())
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
 }
 
 Dict::mapped_type &LLBC_Variant::operator [](const LLBC_Variant &key)
 {
-    LLBC_INL_NS BecomeAndAllocDict(*this, _holder);
-    return (*_holder.obj.dict)[key];
+    if (IsSeq())
+    {
+        // Negative index count from back, index equal to size append a nil element.
+        Seq *seq = DetachSeq(true, true);
+        const sint64 size = static_cast<sint64>(seq->size());
+        sint64 idx = key.AsInt64();
+        if (idx < 0)
+            idx += size;
+
+        if (idx == size)
+        {
+            seq->push_back(LLBC_INL_NS __g_nilVariant);
+        }
+        else if (idx < 0 || idx > size)
+        {
+            // Out of range, don't grow/shift sequence, return discarded element.
+            LLBC_SetLastError(LLBC_ERROR_RANGE);
+
+            LLBC_Variant *&discarded = LLBC_INL_NS __g_discardedSeqElem;
+            if (!discarded)
+                discarded = LLBC_New(LLBC_Variant);
+            else
+                discarded->BecomeNil();
+
+            return *discarded;
+        }
+
+        return (*seq)[static_cast<size_t>(idx)];
+    }
+    else if (IsHashDict())
+    {
+        return (*DetachHashDict(true, true))[key];
+    }
+
+    if (!IsDict())
+        BecomeDict();
+
+    return (*DetachDict(true, true))[key];
 }
 
 const Dict::mapped_type &LLBC_Variant::operator [](const LLBC_Variant &key) const
@@ -375,10 +673,84 @@ const Dict::mapped_type &LLBC_Variant::operator [](const LLBC_Variant &key) cons
         else
             return it->second;
     }
+    else if (IsHashDict() && _holder.obj.hashDict)
+    {
+        HashDict::const_iterator it = _holder.obj.hashDict->find(key);
+        if (it == _holder.obj.hashDict->end())
+            return LLBC_INL_NS __g_nilVariant;
+        else
+            return it->second;
+    }
+    else if (IsSeq() && _holder.obj.seq)
+    {
+        const sint64 size = static_cast<sint64>(_holder.obj.seq->size());
+        sint64 idx = key.AsInt64();
+        if (idx < 0)
+            idx += size;
+
+        if (idx < 0 || idx >= size)
+            return LLBC_INL_NS __g_nilVariant;
+        else
+            return (*_holder.obj.seq)[static_cast<size_t>(idx)];
+    }
 
     return LLBC_INL_NS __g_nilVariant;
 }
 
+SeqIter LLBC_Variant::SeqBegin()
+{
+    if (IsSeq() && _holder.obj.seq)
+        return DetachSeq(false, true)->begin();
+    else
+        return const_cast<Seq &>(LLBC_INL_NS __g_nullSeq).begin();
+}
+
+SeqConstIter LLBC_Variant::SeqBegin() const
+{
+    if (IsSeq() && _holder.obj.seq)
+        return _holder.obj.seq->begin();
+    else
+        return LLBC_INL_NS __g_nullSeq.begin();
+}
+
+SeqIter LLBC_Variant::SeqEnd()
+{
+    if (IsSeq() && _holder.obj.seq)
+        return DetachSeq(false, true)->end();
+    else
+        return const_cast<Seq &>(LLBC_INL_NS __g_nullSeq).end();
+}
+
+SeqConstIter LLBC_Variant::SeqEnd() const
+{
+    if (IsSeq() && _holder.obj.seq)
+        return _holder.obj.seq->end();
+    else
+        return LLBC_INL_NS __g_nullSeq.end();
+}
+
+void LLBC_Variant::SeqPushBack(const Seq::value_type &val)
+{
+    // Don't silently discard dictionary/hash dictionary.
+    if (IsDict() || IsHashDict())
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+        return;
+    }
+
+    if (!IsSeq())
+        BecomeSeq();
+
+    // If value is the element of this shared sequence, it still hold by other variants after detached.
+    DetachSeq(true, false)->push_back(val);
+}
+
+void LLBC_Variant::SeqPopBack()
+{
+    if (IsSeq() && _holder.obj.seq && !_holder.obj.seq->empty())
+        DetachSeq(false, false)->pop_back();
+}
+
 LLBC_Variant &LLBC_Variant::operator =(sint8 val)
 {
     CleanTypeData(_holder.type);
@@ -507,18 +879,7 @@ LLBC_Variant &LLBC_Variant::operator =(const LLBC_String &val)
         _holder.type = LLBC_VariantType::VT_STR_DFT;
     }
 
-    if (val.empty())
-    {
-        if (_holder.obj.str)
-            _holder.obj.str->clear();
-    }
-    else
-    {
-        if (_holder.obj.str)
-            *_holder.obj.str = val;
-        else
-            _holder.obj.str = LLBC_New1(LLBC_String, val);
-    }
+    SetStr(val.data(), val.size());
 
     return *this;
 }
@@ -531,19 +892,34 @@ LLBC_Variant &LLBC_Variant::operator =(const Dict &val)
         _holder.type = LLBC_VariantType::VT_DICT_DFT;
     }
 
-    if (val.empty())
+    SetDict(val);
+
+    return *this;
+}
+
+LLBC_Variant &LLBC_Variant::operator =(const HashDict &val)
+{
+    if (!IsHashDict())
     {
-        if (_holder.obj.dict)
-            _holder.obj.dict->clear();
+        CleanTypeData(_holder.type);
+        _holder.type = LLBC_VariantType::VT_DICT_HASH;
     }
-    else
+
+    SetHashDict(val);
+
+    return *this;
+}
+
+LLBC_Variant &LLBC_Variant::operator =(const Seq &val)
+{
+    if (!IsSeq())
     {
-        if (_holder.obj.dict)
-            *_holder.obj.dict = val;
-        else
-            _holder.obj.dict = LLBC_New1(Dict, val);
+        CleanTypeData(_holder.type);
+        _holder.type = LLBC_VariantType::VT_SEQ_DFT;
     }
 
+    SetSeq(val);
+
     return *this;
 }
 
@@ -636,30 +1012,40 @@ LLBC_String LLBC_Variant::ValueToString() const
 {
     if (IsStr())
     {
-        return _holder.obj.str ? *_holder.obj.str : LLBC_INL_NS __g_nullStr;
+        return AsStr();
     }
     else if (IsDict())
     {
+        LLBC_String content;
+        LLBC_INL_NS DictValueToString(_holder.obj.dict, content);
 
+        return content;
+    }
+    else if (IsHashDict())
+    {
         LLBC_String content;
-        content.append("{");
+        LLBC_INL_NS DictValueToString(_holder.obj.hashDict, content);
 
-        if (_holder.obj.dict)
+        return content;
+    }
+    else if (IsSeq())
+    {
+        LLBC_String content;
+        content.append("[");
+
+        if (_holder.obj.seq)
         {
-            for (DictConstIter it = _holder.obj.dict->begin();
-                 it != _holder.obj.dict->end();
+            for (SeqConstIter it = _holder.obj.seq->begin();
+                 it != _holder.obj.seq->end();
                  )
             {
-                content.append(it->first.ValueToString());
-                content.append(":");
-                content.append(it->second.ValueToString());
-
-                if (++it != _holder.obj.dict->end())
+                content.append(it->ValueToString());
+                if (++it != _holder.obj.seq->end())
                     content.append("|");
             }
         }
 
-        content.append("}");
+        content.append("]");
         return content;
     }
     else if (IsNil())
@@ -712,6 +1098,12 @@ LLBC_String LLBC_Variant::ToString() const
 
 void LLBC_Variant::Serialize(LLBC_Stream &stream) const
 {
+    if (stream.IsCompact())
+    {
+        SerializeCompact(stream);
+        return;
+    }
+
     stream.Write(_holder.type);
 
     if (IsRaw())
@@ -720,7 +1112,10 @@ void LLBC_Variant::Serialize(LLBC_Stream &stream) const
     }
     else if (IsStr())
     {
-        stream.WriteEx(_holder.obj.str ? *_holder.obj.str : LLBC_INL_NS __g_nullStr);
+        // Same as LLBC_String::SerializeEx(), but no need to construct string object.
+        const size_t strSize = GetStrSize();
+        stream.WriteEx(static_cast<uint32>(strSize));
+        stream.WriteBuffer(GetStrData(), strSize);
     }
     else if (IsDict())
     {
@@ -740,20 +1135,64 @@ void LLBC_Variant::Serialize(LLBC_Stream &stream) const
             }
         }
     }
+    else if (IsHashDict())
+    {
+        if (!_holder.obj.hashDict)
+        {
+            stream.Write(static_cast<uint32>(0));
+        }
+        else
+        {
+            stream.Write(static_cast<uint32>(_holder.obj.hashDict->size()));
+            for (HashDict::const_iterator it = _holder.obj.hashDict->begin();
+                 it != _holder.obj.hashDict->end();
+                 it++)
+            {
+                stream.Write(it->first);
+                stream.Write(it->second);
+            }
+        }
+    }
+    else if (IsSeq())
+    {
+        if (!_holder.obj.seq)
+        {
+            stream.Write(static_cast<uint32>(0));
+        }
+        else
+        {
+            stream.Write(static_cast<uint32>(_holder.obj.seq->size()));
+            for (SeqConstIter it = _holder.obj.seq->begin();
+                 it != _holder.obj.seq->end();
+                 it++)
+                stream.Write(*it);
+        }
+    }
 }
 
 bool LLBC_Variant::DeSerialize(LLBC_Stream &stream)
 {
     BecomeNil();
 
-    if (!stream.Read(_holder.type))
-        return false;
+    if (stream.IsCompact())
+    {
+        if (!DeSerializeCompactHead(stream))
+            return false;
+    }
+    else
+    {
+        if (!stream.Read(_holder.type))
+            return false;
+    }
 
     if (IsNil())
         return true;
 
     if (IsRaw())
     {
+        if (stream.IsCompact())
+            return true;
+
         if (!stream.Read(_holder.raw.uint64Val))
         {
             _holder.type = LLBC_VariantType::VT_NIL;
@@ -764,12 +1203,31 @@ bool LLBC_Variant::DeSerialize(LLBC_Stream &stream)
     }
     else if (IsStr())
     {
-        if (!_holder.obj.str)
-            _holder.obj.str = LLBC_New0(LLBC_String);
+        // Same as LLBC_String::DeSerializeEx(), short string read into inline storage directly.
+        uint32 strSize = 0;
+        if (!stream.ReadEx(strSize))
+        {
+            _holder.type = LLBC_VariantType::VT_NIL;
+            return false;
+        }
+
+        bool readRet;
+        if (strSize < sizeof(_holder.inlStr))
+        {
+            readRet = stream.ReadBuffer(_holder.inlStr, strSize);
+            _holder.inlStr[readRet ? strSize : 0] = '\0';
+            _holder.raw.uint64Val = readRet ? strSize : 0;
+        }
+        else
+        {
+            _holder.obj.str = LLBC_New2(LLBC_INL_NS __LLBC_VariantSharedStr, "", 0);
+            _holder.obj.str->resize(strSize);
+            readRet = stream.ReadBuffer(const_cast<char *>(_holder.obj.str->data()), strSize);
+        }
 
-        if (!stream.ReadEx(*_holder.obj.str))
+        if (!readRet)
         {
-            LLBC_XDelete(_holder.obj.str);
+            CleanStrData();
             _holder.type = LLBC_VariantType::VT_NIL;
 
             return false;
@@ -777,7 +1235,7 @@ bool LLBC_Variant::DeSerialize(LLBC_Stream &stream)
 
         return true;
     }
-    else if (IsDict())
+    else if (IsDict() || IsHashDict() || IsSeq())
     {
         uint32 count = 0;
         if (!stream.Read(count))
@@ -789,27 +1247,138 @@ bool LLBC_Variant::DeSerialize(LLBC_Stream &stream)
         if (count == 0)
             return true;
 
-        _holder.obj.dict = LLBC_New0(Dict);
-        for (uint32 i = 0; i < count; ++i)
+        bool readRet = true;
+        if (IsSeq())
+        {
+            // Not reserve by count, count maybe damaged.
+            Seq *seq = DetachSeq(true, false);
+            for (uint32 i = 0; i < count && readRet; ++i)
+            {
+                seq->push_back(LLBC_INL_NS __g_nilVariant);
+                readRet = stream.Read(seq->back());
+            }
+        }
+        else
         {
-            LLBC_Variant key;
-            LLBC_Variant val;
-            if (!stream.Read(key) || !stream.Read(val))
+            Dict *dict = IsDict() ? DetachDict(true, false) : NULL;
+            HashDict *hashDict = IsHashDict() ? DetachHashDict(true, false) : NULL;
+            for (uint32 i = 0; i < count; ++i)
             {
-                LLBC_XDelete(_holder.obj.dict);
-                _holder.type = LLBC_VariantType::VT_NIL;
-                return false;
+                LLBC_Variant key;
+                LLBC_Variant val;
+                if (!stream.Read(key) || !stream.Read(val))
+                {
+                    readRet = false;
+                    break;
+                }
+
+                if (dict)
+                    dict->insert(std::make_pair(key, val));
+                else
+                    hashDict->insert(std::make_pair(key, val));
             }
+        }
 
-            _holder.obj.dict->insert(std::make_pair(key, val));
+        if (!readRet)
+        {
+            CleanTypeData(_holder.type);
+            _holder.type = LLBC_VariantType::VT_NIL;
+            return false;
         }
 
         return true;
     }
-    
+
+    _holder.type = LLBC_VariantType::VT_NIL;
     return false;
 }
 
+void LLBC_Variant::SerializeCompact(LLBC_Stream &stream) const
+{
+    // Compact type: rotate first type(high 8 bits) to low bits, most types only need 2 bytes varint.
+    const uint32 type = static_cast<uint32>(_holder.type);
+    stream.WriteVarUInt32((type << 8) | (type >> 24));
+
+    if (IsRaw())
+    {
+        if (IsFloat() || IsDouble())
+            stream.WriteDouble(_holder.raw.doubleVal);
+        else if (IsSignedRaw())
+            stream.WriteVarSInt64(_holder.raw.int64Val);
+        else
+            stream.WriteVarUInt64(_holder.raw.uint64Val);
+    }
+    else if (IsStr())
+    {
+        const size_t strSize = GetStrSize();
+        stream.WriteEx(static_cast<uint32>(strSize));
+        stream.WriteBuffer(GetStrData(), strSize);
+    }
+    else if (IsDict())
+    {
+        stream.WriteVarUInt32(_holder.obj.dict ? static_cast<uint32>(_holder.obj.dict->size()) : 0);
+        if (_holder.obj.dict)
+        {
+            for (DictConstIter it = _holder.obj.dict->begin();
+                 it != _holder.obj.dict->end();
+                 it++)
+            {
+                it->first.SerializeCompact(stream);
+                it->second.SerializeCompact(stream);
+            }
+        }
+    }
+    else if (IsHashDict())
+    {
+        stream.WriteVarUInt32(_holder.obj.hashDict ? static_cast<uint32>(_holder.obj.hashDict->size()) : 0);
+        if (_holder.obj.hashDict)
+        {
+            for (HashDict::const_iterator it = _holder.obj.hashDict->begin();
+                 it != _holder.obj.hashDict->end();
+                 it++)
+            {
+                it->first.SerializeCompact(stream);
+                it->second.SerializeCompact(stream);
+            }
+        }
+    }
+    else if (IsSeq())
+    {
+        stream.WriteVarUInt32(_holder.obj.seq ? static_cast<uint32>(_holder.obj.seq->size()) : 0);
+        if (_holder.obj.seq)
+        {
+            for (SeqConstIter it = _holder.obj.seq->begin();
+                 it != _holder.obj.seq->end();
+                 it++)
+                it->SerializeCompact(stream);
+        }
+    }
+}
+
+bool LLBC_Variant::DeSerializeCompactHead(LLBC_Stream &stream)
+{
+    uint32 type;
+    if (!stream.ReadVarUInt32(type))
+        return false;
+
+    _holder.type = static_cast<LLBC_VariantType::ENUM>((type >> 8) | (type << 24));
+    if (!IsRaw())
+        return true;
+
+    bool ret;
+    if (IsFloat() || IsDouble())
+        ret = stream.ReadDouble(_holder.raw.doubleVal);
+    else if (IsSignedRaw())
+        ret = stream.ReadVarSInt64(_holder.raw.int64Val);
+    else
+        ret = stream.ReadVarUInt64(_holder.raw.uint64Val);
+
+    if (!ret)
+        _holder.type = LLBC_VariantType::VT_NIL;
+
+    return ret;
+}
+
 void LLBC_Variant::SerializeEx(LLBC_Stream &stream) const
 {
     Serialize(stream);
@@ -837,12 +1406,23 @@ void LLBC_Variant::CleanRawData()
 
 void LLBC_Variant::CleanStrData()
 {
-    LLBC_XDelete(_holder.obj.str);
+    LLBC_INL_NS ReleaseStr(_holder.obj.str);
+
+    _holder.raw.uint64Val = 0;
+    _holder.inlStr[0] = '\0';
 }
 
 void LLBC_Variant::CleanDictData()
 {
-    LLBC_XDelete(_holder.obj.dict);
+    if (_holder.type == LLBC_VariantType::VT_DICT_HASH)
+        LLBC_INL_NS ReleaseObj(_holder.obj.hashDict);
+    else
+        LLBC_INL_NS ReleaseObj(_holder.obj.dict);
+}
+
+void LLBC_Variant::CleanSeqData()
+{
+    LLBC_INL_NS ReleaseObj(_holder.obj.seq);
 }
 
 void LLBC_Variant::CleanTypeData(int type)
@@ -864,6 +1444,10 @@ void LLBC_Variant::CleanTypeData(int type)
         CleanDictData();
         break;
 
+    case _Type::VT_SEQ:
+        CleanSeqData();
+        break;
+
     default:
         break;
     }
@@ -873,14 +1457,181 @@ void LLBC_Variant::OptimizePerformance()
 {
     if (IsStr())
     {
-        if (_holder.obj.str && _holder.obj.str->empty())
-            LLBC_XDelete(_holder.obj.str);
+        if (_holder.obj.str && _holder.obj.str->size() < sizeof(_holder.inlStr))
+        {
+            Str *heapStr = _holder.obj.str;
+            _holder.obj.str = NULL;
+
+            SetStr(heapStr->data(), heapStr->size());
+            LLBC_INL_NS ReleaseStr(heapStr);
+        }
     }
     else if (IsDict())
     {
         if (_holder.obj.dict && _holder.obj.dict->empty())
-            LLBC_XDelete(_holder.obj.dict);
+            LLBC_INL_NS ReleaseObj(_holder.obj.dict);
+    }
+    else if (IsHashDict())
+    {
+        if (_holder.obj.hashDict && _holder.obj.hashDict->empty())
+            LLBC_INL_NS ReleaseObj(_holder.obj.hashDict);
+    }
+    else if (IsSeq())
+    {
+        if (_holder.obj.seq && _holder.obj.seq->empty())
+            LLBC_INL_NS ReleaseObj(_holder.obj.seq);
+    }
+}
+
+void LLBC_Variant::SetStr(const char *str, size_t len)
+{
+    Str *&heapStr = _holder.obj.str;
+    if (len < sizeof(_holder.inlStr))
+    {
+        // Copy before release heap string, the source string maybe is the heap string.
+        ::memmove(_holder.inlStr, str, len);
+        _holder.inlStr[len] = '\0';
+        _holder.raw.uint64Val = len;
+
+        LLBC_INL_NS ReleaseStr(heapStr);
+
+        return;
+    }
+
+    if (heapStr && LLBC_INL_NS __AsSharedStr(heapStr)->refs == 1)
+    {
+        heapStr->assign(str, len);
+    }
+    else
+    {
+        Str *newStr = LLBC_New2(LLBC_INL_NS __LLBC_VariantSharedStr, str, len);
+        LLBC_INL_NS ReleaseStr(heapStr);
+
+        heapStr = newStr;
+    }
+
+    _holder.raw.uint64Val = 0;
+    _holder.inlStr[0] = '\0';
+}
+
+void LLBC_Variant::AssignStr(const LLBC_Variant &another)
+{
+    const Holder &rHolder = another._holder;
+    if (rHolder.obj.str == NULL)
+    {
+        // Inline string, copy whole inline storage directly.
+        LLBC_INL_NS ReleaseStr(_holder.obj.str);
+
+        ::memcpy(_holder.inlStr, rHolder.inlStr, sizeof(_holder.inlStr));
+        _holder.raw.uint64Val = rHolder.raw.uint64Val;
+
+        return;
     }
+
+    if (_holder.obj.str == rHolder.obj.str)
+        return;
+
+    LLBC_AtomicFetchAndAdd(&LLBC_INL_NS __AsSharedStr(rHolder.obj.str)->refs, 1);
+    LLBC_INL_NS ReleaseStr(_holder.obj.str);
+
+    _holder.obj.str = rHolder.obj.str;
+    _holder.raw.uint64Val = 0;
+    _holder.inlStr[0] = '\0';
+}
+
+void LLBC_Variant::SetDict(const Dict &dict)
+{
+    LLBC_INL_NS SetObj(_holder.obj.dict, dict);
+}
+
+void LLBC_Variant::AssignDict(const LLBC_Variant &another)
+{
+    LLBC_INL_NS AssignObj(_holder.obj.dict, another._holder.obj.dict);
+}
+
+Dict *LLBC_Variant::DetachDict(bool alloc, bool exposed)
+{
+    return LLBC_INL_NS DetachObj(_holder.obj.dict, alloc, exposed);
+}
+
+void LLBC_Variant::SetHashDict(const HashDict &hashDict)
+{
+    LLBC_INL_NS SetObj(_holder.obj.hashDict, hashDict);
+}
+
+void LLBC_Variant::AssignHashDict(const LLBC_Variant &another)
+{
+    LLBC_INL_NS AssignObj(_holder.obj.hashDict, another._holder.obj.hashDict);
+}
+
+HashDict *LLBC_Variant::DetachHashDict(bool alloc, bool exposed)
+{
+    return LLBC_INL_NS DetachObj(_holder.obj.hashDict, alloc, exposed);
+}
+
+void LLBC_Variant::SetSeq(const Seq &seq)
+{
+    LLBC_INL_NS SetObj(_holder.obj.seq, seq);
+}
+
+void LLBC_Variant::AssignSeq(const LLBC_Variant &another)
+{
+    LLBC_INL_NS AssignObj(_holder.obj.seq, another._holder.obj.seq);
+}
+
+Seq *LLBC_Variant::DetachSeq(bool alloc, bool exposed)
+{
+    return LLBC_INL_NS DetachObj(_holder.obj.seq, alloc, exposed);
+}
+
+size_t LLBC_VariantHash::operator()(const LLBC_Variant &var) const
+{
+    if (var.IsRaw())
+    {
+        // Raw variants equal by value(eg: int32 1 == double 1.0), integral float/double hash as integer.
+        uint64 val = var.GetHolder().raw.uint64Val;
+        if (var.IsFloat() || var.IsDouble())
+        {
+            const double dblVal = var.GetHolder().raw.doubleVal;
+            if (dblVal >= -9223372036854775808.0 && dblVal < 9223372036854775808.0 &&
+                static_cast<double>(static_cast<sint64>(dblVal)) == dblVal)
+                val = static_cast<uint64>(static_cast<sint64>(dblVal));
+            else if (dblVal >= 0.0 && dblVal < 18446744073709551616.0 &&
+                static_cast<double>(static_cast<uint64>(dblVal)) == dblVal)
+                val = static_cast<uint64>(dblVal);
+        }
+
+        return LLBC_INL_NS HashMix(0, val);
+    }
+    else if (var.IsStr())
+    {
+        // FNV-1a.
+        uint64 hash = 0xcbf29ce484222325ULL;
+        const uint8 *data = reinterpret_cast<const uint8 *>(var.GetStrData());
+        for (size_t i = 0, size = var.GetStrSize(); i < size; ++i)
+            hash = (hash ^ data[i]) * 0x100000001b3ULL;
+
+        return static_cast<size_t>(hash);
+    }
+    else if (var.IsDict())
+    {
+        return LLBC_INL_NS HashMix(var.GetType(), var.AsDict().size());
+    }
+    else if (var.IsHashDict())
+    {
+        return LLBC_INL_NS HashMix(var.GetType(), var.AsHashDict().size());
+    }
+    else if (var.IsSeq())
+    {
+        size_t hash = var.GetType();
+        const Seq &seq = var.AsSeq();
+        for (SeqConstIter it = seq.begin(); it != seq.end(); ++it)
+            hash = LLBC_INL_NS HashMix(hash, (*this)(*it));
+
+        return hash;
+    }
+
+    return 0;
 }
 
 __LLBC_NS_END
@@ -28,81 +28,120 @@
 #include "llbc/core/variant/VariantArithmetic.h"
 #include "llbc/core/variant/VariantTraits.h"
 
-__LLBC_NS_BEGIN
+__LLBC_INTERNAL_NS_BEGIN
 
-void LLBC_VariantTraits::assign(LLBC_Variant &left, const LLBC_Variant &right)
+static inline bool __IsDictLike(const LLBC_NS LLBC_Variant &var)
 {
-    if (&left == &right)
-        return;
+    return var.IsDict() || var.IsHashDict();
+}
 
-    // Execute assignment.
-    if (right.IsNil())// Do NIL type data assignment.
-    {
-        left.BecomeNil();
-    }
-    else if (right.IsRaw()) // Do RAW type data assignment.
-    {
-        // If left type is STR/DICT type, clean first.
-        if (left.IsStr())
-            left.CleanStrData();
-        else if (left.IsDict())
-            left.CleanDictData();
+static inline size_t __DictSize(const LLBC_NS LLBC_Variant &var)
+{
+    return var.IsHashDict() ? var.AsHashDict().size() : var.AsDict().size();
+}
 
-        // Assignment.
-        left.SetType(right.GetType());
-        left.GetHolder().raw.uint64Val = right.GetHolder().raw.uint64Val;
-    }
-    else if (right.IsStr()) // Do STR type data assignment.
+/**
+ * Get variant type compare rank, Dict < HashDict < Seq < Str < Raw < Nil.
+ */
+static inline int __CompareRank(const LLBC_NS LLBC_Variant &var)
+{
+    if (var.IsDict())
+        return 0;
+    else if (var.IsHashDict())
+        return 1;
+    else if (var.IsSeq())
+        return 2;
+    else if (var.IsStr())
+        return 3;
+    else if (var.IsRaw())
+        return 4;
+    else
+        return 5;
+}
+
+/**
+ * Dictionary like arithmetic, dictionary/hash dictionary can mixed.
+ *  +: union, -: difference, *: intersection, /: symmetric difference.
+ */
+template <typename _LDict, typename _RDict>
+static void __DictPerforms(_LDict *dlDict, const _LDict &clDict, const _RDict &rDict, int type)
+{
+    typedef typename _LDict::const_iterator _LIt;
+    typedef typename _RDict::const_iterator _RIt;
+
+    switch (type)
     {
-        // If left type is RAW/DICT type, clean first.
-        if (left.IsRaw())
-            left.CleanRawData();
-        else if (left.IsDict())
-            left.CleanDictData();
+    case LLBC_NS LLBC_VariantArithmetic::VT_ARITHMETIC_ADD:
+        dlDict->insert(rDict.begin(), rDict.end());
+        break;
 
-        // Assignment.
-        left.SetType(right.GetType());
-        LLBC_Variant::Holder &lHolder = left.GetHolder();
-        const LLBC_Variant::Holder &rHolder = right.GetHolder();
-        if (rHolder.obj.str == NULL || rHolder.obj.str->empty())
-        {
-            if (lHolder.obj.str)
-                lHolder.obj.str->clear();
-        }
-        else
+    case LLBC_NS LLBC_VariantArithmetic::VT_ARITHMETIC_SUB:
+        for (_RIt rIt = rDict.begin();
+             rIt != rDict.end() && !dlDict->empty();
+             rIt++)
+            dlDict->erase(rIt->first);
+        break;
+
+    case LLBC_NS LLBC_VariantArithmetic::VT_ARITHMETIC_MUL:
+        for (_LIt clIt = clDict.begin(); clIt != clDict.end(); clIt++)
         {
-            if (lHolder.obj.str == NULL)
-                lHolder.obj.str = LLBC_New1(LLBC_String, *rHolder.obj.str);
-            else if (lHolder.obj.str != rHolder.obj.str)
-                *lHolder.obj.str = *rHolder.obj.str;
+            if (rDict.find(clIt->first) == rDict.end())
+                dlDict->erase(clIt->first);
         }
-    }
-    else if (right.IsDict()) // Do DICT type data assignment.
-    {
-        // If left type is RAW/STR type, clean first.
-        if (left.IsRaw())
-            left.CleanRawData();
-        else if (left.IsStr())
-            left.CleanStrData();
+        break;
 
-        left.SetType(right.GetType());
-        LLBC_Variant::Holder &lHolder = left.GetHolder();
-        const LLBC_Variant::Holder &rHolder = right.GetHolder();
-        if (rHolder.obj.dict == NULL || rHolder.obj.dict->empty())
+    case LLBC_NS LLBC_VariantArithmetic::VT_ARITHMETIC_DIV:
+        for (_LIt clIt = clDict.begin(); clIt != clDict.end(); clIt++)
         {
-            if (lHolder.obj.dict)
-                lHolder.obj.dict->clear();
+            if (rDict.find(clIt->first) != rDict.end())
+                dlDict->erase(clIt->first);
         }
-        else
+
+        for (_RIt rIt = rDict.begin(); rIt != rDict.end(); rIt++)
         {
-            if (lHolder.obj.dict == NULL)
-                lHolder.obj.dict = LLBC_New1(LLBC_Variant::Dict, *rHolder.obj.dict);
-            else if (lHolder.obj.dict != rHolder.obj.dict)
-                *lHolder.obj.dict = *rHolder.obj.dict;
+            if (clDict.find(rIt->first) == clDict.end())
+                dlDict->insert(std::make_pair(rIt->first, rIt->second));
         }
+        break;
+
+    default:
+        break;
     }
 }
 
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+void LLBC_VariantTraits::assign(LLBC_Variant &left, const LLBC_Variant &right)
+{
+    if (&left == &right)
+        return;
+
+    // Execute assignment.
+    if (right.IsNil())// Do NIL type data assignment.
+    {
+        left.BecomeNil();
+        return;
+    }
+
+    // If left type is different type(except RAW types), clean first.
+    if (left.GetType() != right.GetType() && !(left.IsRaw() && right.IsRaw()))
+        left.CleanTypeData(left.GetType());
+
+    left.SetType(right.GetType());
+    if (right.IsRaw()) // Do RAW type data assignment.
+        left.GetHolder().raw.uint64Val = right.GetHolder().raw.uint64Val;
+    else if (right.IsStr()) // Do STR type data assignment(inline string copy or shared string add reference).
+        left.AssignStr(right);
+    else if (right.IsDict()) // Do DICT/HASH_DICT/SEQ type data assignment(shared object add reference, or deep copy if unshareable).
+        left.AssignDict(right);
+    else if (right.IsHashDict())
+        left.AssignHashDict(right);
+    else if (right.IsSeq())
+        left.AssignSeq(right);
+}
+
 bool LLBC_VariantTraits::eq(const LLBC_Variant &left, const LLBC_Variant &right)
 {
     const LLBC_Variant::Holder &lHolder = left.GetHolder();
@@ -112,20 +151,12 @@ bool LLBC_VariantTraits::eq(const LLBC_Variant &left, const LLBC_Variant &right)
         if (!right.IsStr())
             return false;
 
-        if (lHolder.obj.str)
-        {
-            if (rHolder.obj.str)
-                return *lHolder.obj.str == *rHolder.obj.str;
-            else
-                return lHolder.obj.str->empty();
-        }
-        else
-        {
-            if (rHolder.obj.str)
-                return rHolder.obj.str->empty();
-            else
-                return true;
-        }
+        if (lHolder.obj.str && lHolder.obj.str == rHolder.obj.str)
+            return true;
+
+        const size_t lSize = left.GetStrSize();
+        return lSize == right.GetStrSize() &&
+            ::memcmp(left.GetStrData(), right.GetStrData(), lSize) == 0;
     }
     else if (left.IsDict())
     {
@@ -137,7 +168,7 @@ bool LLBC_VariantTraits::eq(const LLBC_Variant &left, const LLBC_Variant &right)
         if (lDict)
         {
             if (rDict)
-                return *lDict == *rDict;
+                return lDict == rDict || *lDict == *rDict;
             else
                 return lDict->empty();
         }
@@ -149,6 +180,38 @@ bool LLBC_VariantTraits::eq(const LLBC_Variant &left, const LLBC_Variant &right)
                 return true;
         }
     }
+    else if (left.IsHashDict())
+    {
+        if (!right.IsHashDict())
+            return false;
+
+        if (lHolder.obj.hashDict == rHolder.obj.hashDict)
+            return true;
+
+        const LLBC_Variant::HashDict &lDict = left.AsHashDict();
+        const LLBC_Variant::HashDict &rDict = right.AsHashDict();
+        if (lDict.size() != rDict.size())
+            return false;
+
+        for (LLBC_Variant::HashDict::const_iterator lIt = lDict.begin();
+             lIt != lDict.end();
+             lIt++)
+        {
+            LLBC_Variant::HashDict::const_iterator rIt = rDict.find(lIt->first);
+            if (rIt == rDict.end() || rIt->second != lIt->second)
+                return false;
+        }
+
+        return true;
+    }
+    else if (left.IsSeq())
+    {
+        if (!right.IsSeq())
+            return false;
+
+        return lHolder.obj.seq == rHolder.obj.seq ||
+            left.AsSeq() == right.AsSeq();
+    }
     else if (left.IsRaw())
     {
         if (!right.IsRaw())
@@ -174,71 +237,67 @@ bool LLBC_VariantTraits::ne(const LLBC_Variant &left, const LLBC_Variant &right)
 
 bool LLBC_VariantTraits::lt(const LLBC_Variant &left, const LLBC_Variant &right)
 {
-    if (left.IsDict())
+    // Different types: Dict < HashDict < Seq < Str < Raw < Nil.
+    const int lRank = LLBC_INL_NS __CompareRank(left);
+    const int rRank = LLBC_INL_NS __CompareRank(right);
+    if (lRank != rRank)
+        return lRank < rRank;
+
+    if (left.IsDict()) // Dict: compare
     {
-        if (right.IsDict()) // Dict: compare
-        {
-            const LLBC_Variant::Dict *lDict = left.GetHolder().obj.dict;
-            const LLBC_Variant::Dict *rDict = right.GetHolder().obj.dict;
+        const LLBC_Variant::Dict *lDict = left.GetHolder().obj.dict;
+        const LLBC_Variant::Dict *rDict = right.GetHolder().obj.dict;
 
-            if (lDict == rDict)
-                return false;
+        if (lDict == rDict)
+            return false;
 
-            if (lDict == NULL || lDict->empty())
-                return rDict && !rDict->empty();
-            if (rDict == NULL || rDict->empty())
-                return false;
+        if (lDict == NULL || lDict->empty())
+            return rDict && !rDict->empty();
+        if (rDict == NULL || rDict->empty())
+            return false;
 
-            return *lDict < *rDict;
-        }
-        else // Str/Raw/Nil: true
-        {
-            return true;
-        }
+        return *lDict < *rDict;
     }
-    else if (left.IsStr())
+    else if (left.IsHashDict()) // HashDict: compare size, then compare as ordered dictionary
     {
-        if (right.IsDict()) // Dict: true
-        {
+        if (left.GetHolder().obj.hashDict == right.GetHolder().obj.hashDict)
             return false;
-        }
-        else if (right.IsStr()) // Str: exec compare
-        {
-            return left.AsStr() < right.AsStr();
-        }
-        else // Raw/Nil: true
-        {
-            return true;
-        }
+
+        const LLBC_Variant::HashDict &lDict = left.AsHashDict();
+        const LLBC_Variant::HashDict &rDict = right.AsHashDict();
+        if (lDict.size() != rDict.size())
+            return lDict.size() < rDict.size();
+
+        return LLBC_Variant::Dict(lDict.begin(), lDict.end()) <
+            LLBC_Variant::Dict(rDict.begin(), rDict.end());
     }
-    else if (left.IsRaw())
+    else if (left.IsSeq()) // Seq: lexicographical compare
     {
-        if (right.IsDict()) // Dict: false
-        {
-            return false;
-        }
-        else if (right.IsStr()) // Str: false
-        {
+        if (left.GetHolder().obj.seq == right.GetHolder().obj.seq)
             return false;
-        }
-        else if (right.IsRaw()) // Raw: exec compare
-        {
-            if ((left.IsDouble() || left.IsFloat()) ||
-                (right.IsDouble() || right.IsFloat()))
-                return left.AsDouble() < right.AsDouble();
 
-            if (left.IsSignedRaw() || right.IsSignedRaw())
-                return left.AsInt64() < right.AsInt64();
-            else
-                return left.AsUInt64() < right.AsUInt64();
-        }
-        else // Nil: true
-        {
-            return true;
-        }
+        return left.AsSeq() < right.AsSeq();
+    }
+    else if (left.IsStr()) // Str: exec compare
+    {
+        const size_t lSize = left.GetStrSize();
+        const size_t rSize = right.GetStrSize();
+        const int cmpRet = ::memcmp(left.GetStrData(), right.GetStrData(), MIN(lSize, rSize));
+        return cmpRet < 0 || (cmpRet == 0 && lSize < rSize);
+    }
+    else if (left.IsRaw()) // Raw: exec compare
+    {
+        if ((left.IsDouble() || left.IsFloat()) ||
+            (right.IsDouble() || right.IsFloat()))
+            return left.AsDouble() < right.AsDouble();
+
+        if (left.IsSignedRaw() || right.IsSignedRaw())
+            return left.AsInt64() < right.AsInt64();
+        else
+            return left.AsUInt64() < right.AsUInt64();
     }
 
-    // Nil < any type: false
+    // Nil < Nil: false
     return false;
 }
 
@@ -296,26 +355,30 @@ void LLBC_VariantTraits::add_equal(LLBC_Variant &left, const LLBC_Variant &right
         left.BecomeNil();
         return;
     }
-    else if (left.IsDict() || right.IsDict())
+    else if (LLBC_INL_NS __IsDictLike(left) || LLBC_INL_NS __IsDictLike(right))
     {
-        if (!left.IsDict() || !right.IsDict())
+        if (!LLBC_INL_NS __IsDictLike(left) || !LLBC_INL_NS __IsDictLike(right))
         {
             left.BecomeNil();
             return;
         }
 
-        LLBC_Variant::Dict *&lDict = left.GetHolder().obj.dict;
-        const LLBC_Variant:: Dict *rDict = right.GetHolder().obj.dict;
-        if (lDict == NULL)
-        {
-            if (rDict == NULL || rDict->empty())
-                return;
+        if (&left == &right || LLBC_INL_NS __DictSize(right) == 0)
+            return;
 
-            lDict = LLBC_New0(LLBC_Variant::Dict);
+        dict_performs(left, right, LLBC_VariantArithmetic::VT_ARITHMETIC_ADD);
+
+        return;
+    }
+    else if (left.IsSeq() || right.IsSeq())
+    {
+        if (!left.IsSeq() || !right.IsSeq())
+        {
+            left.BecomeNil();
+            return;
         }
 
-        if (rDict)
-            lDict->insert(rDict->begin(), rDict->end());
+        seq_performs(left, right, LLBC_VariantArithmetic::VT_ARITHMETIC_ADD);
 
         return;
     }
@@ -335,35 +398,38 @@ void LLBC_VariantTraits::sub_equal(LLBC_Variant &left, const LLBC_Variant &right
         left.BecomeNil();
         return;
     }
-    else if (left.IsDict() || right.IsDict())
+    else if (LLBC_INL_NS __IsDictLike(left) || LLBC_INL_NS __IsDictLike(right))
     {
-        if (!left.IsDict() || !right.IsDict())
+        if (!LLBC_INL_NS __IsDictLike(left) || !LLBC_INL_NS __IsDictLike(right))
         {
             left.BecomeNil();
             return;
         }
 
-        LLBC_Variant::Dict *&lDict = left.GetHolder().obj.dict;
-        const LLBC_Variant::Dict *rDict = right.GetHolder().obj.dict;
-        if (lDict == NULL)
+        if (&left == &right)
         {
-            if (rDict == NULL || rDict->empty())
-                return;
-
-            lDict = LLBC_New0(LLBC_Variant::Dict);
+            left.CleanDictData();
+            return;
         }
 
-        if (rDict)
+        if (LLBC_INL_NS __DictSize(left) == 0 ||
+            LLBC_INL_NS __DictSize(right) == 0)
+            return;
+
+        dict_performs(left, right, LLBC_VariantArithmetic::VT_ARITHMETIC_SUB);
+
+        return;
+    }
+    else if (left.IsSeq() || right.IsSeq())
+    {
+        if (!left.IsSeq() || !right.IsSeq())
         {
-            typedef LLBC_Variant::Dict::const_iterator _It;
-            for (_It rIt = rDict->begin(); 
-                 rIt != rDict->end() && !lDict->empty(); 
-                 rIt++)
-            {
-                lDict->erase(rIt->first);
-            }
+            left.BecomeNil();
+            return;
         }
 
+        seq_performs(left, right, LLBC_VariantArithmetic::VT_ARITHMETIC_SUB);
+
         return;
     }
     else if (left.IsStr() || right.IsStr())
@@ -382,33 +448,38 @@ void LLBC_VariantTraits::mul_equal(LLBC_Variant &left, const LLBC_Variant &right
         left.BecomeNil();
         return;
     }
-    else if (left.IsDict() || right.IsDict())
+    else if (LLBC_INL_NS __IsDictLike(left) || LLBC_INL_NS __IsDictLike(right))
     {
-        if (!left.IsDict() || !right.IsDict())
+        if (!LLBC_INL_NS __IsDictLike(left) || !LLBC_INL_NS __IsDictLike(right))
         {
             left.BecomeNil();
             return;
         }
 
-        LLBC_Variant::Dict *&lDict = left.GetHolder().obj.dict;
-        const LLBC_Variant::Dict *rDict = right.GetHolder().obj.dict;
-        if ((lDict == NULL || lDict->empty()) ||
-            (rDict == NULL || rDict->empty()))
+        if (&left == &right)
+            return;
+
+        if (LLBC_INL_NS __DictSize(left) == 0 ||
+            LLBC_INL_NS __DictSize(right) == 0)
         {
-            if (lDict)
-                lDict->clear();
+            left.CleanDictData();
             return;
         }
 
-        LLBC_Variant cLeft(left);
-        LLBC_Variant::Dict *clDict = cLeft.GetHolder().obj.dict;
-        for (LLBC_Variant::Dict::const_iterator clIt = clDict->begin();
-             clIt != clDict->end(); clIt++)
+        dict_performs(left, right, LLBC_VariantArithmetic::VT_ARITHMETIC_MUL);
+
+        return;
+    }
+    else if (left.IsSeq() || right.IsSeq())
+    {
+        if (!left.IsSeq() || !right.IsRaw())
         {
-            if (rDict->find(clIt->first) == rDict->end())
-                lDict->erase(clIt->first);
+            left.BecomeNil();
+            return;
         }
 
+        seq_performs(left, right, LLBC_VariantArithmetic::VT_ARITHMETIC_MUL);
+
         return;
     }
     else if (left.IsStr() || right.IsStr())
@@ -416,9 +487,12 @@ void LLBC_VariantTraits::mul_equal(LLBC_Variant &left, const LLBC_Variant &right
         if (left.IsStr() && right.IsRaw())
         {
             size_t rawRight = static_cast<size_t>(right.AsUInt32());
-            LLBC_Variant::Str *&lStr = left.GetHolder().obj.str;
-            if (lStr && !lStr->empty())
-                *lStr *= rawRight;
+            if (left.GetStrSize() != 0)
+            {
+                LLBC_Variant::Str lStr = left.AsStr();
+                lStr *= rawRight;
+                left = lStr;
+            }
         }
         else
         {
@@ -437,46 +511,28 @@ void LLBC_VariantTraits::div_equal(LLBC_Variant &left, const LLBC_Variant &right
         left.BecomeNil();
         return;
     }
-    else if (left.IsDict() || right.IsDict())
+    else if (LLBC_INL_NS __IsDictLike(left) || LLBC_INL_NS __IsDictLike(right))
     {
-        if (!left.IsDict() || !right.IsDict())
+        if (!LLBC_INL_NS __IsDictLike(left) || !LLBC_INL_NS __IsDictLike(right))
         {
             left.BecomeNil();
             return;
         }
 
-        LLBC_Variant::Dict *&lDict = left.GetHolder().obj.dict;
-        const LLBC_Variant::Dict *rDict = right.GetHolder().obj.dict;
-        if ((!lDict || lDict->empty()) ||
-            (!rDict || rDict->empty()))
+        if (&left == &right ||
+            LLBC_INL_NS __DictSize(left) == 0 ||
+            LLBC_INL_NS __DictSize(right) == 0)
         {
-            if (lDict)
-                lDict->clear();
+            left.CleanDictData();
             return;
         }
 
-        LLBC_Variant cLeft(left);
-        LLBC_Variant::Dict *clDict = cLeft.GetHolder().obj.dict;
-        for (LLBC_Variant::Dict::const_iterator clIt = clDict->begin();
-             clIt != clDict->end();
-             clIt++)
-        {
-            if (rDict->find(clIt->first) != rDict->end())
-                lDict->erase(clIt->first);
-        }
-
-        for (LLBC_Variant::Dict::const_iterator rIt = rDict->begin();
-             rIt != rDict->end();
-             rIt++)
-        {
-            if (clDict->find(rIt->first) == clDict->end())
-                lDict->insert(std::make_pair(rIt->first, rIt->second));
-        }
+        dict_performs(left, right, LLBC_VariantArithmetic::VT_ARITHMETIC_DIV);
 
         return;
- 
     }
-    else if (left.IsStr() || right.IsStr())
+    else if (left.IsStr() || right.IsStr() ||
+             left.IsSeq() || right.IsSeq())
     {
         left.BecomeNil();
         return;
@@ -485,6 +541,99 @@ void LLBC_VariantTraits::div_equal(LLBC_Variant &left, const LLBC_Variant &right
     LLBC_VariantArithmetic::Performs(left, right, LLBC_VariantArithmetic::VT_ARITHMETIC_DIV);
 }
 
+void LLBC_VariantTraits::dict_performs(LLBC_Variant &left, const LLBC_Variant &right, int type)
+{
+    // Hold origin left dictionary, then detach(copy-on-write) left dictionary to modify,
+    // right dictionary still hold by right variant.
+    LLBC_Variant cLeft;
+    if (type == LLBC_VariantArithmetic::VT_ARITHMETIC_MUL ||
+        type == LLBC_VariantArithmetic::VT_ARITHMETIC_DIV)
+        cLeft = left;
+
+    if (left.IsHashDict())
+    {
+        LLBC_Variant::HashDict *dlDict = left.DetachHashDict(true, false);
+        if (right.IsHashDict())
+            LLBC_INL_NS __DictPerforms(dlDict, cLeft.AsHashDict(), right.AsHashDict(), type);
+        else
+            LLBC_INL_NS __DictPerforms(dlDict, cLeft.AsHashDict(), right.AsDict(), type);
+    }
+    else
+    {
+        LLBC_Variant::Dict *dlDict = left.DetachDict(true, false);
+        if (right.IsHashDict())
+            LLBC_INL_NS __DictPerforms(dlDict, cLeft.AsDict(), right.AsHashDict(), type);
+        else
+            LLBC_INL_NS __DictPerforms(dlDict, cLeft.AsDict(), right.AsDict(), type);
+    }
+}
+
+void LLBC_VariantTraits::seq_performs(LLBC_Variant &left, const LLBC_Variant &right, int type)
+{
+    if (&left == &right)
+    {
+        // Hold right sequence, left sequence will be modified.
+        const LLBC_Variant cRight(right);
+        seq_performs(left, cRight, type);
+
+        return;
+    }
+
+    if (type == LLBC_VariantArithmetic::VT_ARITHMETIC_ADD) // Seq + Seq: concatenate
+    {
+        const LLBC_Variant::Seq &rSeq = right.AsSeq();
+        if (rSeq.empty())
+            return;
+
+        LLBC_Variant::Seq *dlSeq = left.DetachSeq(true, false);
+        dlSeq->insert(dlSeq->end(), rSeq.begin(), rSeq.end());
+    }
+    else if (type == LLBC_VariantArithmetic::VT_ARITHMETIC_SUB) // Seq - Seq: remove all elements in right
+    {
+        const LLBC_Variant::Seq &rSeq = right.AsSeq();
+        if (rSeq.empty() || left.AsSeq().empty())
+            return;
+
+        const std::set<LLBC_Variant> rElems(rSeq.begin(), rSeq.end());
+        LLBC_Variant::Seq *dlSeq = left.DetachSeq(false, false);
+
+        size_t keptCount = 0;
+        for (size_t i = 0; i < dlSeq->size(); ++i)
+        {
+            if (rElems.find((*dlSeq)[i]) != rElems.end())
+                continue;
+
+            if (keptCount != i)
+                (*dlSeq)[keptCount] = (*dlSeq)[i];
+            ++keptCount;
+        }
+
+        dlSeq->resize(keptCount);
+    }
+    else if (type == LLBC_VariantArithmetic::VT_ARITHMETIC_MUL) // Seq * Raw: repeat
+    {
+        const size_t times = static_cast<size_t>(right.AsUInt32());
+        const size_t size = left.AsSeq().size();
+        if (size == 0 || times == 1)
+            return;
+
+        if (times == 0)
+        {
+            left.CleanSeqData();
+            return;
+        }
+
+        // Reserved, push back self elements will not reallocate.
+        LLBC_Variant::Seq *dlSeq = left.DetachSeq(false, false);
+        dlSeq->reserve(size * times);
+        for (size_t i = 1; i < times; ++i)
+        {
+            for (size_t j = 0; j < size; ++j)
+                dlSeq->push_back((*dlSeq)[j]);
+        }
+    }
+}
+
 __LLBC_NS_END
 
 #include "llbc/common/AfterIncl.h"
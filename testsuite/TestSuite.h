@@ -29,6 +29,7 @@
 #include "common/TestCase_Com_Version.h"
 #include "common/TestCase_Com_Compiler.h"
 #include "common/TestCase_Com_RTTI.h"
+#include "common/TestCase_Com_Allocator.h"
 
 #include "core/os/TestCase_Core_OS_Symbol.h"
 #include "core/os/TestCase_Core_OS_Thread.h"
@@ -59,6 +60,7 @@
 #include "core/thread/TestCase_Core_Thread_Tls.h"
 #include "core/thread/TestCase_Core_Thread_ThreadMgr.h"
 #include "core/thread/TestCase_Core_Thread_Task.h"
+#include "core/timer/TestCase_Core_Timer_Scheduler.h"
 #include "core/random/TestCase_Core_Random.h"
 #include "core/log/TestCase_Core_Log.h"
 #include "core/entity/TestCase_Core_Entity.h"
@@ -85,6 +87,7 @@
 #include "comm/TestCase_Comm_LazyTask.h"
 #include "comm/TestCase_Comm_ProtoStackCtrl.h"
 #include "comm/TestCase_Comm_MessageBuffer.h"
+#include "comm/TestCase_Comm_EventBus.h"
 
 #include "application/TestCase_App_AppTest.h"
 
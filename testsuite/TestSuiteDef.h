@@ -9,6 +9,7 @@ __DEFINE_TEST_CASE(TestCase_Com_Stream)
 __DEFINE_TEST_CASE(TestCase_Com_Error)
 __DEFINE_TEST_CASE(TestCase_Com_Compiler)
 __DEFINE_TEST_CASE(TestCase_Com_RTTI)
+__DEFINE_TEST_CASE(TestCase_Com_Allocator)
 __DEFINE_TEST_CASE(TestCase_Core_OS_Symbol)
 __DEFINE_TEST_CASE(TestCase_Core_OS_Thread)
 __DEFINE_TEST_CASE(TestCase_Core_OS_Console)
@@ -38,6 +39,7 @@ __DEFINE_TEST_CASE(TestCase_Core_Thread_Semaphore)
 __DEFINE_TEST_CASE(TestCase_Core_Thread_Tls)
 __DEFINE_TEST_CASE(TestCase_Core_Thread_ThreadMgr)
 __DEFINE_TEST_CASE(TestCase_Core_Thread_Task)
+__DEFINE_TEST_CASE(TestCase_Core_Timer_Scheduler)
 __DEFINE_TEST_CASE(TestCase_Core_Random)
 __DEFINE_TEST_CASE(TestCase_Core_Log)
 __DEFINE_TEST_CASE(TestCase_Core_Entity)
@@ -63,6 +65,7 @@ __DEFINE_TEST_CASE(TestCase_Comm_ExternalDriveSvc)
 __DEFINE_TEST_CASE(TestCase_Comm_LazyTask)
 __DEFINE_TEST_CASE(TestCase_Comm_ProtoStackCtrl)
 __DEFINE_TEST_CASE(TestCase_Comm_MessageBuffer)
+__DEFINE_TEST_CASE(TestCase_Comm_EventBus)
 __DEFINE_TEST_CASE(TestCase_App_AppTest)
 __DEF_TEST_CASE_END
 
@@ -0,0 +1,274 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "comm/TestCase_Comm_EventBus.h"
+
+namespace
+{
+
+class EvIds
+{
+public:
+    enum
+    {
+        EntityChanged = 1,
+        WorldNotice = 2,
+        DerivedNotice = 3,
+        KeptEvent = 4,
+    };
+};
+
+class Topics
+{
+public:
+    enum
+    {
+        World = 1,
+    };
+};
+
+// Derived event, not override Clone(), can't be published.
+class SlicedEvent : public LLBC_Event
+{
+public:
+    SlicedEvent() : LLBC_Event(EvIds::DerivedNotice), extra(0) {  }
+
+public:
+    int extra;
+};
+
+// Derived event, override Clone().
+class CloneableEvent : public LLBC_Event
+{
+public:
+    CloneableEvent() : LLBC_Event(EvIds::DerivedNotice), extra(0) {  }
+
+public:
+    virtual LLBC_Event *Clone() const
+    {
+        CloneableEvent *clone = LLBC_New(CloneableEvent);
+        clone->extra = extra;
+
+        return clone;
+    }
+
+public:
+    int extra;
+};
+
+const int FrameCount = 10;
+const int EntityCount = 100;
+const int ChangeTimesPerFrame = 10;
+
+class ZoneFacade : public LLBC_IFacade
+{
+public:
+    ZoneFacade(int socialSvcId)
+    : LLBC_IFacade(LLBC_FacadeEvents::DefaultEvents | LLBC_FacadeEvents::OnUpdate)
+    , _socialSvcId(socialSvcId)
+    , _frames(0)
+    , slicedPublishRet(LLBC_OK)
+    , cloneablePublishRet(LLBC_FAILED)
+    , keptEv(NULL)
+    {
+    }
+
+public:
+    virtual bool OnStart()
+    {
+        LLBC_EventBus &evBus = GetService()->GetEventBus();
+
+        // Derived event which not override Clone() will be rejected, don't slice it when fan out.
+        slicedPublishRet = evBus.Publish(Topics::World, LLBC_New(SlicedEvent));
+
+        CloneableEvent *cloneableEv = LLBC_New(CloneableEvent);
+        cloneableEv->extra = 10086;
+        cloneablePublishRet = evBus.Publish(Topics::World, cloneableEv);
+
+        // Dont delete after fire event replaced by dedup will not be deleted by event bus.
+        keptEv = LLBC_New2(LLBC_Event, EvIds::KeptEvent, true);
+        evBus.Post(_socialSvcId, keptEv, 1);
+        evBus.Post(_socialSvcId, LLBC_New1(LLBC_Event, EvIds::KeptEvent), 1);
+
+        return true;
+    }
+
+
+    virtual void OnUpdate()
+    {
+        if (_frames >= FrameCount)
+            return;
+
+        ++_frames;
+
+        // Every entity change many times per frame, use entity Id as dedup key, only the latest change delivered.
+        LLBC_EventBus &evBus = GetService()->GetEventBus();
+        for (int entityId = 1; entityId <= EntityCount; ++entityId)
+        {
+            for (int ver = 1; ver <= ChangeTimesPerFrame; ++ver)
+            {
+                LLBC_Event *ev = LLBC_New1(LLBC_Event, EvIds::EntityChanged);
+                ev->SetParam(1, entityId);
+                ev->SetParam(2, ver);
+                evBus.Post(_socialSvcId, ev, entityId);
+            }
+        }
+
+        // Publish world notice to all subscribed services.
+        LLBC_Event *notice = LLBC_New1(LLBC_Event, EvIds::WorldNotice);
+        notice->SetParam(1, _frames);
+        evBus.Publish(Topics::World, notice);
+    }
+
+private:
+    int _socialSvcId;
+    int _frames;
+
+public:
+    int slicedPublishRet;
+    int cloneablePublishRet;
+    LLBC_Event *keptEv;
+};
+
+class SocialFacade : public LLBC_IFacade
+{
+public:
+    SocialFacade()
+    : changedTimes(0)
+    , notLatestTimes(0)
+    , noticeTimes(0)
+    , derivedNoticeTimes(0)
+    {
+    }
+
+public:
+    virtual bool OnInitialize()
+    {
+        LLBC_IService *svc = GetService();
+        svc->SubscribeEvent(EvIds::EntityChanged, this, &SocialFacade::OnEntityChanged);
+        svc->SubscribeEvent(EvIds::WorldNotice, this, &SocialFacade::OnWorldNotice);
+        svc->SubscribeEvent(EvIds::DerivedNotice, this, &SocialFacade::OnDerivedNotice);
+
+        return true;
+    }
+
+    virtual bool OnStart()
+    {
+        GetService()->GetEventBus().SubscribeTopic(Topics::World);
+        return true;
+    }
+
+public:
+    void OnEntityChanged(LLBC_Event *ev)
+    {
+        ++changedTimes;
+        if ((*ev)[2].AsInt32() != ChangeTimesPerFrame)
+            ++notLatestTimes;
+    }
+
+    void OnWorldNotice(LLBC_Event *ev)
+    {
+        ++noticeTimes;
+    }
+
+    void OnDerivedNotice(LLBC_Event *ev)
+    {
+        CloneableEvent *cloneableEv = dynamic_cast<CloneableEvent *>(ev);
+        if (cloneableEv && cloneableEv->extra == 10086)
+            ++derivedNoticeTimes;
+    }
+
+public:
+    int changedTimes;
+    int notLatestTimes;
+    int noticeTimes;
+    int derivedNoticeTimes;
+};
+
+}
+
+TestCase_Comm_EventBus::TestCase_Comm_EventBus()
+{
+}
+
+TestCase_Comm_EventBus::~TestCase_Comm_EventBus()
+{
+}
+
+int TestCase_Comm_EventBus::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("Comm/EventBus test:");
+
+    // Create social services(event receivers), all social services subscribe world topic.
+    SocialFacade *socialFacade = LLBC_New(SocialFacade);
+    LLBC_IService *socialSvc = LLBC_IService::Create(LLBC_IService::Normal, "EventBusSocial");
+    socialSvc->RegisterFacade(socialFacade);
+    socialSvc->Start();
+
+    SocialFacade *socialFacade2 = LLBC_New(SocialFacade);
+    LLBC_IService *socialSvc2 = LLBC_IService::Create(LLBC_IService::Normal, "EventBusSocial2");
+    socialSvc2->RegisterFacade(socialFacade2);
+    socialSvc2->Start();
+
+    // Create zone service(event sender).
+    LLBC_IService *zoneSvc = LLBC_IService::Create(LLBC_IService::Normal, "EventBusZone");
+    ZoneFacade *zoneFacade = LLBC_New1(ZoneFacade, socialSvc->GetId());
+    zoneSvc->RegisterFacade(zoneFacade);
+    zoneSvc->Start();
+
+    LLBC_PrintLine("Wait for %d zone frames...", FrameCount);
+    LLBC_ThreadManager::Sleep(2000);
+
+    zoneSvc->Stop();
+    socialSvc->Stop();
+    socialSvc2->Stop();
+
+    LLBC_PrintLine("Social service received entity changed events: %d(expect: %d), not latest change events: %d",
+                   socialFacade->changedTimes, FrameCount * EntityCount, socialFacade->notLatestTimes);
+    LLBC_PrintLine("Social service received world notices: %d(expect: %d)",
+                   socialFacade->noticeTimes, FrameCount);
+    LLBC_PrintLine("Social service 2 received world notices: %d(expect: %d)",
+                   socialFacade2->noticeTimes, FrameCount);
+
+    LLBC_PrintLine("Publish not cloneable derived event ret: %d(expect: %d), cloneable derived event ret: %d(expect: %d)",
+                   zoneFacade->slicedPublishRet, LLBC_FAILED, zoneFacade->cloneablePublishRet, LLBC_OK);
+    LLBC_PrintLine("Social services received derived notices(derived type kept): %d, %d(expect: 1, 1)",
+                   socialFacade->derivedNoticeTimes, socialFacade2->derivedNoticeTimes);
+
+    // Dont delete after fire event still owned by us.
+    LLBC_PrintLine("Dedup replaced dont delete after fire event, event Id: %d", zoneFacade->keptEv->GetId());
+    LLBC_Delete(zoneFacade->keptEv);
+
+    // Stopped services' topic subscriptions removed.
+    std::vector<int> subscribers;
+    LLBC_ServiceMgrSingleton->GetTopicSubscribers(Topics::World, subscribers);
+    LLBC_PrintLine("World topic subscribers after services stopped: %lu(expect: 0)", subscribers.size());
+
+    LLBC_Delete(zoneSvc);
+    LLBC_Delete(socialSvc);
+    LLBC_Delete(socialSvc2);
+
+    LLBC_PrintLine("Press any key to continue...");
+    getchar();
+
+    return LLBC_OK;
+}
@@ -0,0 +1,177 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "common/TestCase_Com_Allocator.h"
+
+int TestCase_Com_Allocator::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("common/allocator test:");
+    LLBC_PrintLine("allocator backend: %d, tag stat enabled: %s",
+        LLBC_CFG_COM_ALLOCATOR_BACKEND, LLBC_CFG_COM_ALLOCATOR_ENABLE_TAG_STAT ? "true" : "false");
+
+    if (CorrectnessTest() != LLBC_OK)
+    {
+        LLBC_PrintLine("Press any key to continue ...");
+        getchar();
+
+        return LLBC_FAILED;
+    }
+
+    PerfTest();
+    DumpTagStats();
+
+    LLBC_PrintLine("Press any key to continue ...");
+    getchar();
+
+    return LLBC_OK;
+}
+
+int TestCase_Com_Allocator::CorrectnessTest()
+{
+    LLBC_PrintLine("Correctness test:");
+
+    // Allocate random size blocks, fill and verify it.
+    const int blockCount = 10000;
+    std::vector<std::pair<uint8 *, size_t> > blocks;
+    for (int i = 0; i < blockCount; ++i)
+    {
+        const size_t size = static_cast<size_t>(LLBC_RandInt(0, (i % 10 == 0) ? 100000 : 512));
+        uint8 *block = LLBC_Malloc(uint8, size);
+        if (!block)
+        {
+            LLBC_PrintLine("  Allocate %lu bytes failed", size);
+            return LLBC_FAILED;
+        }
+
+        ::memset(block, i & 0xff, size);
+        blocks.push_back(std::make_pair(block, size));
+    }
+
+    // Realloc half of blocks.
+    for (int i = 0; i < blockCount; i += 2)
+    {
+        std::pair<uint8 *, size_t> &block = blocks[i];
+        const size_t newSize = block.second * 2 + 1;
+        block.first = LLBC_Realloc(uint8, block.first, newSize);
+        ::memset(block.first + block.second, i & 0xff, newSize - block.second);
+        block.second = newSize;
+    }
+
+    for (int i = 0; i < blockCount; ++i)
+    {
+        const std::pair<uint8 *, size_t> &block = blocks[i];
+        for (size_t j = 0; j < block.second; ++j)
+        {
+            if (block.first[j] != static_cast<uint8>(i & 0xff))
+            {
+                LLBC_PrintLine("  Verify block %d failed, offset: %lu", i, j);
+                return LLBC_FAILED;
+            }
+        }
+
+        LLBC_Free(block.first);
+    }
+
+    // Calloc test.
+    uint8 *zeroBlock = LLBC_Calloc(uint8, 1024);
+    for (int i = 0; i < 1024; ++i)
+    {
+        if (zeroBlock[i] != 0)
+        {
+            LLBC_PrintLine("  Calloc block not zeroed, offset: %d", i);
+            LLBC_Free(zeroBlock);
+            return LLBC_FAILED;
+        }
+    }
+    LLBC_Free(zeroBlock);
+
+    LLBC_PrintLine("  Correctness test passed");
+
+    return LLBC_OK;
+}
+
+void TestCase_Com_Allocator::PerfTest()
+{
+    LLBC_PrintLine("Performance test:");
+
+    const int loopTimes = 1000000;
+    const size_t sizes[] = {16, 64, 256, 1024, 4096};
+
+    for (size_t sizeIdx = 0; sizeIdx < sizeof(sizes) / sizeof(sizes[0]); ++sizeIdx)
+    {
+        const size_t size = sizes[sizeIdx];
+
+        sint64 begTime = LLBC_GetMicroSeconds();
+        for (int i = 0; i < loopTimes; ++i)
+        {
+            void *block = ::malloc(size);
+            *reinterpret_cast<volatile char *>(block) = 0;
+            ::free(block);
+        }
+        const sint64 sysUsed = LLBC_GetMicroSeconds() - begTime;
+
+        begTime = LLBC_GetMicroSeconds();
+        for (int i = 0; i < loopTimes; ++i)
+        {
+            char *block = LLBC_Malloc(char, size);
+            *reinterpret_cast<volatile char *>(block) = 0;
+            LLBC_Free(block);
+        }
+        const sint64 libUsed = LLBC_GetMicroSeconds() - begTime;
+
+        LLBC_PrintLine("  size %4lu, %d times malloc/free, system: %lld us, LLBC_Malloc/LLBC_Free: %lld us",
+            size, loopTimes, sysUsed, libUsed);
+    }
+
+    // Message block churn(send path like).
+    sint64 begTime = LLBC_GetMicroSeconds();
+    for (int i = 0; i < loopTimes; ++i)
+    {
+        LLBC_MessageBlock *block = LLBC_New1(LLBC_MessageBlock, 128);
+        block->Write(&i, sizeof(i));
+        LLBC_Delete(block);
+    }
+    LLBC_PrintLine("  %d times LLBC_New1(LLBC_MessageBlock, 128)/LLBC_Delete used: %lld us",
+        loopTimes, LLBC_GetMicroSeconds() - begTime);
+}
+
+void TestCase_Com_Allocator::DumpTagStats()
+{
+    LLBC_PrintLine("Memory tag statistics:");
+#if !LLBC_CFG_COM_ALLOCATOR_ENABLE_TAG_STAT
+    LLBC_PrintLine("  Tag statistic disabled, enable LLBC_CFG_COM_ALLOCATOR_ENABLE_TAG_STAT to dump it");
+    return;
+#endif // !LLBC_CFG_COM_ALLOCATOR_ENABLE_TAG_STAT
+
+    LLBC_MemoryTagStat stat;
+    for (int tag = LLBC_MemoryTag::Begin; tag != LLBC_MemoryTag::End; ++tag)
+    {
+        if (LLBC_GetMemoryTagStat(tag, stat) != LLBC_OK)
+        {
+            LLBC_PrintLine("  Get tag stat failed, error: %s", LLBC_FormatLastError());
+            return;
+        }
+
+        LLBC_PrintLine("  %-10s inUseBytes: %lld, inUseBlocks: %lld, totalAllocTimes: %lld",
+            LLBC_MemoryTag::GetTagDesc(tag), stat.inUseBytes, stat.inUseBlocks, stat.totalAllocTimes);
+    }
+}
@@ -60,9 +60,125 @@ int TestCase_Com_Endian::Run(int argc, char *argv[])
     LLBC_PrintLine("host to net test(long data), host: 0x%16llx, net: 0x%16llx", longData, LLBC_Host2Net2(longData));
     LLBC_Host2Net(longData);
     LLBC_PrintLine("net to host test, net: 0x%16llx, host: 0x%16llx", longData, LLBC_Net2Host2(longData));
+    LLBC_PrintLine("");
+
+    // Bulk reverse bytes test.
+    if (BulkReverseBytesTest() != LLBC_OK)
+        return LLBC_FAILED;
+
+    // Packet pod array(bulk byte order convert) test.
+    if (PacketPodArrayTest() != LLBC_OK)
+        return LLBC_FAILED;
 
     LLBC_PrintLine("Press any key to continue ...");
     getchar();
 
     return 0;
 }
+
+int TestCase_Com_Endian::BulkReverseBytesTest()
+{
+    LLBC_PrintLine("Bulk reverse bytes test, implement: %s", LLBC_GetReverseBytesArrayImpl());
+
+    // Odd count, make sure the scalar tail path is covered too.
+    const size_t count = 1024 * 1024 + 7;
+    const int loopTimes = 20;
+    if (BulkReverseBytesTest<uint16>("uint16", count, loopTimes) != LLBC_OK ||
+        BulkReverseBytesTest<uint32>("uint32", count, loopTimes) != LLBC_OK ||
+        BulkReverseBytesTest<uint64>("uint64", count, loopTimes) != LLBC_OK)
+        return LLBC_FAILED;
+
+    LLBC_PrintLine("");
+
+    return LLBC_OK;
+}
+
+int TestCase_Com_Endian::PacketPodArrayTest()
+{
+    LLBC_PrintLine("Packet pod array test:");
+
+    std::vector<sint16> i16s;
+    std::vector<uint32> u32s;
+    std::vector<sint64> i64s;
+    std::vector<double> dbls;
+    for (int i = 0; i < 1000; ++i)
+    {
+        i16s.push_back(static_cast<sint16>(i * 31 - 15000));
+        u32s.push_back(static_cast<uint32>(i) * 0x01020304u);
+        i64s.push_back(static_cast<sint64>(static_cast<uint64>(i) * 0x0102030405060708ULL) - 1);
+        dbls.push_back(i * 3.1415926);
+    }
+
+    // Write vectors by bulk path, and write last sint64 element by element path, compare the wire format.
+    LLBC_Packet pkt;
+    pkt << i16s << u32s << i64s << dbls << i64s.back();
+
+    const size_t tailOff = pkt.GetPayloadLength() - sizeof(sint64);
+    const size_t lastElemOff = tailOff - sizeof(double) * dbls.size() - sizeof(uint32) - sizeof(sint64);
+    const uint8 *payload = reinterpret_cast<const uint8 *>(pkt.GetPayload());
+    if (memcmp(payload + tailOff, payload + lastElemOff, sizeof(sint64)) != 0)
+    {
+        LLBC_PrintLine("Packet sint64 array wire format not same as single sint64 wire format");
+        return LLBC_FAILED;
+    }
+
+    std::vector<sint16> i16s2;
+    std::vector<uint32> u32s2;
+    std::vector<sint64> i64s2;
+    std::vector<double> dbls2;
+    sint64 lastI64 = 0;
+    pkt >> i16s2 >> u32s2 >> i64s2 >> dbls2 >> lastI64;
+    if (i16s2 != i16s || u32s2 != u32s || i64s2 != i64s || dbls2 != dbls || lastI64 != i64s.back())
+    {
+        LLBC_PrintLine("Packet pod array read/write failed");
+        return LLBC_FAILED;
+    }
+
+    // Truncated packet read must fail.
+    LLBC_Packet truncPkt;
+    truncPkt << static_cast<uint32>(100) << static_cast<uint32>(1);
+    std::vector<uint32> truncVec;
+    if (truncPkt.Read(truncVec) == LLBC_OK)
+    {
+        LLBC_PrintLine("Truncated packet pod array read success, test failed");
+        return LLBC_FAILED;
+    }
+
+    LLBC_PrintLine("Packet pod array test success");
+    LLBC_PrintLine("");
+
+    return LLBC_OK;
+}
+
+template <typename T>
+int TestCase_Com_Endian::BulkReverseBytesTest(const char *typeName, size_t count, int loopTimes)
+{
+    std::vector<T> scalarArr(count);
+    for (size_t i = 0; i < count; ++i)
+        scalarArr[i] = static_cast<T>(i * 0x0102030405060708ULL);
+    std::vector<T> bulkArr(scalarArr);
+
+    sint64 begTime = LLBC_GetMicroSeconds();
+    for (int loop = 0; loop < loopTimes; ++loop)
+    {
+        for (size_t i = 0; i < count; ++i)
+            LLBC_ReverseBytes(scalarArr[i]);
+    }
+    const sint64 scalarUsed = LLBC_GetMicroSeconds() - begTime;
+
+    begTime = LLBC_GetMicroSeconds();
+    for (int loop = 0; loop < loopTimes; ++loop)
+        LLBC_ReverseBytesArray(&bulkArr[0], sizeof(T), count);
+    const sint64 bulkUsed = LLBC_GetMicroSeconds() - begTime;
+
+    if (scalarArr != bulkArr)
+    {
+        LLBC_PrintLine("  %s: bulk reverse result not same as element by element reverse", typeName);
+        return LLBC_FAILED;
+    }
+
+    LLBC_PrintLine("  %s x %lu, loop %d times, element by element: %lld us, bulk: %lld us",
+        typeName, static_cast<unsigned long>(count), loopTimes, scalarUsed, bulkUsed);
+
+    return LLBC_OK;
+}
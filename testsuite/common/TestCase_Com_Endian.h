@@ -29,6 +29,13 @@ class TestCase_Com_Endian : public LLBC_BaseTestCase
 {
 public:
     virtual int Run(int argc, char *argv[]);
+
+private:
+    int BulkReverseBytesTest();
+    int PacketPodArrayTest();
+
+    template <typename T>
+    int BulkReverseBytesTest(const char *typeName, size_t count, int loopTimes);
 };
 
 #endif // !__LLBC_TEST_CASE_COM_ENDIAN_H__
@@ -60,10 +60,51 @@ struct Serialize_Test2
     }
 };
 
+struct Serialize_TestPoint
+{
+    float x;
+    float y;
+    float z;
+};
+
+LLBC_STREAM_DECLARE_POD(Serialize_TestPoint)
+
+struct Serialize_Test3
+{
+    sint32 id;
+    std::string name;
+    std::vector<sint64> values;
+    std::vector<Serialize_TestPoint> points;
+    std::map<int, std::string> attrs;
+
+    LLBC_STREAM_FIELDS_BEGIN()
+        LLBC_STREAM_FIELD(id)
+        LLBC_STREAM_FIELD(name)
+        LLBC_STREAM_FIELD(values)
+        LLBC_STREAM_FIELD(points)
+        LLBC_STREAM_FIELD(attrs)
+    LLBC_STREAM_FIELDS_END()
+
+    bool operator ==(const Serialize_Test3 &another) const
+    {
+        if (id != another.id || name != another.name ||
+            values != another.values || attrs != another.attrs ||
+            points.size() != another.points.size())
+            return false;
+
+        return points.empty() || 
+            memcmp(&points[0], &another.points[0], sizeof(Serialize_TestPoint) * points.size()) == 0;
+    }
+};
+
 static void ClearTest();
 static void RawSerializeTest();
 static void STLContainersSerializeTest();
 static void MethodSerializeTest();
+static void CompactSerializeTest();
+static void SegmentedStreamTest();
+static void FieldsSerializeTest();
+static void ReadViewTest();
 
 static LLBC_String ToStringVec(const std::vector<int> &vec);
 static LLBC_String ToStringNestingVec(const std::vector<std::vector<int> > &vec);
@@ -78,6 +119,10 @@ int TestCase_Com_Stream::Run(int argc, char *argv[])
     RawSerializeTest();
     STLContainersSerializeTest();
     MethodSerializeTest();
+    CompactSerializeTest();
+    SegmentedStreamTest();
+    FieldsSerializeTest();
+    ReadViewTest();
 
     LLBC_PrintLine("Press any key to continue ...");
     getchar();
@@ -259,6 +304,351 @@ static void MethodSerializeTest()
         "sint64Val: %lld, strVal: %s\n", test2.sint64val, test2.strVal.c_str() );
 }
 
+static void CompactSerializeTest()
+{
+    LLBC_PrintLine("Compact(varint/zigzag) serialize test:");
+
+    LLBC_Stream fixedStream;
+    LLBC_Stream compactStream;
+    compactStream.SetCompact(true);
+
+    // Integer boundary values.
+    const sint32 sint32Vals[] = {0, 1, -1, 63, -64, 64, -65, 10086, 0x7fffffff, -0x7fffffff - 1};
+    const uint64 uint64Vals[] = {0, 1, 127, 128, 16383, 16384, 0xffffffffull, 0xffffffffffffffffull};
+    const sint64 sint64Vals[] = {0, -1, 1000000000000ll, -1000000000000ll, 0x7fffffffffffffffll, -0x7fffffffffffffffll - 1};
+    const size_t sint32Count = sizeof(sint32Vals) / sizeof(sint32Vals[0]);
+    const size_t uint64Count = sizeof(uint64Vals) / sizeof(uint64Vals[0]);
+    const size_t sint64Count = sizeof(sint64Vals) / sizeof(sint64Vals[0]);
+
+    LLBC_Stream *streams[] = {&fixedStream, &compactStream};
+    for (int i = 0; i < 2; ++i)
+    {
+        LLBC_Stream &stream = *streams[i];
+        for (size_t j = 0; j < sint32Count; ++j)
+            stream.Write(sint32Vals[j]);
+        for (size_t j = 0; j < uint64Count; ++j)
+            stream.Write(uint64Vals[j]);
+        for (size_t j = 0; j < sint64Count; ++j)
+            stream.WriteEx(sint64Vals[j]);
+        stream.Write(static_cast<sint16>(-300));
+        stream.Write(static_cast<uint16>(300));
+        stream.Write(3.1415926);
+    }
+
+    LLBC_PrintLine("Fixed width stream size: %lu, compact stream size: %lu",
+                   fixedStream.GetPos(), compactStream.GetPos());
+
+    for (int i = 0; i < 2; ++i)
+    {
+        LLBC_Stream &stream = *streams[i];
+        stream.SetPos(0);
+
+        bool succeed = true;
+        for (size_t j = 0; j < sint32Count; ++j)
+            succeed = succeed && stream.ReadSInt32_2() == sint32Vals[j];
+        for (size_t j = 0; j < uint64Count; ++j)
+            succeed = succeed && stream.ReadUInt64_2() == uint64Vals[j];
+        for (size_t j = 0; j < sint64Count; ++j)
+        {
+            sint64 val = 0;
+            succeed = succeed && stream.ReadEx(val) && val == sint64Vals[j];
+        }
+        succeed = succeed && stream.ReadSInt16_2() == -300;
+        succeed = succeed && stream.ReadUInt16_2() == 300;
+        succeed = succeed && stream.ReadDouble_2() == 3.1415926;
+
+        LLBC_PrintLine("%s stream read back: %s", i == 0 ? "Fixed width" : "Compact", succeed ? "succeed" : "failed");
+    }
+
+    // Out of range value can't be read to narrower type.
+    compactStream.Clear();
+    compactStream.Write(static_cast<uint32>(70000));
+    compactStream.SetPos(0);
+    uint16 narrowVal = 0;
+    LLBC_PrintLine("Read 70000 to uint16: %s(pos: %lu)",
+                   compactStream.Read(narrowVal) ? "succeed" : "failed", compactStream.GetPos());
+
+    // Container & variant.
+    std::vector<int> vec;
+    for (int i = 0; i < 100; ++i)
+        vec.push_back(i * 10);
+
+    LLBC_Variant var;
+    var["id"] = 10086;
+    var["name"] = "compact";
+    var["ratio"] = 0.5;
+    var["counts"][1] = -1;
+
+    fixedStream.Clear();
+    compactStream.Clear();
+    for (int i = 0; i < 2; ++i)
+    {
+        streams[i]->Write(vec);
+        streams[i]->Write(var);
+    }
+
+    LLBC_PrintLine("Container & variant, fixed width stream size: %lu, compact stream size: %lu",
+                   fixedStream.GetPos(), compactStream.GetPos());
+
+    std::vector<int> vec2;
+    LLBC_Variant var2;
+    compactStream.SetPos(0);
+    const bool readRet = compactStream.Read(vec2) && compactStream.Read(var2);
+    LLBC_PrintLine("Compact stream read back container & variant: %s, variant: %s",
+                   readRet && vec2 == vec && var2 == var ? "succeed" : "failed", var2.ValueToString().c_str());
+}
+
+static void SegmentedStreamTest()
+{
+    LLBC_PrintLine("Segmented stream test:");
+
+    // Write same data to contiguous stream & segmented stream(small segment size).
+    LLBC_Stream contiguousStream;
+    LLBC_Stream segmentedStream;
+    segmentedStream.SetSegmented(256);
+
+    std::vector<int> vec;
+    for (int i = 0; i < 100; ++i)
+        vec.push_back(i);
+
+    LLBC_Stream *streams[] = {&contiguousStream, &segmentedStream};
+    for (int i = 0; i < 2; ++i)
+    {
+        for (int j = 0; j < 20; ++j)
+        {
+            streams[i]->Write(j);
+            streams[i]->Write(std::string("segmented stream"));
+            streams[i]->Write(vec);
+        }
+    }
+
+    LLBC_PrintLine("Contiguous stream pos: %lu, segmented stream pos: %lu, segments: %lu",
+                   contiguousStream.GetPos(), segmentedStream.GetPos(), segmentedStream.GetSegmentCount());
+
+    // Segments(iovec) content must equal to contiguous stream.
+    std::vector<LLBC_StreamSegment> segments(segmentedStream.GetSegmentCount());
+    segmentedStream.GetSegments(&segments[0], segments.size());
+
+    size_t offset = 0;
+    bool contentEqual = true;
+    for (size_t i = 0; i < segments.size(); ++i)
+    {
+        contentEqual = contentEqual && 
+            memcmp(reinterpret_cast<char *>(contiguousStream.GetBuf()) + offset, segments[i].buf, segments[i].len) == 0;
+        offset += segments[i].len;
+    }
+
+    LLBC_PrintLine("Segments content equal: %s", contentEqual && offset == contiguousStream.GetPos() ? "true" : "false");
+
+    // Append to message buffer without copy.
+    LLBC_Stream bufStream;
+    bufStream.Assign(segmentedStream);
+
+    LLBC_MessageBuffer msgBuf;
+    msgBuf.Append(segmentedStream);
+    const void *firstBlockData = msgBuf.FirstBlock() ? msgBuf.FirstBlock()->GetData() : NULL;
+    LLBC_PrintLine("Append to message buffer, size: %lu, zero copy: %s, stream pos after append: %lu",
+                   msgBuf.GetSize(), firstBlockData == segments[0].buf ? "true" : "false", segmentedStream.GetPos());
+
+    // Read segmented stream(flatten on demand).
+    segmentedStream.Clear();
+    for (int j = 0; j < 20; ++j)
+    {
+        segmentedStream.Write(j);
+        segmentedStream.Write(std::string("segmented stream"));
+        segmentedStream.Write(vec);
+    }
+
+    segmentedStream.SetPos(0);
+    bool readSucceed = !segmentedStream.IsSegmented();
+    for (int j = 0; j < 20 && readSucceed; ++j)
+    {
+        int intVal;
+        std::string strVal;
+        std::vector<int> vecVal;
+        readSucceed = segmentedStream.Read(intVal) && intVal == j &&
+            segmentedStream.Read(strVal) && strVal == "segmented stream" &&
+            segmentedStream.Read(vecVal) && vecVal == vec;
+    }
+
+    LLBC_PrintLine("Read after flatten: %s, assign copy equal: %s",
+                   readSucceed ? "succeed" : "failed",
+                   bufStream.GetPos() == contiguousStream.GetPos() && 
+                   memcmp(bufStream.GetBuf(), contiguousStream.GetBuf(), bufStream.GetPos()) == 0 ? "true" : "false");
+
+    // Out of range compact read in tail segment must restore read position.
+    LLBC_Stream compactStream;
+    compactStream.SetCompact(true);
+    compactStream.SetSegmented(256);
+    for (int j = 0; j < 100; ++j)
+        compactStream.Write(std::string("segmented compact stream"));
+
+    const size_t bigValPos = compactStream.GetPos();
+    const uint64 bigVal = 0x10000000000ull;
+    compactStream.Write(bigVal);
+
+    compactStream.SetPos(bigValPos);
+    const bool segmentedBeforeRead = compactStream.IsSegmented();
+
+    uint32 smallVal = 0;
+    uint64 readBigVal = 0;
+    const bool smallReadFailed = !compactStream.Read(smallVal);
+    const bool posRestored = compactStream.GetPos() == bigValPos;
+    const bool bigReadSucceed = compactStream.Read(readBigVal) && readBigVal == bigVal;
+    LLBC_PrintLine("Segmented compact stream out of range read(segmented before read: %s): %s, "
+                   "pos restored: %s, read again: %s",
+                   segmentedBeforeRead ? "true" : "false",
+                   smallReadFailed ? "failed" : "succeed",
+                   posRestored ? "true" : "false",
+                   bigReadSucceed ? "succeed" : "failed");
+}
+
+static void FieldsSerializeTest()
+{
+    LLBC_PrintLine("Field-list serialize test:");
+
+    Serialize_Test3 obj;
+    obj.id = 10086;
+    obj.name = "field-list";
+    obj.attrs[1] = "attr1";
+    obj.attrs[2] = "attr2";
+    for (int i = 0; i < 1000; ++i)
+    {
+        obj.values.push_back(static_cast<sint64>(i) * 0x100000001ll);
+
+        Serialize_TestPoint point = {i * 1.0f, i * 2.0f, i * 3.0f};
+        obj.points.push_back(point);
+    }
+
+    // Bulk copy result must equal to element by element write.
+    LLBC_Stream bulkStream;
+    bulkStream.Write(obj.values);
+
+    LLBC_Stream elemStream;
+    elemStream.Write(static_cast<uint32>(obj.values.size()));
+    for (size_t i = 0; i < obj.values.size(); ++i)
+        elemStream.Write(obj.values[i]);
+
+    LLBC_PrintLine("Bulk write equal to element write(endian: %s): %s",
+                   LLBC_Endian::Type2Str(bulkStream.GetEndian()),
+                   bulkStream.GetPos() == elemStream.GetPos() &&
+                   memcmp(bulkStream.GetBuf(), elemStream.GetBuf(), bulkStream.GetPos()) == 0 ? "true" : "false");
+
+    // Read/Write, ReadEx/WriteEx, in fixed width and compact mode.
+    for (int i = 0; i < 4; ++i)
+    {
+        const bool compact = (i & 0x01) != 0;
+        const bool ex = (i & 0x02) != 0;
+
+        LLBC_Stream stream;
+        stream.SetCompact(compact);
+        if (ex)
+            stream.WriteEx(obj);
+        else
+            stream.Write(obj);
+
+        Serialize_Test3 readObj;
+        stream.SetPos(0);
+        const bool readRet = ex ? stream.ReadEx(readObj) : stream.Read(readObj);
+        LLBC_PrintLine("compact: %s, ex: %s, serialized size: %lu, read back: %s",
+                       compact ? "true" : "false", ex ? "true" : "false",
+                       stream.GetPos(), readRet && readObj == obj ? "succeed" : "failed");
+    }
+
+    // Truncated data can't be read.
+    LLBC_Stream truncatedStream;
+    truncatedStream.Write(obj.values);
+
+    std::vector<sint64> truncatedValues;
+    LLBC_Stream attachStream(truncatedStream.GetBuf(), truncatedStream.GetPos() - 1, true);
+    LLBC_PrintLine("Read truncated data: %s", attachStream.Read(truncatedValues) ? "succeed" : "failed");
+}
+
+static void ReadViewTest()
+{
+    LLBC_PrintLine("Read view test:");
+
+#if LLBC_CFG_COM_VIEW_GUARD_ENABLED
+    const char *guardEnabled = "true";
+#else
+    const char *guardEnabled = "false";
+#endif
+
+    std::vector<Serialize_TestPoint> points;
+    for (int i = 0; i < 100; ++i)
+    {
+        Serialize_TestPoint point = {i * 1.0f, i * 2.0f, i * 3.0f};
+        points.push_back(point);
+    }
+
+    LLBC_Stream stream;
+    stream.WriteEx(std::string("hello view"));
+    stream.Write(LLBC_String("c string view"));
+    stream.Write(points);
+    stream.WriteBuffer("blob", 4);
+    stream.Write(std::vector<uint32>(10, 1));
+
+    stream.SetPos(0);
+    LLBC_StringView strView;
+    LLBC_StringView cstrView;
+    LLBC_ArrayView<Serialize_TestPoint> pointsView;
+    LLBC_BlobView blobView;
+    LLBC_ArrayView<uint32> u32View;
+    const bool readRet = stream.ReadViewEx(strView) &&
+                         stream.ReadCStrView(cstrView) &&
+                         stream.ReadView(pointsView) &&
+                         stream.ReadBufferView(blobView, 4);
+    LLBC_PrintLine("Read views: %s", readRet ? "succeed" : "failed");
+    if (readRet)
+    {
+        LLBC_PrintLine("  string view: %s",
+                       std::string(strView.data(), strView.size()) == "hello view" ? "succeed" : "failed");
+        LLBC_PrintLine("  c string view: %s",
+                       std::string(cstrView.begin(), cstrView.end()) == "c string view" ? "succeed" : "failed");
+        LLBC_PrintLine("  pod array view: %s",
+                       pointsView.size() == points.size() &&
+                       memcmp(pointsView.data(), &points[0], sizeof(Serialize_TestPoint) * points.size()) == 0 ?
+                           "succeed" : "failed");
+        LLBC_PrintLine("  blob view: %s",
+                       memcmp(blobView.data(), "blob", 4) == 0 ? "succeed" : "failed");
+    }
+
+    // Byte order convert required(or compact mode) elements, can't read as view.
+    const size_t pos = stream.GetPos();
+    const bool u32ViewRet = stream.ReadView(u32View);
+    LLBC_PrintLine("Read uint32 array view(endian: %s): %s, pos unchanged: %s",
+                   LLBC_Endian::Type2Str(stream.GetEndian()),
+                   u32ViewRet ? "succeed" : "failed",
+                   stream.GetPos() == pos ? "true" : "false");
+
+    // Stream buffer reallocated, views invalid(only available when view guard enabled).
+    stream.SetPos(stream.GetSize());
+    stream.Write(std::vector<uint8>(stream.GetSize() * 2));
+    LLBC_PrintLine("After stream buffer reallocated, view valid: %s(guard enabled: %s)",
+                   strView.IsValid() ? "true" : "false", guardEnabled);
+
+    // Packet views.
+    LLBC_Packet packet;
+    packet.Write(static_cast<const char *>("packet c string"));
+    packet.Write(std::string("packet string"));
+    packet.Write(std::vector<uint8>(16, 0xab));
+
+    LLBC_StringView pktCStrView;
+    LLBC_StringView pktStrView;
+    LLBC_BlobView pktBytesView;
+    const bool pktReadRet = packet.ReadCStrView(pktCStrView) == LLBC_OK &&
+                            packet.ReadCStrView(pktStrView) == LLBC_OK &&
+                            packet.ReadView(pktBytesView) == LLBC_OK;
+    LLBC_PrintLine("Read packet views: %s", pktReadRet &&
+                   std::string(pktCStrView.data(), pktCStrView.size()) == "packet c string" &&
+                   std::string(pktStrView.data(), pktStrView.size()) == "packet string" &&
+                   pktBytesView.size() == 16 && pktBytesView[15] == 0xab ? "succeed" : "failed");
+
+    packet.Clear();
+    LLBC_PrintLine("After packet cleared, view valid: %s(guard enabled: %s)",
+                   pktStrView.IsValid() ? "true" : "false", guardEnabled);
+}
+
 static LLBC_String ToStringVec(const std::vector<int> &vec)
 {
     LLBC_String out;
@@ -21,6 +21,12 @@
 
 #include "core/event/TestCase_Core_Event.h"
 
+struct TypedEvent
+{
+    int value;
+    const char *desc;
+};
+
 namespace
 {
     class EventIds
@@ -30,13 +36,39 @@ namespace
         {
             Event1 = 1,
             Event2 = 2,
+            TypedEvent = 3,
+            BenchEvent = 4,
         };
     };
 
     static LLBC_EventManager evMgr;
+
+    static sint64 typedFuncSum = 0;
+    static void OnTypedEventFunc(const TypedEvent &ev)
+    {
+        typedFuncSum += ev.value;
+    }
+
+    struct OtherTypedEvent
+    {
+        int value;
+    };
+
+    static int otherTypedFiredTimes = 0;
+    static void OnOtherTypedEventFunc(const OtherTypedEvent &ev)
+    {
+        ++otherTypedFiredTimes;
+    }
+
+    static sint64 eventSum = 0;
+    static void OnEventFunc(LLBC_Event *ev)
+    {
+        eventSum += (*ev)[0].AsInt64();
+    }
 }
 
 TestCase_Core_Event::TestCase_Core_Event()
+: _typedFiredTimes(0)
 {
 }
 
@@ -76,6 +108,9 @@ int TestCase_Core_Event::Run(int argc, char *argv[])
     std::cout <<"Fire Event1" <<std::endl;
     evMgr.FireEvent(LLBC_New1(LLBC_Event, EventIds::Event1));
 
+    // Typed event test.
+    TypedEventTest();
+
     LLBC_PrintLine("Press any key to continue ...");
     getchar();
 
@@ -116,3 +151,80 @@ void TestCase_Core_Event::OnEvent2(LLBC_Event *ev)
     // Remove Event2 OnEvent2() listener.
     evMgr.RemoveListener(EventIds::Event2);
 }
+
+void TestCase_Core_Event::TypedEventTest()
+{
+    std::cout <<"Typed event test:" <<std::endl;
+
+    _typedFuncStub = evMgr.AddTypedListener(EventIds::TypedEvent, &OnTypedEventFunc);
+    LLBC_ListenerStub methStub = evMgr.AddTypedListener(EventIds::TypedEvent, this, &TestCase_Core_Event::OnTypedEvent);
+    std::cout <<"Add typed listeners, func stub: " <<_typedFuncStub <<", method stub: " <<methStub <<std::endl;
+
+    LLBC_ListenerStub limitStub = evMgr.AddTypedListener(LLBC_CFG_CORE_EVENT_TYPED_EVENT_MAX_ID + 1, &OnTypedEventFunc);
+    std::cout <<"Add typed listener to out of limit event Id, stub: " <<limitStub
+              <<", error: " <<LLBC_FormatLastError() <<std::endl;
+
+    // Event Id bound to TypedEvent, other event type listener/firing will be rejected.
+    LLBC_ListenerStub otherStub = evMgr.AddTypedListener(EventIds::TypedEvent, &OnOtherTypedEventFunc);
+    std::cout <<"Add other type typed listener to bound event Id, stub: " <<otherStub
+              <<", error: " <<LLBC_FormatLastError() <<std::endl;
+
+    OtherTypedEvent otherEv;
+    otherEv.value = 1;
+    evMgr.FireTypedEvent(EventIds::TypedEvent, otherEv);
+    std::cout <<"Fire other type typed event, method listener fired times: " <<_typedFiredTimes
+              <<"(expect 0), error: " <<LLBC_FormatLastError() <<std::endl;
+
+    // Fire stack allocated typed event, OnTypedEvent() will remove func listener in first firing.
+    TypedEvent ev;
+    ev.value = 10;
+    ev.desc = "Hello typed event";
+    evMgr.FireTypedEvent(EventIds::TypedEvent, ev);
+    ev.value = 20;
+    evMgr.FireTypedEvent(EventIds::TypedEvent, ev);
+    std::cout <<"Fire typed event twice, method listener fired times: " <<_typedFiredTimes
+              <<", func listener sum: " <<typedFuncSum <<"(expect 10)" <<std::endl;
+
+    std::cout <<"Remove typed event listeners by event Id, ret: " <<evMgr.RemoveListener(EventIds::TypedEvent) <<std::endl;
+    evMgr.FireTypedEvent(EventIds::TypedEvent, ev);
+    std::cout <<"Fire typed event after removed, method listener fired times: " <<_typedFiredTimes <<std::endl;
+
+    // Performance compare with LLBC_Event.
+    const int fireTimes = 1000000;
+    LLBC_EventManager benchEvMgr;
+    benchEvMgr.AddListener(EventIds::BenchEvent, &OnEventFunc);
+    benchEvMgr.AddTypedListener(EventIds::BenchEvent, &OnTypedEventFunc);
+
+    sint64 begin = LLBC_GetMicroSeconds();
+    for (int i = 0; i < fireTimes; ++i)
+    {
+        LLBC_Event *bevEv = LLBC_New1(LLBC_Event, EventIds::BenchEvent);
+        bevEv->SetParam(0, i);
+        benchEvMgr.FireEvent(bevEv);
+    }
+    std::cout <<"Fire LLBC_Event " <<fireTimes <<" times, used(us): " <<LLBC_GetMicroSeconds() - begin <<std::endl;
+
+    begin = LLBC_GetMicroSeconds();
+    for (int i = 0; i < fireTimes; ++i)
+    {
+        TypedEvent benchEv;
+        benchEv.value = i;
+        benchEv.desc = NULL;
+        benchEvMgr.FireTypedEvent(EventIds::BenchEvent, benchEv);
+    }
+    std::cout <<"Fire typed event " <<fireTimes <<" times, used(us): " <<LLBC_GetMicroSeconds() - begin <<std::endl;
+}
+
+void TestCase_Core_Event::OnTypedEvent(const TypedEvent &ev)
+{
+    ++_typedFiredTimes;
+    std::cout <<"OnTypedEvent() called, value: " <<ev.value <<", desc: " <<ev.desc <<std::endl;
+
+    // Remove func listener in firing, operation will be delayed.
+    if (_typedFuncStub != LLBC_INVALID_LISTENER_STUB)
+    {
+        int ret = evMgr.RemoveListenerX(_typedFuncStub);
+        std::cout <<"Remove typed func listener in firing, ret: " <<ret
+                  <<", error: " <<LLBC_FormatLastError() <<std::endl;
+    }
+}
@@ -25,6 +25,8 @@
 #include "llbc.h"
 using namespace llbc;
 
+struct TypedEvent;
+
 class TestCase_Core_Event : public LLBC_BaseTestCase
 {
 public:
@@ -40,9 +42,16 @@ private:
 
     void OnEvent2(LLBC_Event *ev);
 
+private:
+    void TypedEventTest();
+    void OnTypedEvent(const TypedEvent &ev);
+
 private:
     LLBC_ListenerStub _ev1Stub;
     LLBC_ListenerStub _ev1TooStub;
+
+    LLBC_ListenerStub _typedFuncStub;
+    int _typedFiredTimes;
 };
 
 #endif // !__LLBC_TEST_CASE_CORE_EVENT_H__
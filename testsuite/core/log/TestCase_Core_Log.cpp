@@ -22,6 +22,44 @@
 
 #include "core/log/TestCase_Core_Log.h"
 
+namespace
+{
+    class RingLogPerfTestTask : public LLBC_BaseTask
+    {
+    public:
+        RingLogPerfTestTask(int logTimes)
+        : _logTimes(logTimes)
+        {
+        }
+
+    public:
+        virtual void Svc()
+        {
+            for (int i = 0; i < _logTimes; ++i)
+                LLBC_DEBUG_LOG_SPEC("ringperftest", "ring performance test msg, idx: %d", i);
+        }
+
+        virtual void Cleanup()
+        {
+        }
+
+    private:
+        int _logTimes;
+    };
+
+    // Short-lived log ring producer thread, log some messages and exit.
+    const int ringReclaimTestLogTimes = 100;
+
+    int RingReclaimTestThreadProc(void *arg)
+    {
+        const int threadIdx = static_cast<int>(reinterpret_cast<size_t>(arg));
+        for (int i = 0; i < ringReclaimTestLogTimes; ++i)
+            LLBC_DEBUG_LOG_SPEC("ringreclaimtest", "ring reclaim test msg, thread: %d, idx: %d", threadIdx, i);
+
+        return 0;
+    }
+}
+
 TestCase_Core_Log::TestCase_Core_Log()
 {
 }
@@ -162,6 +200,33 @@ int TestCase_Core_Log::Run(int argc, char *argv[])
     LLBC_PrintLine("Performance test completed, "
         "log size:%d, elapsed time: %s", loopLmt, elapsed.ToString().c_str());
 
+    // Perform binary log(deferred formatting) test.
+    DoBinaryLogTest();
+
+    // Perform log ring performance test.
+    DoRingLogPerfTest();
+
+    // Perform log ring reclaim test.
+    DoRingReclaimLogTest();
+
+    // Perform network log test.
+    DoNetworkLogTest();
+
+    // Perform file chunk mode test.
+    DoChunkLogTest();
+
+    // Perform file mmap mode performance test.
+    DoMmapLogPerfTest();
+
+    // Perform rate limit log test.
+    DoRateLimitLogTest();
+
+    // Perform json log(streaming & deferred) performance test.
+    DoJsonLogPerfTest();
+
+    // Perform disabled level log performance test.
+    DoDisabledLogPerfTest();
+
     // test json styled log
     DoJsonLogTest();
 
@@ -178,6 +243,353 @@ int TestCase_Core_Log::Run(int argc, char *argv[])
     return 0;
 }
 
+void TestCase_Core_Log::DoBinaryLogTest()
+{
+    LLBC_PrintLine("Perform binary log test:");
+
+    LLBC_DEBUG_BLOG("This is a binary debug log message.");
+    LLBC_INFO_BLOG2("test_tag", "Binary log message, sint32: %d, uint32: %u, sint64: %lld, hex: 0x%08x",
+                    -32, 32u, static_cast<sint64>(-64), 0xabcdu);
+    LLBC_WARN_BLOG("Binary log message, float: %.3f, double: %e, char: %c, bool: %d", 1.5f, 2.5, 'c', true);
+    LLBC_ERROR_BLOG("Binary log message, str: %s, std::string: %-10s|, LLBC_String: %10s|, ptr: %p",
+                    "c_str", std::string("std_str"), LLBC_String("llbc_str"), this);
+    LLBC_FATAL_BLOG("Binary log message, width: %*d|, precision: %.*f, percent: 100%%, missing arg: %d", 8, 10, 2, 3.14159);
+    LLBC_INFO_BLOG_SPEC2("test", "test_tag", "Binary log message to test logger, mismatched conversion: %d, %s", 3.9, 10);
+
+    LLBC_CPUTime begin = LLBC_CPUTime::Current();
+    const int loopLmt = 500000;
+    for (int i = 0; i < loopLmt; ++i)
+        LLBC_DEBUG_BLOG_SPEC("perftest", "binary performance test msg, idx: %d, str: %s", i, "str");
+
+    LLBC_CPUTime elapsed = LLBC_CPUTime::Current() - begin;
+    LLBC_PrintLine("Binary log performance test completed, "
+        "log size:%d, elapsed time: %s", loopLmt, elapsed.ToString().c_str());
+}
+
+void TestCase_Core_Log::DoRingLogPerfTest()
+{
+    LLBC_PrintLine("Perform log ring preformance test:");
+
+    const int threadNum = 4;
+    const int logTimes = 200000;
+    RingLogPerfTestTask *task = LLBC_New1(RingLogPerfTestTask, logTimes);
+
+    LLBC_CPUTime begin = LLBC_CPUTime::Current();
+    task->Activate(threadNum);
+    task->Wait();
+    LLBC_CPUTime elapsed = LLBC_CPUTime::Current() - begin;
+
+    LLBC_Delete(task);
+
+    LLBC_Logger *logger = LLBC_LoggerManagerSingleton->GetLogger("ringperftest");
+    LLBC_PrintLine("Log ring performance test completed, threads: %d, log size:%d, elapsed time: %s, dropped: %lld",
+                   threadNum, threadNum * logTimes, elapsed.ToString().c_str(), logger->GetDroppedLogCount());
+}
+
+void TestCase_Core_Log::DoRingReclaimLogTest()
+{
+    LLBC_PrintLine("Perform log ring reclaim test:");
+
+    // Log file lazy created, delete old log file to only check this test's log records.
+    const LLBC_String logFile = "log/ringreclaimtest.log";
+    if (LLBC_File::Exists(logFile))
+        LLBC_File::DeleteFile(logFile);
+
+    // Short-lived producer threads more than max ring count, exited threads' rings must be reused,
+    // and log records written before thread exit must not lost.
+    const int threadNum = LLBC_CFG_LOG_MAX_RING_COUNT + 44;
+    const int logTimes = ringReclaimTestLogTimes;
+    for (int threadIdx = 0; threadIdx < threadNum; ++threadIdx)
+    {
+        // Thread exit immediately, use native thread to wait thread exited.
+        LLBC_NativeThreadHandle nativeHandle;
+        if (LLBC_CreateThread(&nativeHandle,
+                              &RingReclaimTestThreadProc,
+                              reinterpret_cast<void *>(static_cast<size_t>(threadIdx))) != LLBC_OK)
+        {
+            LLBC_PrintLine("Create log ring producer thread failed, error: %s", LLBC_FormatLastError());
+            return;
+        }
+
+        LLBC_JoinThread(nativeHandle);
+    }
+
+    // Wait for log thread drain rings and flush.
+    LLBC_ThreadManager::Sleep(LLBC_CFG_LOG_MAX_LOG_FLUSH_INTERVAL + 500);
+
+    // Check all log records output once.
+    std::vector<int> outputTimes(threadNum * logTimes, 0);
+    const std::vector<LLBC_String> lines = LLBC_File::ReadToEnd(logFile).split('\n');
+    int matchedRecords = 0;
+    for (size_t i = 0; i < lines.size(); ++i)
+    {
+        int threadIdx, idx;
+        if (sscanf(lines[i].c_str(), "ring reclaim test msg, thread: %d, idx: %d", &threadIdx, &idx) != 2 ||
+            threadIdx < 0 || threadIdx >= threadNum || idx < 0 || idx >= logTimes)
+            continue;
+
+        if (++outputTimes[threadIdx * logTimes + idx] == 1)
+            ++matchedRecords;
+    }
+
+    const bool allOutputOnce =
+        std::count(outputTimes.begin(), outputTimes.end(), 1) == static_cast<int>(outputTimes.size());
+    LLBC_PrintLine("Log ring reclaim test completed, threads: %d, log size: %d, matched records: %d",
+                   threadNum, threadNum * logTimes, matchedRecords);
+    if (!allOutputOnce)
+        LLBC_PrintLine("  Log ring reclaim test failed, some log records lost or output more than once");
+}
+
+void TestCase_Core_Log::DoNetworkLogTest()
+{
+    LLBC_PrintLine("Perform network log test:");
+
+    // Create local log collector(the port must same as networktest logger config).
+    LLBC_SocketHandle collector = LLBC_CreateUdpSocket();
+    if (collector == LLBC_INVALID_SOCKET_HANDLE ||
+        LLBC_BindToAddress(collector, "127.0.0.1", 17789) != LLBC_OK)
+    {
+        LLBC_PrintLine("Create local log collector failed, error: %s", LLBC_FormatLastError());
+        if (collector != LLBC_INVALID_SOCKET_HANDLE)
+            LLBC_CloseSocket(collector);
+
+        return;
+    }
+
+    const int logTimes = 2000;
+    for (int i = 0; i < logTimes; ++i)
+        LLBC_INFO_LOG_SPEC("networktest", "network log test msg, idx: %d", i);
+
+    // Receive log records, every datagram contain many frames: [uint32 length(network order)][log record].
+    int recvCount = 0;
+    int datagramCount = 0;
+    int outOfOrderCount = 0;
+    char buf[65536];
+    while (recvCount < logTimes)
+    {
+        LLBC_FdSet readFds;
+        LLBC_ZeroFdSet(&readFds);
+        LLBC_SetFd(collector, &readFds);
+        if (LLBC_Select(static_cast<int>(collector) + 1, &readFds, NULL, NULL, 3000) <= 0)
+            break;
+
+        const int len = LLBC_Recv(collector, buf, sizeof(buf), 0);
+        if (len <= 0)
+            break;
+
+        ++datagramCount;
+        for (int pos = 0; pos + static_cast<int>(sizeof(uint32)) <= len; )
+        {
+            uint32 recordLen;
+            ::memcpy(&recordLen, buf + pos, sizeof(uint32));
+            recordLen = LLBC_Net2Host2(recordLen);
+            pos += sizeof(uint32);
+
+            const LLBC_String record(buf + pos, recordLen);
+            if (record != LLBC_String().format("network log test msg, idx: %d", recvCount))
+                ++outOfOrderCount;
+
+            pos += recordLen;
+            ++recvCount;
+        }
+    }
+
+    LLBC_CloseSocket(collector);
+
+    LLBC_Logger *logger = LLBC_LoggerManagerSingleton->GetLogger("networktest");
+    LLBC_PrintLine("Network log test completed, logged: %d, received: %d, datagrams: %d, "
+                   "out of order: %d, sent: %lld, dropped: %lld",
+                   logTimes, recvCount, datagramCount, outOfOrderCount,
+                   logger->GetNetworkSentLogCount(), logger->GetNetworkDroppedLogCount());
+}
+
+void TestCase_Core_Log::DoChunkLogTest()
+{
+    LLBC_PrintLine("Perform file chunk mode test:");
+
+    // Log file lazy created, delete old log file to make file offset start from 0.
+    const LLBC_String logFile = "log/chunktest.log";
+    if (LLBC_File::Exists(logFile))
+        LLBC_File::DeleteFile(logFile);
+
+    // Log records with different length(some records greater than chunk size, will span chunks),
+    // except partial chunk flushed, every chunk write must end at chunk boundary.
+    const int chunkSize = 4096;
+    const int recordCount = 300;
+    std::vector<LLBC_String> records;
+    int alignedTimes = 0;
+    int unalignedTimes = 0;
+    sint64 lastFileSize = 0;
+    for (int i = 0; i < recordCount; ++i)
+    {
+        LLBC_String record;
+        record.format("chunk test record, idx: %d, padding: ", i);
+        record.append((i * 1031) % 6000, 'x');
+        records.push_back(record);
+
+        LLBC_DEBUG_LOG_SPEC("chunktest", "%s", record.c_str());
+        LLBC_ThreadManager::Sleep(1);
+
+        LLBC_FileAttributes attrs;
+        if (LLBC_File::GetFileAttributes(logFile, attrs) != LLBC_OK ||
+            attrs.fileSize == lastFileSize)
+            continue;
+
+        lastFileSize = attrs.fileSize;
+        if (lastFileSize % chunkSize == 0)
+            ++alignedTimes;
+        else
+            ++unalignedTimes;
+    }
+
+    // Wait for partial chunk flushed.
+    LLBC_ThreadManager::Sleep(LLBC_CFG_LOG_MAX_LOG_FLUSH_INTERVAL + 500);
+
+    // Check record boundaries.
+    const LLBC_String content = LLBC_File::ReadToEnd(logFile);
+    int matchedRecords = 0;
+    size_t pos = 0;
+    for (; matchedRecords < recordCount; ++matchedRecords)
+    {
+        const LLBC_String &record = records[matchedRecords];
+        if (content.size() < pos + record.size() + 1 ||
+            ::memcmp(content.data() + pos, record.data(), record.size()) != 0 ||
+            content[pos + record.size()] != '\n')
+            break;
+
+        pos += record.size() + 1;
+    }
+
+    LLBC_PrintLine("File chunk mode test completed, file size: %lu, matched records: %d(expect: %d), "
+                   "chunk boundary aligned file size changes: %d, unaligned(partial chunk flushed): %d",
+                   content.size(), matchedRecords, recordCount, alignedTimes, unalignedTimes);
+    if (matchedRecords != recordCount || pos != content.size())
+        LLBC_PrintLine("  File chunk mode test failed, record boundary error at record: %d, file pos: %lu",
+                       matchedRecords, pos);
+    if (unalignedTimes * 4 > alignedTimes)
+        LLBC_PrintLine("  File chunk mode test failed, too many chunk writes not end at chunk boundary");
+}
+
+void TestCase_Core_Log::DoMmapLogPerfTest()
+{
+    LLBC_PrintLine("Perform file mmap mode preformance test:");
+
+    LLBC_CPUTime begin = LLBC_CPUTime::Current();
+    const int loopLmt = 500000;
+    for (int i = 0; i < loopLmt; ++i)
+        LLBC_DEBUG_LOG_SPEC("mmapperftest", "mmap mode performance test msg, idx: %d", i);
+
+    LLBC_CPUTime elapsed = LLBC_CPUTime::Current() - begin;
+    LLBC_PrintLine("File mmap mode performance test completed, "
+        "log size:%d, elapsed time: %s", loopLmt, elapsed.ToString().c_str());
+}
+
+void TestCase_Core_Log::DoRateLimitLogTest()
+{
+    LLBC_PrintLine("Perform rate limit log test:");
+
+    // Log file already created, only check log records appended by this test.
+    const LLBC_String logFile = "log/ratelimittest.log";
+    LLBC_FileAttributes attrs;
+    const sint64 beginFileSize = LLBC_File::GetFileAttributes(logFile, attrs) == LLBC_OK ? attrs.fileSize : 0;
+
+    // Error storm: noisy tag limited to 10/s, other tags limited to 100/s, logger limited to 1000/s, and 50% sampled.
+    const int loopLmt = 100000;
+    for (int i = 0; i < loopLmt; ++i)
+    {
+        LLBC_ERROR_LOG_SPEC2("ratelimittest", "noisy_tag", "noisy error storm msg, idx: %d", i);
+        LLBC_ERROR_LOG_SPEC2("ratelimittest", "other_tag", "other error storm msg, idx: %d", i);
+        LLBC_INFO_LOG_SPEC("ratelimittest", "untagged msg, idx: %d", i);
+    }
+
+    // Suppressed report output by log thread's flush tick, no need any more log message to trigger it.
+    LLBC_Sleep(LLBC_CFG_LOG_MAX_LOG_FLUSH_INTERVAL + 500);
+
+    const LLBC_String content = LLBC_File::ReadToEnd(logFile);
+    const bool reported = content.size() > static_cast<size_t>(beginFileSize) &&
+        ::strstr(content.c_str() + beginFileSize, "suppressed ") != NULL;
+
+    LLBC_Logger *logger = LLBC_LoggerManagerSingleton->GetLogger("ratelimittest");
+    LLBC_PrintLine("Rate limit log test completed, logged: %d, suppressed: %lld, suppressed report output: %s",
+                   loopLmt * 3, logger->GetSuppressedLogCount(), reported ? "true" : "false");
+    if (!reported)
+        LLBC_PrintLine("  Rate limit log test failed, suppressed report not output by log thread");
+}
+
+void TestCase_Core_Log::DoJsonLogPerfTest()
+{
+    LLBC_PrintLine("Perform json log performance test:");
+
+    const char *loggers[] = {"jsonperftest", "jsondeferperftest"};
+    for (int loggerIdx = 0; loggerIdx < 2; ++loggerIdx)
+    {
+        const char *loggerName = loggers[loggerIdx];
+        LLBC_CPUTime begin = LLBC_CPUTime::Current();
+        const int loopLmt = 200000;
+        for (int i = 0; i < loopLmt; ++i)
+        {
+            Log.ji3(loggerName)
+                .Add("idx", i)
+                .Add("uid", static_cast<uint64>(10000000000ull + i))
+                .Add("ok", (i & 0x1) == 0)
+                .Add("ratio", i / 3.0)
+                .Add("name", "json \"perf\" test")
+                .Add("server", LLBC_String("game_1"))
+                .Finish("json log performance test msg, idx: %d", i);
+        }
+
+        LLBC_CPUTime elapsed = LLBC_CPUTime::Current() - begin;
+        LLBC_PrintLine("Json log performance test completed, logger: %s, "
+            "log size:%d, elapsed time: %s", loggerName, loopLmt, elapsed.ToString().c_str());
+    }
+}
+
+void TestCase_Core_Log::DoDisabledLogPerfTest()
+{
+    LLBC_PrintLine("Perform disabled level log performance test:");
+
+    // Lock free logger lookup must be consistent with locked lookup.
+    LLBC_Logger *logger = LLBC_LoggerManagerSingleton->GetLogger("test");
+    LLBC_String loggerName("test");
+    ASSERT(logger != NULL && logger == LLBC_LoggerManagerSingleton->GetLogger(loggerName));
+    ASSERT(Log.GetLogger("test") == logger && Log.GetLogger(NULL) == LLBC_LoggerManagerSingleton->GetRootLogger());
+
+    // Filtered json messages share one disabled message, don't get message from object pool.
+    ASSERT(&Log.jd5(logger, "disabled_tag") == &Log.jd4("test", "disabled_tag"));
+    Log.jd5(logger, "disabled_tag").Add("testKey", "testValue").Finish("");
+
+    // Enabled level messages still output through logger handle.
+    Log.i5(logger, "enabled_tag", "Enabled level log msg(from Log.i5())");
+    Log.ji5(logger, "enabled_tag").Add("testKey", "testValue->ji5").Finish("Enabled level json log msg");
+
+    // test logger level is INFO, all debug messages will be discarded before formatting.
+    LLBC_CPUTime begin = LLBC_CPUTime::Current();
+    const int loopLmt = 10000000;
+    for (int i = 0; i < loopLmt; ++i)
+        Log.d4("test", "disabled_tag", "disabled level log msg, idx: %d", i);
+
+    LLBC_CPUTime elapsed = LLBC_CPUTime::Current() - begin;
+    LLBC_PrintLine("Disabled level log performance test(by logger name) completed, "
+        "log size:%d, elapsed time: %s", loopLmt, elapsed.ToString().c_str());
+
+    // Use cached logger handle, only check logger's log level.
+    begin = LLBC_CPUTime::Current();
+    for (int i = 0; i < loopLmt; ++i)
+        Log.d5(logger, "disabled_tag", "disabled level log msg, idx: %d", i);
+
+    elapsed = LLBC_CPUTime::Current() - begin;
+    LLBC_PrintLine("Disabled level log performance test(by logger handle) completed, "
+        "log size:%d, elapsed time: %s", loopLmt, elapsed.ToString().c_str());
+
+    begin = LLBC_CPUTime::Current();
+    for (int i = 0; i < loopLmt; ++i)
+        Log.jd5(logger, "disabled_tag").Add("idx", i).Finish("disabled level json log msg");
+
+    elapsed = LLBC_CPUTime::Current() - begin;
+    LLBC_PrintLine("Disabled level json log performance test(by logger handle) completed, "
+        "log size:%d, elapsed time: %s", loopLmt, elapsed.ToString().c_str());
+}
+
 void TestCase_Core_Log::DoJsonLogTest()
 {
     LLBC_Logger *rootLogger = LLBC_LoggerManagerSingleton->GetRootLogger();
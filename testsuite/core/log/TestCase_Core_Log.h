@@ -36,6 +36,15 @@ public:
 
 private:
     void DoJsonLogTest();
+    void DoBinaryLogTest();
+    void DoRingLogPerfTest();
+    void DoRingReclaimLogTest();
+    void DoNetworkLogTest();
+    void DoChunkLogTest();
+    void DoMmapLogPerfTest();
+    void DoRateLimitLogTest();
+    void DoJsonLogPerfTest();
+    void DoDisabledLogPerfTest();
     void DoUninitLogTest();
 
     void OnLogHook(const LLBC_LogData *logData);
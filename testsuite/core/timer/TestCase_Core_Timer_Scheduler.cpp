@@ -0,0 +1,596 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "core/timer/TestCase_Core_Timer_Scheduler.h"
+
+namespace
+{
+
+class BenchTimer : public LLBC_Timer
+{
+public:
+    BenchTimer(LLBC_TimerScheduler *scheduler)
+    : LLBC_Timer(NULL, NULL, scheduler)
+    , expectTime(0)
+    , timeoutTimes(0)
+    , earlyTimes(0)
+    , maxLateness(0)
+    , lastTimeoutTime(0)
+    , cancelAfterTimeout(false)
+    {
+    }
+
+public:
+    virtual void OnTimeout()
+    {
+        const sint64 now = LLBC_GetMilliSeconds();
+        if (now < expectTime)
+            ++earlyTimes;
+        else if (now - expectTime > maxLateness)
+            maxLateness = now - expectTime;
+
+        lastTimeoutTime = now;
+
+        ++timeoutTimes;
+        expectTime += static_cast<sint64>(GetPeriod());
+
+        if (cancelAfterTimeout)
+            Cancel();
+    }
+
+public:
+    sint64 expectTime;
+    int timeoutTimes;
+    int earlyTimes;
+    sint64 maxLateness;
+    sint64 lastTimeoutTime;
+    bool cancelAfterTimeout;
+};
+
+class SlowTimer : public BenchTimer
+{
+public:
+    SlowTimer(LLBC_TimerScheduler *scheduler)
+    : BenchTimer(scheduler)
+    {
+    }
+
+public:
+    virtual void OnTimeout()
+    {
+        BenchTimer::OnTimeout();
+
+        const sint64 endTime = LLBC_GetMicroSeconds() + 200;
+        while (LLBC_GetMicroSeconds() < endTime);
+    }
+};
+
+class BatchTimeoutHandler
+{
+public:
+    BatchTimeoutHandler()
+    : calledTimes(0)
+    , timeoutTimers(0)
+    {
+    }
+
+public:
+    void OnBatchTimeout(const std::vector<LLBC_Timer *> &timers)
+    {
+        ++calledTimes;
+        timeoutTimers += static_cast<int>(timers.size());
+        for (size_t i = 0; i < timers.size(); ++i)
+            static_cast<BenchTimer *>(timers[i])->OnTimeout();
+    }
+
+public:
+    int calledTimes;
+    int timeoutTimers;
+};
+
+// Batch timeout handler, replace self with new handler in every invoke.
+class SelfReplaceBatchHandler : public LLBC_IDelegate1<void, const std::vector<LLBC_Timer *> &>
+{
+public:
+    SelfReplaceBatchHandler(LLBC_TimerScheduler *scheduler)
+    : _scheduler(scheduler)
+    , _invoking(false)
+    {
+    }
+
+    virtual ~SelfReplaceBatchHandler()
+    {
+        if (_invoking)
+            ++deletedWhenInvokingTimes;
+    }
+
+public:
+    virtual void Invoke(const std::vector<LLBC_Timer *> &timers)
+    {
+        _invoking = true;
+
+        ++calledTimes;
+        timeoutTimers += static_cast<int>(timers.size());
+        for (size_t i = 0; i < timers.size(); ++i)
+            static_cast<BenchTimer *>(timers[i])->OnTimeout();
+
+        _scheduler->SetBatchTimeoutHandler(1, LLBC_New1(SelfReplaceBatchHandler, _scheduler));
+
+        _invoking = false;
+    }
+
+public:
+    static int calledTimes;
+    static int timeoutTimers;
+    static int deletedWhenInvokingTimes;
+
+private:
+    LLBC_TimerScheduler *_scheduler;
+    bool _invoking;
+};
+
+int SelfReplaceBatchHandler::calledTimes = 0;
+int SelfReplaceBatchHandler::timeoutTimers = 0;
+int SelfReplaceBatchHandler::deletedWhenInvokingTimes = 0;
+
+// Delete specified timers in timeout, use to delete batch group timers which timeout in same Update().
+class DeleteTimersTimer : public LLBC_Timer
+{
+public:
+    DeleteTimersTimer(LLBC_TimerScheduler *scheduler)
+    : LLBC_Timer(NULL, NULL, scheduler)
+    {
+    }
+
+public:
+    virtual void OnTimeout()
+    {
+        for (size_t i = 0; i < victims.size(); ++i)
+            LLBC_Delete(victims[i]);
+        victims.clear();
+
+        Cancel();
+    }
+
+public:
+    std::vector<BenchTimer *> victims;
+};
+
+}
+
+int TestCase_Core_Timer_Scheduler::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("core/timer scheduler test:");
+
+    for (int type = LLBC_TimerSchedulerType::Begin; type != LLBC_TimerSchedulerType::End; ++type)
+    {
+        if (CorrectnessTest(type) != LLBC_OK ||
+            CoalesceTest(type) != LLBC_OK ||
+            ReplaceBatchHandlerTest(type) != LLBC_OK ||
+            DeleteBatchTimerTest(type) != LLBC_OK ||
+            InstrumentTest(type) != LLBC_OK)
+        {
+            LLBC_PrintLine("Press any key to continue ...");
+            getchar();
+
+            return LLBC_FAILED;
+        }
+    }
+
+    const int timerCounts[] = {10000, 100000, 1000000};
+    for (size_t i = 0; i < sizeof(timerCounts) / sizeof(timerCounts[0]); ++i)
+    {
+        for (int type = LLBC_TimerSchedulerType::Begin; type != LLBC_TimerSchedulerType::End; ++type)
+            PerfTest(type, timerCounts[i]);
+    }
+
+    LLBC_PrintLine("Press any key to continue ...");
+    getchar();
+
+    return LLBC_OK;
+}
+
+int TestCase_Core_Timer_Scheduler::CorrectnessTest(int schedulerType)
+{
+    LLBC_PrintLine("Correctness test, scheduler type: %s", 
+        LLBC_TimerSchedulerType::GetTypeDesc(schedulerType).c_str());
+
+    const int timerCount = 2000;
+    LLBC_TimerScheduler scheduler(schedulerType);
+
+    // Schedule timers, cancel odd timers, even timers cancel self after first timeout.
+    std::vector<BenchTimer *> timers;
+    for (int i = 0; i < timerCount; ++i)
+    {
+        BenchTimer *timer = LLBC_New1(BenchTimer, &scheduler);
+        const uint64 dueTime = (i % 100 == 0) ? 0 : LLBC_RandInt(1, 500);
+        timer->expectTime = LLBC_GetMilliSeconds() + dueTime;
+        timer->cancelAfterTimeout = true;
+        timer->Schedule(dueTime, 1000);
+
+        timers.push_back(timer);
+    }
+
+    for (int i = 1; i < timerCount; i += 2)
+        timers[i]->Cancel();
+
+    if (scheduler.GetTimerCount() != static_cast<size_t>(timerCount / 2))
+    {
+        LLBC_PrintLine("  Timer count error after cancel, expect: %d, actual: %lu",
+            timerCount / 2, scheduler.GetTimerCount());
+        return LLBC_FAILED;
+    }
+
+    const sint64 endTime = LLBC_GetMilliSeconds() + 600;
+    while (LLBC_GetMilliSeconds() < endTime)
+    {
+        scheduler.Update();
+        LLBC_ThreadManager::Sleep(1);
+    }
+
+    int ret = LLBC_OK;
+    sint64 maxLateness = 0;
+    for (int i = 0; i < timerCount; ++i)
+    {
+        BenchTimer *timer = timers[i];
+        const int expectTimes = (i % 2 == 0) ? 1 : 0;
+        if (timer->timeoutTimes != expectTimes || timer->earlyTimes != 0)
+        {
+            LLBC_PrintLine("  Timer %d timeout error, expect times: %d, actual times: %d, early times: %d",
+                i, expectTimes, timer->timeoutTimes, timer->earlyTimes);
+            ret = LLBC_FAILED;
+        }
+
+        maxLateness = MAX(maxLateness, timer->maxLateness);
+        LLBC_Delete(timer);
+    }
+
+    if (ret == LLBC_OK)
+        LLBC_PrintLine("  Correctness test passed, max lateness: %lld ms, remain timers: %lu",
+            maxLateness, scheduler.GetTimerCount());
+
+    return ret;
+}
+
+int TestCase_Core_Timer_Scheduler::CoalesceTest(int schedulerType)
+{
+    LLBC_PrintLine("Coalesce test, scheduler type: %s",
+        LLBC_TimerSchedulerType::GetTypeDesc(schedulerType).c_str());
+
+    const int timerCount = 2000;
+    const uint64 slack = 64;
+    LLBC_TimerScheduler scheduler(schedulerType);
+
+    typedef LLBC_Delegate1<void, BatchTimeoutHandler, const std::vector<LLBC_Timer *> &> _BatchDeleg;
+
+    BatchTimeoutHandler handler;
+    scheduler.SetBatchTimeoutHandler(1, LLBC_New2(_BatchDeleg, &handler, &BatchTimeoutHandler::OnBatchTimeout));
+
+    // All timers set slack, even timers use batch group 1.
+    std::vector<BenchTimer *> timers;
+    for (int i = 0; i < timerCount; ++i)
+    {
+        BenchTimer *timer = LLBC_New1(BenchTimer, &scheduler);
+        const uint64 dueTime = LLBC_RandInt(1, 500);
+        timer->expectTime = LLBC_GetMilliSeconds() + dueTime;
+        timer->cancelAfterTimeout = true;
+        timer->SetSlack(slack);
+        if (i % 2 == 0)
+            timer->SetBatchGroup(1);
+
+        timer->Schedule(dueTime, 1000);
+        timers.push_back(timer);
+    }
+
+    const sint64 endTime = LLBC_GetMilliSeconds() + 700;
+    while (LLBC_GetMilliSeconds() < endTime)
+    {
+        scheduler.Update();
+        LLBC_ThreadManager::Sleep(1);
+    }
+
+    int ret = LLBC_OK;
+    sint64 maxLateness = 0;
+    std::set<sint64> timeoutTimes;
+    for (int i = 0; i < timerCount; ++i)
+    {
+        BenchTimer *timer = timers[i];
+        if (timer->timeoutTimes != 1 || timer->earlyTimes != 0)
+        {
+            LLBC_PrintLine("  Timer %d timeout error, timeout times: %d, early times: %d",
+                i, timer->timeoutTimes, timer->earlyTimes);
+            ret = LLBC_FAILED;
+        }
+
+        timeoutTimes.insert(timer->lastTimeoutTime);
+        maxLateness = MAX(maxLateness, timer->maxLateness);
+        LLBC_Delete(timer);
+    }
+
+    if (handler.timeoutTimers != timerCount / 2)
+    {
+        LLBC_PrintLine("  Batch timeout timers error, expect: %d, actual: %d", timerCount / 2, handler.timeoutTimers);
+        ret = LLBC_FAILED;
+    }
+
+    if (ret == LLBC_OK)
+        LLBC_PrintLine("  Coalesce test passed, slack: %llu ms, max lateness: %lld ms, "
+                       "distinct timeout time: %lu, batch handler called times: %d",
+                       slack, maxLateness, timeoutTimes.size(), handler.calledTimes);
+
+    return ret;
+}
+
+int TestCase_Core_Timer_Scheduler::ReplaceBatchHandlerTest(int schedulerType)
+{
+    LLBC_PrintLine("Replace batch handler in handler test, scheduler type: %s",
+        LLBC_TimerSchedulerType::GetTypeDesc(schedulerType).c_str());
+
+    const int timerCount = 200;
+    LLBC_TimerScheduler scheduler(schedulerType);
+    scheduler.SetInstrumentEnabled(true);
+
+    SelfReplaceBatchHandler::calledTimes = 0;
+    SelfReplaceBatchHandler::timeoutTimers = 0;
+    SelfReplaceBatchHandler::deletedWhenInvokingTimes = 0;
+    scheduler.SetBatchTimeoutHandler(1, LLBC_New1(SelfReplaceBatchHandler, &scheduler));
+
+    std::vector<BenchTimer *> timers;
+    for (int i = 0; i < timerCount; ++i)
+    {
+        BenchTimer *timer = LLBC_New1(BenchTimer, &scheduler);
+        const uint64 dueTime = LLBC_RandInt(1, 100);
+        timer->expectTime = LLBC_GetMilliSeconds() + dueTime;
+        timer->cancelAfterTimeout = true;
+        timer->SetBatchGroup(1);
+        timer->Schedule(dueTime, 1000);
+        timers.push_back(timer);
+    }
+
+    const sint64 endTime = LLBC_GetMilliSeconds() + 300;
+    while (LLBC_GetMilliSeconds() < endTime)
+    {
+        scheduler.Update();
+        LLBC_ThreadManager::Sleep(1);
+    }
+
+    int ret = LLBC_OK;
+    for (int i = 0; i < timerCount; ++i)
+    {
+        if (timers[i]->timeoutTimes != 1)
+        {
+            LLBC_PrintLine("  Timer %d timeout error, timeout times: %d", i, timers[i]->timeoutTimes);
+            ret = LLBC_FAILED;
+        }
+
+        LLBC_Delete(timers[i]);
+    }
+
+    if (SelfReplaceBatchHandler::timeoutTimers != timerCount ||
+        SelfReplaceBatchHandler::deletedWhenInvokingTimes != 0)
+    {
+        LLBC_PrintLine("  Replace batch handler error, batch timeout timers: %d(expect: %d), "
+                       "handler deleted when invoking times: %d",
+                       SelfReplaceBatchHandler::timeoutTimers, timerCount,
+                       SelfReplaceBatchHandler::deletedWhenInvokingTimes);
+        ret = LLBC_FAILED;
+    }
+
+    if (ret == LLBC_OK)
+        LLBC_PrintLine("  Replace batch handler test passed, handler called(and replaced) times: %d",
+                       SelfReplaceBatchHandler::calledTimes);
+
+    return ret;
+}
+
+int TestCase_Core_Timer_Scheduler::DeleteBatchTimerTest(int schedulerType)
+{
+    LLBC_PrintLine("Delete batch timers before batch handler called test, scheduler type: %s",
+        LLBC_TimerSchedulerType::GetTypeDesc(schedulerType).c_str());
+
+    const int timerCount = 10;
+    LLBC_TimerScheduler scheduler(schedulerType);
+
+    // Batch group 1: half timers deleted, batch group 2: all timers deleted.
+    typedef LLBC_Delegate1<void, BatchTimeoutHandler, const std::vector<LLBC_Timer *> &> _BatchDeleg;
+    BatchTimeoutHandler handler1;
+    BatchTimeoutHandler handler2;
+    scheduler.SetBatchTimeoutHandler(1, LLBC_New2(_BatchDeleg, &handler1, &BatchTimeoutHandler::OnBatchTimeout));
+    scheduler.SetBatchTimeoutHandler(2, LLBC_New2(_BatchDeleg, &handler2, &BatchTimeoutHandler::OnBatchTimeout));
+
+    DeleteTimersTimer *deleteTimer = LLBC_New1(DeleteTimersTimer, &scheduler);
+    std::vector<BenchTimer *> keptTimers;
+    for (int i = 0; i < timerCount; ++i)
+    {
+        BenchTimer *timer1 = LLBC_New1(BenchTimer, &scheduler);
+        timer1->SetBatchGroup(1);
+        timer1->Schedule(5, 1000);
+        if (i % 2 == 0)
+            deleteTimer->victims.push_back(timer1);
+        else
+            keptTimers.push_back(timer1);
+
+        BenchTimer *timer2 = LLBC_New1(BenchTimer, &scheduler);
+        timer2->SetBatchGroup(2);
+        timer2->Schedule(5, 1000);
+        deleteTimer->victims.push_back(timer2);
+    }
+
+    // Delete timer timeout after batch timers, but in the same Update().
+    deleteTimer->Schedule(10, 1000);
+    LLBC_ThreadManager::Sleep(30);
+    scheduler.Update();
+
+    int ret = LLBC_OK;
+    if (!deleteTimer->victims.empty())
+    {
+        LLBC_PrintLine("  Delete timer not timeout in the same Update() with batch timers");
+        ret = LLBC_FAILED;
+    }
+
+    if (handler1.calledTimes != 1 || handler1.timeoutTimers != timerCount / 2)
+    {
+        LLBC_PrintLine("  Batch group 1 error, called times: %d(expect: 1), timeout timers: %d(expect: %d)",
+                       handler1.calledTimes, handler1.timeoutTimers, timerCount / 2);
+        ret = LLBC_FAILED;
+    }
+
+    if (handler2.calledTimes != 0)
+    {
+        LLBC_PrintLine("  Batch group 2 error, all timers deleted, but handler called times: %d",
+                       handler2.calledTimes);
+        ret = LLBC_FAILED;
+    }
+
+    for (size_t i = 0; i < keptTimers.size(); ++i)
+    {
+        if (keptTimers[i]->timeoutTimes != 1)
+        {
+            LLBC_PrintLine("  Kept timer %lu timeout error, timeout times: %d",
+                           i, keptTimers[i]->timeoutTimes);
+            ret = LLBC_FAILED;
+        }
+
+        LLBC_Delete(keptTimers[i]);
+    }
+
+    LLBC_Delete(deleteTimer);
+
+    if (ret == LLBC_OK)
+        LLBC_PrintLine("  Delete batch timers test passed");
+
+    return ret;
+}
+
+int TestCase_Core_Timer_Scheduler::InstrumentTest(int schedulerType)
+{
+    LLBC_PrintLine("Instrument test, scheduler type: %s",
+        LLBC_TimerSchedulerType::GetTypeDesc(schedulerType).c_str());
+
+    LLBC_TimerScheduler scheduler(schedulerType);
+    scheduler.SetInstrumentEnabled(true);
+
+    // Schedule fast timers and slow timers(cost 200us per timeout).
+    std::vector<BenchTimer *> timers;
+    for (int i = 0; i < 1000; ++i)
+    {
+        BenchTimer *timer = i % 10 == 0 ? LLBC_New1(SlowTimer, &scheduler) : LLBC_New1(BenchTimer, &scheduler);
+        timer->Schedule(LLBC_RandInt(1, 200), LLBC_RandInt(50, 200));
+        timers.push_back(timer);
+    }
+
+    const sint64 endTime = LLBC_GetMilliSeconds() + 500;
+    while (LLBC_GetMilliSeconds() < endTime)
+    {
+        scheduler.Update();
+        LLBC_ThreadManager::Sleep(1);
+    }
+
+    sint64 timeoutTimes = 0;
+    for (size_t i = 0; i < timers.size(); ++i)
+    {
+        timeoutTimes += timers[i]->timeoutTimes;
+        LLBC_Delete(timers[i]);
+    }
+
+    LLBC_TimerInstrumentStat stat;
+    if (scheduler.InstrumentStat(stat) != LLBC_OK)
+    {
+        LLBC_PrintLine("  Get instrument stat failed, error: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    LLBC_PrintLine("  %s", stat.ToString().c_str());
+    if (stat.lateness.count != static_cast<uint64>(timeoutTimes) ||
+        stat.callbackCost.count != static_cast<uint64>(timeoutTimes) ||
+        stat.topSlowClasses.size() != 2 ||
+        stat.topSlowClasses[0].name.find("SlowTimer") == LLBC_String::npos)
+    {
+        LLBC_PrintLine("  Instrument test failed, timeout times: %lld", timeoutTimes);
+        return LLBC_FAILED;
+    }
+
+    LLBC_PrintLine("  Instrument test passed");
+
+    return LLBC_OK;
+}
+
+void TestCase_Core_Timer_Scheduler::PerfTest(int schedulerType, int timerCount)
+{
+    LLBC_PrintLine("Perf test, scheduler type: %s, timers: %d",
+        LLBC_TimerSchedulerType::GetTypeDesc(schedulerType).c_str(), timerCount);
+
+    LLBC_TimerScheduler *scheduler = LLBC_New1(LLBC_TimerScheduler, schedulerType);
+
+    std::vector<BenchTimer *> timers;
+    timers.reserve(timerCount);
+    for (int i = 0; i < timerCount; ++i)
+        timers.push_back(LLBC_New1(BenchTimer, scheduler));
+
+    // Schedule.
+    sint64 begTime = LLBC_GetMicroSeconds();
+    for (int i = 0; i < timerCount; ++i)
+        timers[i]->Schedule(LLBC_RandInt(1, 1000), LLBC_RandInt(200, 2000));
+    LLBC_PrintLine("  Schedule used: %lld us", LLBC_GetMicroSeconds() - begTime);
+
+    // Update for 1 second.
+    int updateTimes = 0;
+    sint64 updateUsed = 0;
+    const sint64 endTime = LLBC_GetMilliSeconds() + 1000;
+    while (LLBC_GetMilliSeconds() < endTime)
+    {
+        begTime = LLBC_GetMicroSeconds();
+        scheduler->Update();
+        updateUsed += LLBC_GetMicroSeconds() - begTime;
+
+        ++updateTimes;
+        LLBC_ThreadManager::Sleep(1);
+    }
+
+    sint64 timeoutTimes = 0;
+    for (int i = 0; i < timerCount; ++i)
+        timeoutTimes += timers[i]->timeoutTimes;
+    LLBC_PrintLine("  Update %d times used: %lld us, timeout times: %lld, timer count: %lu",
+        updateTimes, updateUsed, timeoutTimes, scheduler->GetTimerCount());
+
+    // Reschedule.
+    begTime = LLBC_GetMicroSeconds();
+    for (int i = 0; i < timerCount; ++i)
+        timers[i]->Schedule(LLBC_RandInt(1000, 5000), LLBC_RandInt(200, 2000));
+    LLBC_PrintLine("  Reschedule used: %lld us, timer count: %lu",
+        LLBC_GetMicroSeconds() - begTime, scheduler->GetTimerCount());
+
+    LLBC_TimerSchedulerStat stat;
+    scheduler->Stat(stat);
+    LLBC_PrintLine("  Scheduler stat: %s", stat.ToString().c_str());
+
+    // Cancel.
+    begTime = LLBC_GetMicroSeconds();
+    for (int i = 0; i < timerCount; ++i)
+        timers[i]->Cancel();
+    LLBC_PrintLine("  Cancel used: %lld us, timer count: %lu",
+        LLBC_GetMicroSeconds() - begTime, scheduler->GetTimerCount());
+
+    for (int i = 0; i < timerCount; ++i)
+        LLBC_Delete(timers[i]);
+    LLBC_Delete(scheduler);
+}
@@ -22,6 +22,55 @@
 
 #include "core/variant/TestCase_Core_VariantTest.h"
 
+namespace
+{
+    const void *HeapObj(const LLBC_Variant &var)
+    {
+        const LLBC_Variant::Holder &holder = var.GetHolder();
+        if (var.IsDict())
+            return holder.obj.dict;
+        else if (var.IsHashDict())
+            return holder.obj.hashDict;
+        else if (var.IsSeq())
+            return holder.obj.seq;
+        else
+            return holder.obj.str;
+    }
+
+    // Convert json document value to variant by hand(compare with SAX based LLBC_JsonToVariant()).
+    void JsonValueToVariant(const LLBC_JsonValue &value, LLBC_Variant &var)
+    {
+        if (value.IsObject())
+        {
+            var.BecomeDict();
+            for (LLBC_JsonMemberCIter it = value.MemberBegin(); it != value.MemberEnd(); ++it)
+                JsonValueToVariant(it->value, var[LLBC_String(it->name.GetString(), it->name.GetStringLength())]);
+        }
+        else if (value.IsArray())
+        {
+            var.BecomeSeq();
+            for (LLBC_JsonValueCIter it = value.Begin(); it != value.End(); ++it)
+            {
+                LLBC_Variant elem;
+                JsonValueToVariant(*it, elem);
+                var.SeqPushBack(elem);
+            }
+        }
+        else if (value.IsString())
+            var = LLBC_String(value.GetString(), value.GetStringLength());
+        else if (value.IsBool())
+            var = LLBC_Variant(value.GetBool());
+        else if (value.IsInt64())
+            var = static_cast<sint64>(value.GetInt64());
+        else if (value.IsUint64())
+            var = static_cast<uint64>(value.GetUint64());
+        else if (value.IsNumber())
+            var = value.GetDouble();
+        else
+            var.BecomeNil();
+    }
+}
+
 int TestCase_Core_VariantTest::Run(int argc, char *argv[])
 {
     std::cout <<"LLBC_Variant test:" <<std::endl;
@@ -39,6 +88,18 @@ int TestCase_Core_VariantTest::Run(int argc, char *argv[])
     std::cout <<std::endl;
 
     SerializeTest();
+    std::cout <<std::endl;
+
+    CopyOnWriteTest();
+    std::cout <<std::endl;
+
+    SeqAndHashDictTest();
+    std::cout <<std::endl;
+
+    JsonTest();
+    std::cout <<std::endl;
+
+    PerfTest();
 
     std::cout <<"Press any key to continue ... ..." <<std::endl;
     getchar();
@@ -307,3 +368,278 @@ void TestCase_Core_VariantTest::SerializeTest()
     stream>> deserDict;
     std::cout <<"Deserialized from stream: [" <<deserDict <<"]" <<std::endl;
 }
+
+void TestCase_Core_VariantTest::CopyOnWriteTest()
+{
+    std::cout <<"Copy-on-write test" <<std::endl;
+
+    // Short string store in variant inline, large string shared between copied variants.
+    LLBC_Variant shortStr("short str");
+    LLBC_Variant largeStr(LLBC_String(64, 'x'));
+    LLBC_Variant copiedLargeStr(largeStr);
+    std::cout <<"shortStr: " <<shortStr <<", heap allocated: " <<(HeapObj(shortStr) != NULL) <<std::endl;
+    std::cout <<"copiedLargeStr shared with largeStr: "
+              <<(HeapObj(copiedLargeStr) == HeapObj(largeStr)) <<std::endl;
+
+    copiedLargeStr = LLBC_String(64, 'y');
+    std::cout <<"After modify copiedLargeStr, largeStr unchanged: " <<(largeStr.AsStr() == LLBC_String(64, 'x'))
+              <<", shared: " <<(HeapObj(copiedLargeStr) == HeapObj(largeStr)) <<std::endl;
+
+    // Dictionary built by operator [](mutable element reference exposed) will not shared.
+    LLBC_Variant dict;
+    dict["name"] = "Judy";
+    dict["level"] = 10;
+    LLBC_Variant copiedDict(dict);
+    std::cout <<"copiedDict shared with dict: " <<(HeapObj(copiedDict) == HeapObj(dict)) <<std::endl;
+
+    // Element reference exposed before copies, modify through it must not affect any copy.
+    LLBC_Variant refDict;
+    refDict["k"] = 1;
+    LLBC_Variant &slot = refDict["k"];
+    LLBC_Variant refCopied1, refCopied2;
+    refCopied1 = refDict;
+    refCopied2 = refDict;
+    slot = 5;
+    std::cout <<"Modify exposed slot after copy, refDict[k]: " <<refDict["k"].AsInt32()
+              <<", refCopied1[k]: " <<refCopied1["k"].AsInt32()
+              <<", refCopied2[k]: " <<refCopied2["k"].AsInt32() <<std::endl;
+    if (refCopied1["k"].AsInt32() != 1 || refCopied2["k"].AsInt32() != 1)
+        std::cerr <<"Value semantics broken by exposed slot!" <<std::endl;
+
+    // Copied dictionary shared until modified.
+    LLBC_Variant copiedDict2(copiedDict);
+    std::cout <<"copiedDict2 shared with copiedDict: " <<(HeapObj(copiedDict2) == HeapObj(copiedDict)) <<std::endl;
+
+    copiedDict2["level"] = 11;
+    std::cout <<"After modify copiedDict2, copiedDict: " <<copiedDict <<", copiedDict2: " <<copiedDict2 <<std::endl;
+}
+
+void TestCase_Core_VariantTest::SeqAndHashDictTest()
+{
+    std::cout <<"Sequence and hash dictionary test" <<std::endl;
+
+    // Sequence basic operations.
+    LLBC_Variant seq;
+    seq.SeqPushBack(1);
+    seq.SeqPushBack("Hello World!");
+    seq.SeqPushBack(3.5);
+    std::cout <<"seq: " <<seq <<", size: " <<seq.AsSeq().size() <<std::endl;
+    std::cout <<"seq[1]: " <<seq[1] <<", seq[-1]: " <<seq[-1] <<std::endl;
+
+    seq[3] = "append";
+    std::cout <<"After seq[3] = \"append\": " <<seq <<std::endl;
+    seq[10] = "out of range";
+    seq[-10] = "out of range";
+    std::cout <<"After seq[10]/seq[-10] assigned(out of range, discarded): " <<seq
+              <<", last error is range error: " <<(LLBC_GetLastError() == LLBC_ERROR_RANGE) <<std::endl;
+    seq.SeqPopBack();
+    std::cout <<"After SeqPopBack(): " <<seq <<std::endl;
+
+    // Sequence arithmetic.
+    LLBC_Variant seq2(LLBC_Variant::Seq(2, LLBC_Variant(1)));
+    std::cout <<"seq + seq2: " <<(seq + seq2) <<std::endl;
+    std::cout <<"seq - seq2: " <<(seq - seq2) <<std::endl;
+    std::cout <<"seq2 * 3: " <<(seq2 * LLBC_Variant(3)) <<std::endl;
+    seq2 += seq2;
+    std::cout <<"seq2 += seq2: " <<seq2 <<std::endl;
+
+    // Sequence compare and copy-on-write.
+    LLBC_Variant copiedSeq2(seq2);
+    LLBC_Variant copiedSeq2_2(copiedSeq2);
+    std::cout <<"copiedSeq2 == seq2: " <<(copiedSeq2 == seq2)
+              <<", copiedSeq2_2 shared with copiedSeq2: " <<(HeapObj(copiedSeq2_2) == HeapObj(copiedSeq2)) <<std::endl;
+    copiedSeq2_2.SeqPushBack(2);
+    std::cout <<"After push back, copiedSeq2 < copiedSeq2_2: " <<(copiedSeq2 < copiedSeq2_2)
+              <<", copiedSeq2: " <<copiedSeq2 <<std::endl;
+
+    // Hash dictionary basic operations.
+    LLBC_Variant hashDict;
+    hashDict.BecomeHashDict();
+    hashDict["name"] = "Judy";
+    hashDict["level"] = 10;
+    hashDict[1] = seq2;
+    std::cout <<"hashDict: " <<hashDict <<std::endl;
+    std::cout <<"hashDict[\"level\"]: " <<hashDict["level"] <<", hashDict[1.0]: " <<hashDict[1.0] <<std::endl;
+
+    // Ordered dictionary iterator based methods don't support hash dictionary(and never convert it).
+    const bool inserted = hashDict.Insert("exp", 100).second;
+    std::cout <<"hashDict.Insert() inserted: " <<inserted
+              <<", still hash dict: " <<hashDict.IsHashDict()
+              <<", Find() == End(): " <<(hashDict.Find("name") == hashDict.End())
+              <<", size: " <<hashDict.AsHashDict().size() <<std::endl;
+
+    // Hash dictionary arithmetic, can mixed with ordered dictionary.
+    LLBC_Variant dict;
+    dict["level"] = 11;
+    dict["exp"] = 100;
+    std::cout <<"hashDict + dict: " <<(hashDict + dict) <<std::endl;
+    std::cout <<"hashDict - dict: " <<(hashDict - dict) <<std::endl;
+    std::cout <<"hashDict * dict: " <<(hashDict * dict) <<std::endl;
+    std::cout <<"hashDict / dict: " <<(hashDict / dict) <<std::endl;
+
+    // Become ordered dictionary / hash dictionary.
+    LLBC_Variant orderedDict(hashDict);
+    orderedDict.BecomeDict();
+    std::cout <<"orderedDict: " <<orderedDict <<", back to hash dict equal: "
+              <<(LLBC_Variant(orderedDict).BecomeHashDict() == hashDict) <<std::endl;
+
+    // Serialize, normal & compact mode.
+    for (int compact = 0; compact < 2; ++compact)
+    {
+        LLBC_Stream stream;
+        stream.SetCompact(compact != 0);
+        stream <<hashDict <<seq;
+
+        LLBC_Variant deserHashDict, deserSeq;
+        stream.SetPos(0);
+        stream >>deserHashDict >>deserSeq;
+        std::cout <<(compact ? "Compact" : "Normal") <<" serialized size: " <<stream.GetPos()
+                  <<", deserialized hashDict equal: " <<(deserHashDict == hashDict)
+                  <<", seq equal: " <<(deserSeq == seq) <<std::endl;
+    }
+}
+
+void TestCase_Core_VariantTest::JsonTest()
+{
+    std::cout <<"Json test" <<std::endl;
+
+    // Parse json to variant.
+    const LLBC_String json = "{\"name\":\"Judy\",\"level\":10,\"exp\":1.5,\"vip\":true,\"guild\":null,"
+        "\"items\":[1001,1002,{\"id\":1003,\"count\":18446744073709551615}],\"desc\":\"line1\\nline2\"}";
+    LLBC_Variant var;
+    int ret = LLBC_JsonToVariant(json, var);
+    std::cout <<"Parse json: " <<json <<std::endl;
+    std::cout <<"  ret: " <<ret <<", var: " <<var <<std::endl;
+    std::cout <<"  var[\"items\"][2][\"count\"]: " <<var["items"][2]["count"] <<std::endl;
+
+    LLBC_Variant hashVar;
+    ret = LLBC_JsonToVariant(json, hashVar, true);
+    std::cout <<"  parse as hash dict, ret: " <<ret <<", var[\"level\"]: " <<hashVar["level"]
+              <<", type: " <<hashVar.TypeToString() <<std::endl;
+
+    // Variant to json, and round trip.
+    LLBC_String outJson;
+    LLBC_VariantToJson(var, outJson);
+    std::cout <<"Variant to json: " <<outJson <<std::endl;
+
+    LLBC_Variant roundTripVar;
+    LLBC_JsonToVariant(outJson, roundTripVar);
+    std::cout <<"  round trip equal: " <<(roundTripVar == var) <<std::endl;
+
+    LLBC_Variant nonStrKeyDict;
+    nonStrKeyDict[1] = "one";
+    nonStrKeyDict[2.5] = LLBC_Variant::Seq(2, LLBC_Variant("two"));
+    LLBC_VariantToJson(nonStrKeyDict, outJson, true);
+    std::cout <<"Non-string key dict to pretty json: " <<std::endl <<outJson <<std::endl;
+
+    // Parse invalid json.
+    ret = LLBC_JsonToVariant("{\"name\":\"Judy\",", var);
+    std::cout <<"Parse invalid json, ret: " <<ret <<", error: " <<LLBC_FormatLastError() <<", var: " <<var <<std::endl;
+
+    // Performance: SAX parse/serialize vs json document.
+    LLBC_String bigJson = "[";
+    for (int i = 0; i < 1000; ++i)
+    {
+        if (i != 0)
+            bigJson.append(",");
+        bigJson.append(LLBC_String().format("{\"id\":%d,\"name\":\"item_%d\",\"attrs\":[%d,%d,%d]}", i, i, i, i * 2, i * 3));
+    }
+    bigJson.append("]");
+
+    const int times = 100;
+    sint64 begTime = LLBC_GetMicroSeconds();
+    for (int i = 0; i < times; ++i)
+        LLBC_JsonToVariant(bigJson, var);
+    std::cout <<"Parse " <<bigJson.size() <<" bytes json to variant " <<times <<" times, used(us): "
+              <<LLBC_GetMicroSeconds() - begTime <<std::endl;
+
+    begTime = LLBC_GetMicroSeconds();
+    for (int i = 0; i < times; ++i)
+    {
+        LLBC_Json::Document doc;
+        doc.Parse(bigJson.c_str());
+
+        LLBC_Variant docVar;
+        JsonValueToVariant(doc, docVar);
+    }
+    std::cout <<"Parse " <<bigJson.size() <<" bytes json to document, then convert to variant " <<times <<" times, used(us): "
+              <<LLBC_GetMicroSeconds() - begTime <<std::endl;
+
+    begTime = LLBC_GetMicroSeconds();
+    for (int i = 0; i < times; ++i)
+        LLBC_VariantToJson(var, outJson);
+    std::cout <<"Serialize variant to json " <<times <<" times, used(us): "
+              <<LLBC_GetMicroSeconds() - begTime <<std::endl;
+}
+
+void TestCase_Core_VariantTest::PerfTest()
+{
+    std::cout <<"Performance test:" <<std::endl;
+
+    const int loopTimes = 200000;
+
+    // Short string construct/copy/destroy.
+    sint64 begTime = LLBC_GetMicroSeconds();
+    for (int i = 0; i < loopTimes; ++i)
+    {
+        LLBC_Variant shortStr("entity.prop.name");
+        LLBC_Variant copied(shortStr);
+        if (copied.IsNil())
+            return;
+    }
+    std::cout <<"  short string(16 bytes) construct + copy, " <<loopTimes <<" times, used(us): "
+              <<LLBC_GetMicroSeconds() - begTime <<std::endl;
+
+    // Large string copy.
+    const LLBC_Variant largeStr(LLBC_String(1024, 'x'));
+    begTime = LLBC_GetMicroSeconds();
+    for (int i = 0; i < loopTimes; ++i)
+    {
+        LLBC_Variant copied(largeStr);
+        if (copied.IsNil())
+            return;
+    }
+    std::cout <<"  large string(1024 bytes) copy, " <<loopTimes <<" times, used(us): "
+              <<LLBC_GetMicroSeconds() - begTime <<std::endl;
+
+    // Dict copy(dict built by operator [], element reference exposed, will deep copy).
+    LLBC_Variant dict;
+    for (int i = 0; i < 16; ++i)
+        dict[i] = "dict value";
+    begTime = LLBC_GetMicroSeconds();
+    for (int i = 0; i < loopTimes / 10; ++i)
+    {
+        LLBC_Variant copied(dict);
+        if (copied.IsNil())
+            return;
+    }
+    std::cout <<"  dict(16 elements, built by operator []) copy, " <<loopTimes / 10 <<" times, used(us): "
+              <<LLBC_GetMicroSeconds() - begTime <<std::endl;
+
+    // Dict copy(copied/deserialized dict, shareable).
+    const LLBC_Variant sharedDict(dict);
+    begTime = LLBC_GetMicroSeconds();
+    for (int i = 0; i < loopTimes / 10; ++i)
+    {
+        LLBC_Variant copied(sharedDict);
+        if (copied.IsNil())
+            return;
+    }
+    std::cout <<"  dict(16 elements, copied from other dict) copy, " <<loopTimes / 10 <<" times, used(us): "
+              <<LLBC_GetMicroSeconds() - begTime <<std::endl;
+
+    // Event params like usage: dict with short string keys/values.
+    begTime = LLBC_GetMicroSeconds();
+    for (int i = 0; i < loopTimes / 10; ++i)
+    {
+        LLBC_Variant params;
+        params["name"] = "player";
+        params["scene"] = "main city";
+        params["level"] = i;
+        LLBC_Variant copied(params);
+        if (copied.IsNil())
+            return;
+    }
+    std::cout <<"  short string params dict build + copy, " <<loopTimes / 10 <<" times, used(us): "
+              <<LLBC_GetMicroSeconds() - begTime <<std::endl;
+}
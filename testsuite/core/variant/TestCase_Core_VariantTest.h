@@ -36,6 +36,10 @@ private:
     void ArithmeticTest();
     void DictTtest();
     void SerializeTest();
+    void CopyOnWriteTest();
+    void SeqAndHashDictTest();
+    void JsonTest();
+    void PerfTest();
 };
 
 #endif // !__LLBC_TEST_CORE_VARIANT_TEST_H__
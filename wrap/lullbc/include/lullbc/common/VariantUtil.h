@@ -0,0 +1,67 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "lullbc/common/Export.h"
+#include "lullbc/common/LibHeader.h"
+
+#ifndef __LULLBC_COM_VARIANT_UTIL_H__
+#define __LULLBC_COM_VARIANT_UTIL_H__
+
+/**
+ * \brief The llbc variant <-> lua object convert util class encapsulation.
+ *        Convert methods never raise lua error, caller raise error after c++ objects destructed.
+ */
+class LULLBC_HIDDEN lullbc_VariantUtil
+{
+public:
+    /**
+     * Push variant to lua stack top.
+     *  - nil:                        nil
+     *  - raw:                        boolean/integer/number(uint64 greater than max integer wrapped to negative)
+     *  - string:                     string
+     *  - dictionary/hash dictionary: table
+     *  - sequence:                   array table(index from 1)
+     * @param[in] l   - the lua vm.
+     * @param[in] var - the variant.
+     * @return int - return 0 if success, otherwise return -1(stack top not restored).
+     */
+    static int Push(lua_State *l, const LLBC_Variant &var);
+
+    /**
+     * Convert lua object to variant, array table(keys are 1..n) convert to sequence,
+     * other tables convert to hash dictionary.
+     * @param[in] l    - the lua vm.
+     * @param[in] idx  - the lua object index on stack.
+     * @param[out] var - the variant.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    static int ToVariant(lua_State *l, int idx, LLBC_Variant &var);
+
+private:
+    static int ToVariant(lua_State *l, int idx, LLBC_Variant &var, int depth);
+    static bool IsArrayTable(lua_State *l, int idx, size_t &len);
+
+private:
+    LLBC_DISABLE_ASSIGNMENT(lullbc_VariantUtil);
+};
+
+#endif // !__LULLBC_COM_VARIANT_UTIL_H__
@@ -17,4 +17,19 @@ function llbc.set_table_readonly(t, promptMsg)
             error("Could not change readonly table")
         end
     end
-end
\ No newline at end of file
+end
+
+-- Serialize lua object to binary string(llbc variant format).
+--  array table(keys are 1..n) serialize as sequence, other tables serialize as hash dictionary.
+-- @param[required] obj - the nil/boolean/number/string/table object, table could not contain function/userdata.
+-- @returns string - the serialized data.
+function llbc.serialize_table(obj)
+    return _llbc.Util_Table_Serialize(obj)
+end
+
+-- Deserialize lua object from binary string, see llbc.serialize_table().
+-- @param[required] data - the serialized data.
+-- @returns object - the deserialized lua object.
+function llbc.deserialize_table(data)
+    return _llbc.Util_Table_Deserialize(data)
+end
@@ -64,6 +64,8 @@ static luaL_Reg lullbc_NativeMethods[] = {
     {"TimerScheduler_Update", _lullbc_TimerScheduler_Update},
     {"Startup", _lullbc_Startup},
     {"Util_Table_Concat", _lullbc_Util_Table_Concat},
+    {"Util_Table_Serialize", _lullbc_Util_Table_Serialize},
+    {"Util_Table_Deserialize", _lullbc_Util_Table_Deserialize},
     {"Dir_IsDir", _lullbc_Dir_IsDir},
     {"Timer_New", _lullbc_Timer_New},
     {"Timer_GetTimerId", _lullbc_Timer_GetTimerId},
@@ -0,0 +1,231 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "lullbc/common/Export.h"
+
+#include "lullbc/common/Macro.h"
+#include "lullbc/common/Errors.h"
+
+#include "lullbc/common/VariantUtil.h"
+
+namespace
+{
+    // The max table nesting depth when convert lua table to variant(avoid recursive table).
+    const int __g_maxTableDepth = 64;
+}
+
+int lullbc_VariantUtil::Push(lua_State *l, const LLBC_Variant &var)
+{
+    if (UNLIKELY(!lua_checkstack(l, 3)))
+    {
+        LLBC_SetLastError(LLBC_ERROR_LIMIT);
+        return LLBC_FAILED;
+    }
+
+    if (var.IsRaw())
+    {
+        if (var.IsBool())
+            lua_pushboolean(l, var.AsBool() ? 1 : 0);
+        else if (var.IsFloat() || var.IsDouble())
+            lua_pushnumber(l, static_cast<lua_Number>(var.AsDouble()));
+        else if (var.IsSignedRaw())
+            lua_pushinteger(l, static_cast<lua_Integer>(var.AsInt64()));
+        else
+            lua_pushinteger(l, static_cast<lua_Integer>(var.AsUInt64()));
+    }
+    else if (var.IsStr())
+    {
+        const LLBC_String str = var.AsStr();
+        lua_pushlstring(l, str.data(), str.size());
+    }
+    else if (var.IsSeq())
+    {
+        const LLBC_Variant::Seq &seq = var.AsSeq();
+        lua_createtable(l, static_cast<int>(seq.size()), 0);
+        for (size_t i = 0; i < seq.size(); ++i)
+        {
+            if (UNLIKELY(Push(l, seq[i]) != LLBC_OK))
+                return LLBC_FAILED;
+
+            lua_rawseti(l, -2, static_cast<lua_Integer>(i + 1));
+        }
+    }
+    else if (var.IsDict())
+    {
+        const LLBC_Variant::Dict &dict = var.AsDict();
+        lua_createtable(l, 0, static_cast<int>(dict.size()));
+        for (LLBC_Variant::DictConstIter it = dict.begin(); it != dict.end(); it++)
+        {
+            // nil could not be table key, skip it.
+            if (UNLIKELY(it->first.IsNil()))
+                continue;
+
+            if (UNLIKELY(Push(l, it->first) != LLBC_OK || Push(l, it->second) != LLBC_OK))
+                return LLBC_FAILED;
+
+            lua_rawset(l, -3);
+        }
+    }
+    else if (var.IsHashDict())
+    {
+        const LLBC_Variant::HashDict &hashDict = var.AsHashDict();
+        lua_createtable(l, 0, static_cast<int>(hashDict.size()));
+        for (LLBC_Variant::HashDict::const_iterator it = hashDict.begin(); it != hashDict.end(); it++)
+        {
+            // nil could not be table key, skip it.
+            if (UNLIKELY(it->first.IsNil()))
+                continue;
+
+            if (UNLIKELY(Push(l, it->first) != LLBC_OK || Push(l, it->second) != LLBC_OK))
+                return LLBC_FAILED;
+
+            lua_rawset(l, -3);
+        }
+    }
+    else
+    {
+        lua_pushnil(l);
+    }
+
+    return LLBC_OK;
+}
+
+int lullbc_VariantUtil::ToVariant(lua_State *l, int idx, LLBC_Variant &var)
+{
+    return ToVariant(l, lua_absindex(l, idx), var, 0);
+}
+
+int lullbc_VariantUtil::ToVariant(lua_State *l, int idx, LLBC_Variant &var, int depth)
+{
+    const int type = lua_type(l, idx);
+    switch (type)
+    {
+    case LUA_TNONE:
+    case LUA_TNIL:
+        var.BecomeNil();
+        break;
+
+    case LUA_TBOOLEAN:
+        var = LLBC_Variant(lua_toboolean(l, idx) != 0);
+        break;
+
+    case LUA_TNUMBER:
+        if (lua_isinteger(l, idx))
+            var = static_cast<sint64>(lua_tointeger(l, idx));
+        else
+            var = static_cast<double>(lua_tonumber(l, idx));
+        break;
+
+    case LUA_TSTRING:
+        {
+            size_t len;
+            const char *str = lua_tolstring(l, idx, &len);
+            var = LLBC_String(str, len);
+        }
+        break;
+
+    case LUA_TTABLE:
+        {
+            if (UNLIKELY(depth >= __g_maxTableDepth || !lua_checkstack(l, 3)))
+            {
+                LLBC_SetLastError(LLBC_ERROR_LIMIT);
+                return LLBC_FAILED;
+            }
+
+            size_t len;
+            if (IsArrayTable(l, idx, len))
+            {
+                LLBC_Variant::Seq seq(len);
+                for (size_t i = 0; i < len; ++i)
+                {
+                    lua_rawgeti(l, idx, static_cast<lua_Integer>(i + 1));
+                    const int ret = ToVariant(l, lua_gettop(l), seq[i], depth + 1);
+                    lua_pop(l, 1);
+
+                    if (UNLIKELY(ret != LLBC_OK))
+                        return LLBC_FAILED;
+                }
+
+                var = seq;
+            }
+            else
+            {
+                LLBC_Variant::HashDict hashDict;
+
+                lua_pushnil(l);
+                while (lua_next(l, idx) != 0)
+                {
+                    LLBC_Variant key;
+                    const int top = lua_gettop(l);
+                    if (UNLIKELY(ToVariant(l, top - 1, key, depth + 1) != LLBC_OK ||
+                                 ToVariant(l, top, hashDict[key], depth + 1) != LLBC_OK))
+                    {
+                        lua_pop(l, 2);
+                        return LLBC_FAILED;
+                    }
+
+                    lua_pop(l, 1);
+                }
+
+                var = hashDict;
+            }
+        }
+        break;
+
+    default:
+        // function/userdata/thread/lightuserdata could not convert to variant.
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    return LLBC_OK;
+}
+
+bool lullbc_VariantUtil::IsArrayTable(lua_State *l, int idx, size_t &len)
+{
+    // Array table: not empty, and keys are exactly 1..#t.
+    len = static_cast<size_t>(lua_rawlen(l, idx));
+    if (len == 0)
+        return false;
+
+    size_t count = 0;
+    lua_pushnil(l);
+    while (lua_next(l, idx) != 0)
+    {
+        lua_pop(l, 1);
+
+        bool isIndex = false;
+        if (lua_isinteger(l, -1))
+        {
+            const lua_Integer key = lua_tointeger(l, -1);
+            isIndex = key >= 1 && static_cast<size_t>(key) <= len;
+        }
+
+        if (!isIndex || ++count > len)
+        {
+            lua_pop(l, 1);
+            return false;
+        }
+    }
+
+    return count == len;
+}
@@ -19,6 +19,8 @@
 // IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
 // CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
+#include "lullbc/common/VariantUtil.h"
+
 // Api: Util_Table_Concat
 LULLBC_LUA_METH int _lullbc_Util_Table_Concat(lua_State *l)
 {
@@ -47,3 +49,62 @@ LULLBC_LUA_METH int _lullbc_Util_Table_Concat(lua_State *l)
 
     return 1;
 }
+
+// Api: Util_Table_Serialize
+LULLBC_LUA_METH int _lullbc_Util_Table_Serialize(lua_State *l)
+{
+    if (lua_gettop(l) < 1)
+        lullbc_SetError(l, LLBC_ERROR_ARG);
+
+    // Raise lua error after variant/stream destructed.
+    int ret;
+    {
+        LLBC_Variant var;
+        ret = lullbc_VariantUtil::ToVariant(l, 1, var);
+        if (ret == LLBC_OK)
+        {
+            LLBC_Stream stream;
+            stream.Write(var);
+            lua_pushlstring(l, reinterpret_cast<const char *>(stream.GetBuf()), stream.GetPos());
+        }
+    }
+
+    if (UNLIKELY(ret != LLBC_OK))
+        lullbc_TransferLLBCError(l, __FILE__, __LINE__, "when serialize %s object", luaL_typename(l, 1));
+
+    return 1;
+}
+
+// Api: Util_Table_Deserialize
+LULLBC_LUA_METH int _lullbc_Util_Table_Deserialize(lua_State *l)
+{
+    luaL_checktype(l, 1, LUA_TSTRING);
+
+    size_t dataLen;
+    const char *data = lua_tolstring(l, 1, &dataLen);
+
+    // Raise lua error after variant/stream destructed.
+    const int top = lua_gettop(l);
+    int ret;
+    {
+        LLBC_Variant var;
+        LLBC_Stream stream(const_cast<char *>(data), dataLen, true);
+        if (stream.Read(var) && stream.GetPos() == dataLen)
+        {
+            ret = lullbc_VariantUtil::Push(l, var);
+        }
+        else
+        {
+            LLBC_SetLastError(LLBC_ERROR_DECODE);
+            ret = LLBC_FAILED;
+        }
+    }
+
+    if (UNLIKELY(ret != LLBC_OK))
+    {
+        lua_settop(l, top);
+        lullbc_TransferLLBCError(l, __FILE__, __LINE__, "when deserialize object");
+    }
+
+    return 1;
+}
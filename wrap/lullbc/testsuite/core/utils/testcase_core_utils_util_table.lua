@@ -4,6 +4,8 @@ function TestCase.run(...)
     print 'util_table test:'
     -- Test set_table_readonly
     TestCase.test_settable_readonly()
+    -- Test serialize_table/deserialize_table
+    TestCase.test_serialize_table()
 
     print 'Util_Table test success!'
 end
@@ -19,4 +21,28 @@ function TestCase.test_settable_readonly()
     print 'Test set table to readonly success!'
 end
 
+function TestCase.test_serialize_table()
+    print 'Serialize table, and deserialize it...'
+    local t = {1, 2.5, 'hello', true, {'nested', {k = 'v'}},
+               name = 'Judy', [100] = 100, empty = {}}
+    local data = llbc.serialize_table(t)
+    local dt = llbc.deserialize_table(data)
+
+    assert(#dt == 5 and dt[1] == 1 and math.type(dt[1]) == 'integer' and dt[2] == 2.5,
+           'Util_Table test failed, deserialized array part not match!')
+    assert(dt[3] == 'hello' and dt[4] == true and dt[5][1] == 'nested' and dt[5][2].k == 'v',
+           'Util_Table test failed, deserialized nested table not match!')
+    assert(dt.name == 'Judy' and dt[100] == 100 and next(dt.empty) == nil,
+           'Util_Table test failed, deserialized hash part not match!')
+
+    local seq = llbc.deserialize_table(llbc.serialize_table({'a', 'b', 'c'}))
+    assert(#seq == 3 and seq[1] == 'a' and seq[3] == 'c', 'Util_Table test failed, sequence not match!')
+
+    local ok = pcall(llbc.serialize_table, {f = function() end})
+    assert(not ok, 'Util_Table test failed, serialize function should be failed!')
+    ok = pcall(llbc.deserialize_table, string.sub(data, 1, #data - 1))
+    assert(not ok, 'Util_Table test failed, deserialize truncated data should be failed!')
+    print 'Test serialize/deserialize table success!'
+end
+
 return TestCase
\ No newline at end of file
@@ -37,6 +37,32 @@ public:
      *                       call PyErr_Occurred() to check this method execute succeed or not.
      */
     static LLBC_String GetObjStr(PyObject *obj);
+
+    /**
+     * Convert llbc variant to python object.
+     *  - nil:                      None
+     *  - raw:                      bool/int/long/float
+     *  - string:                   str
+     *  - dictionary/hash dictionary: dict(sequence key convert to tuple)
+     *  - sequence:                 list
+     * @param[in] var - the variant.
+     * @return PyObject * - the python object(new reference), return NULL if failed.
+     */
+    static PyObject *VariantToObj(const LLBC_Variant &var);
+
+    /**
+     * Convert python object to llbc variant, unicode convert to utf8 string, list/tuple convert to sequence,
+     * dict convert to hash dictionary.
+     * @param[in] obj  - the python object.
+     * @param[out] var - the variant.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    static int ObjToVariant(PyObject *obj, LLBC_Variant &var);
+
+private:
+    static int SetDictItem(PyObject *pyDict, const LLBC_Variant &key, const LLBC_Variant &val);
+    static int ObjToSeq(PyObject *obj, LLBC_Variant &var);
+    static int ObjToHashDict(PyObject *obj, LLBC_Variant &var);
 };
 
 #endif // !__PYLLBC_COM_OBJ_UTIL_H__
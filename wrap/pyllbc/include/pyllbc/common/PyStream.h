@@ -141,6 +141,7 @@ public:
     PyObject *ReadUnicode();
     PyObject *ReadByteArray();
     PyObject *ReadBuffer();
+    PyObject *ReadVariant();
 
     /**
      * Format read data.
@@ -206,6 +207,7 @@ public:
     int WriteList(PyObject *val);
     int WriteSequence(PyObject *val);
     int WriteDict(PyObject *val);
+    int WriteVariant(PyObject *val);
     int WriteInst(PyObject *val);
 
     /**
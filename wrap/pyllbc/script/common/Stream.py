@@ -191,6 +191,12 @@ class pyllbcStream(object):
     def unpackbuffer(self):
         return llbc.inl.PyStreamRead_Buffer(self.__c_obj)
 
+    def unpackvariant(self):
+        """
+        Unpack llbc variant, sequence unpack as list, dictionary/hash dictionary unpack as dict.
+        """
+        return llbc.inl.PyStreamRead_Variant(self.__c_obj)
+
     def unpackstream(self, begin=0, end=-1):
         return llbc.inl.PyStreamRead_Stream(self.__c_obj, begin, end)
 
@@ -285,6 +291,12 @@ class pyllbcStream(object):
     def packdict(self, obj):
         return llbc.inl.PyStreamWrite_Dict(self.__c_obj, obj)
 
+    def packvariant(self, obj):
+        """
+        Pack object as llbc variant, list/tuple pack as sequence, dict pack as hash dictionary.
+        """
+        return llbc.inl.PyStreamWrite_Variant(self.__c_obj, obj)
+
     def packstream(self, s, begin=0, to=-1):
         if not isinstance(s, pyllbcStream):
             raise TypeError('pack argument "s" must be stream type')
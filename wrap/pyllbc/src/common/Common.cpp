@@ -101,6 +101,7 @@ void pyllbc_AddCommonObjs()
     inlMod->AddMethod(methods.PyStreamRead_Unicode);
     inlMod->AddMethod(methods.PyStreamRead_ByteArray);
     inlMod->AddMethod(methods.PyStreamRead_Buffer);
+    inlMod->AddMethod(methods.PyStreamRead_Variant);
     inlMod->AddMethod(methods.PyStreamRead_Stream);
     inlMod->AddMethod(methods.PyStreamFmtRead);
     inlMod->AddMethod(methods.PyStreamWrite);
@@ -123,6 +124,7 @@ void pyllbc_AddCommonObjs()
     inlMod->AddMethod(methods.PyStreamWrite_List);
     inlMod->AddMethod(methods.PyStreamWrite_Sequence);
     inlMod->AddMethod(methods.PyStreamWrite_Dict);
+    inlMod->AddMethod(methods.PyStreamWrite_Variant);
     inlMod->AddMethod(methods.PyStreamWrite_Stream);
     inlMod->AddMethod(methods.PyStreamFmtWrite);
     inlMod->AddMethod(methods.PyStreamEncodeSelf);
@@ -53,3 +53,273 @@ LLBC_String pyllbc_ObjUtil::GetObjStr(PyObject *obj)
 
     return str;
 }
+
+PyObject *pyllbc_ObjUtil::VariantToObj(const LLBC_Variant &var)
+{
+    if (var.IsNil())
+    {
+        Py_RETURN_NONE;
+    }
+    else if (var.IsRaw())
+    {
+        if (var.IsBool())
+        {
+            PyObject *pyBool = var.AsBool() ? Py_True : Py_False;
+            Py_INCREF(pyBool);
+
+            return pyBool;
+        }
+        else if (var.IsFloat() || var.IsDouble())
+        {
+            return PyFloat_FromDouble(var.AsDouble());
+        }
+        else if (var.IsSignedRaw())
+        {
+            const sint64 val = var.AsInt64();
+            if (val >= LONG_MIN && val <= LONG_MAX)
+                return PyInt_FromLong(static_cast<long>(val));
+
+            return PyLong_FromLongLong(val);
+        }
+        else
+        {
+            const uint64 val = var.AsUInt64();
+            if (val <= static_cast<uint64>(LONG_MAX))
+                return PyInt_FromLong(static_cast<long>(val));
+
+            return PyLong_FromUnsignedLongLong(val);
+        }
+    }
+    else if (var.IsStr())
+    {
+        const LLBC_String str = var.AsStr();
+        return PyString_FromStringAndSize(str.data(), str.size());
+    }
+    else if (var.IsSeq())
+    {
+        const LLBC_Variant::Seq &seq = var.AsSeq();
+        PyObject *pyList = PyList_New(seq.size());
+        if (UNLIKELY(!pyList))
+        {
+            pyllbc_TransferPyError("When convert variant to python list");
+            return NULL;
+        }
+
+        for (size_t i = 0; i < seq.size(); ++i)
+        {
+            PyObject *pyElem = VariantToObj(seq[i]);
+            if (UNLIKELY(!pyElem))
+            {
+                Py_DECREF(pyList);
+                return NULL;
+            }
+
+            PyList_SET_ITEM(pyList, i, pyElem); // Steals a reference to pyElem.
+        }
+
+        return pyList;
+    }
+
+    PyObject *pyDict = PyDict_New();
+    if (UNLIKELY(!pyDict))
+    {
+        pyllbc_TransferPyError("When convert variant to python dict");
+        return NULL;
+    }
+
+    if (var.IsDict())
+    {
+        const LLBC_Variant::Dict &dict = var.AsDict();
+        for (LLBC_Variant::DictConstIter it = dict.begin(); it != dict.end(); it++)
+        {
+            if (UNLIKELY(SetDictItem(pyDict, it->first, it->second) != 0))
+            {
+                Py_DECREF(pyDict);
+                return NULL;
+            }
+        }
+    }
+    else if (var.IsHashDict())
+    {
+        const LLBC_Variant::HashDict &hashDict = var.AsHashDict();
+        for (LLBC_Variant::HashDict::const_iterator it = hashDict.begin(); it != hashDict.end(); it++)
+        {
+            if (UNLIKELY(SetDictItem(pyDict, it->first, it->second) != 0))
+            {
+                Py_DECREF(pyDict);
+                return NULL;
+            }
+        }
+    }
+
+    return pyDict;
+}
+
+int pyllbc_ObjUtil::ObjToVariant(PyObject *obj, LLBC_Variant &var)
+{
+    // Not use pyllbc_TypeDetector here, it's PyObject_IsInstance() call failed silently(treat as None)
+    // when nested container reach the recursion limit.
+    if (obj == Py_None)
+    {
+        var.BecomeNil();
+    }
+    else if (PyBool_Check(obj))
+    {
+        var = LLBC_Variant(obj == Py_True);
+    }
+    else if (PyInt_Check(obj))
+    {
+        var = static_cast<sint64>(PyInt_AS_LONG(obj));
+    }
+    else if (PyLong_Check(obj))
+    {
+        int overflow;
+        const PY_LONG_LONG val = PyLong_AsLongLongAndOverflow(obj, &overflow);
+        if (overflow == 0)
+        {
+            var = static_cast<sint64>(val);
+        }
+        else
+        {
+            const unsigned PY_LONG_LONG uval = PyLong_AsUnsignedLongLong(obj);
+            if (UNLIKELY(PyErr_Occurred()))
+            {
+                pyllbc_TransferPyError("When convert python long to variant");
+                return LLBC_FAILED;
+            }
+
+            var = static_cast<uint64>(uval);
+        }
+    }
+    else if (PyFloat_Check(obj))
+    {
+        var = PyFloat_AS_DOUBLE(obj);
+    }
+    else if (PyString_Check(obj))
+    {
+        var = LLBC_String(PyString_AS_STRING(obj), PyString_GET_SIZE(obj));
+    }
+    else if (PyUnicode_Check(obj))
+    {
+        PyObject *utf8Str = PyUnicode_AsUTF8String(obj);
+        if (UNLIKELY(!utf8Str))
+        {
+            pyllbc_TransferPyError("When convert python unicode to variant");
+            return LLBC_FAILED;
+        }
+
+        var = LLBC_String(PyString_AS_STRING(utf8Str), PyString_GET_SIZE(utf8Str));
+        Py_DECREF(utf8Str);
+    }
+    else if (PyDict_Check(obj) ||
+             (PySequence_Check(obj) && !PyByteArray_Check(obj) && !PyBuffer_Check(obj)))
+    {
+        // Container maybe contain itself, limit recursion.
+        if (UNLIKELY(Py_EnterRecursiveCall(const_cast<char *>(" when convert python object to variant")) != 0))
+        {
+            pyllbc_TransferPyError();
+            return LLBC_FAILED;
+        }
+
+        const int ret = PyDict_Check(obj) ?
+            ObjToHashDict(obj, var) : ObjToSeq(obj, var);
+        Py_LeaveRecursiveCall();
+
+        return ret;
+    }
+    else
+    {
+        pyllbc_SetError(LLBC_String().format(
+            "could not convert python object to variant, unsupported type: %s", obj->ob_type->tp_name), LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    return LLBC_OK;
+}
+
+int pyllbc_ObjUtil::SetDictItem(PyObject *pyDict, const LLBC_Variant &key, const LLBC_Variant &val)
+{
+    PyObject *pyKey = VariantToObj(key);
+    if (UNLIKELY(!pyKey))
+        return LLBC_FAILED;
+
+    // List is unhashable, sequence key convert to tuple.
+    if (key.IsSeq())
+    {
+        PyObject *pyList = pyKey;
+        pyKey = PyList_AsTuple(pyList);
+        Py_DECREF(pyList);
+
+        if (UNLIKELY(!pyKey))
+        {
+            pyllbc_TransferPyError("When convert sequence key to python tuple");
+            return LLBC_FAILED;
+        }
+    }
+
+    PyObject *pyVal = VariantToObj(val);
+    if (UNLIKELY(!pyVal))
+    {
+        Py_DECREF(pyKey);
+        return LLBC_FAILED;
+    }
+
+    const int ret = PyDict_SetItem(pyDict, pyKey, pyVal);
+    Py_DECREF(pyKey);
+    Py_DECREF(pyVal);
+
+    if (UNLIKELY(ret != 0))
+    {
+        pyllbc_TransferPyError("When set python dict item");
+        return LLBC_FAILED;
+    }
+
+    return LLBC_OK;
+}
+
+int pyllbc_ObjUtil::ObjToSeq(PyObject *obj, LLBC_Variant &var)
+{
+    PyObject *fastSeq = PySequence_Fast(obj, "");
+    if (UNLIKELY(!fastSeq))
+    {
+        pyllbc_TransferPyError("When convert python sequence to variant");
+        return LLBC_FAILED;
+    }
+
+    const Py_ssize_t size = PySequence_Fast_GET_SIZE(fastSeq);
+    LLBC_Variant::Seq seq(static_cast<size_t>(size));
+    for (Py_ssize_t i = 0; i < size; ++i)
+    {
+        if (UNLIKELY(ObjToVariant(PySequence_Fast_GET_ITEM(fastSeq, i), seq[i]) != LLBC_OK))
+        {
+            Py_DECREF(fastSeq);
+            return LLBC_FAILED;
+        }
+    }
+
+    Py_DECREF(fastSeq);
+    var = seq;
+
+    return LLBC_OK;
+}
+
+int pyllbc_ObjUtil::ObjToHashDict(PyObject *obj, LLBC_Variant &var)
+{
+    PyObject *pyKey, *pyVal;
+    Py_ssize_t pos = 0;
+
+    LLBC_Variant::HashDict hashDict;
+    while (PyDict_Next(obj, &pos, &pyKey, &pyVal))
+    {
+        LLBC_Variant key;
+        if (UNLIKELY(ObjToVariant(pyKey, key) != LLBC_OK))
+            return LLBC_FAILED;
+
+        if (UNLIKELY(ObjToVariant(pyVal, hashDict[key]) != LLBC_OK))
+            return LLBC_FAILED;
+    }
+
+    var = hashDict;
+
+    return LLBC_OK;
+}
@@ -22,6 +22,7 @@
 #include "pyllbc/common/Export.h"
 
 #include "pyllbc/common/Errors.h"
+#include "pyllbc/common/ObjUtil.h"
 #include "pyllbc/common/PyTypeDetector.h"
 #include "pyllbc/common/PackLemma.h"
 #include "pyllbc/common/PackLemmaCompiler.h"
@@ -468,6 +469,18 @@ PyObject *pyllbc_Stream::ReadBuffer()
     return pyVal;
 }
 
+PyObject *pyllbc_Stream::ReadVariant()
+{
+    LLBC_Variant var;
+    if (!_stream.Read(var))
+    {
+        pyllbc_SetError("not enough bytes to decode 'variant'", LLBC_ERROR_LIMIT);
+        return NULL;
+    }
+
+    return pyllbc_ObjUtil::VariantToObj(var);
+}
+
 PyObject *pyllbc_Stream::FmtRead(const LLBC_String &fmt, PyObject *callerEnv)
 {
     pyllbc_PackLemma *lemma = 
@@ -832,6 +845,17 @@ int pyllbc_Stream::WriteDict(PyObject *val)
     return LLBC_OK;
 }
 
+int pyllbc_Stream::WriteVariant(PyObject *val)
+{
+    LLBC_Variant var;
+    if (pyllbc_ObjUtil::ObjToVariant(val, var) != LLBC_OK)
+        return LLBC_FAILED;
+
+    _stream.Write(var);
+
+    return LLBC_OK;
+}
+
 int pyllbc_Stream::WriteInst(PyObject *val)
 {
     // 1) Search encode() method.
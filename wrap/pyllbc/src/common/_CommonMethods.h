@@ -151,6 +151,10 @@ public:
         PyStreamRead_Buffer.ml_meth = (PyCFunction)_pyllbc_PyStreamRead_Buffer;
         PyStreamRead_Buffer.ml_flags = METH_VARARGS;
         PyStreamRead_Buffer.ml_doc = "pyllbc library method/function";
+        PyStreamRead_Variant.ml_name = "PyStreamRead_Variant";
+        PyStreamRead_Variant.ml_meth = (PyCFunction)_pyllbc_PyStreamRead_Variant;
+        PyStreamRead_Variant.ml_flags = METH_VARARGS;
+        PyStreamRead_Variant.ml_doc = "pyllbc library method/function";
         PyStreamWrite_Float.ml_name = "PyStreamWrite_Float";
         PyStreamWrite_Float.ml_meth = (PyCFunction)_pyllbc_PyStreamWrite_Float;
         PyStreamWrite_Float.ml_flags = METH_VARARGS;
@@ -223,6 +227,10 @@ public:
         PyStreamWrite_Dict.ml_meth = (PyCFunction)_pyllbc_PyStreamWrite_Dict;
         PyStreamWrite_Dict.ml_flags = METH_VARARGS;
         PyStreamWrite_Dict.ml_doc = "pyllbc library method/function";
+        PyStreamWrite_Variant.ml_name = "PyStreamWrite_Variant";
+        PyStreamWrite_Variant.ml_meth = (PyCFunction)_pyllbc_PyStreamWrite_Variant;
+        PyStreamWrite_Variant.ml_flags = METH_VARARGS;
+        PyStreamWrite_Variant.ml_doc = "pyllbc library method/function";
         PyStreamRead_PyLong.ml_name = "PyStreamRead_PyLong";
         PyStreamRead_PyLong.ml_meth = (PyCFunction)_pyllbc_PyStreamRead_PyLong;
         PyStreamRead_PyLong.ml_flags = METH_VARARGS;
@@ -303,6 +311,7 @@ public:
     ::PyMethodDef PyStreamWrite_Byte;
     ::PyMethodDef PyStreamRead_Str2;
     ::PyMethodDef PyStreamRead_Buffer;
+    ::PyMethodDef PyStreamRead_Variant;
     ::PyMethodDef PyStreamWrite_Float;
     ::PyMethodDef PyStreamDiscardExpr;
     ::PyMethodDef SetPyStreamSize;
@@ -321,6 +330,7 @@ public:
     ::PyMethodDef PyStreamWrite_Sequence;
     ::PyMethodDef PyStreamWrite_Tuple;
     ::PyMethodDef PyStreamWrite_Dict;
+    ::PyMethodDef PyStreamWrite_Variant;
     ::PyMethodDef PyStreamRead_PyLong;
     ::PyMethodDef PyStreamRead_Unicode;
     ::PyMethodDef PyStreamWrite_Unicode;
@@ -277,6 +277,15 @@ LLBC_EXTERN_C PyObject *_pyllbc_PyStreamRead_Buffer(PyObject *self, PyObject *ar
     return stream->ReadBuffer();
 }
 
+LLBC_EXTERN_C PyObject *_pyllbc_PyStreamRead_Variant(PyObject *self, PyObject *args)
+{
+    pyllbc_Stream *stream;
+    if (!PyArg_ParseTuple(args, "l", &stream))
+        return NULL;
+
+    return stream->ReadVariant();
+}
+
 LLBC_EXTERN_C PyObject *_pyllbc_PyStreamRead_Stream(PyObject *self, PyObject *args)
 {
     pyllbc_Stream *willReadStream;
@@ -613,6 +622,19 @@ LLBC_EXTERN_C PyObject *_pyllbc_PyStreamWrite_Dict(PyObject *self, PyObject *arg
     return stream->GetPyObj();
 }
 
+LLBC_EXTERN_C PyObject *_pyllbc_PyStreamWrite_Variant(PyObject *self, PyObject *args)
+{
+    PyObject *obj;
+    pyllbc_Stream *stream;
+    if (!PyArg_ParseTuple(args, "lO", &stream, &obj))
+        return NULL;
+
+    if (stream->WriteVariant(obj) != LLBC_OK)
+        return NULL;
+
+    return stream->GetPyObj();
+}
+
 LLBC_EXTERN_C PyObject *_pyllbc_PyStreamWrite_Stream(PyObject *self, PyObject *args)
 {
     pyllbc_Stream *stream;
@@ -1898,6 +1898,12 @@ public:
 "    def unpackbuffer(self):\n"
 "        return llbc.inl.PyStreamRead_Buffer(self.__c_obj)\n"
 "\n"
+"    def unpackvariant(self):\n"
+"        \"\"\"\n"
+"        Unpack llbc variant, sequence unpack as list, dictionary/hash dictionary unpack as dict.\n"
+"        \"\"\"\n"
+"        return llbc.inl.PyStreamRead_Variant(self.__c_obj)\n"
+"\n"
 "    def unpackstream(self, begin=0, end=-1):\n"
 "        return llbc.inl.PyStreamRead_Stream(self.__c_obj, begin, end)\n"
 "\n"
@@ -1992,6 +1998,12 @@ public:
 "    def packdict(self, obj):\n"
 "        return llbc.inl.PyStreamWrite_Dict(self.__c_obj, obj)\n"
 "\n"
+"    def packvariant(self, obj):\n"
+"        \"\"\"\n"
+"        Pack object as llbc variant, list/tuple pack as sequence, dict pack as hash dictionary.\n"
+"        \"\"\"\n"
+"        return llbc.inl.PyStreamWrite_Variant(self.__c_obj, obj)\n"
+"\n"
 "    def packstream(self, s, begin=0, to=-1):\n"
 "        if not isinstance(s, pyllbcStream):\n"
 "            raise TypeError('pack argument \"s\" must be stream type')\n"
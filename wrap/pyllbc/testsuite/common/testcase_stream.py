@@ -39,6 +39,7 @@ class StreamTest(TestCase):
         self._brief_meth_call_test()
         self._obj_pack_test()
         self._composite_test()
+        self._variant_test()
         self._perf_test()
 
     @staticmethod
@@ -167,6 +168,46 @@ class StreamTest(TestCase):
         print 'After unpack data: {}'.format(unpacked)
         print
 
+    @staticmethod
+    def _variant_test():
+        print 'Variant test:'
+
+        s = Stream()
+        will_pack = {1: [True, None, -3, 2.5, 'hello', (u'world', [])],
+                     'big': 0xffffffffffffffff,
+                     (1, 2): {'nested': {'seq': [1, 2, 3]}},
+                     'empty': {}}
+        print 'Will pack data: {}'.format(will_pack)
+
+        s.packvariant(will_pack)
+        print 'Pack done, size: {}'.format(s.pos)
+
+        s.pos = 0
+        unpacked = s.unpackvariant()
+        print 'After unpack data: {}'.format(unpacked)
+
+        # tuple unpack as list(unpack as tuple if used as dict key), unicode unpack as utf8 str.
+        expected = {1: [True, None, -3, 2.5, 'hello', ['world', []]],
+                    'big': 0xffffffffffffffff,
+                    (1, 2): {'nested': {'seq': [1, 2, 3]}},
+                    'empty': {}}
+        assert unpacked == expected, 'unpacked variant not equal to expected: {}'.format(expected)
+
+        try:
+            s.packvariant(set([1, 2]))
+            assert False, 'pack set as variant should be failed'
+        except Exception, e:
+            print 'Pack set as variant failed(expected): {}'.format(e)
+
+        recursive_list = []
+        recursive_list.append(recursive_list)
+        try:
+            s.packvariant(recursive_list)
+            assert False, 'pack recursive list as variant should be failed'
+        except Exception, e:
+            print 'Pack recursive list as variant failed(expected): {}'.format(e)
+        print
+
     def _perf_test(self):
         print 'Performance test:'
 